@@ -0,0 +1,510 @@
+// miv_bench - headless benchmark of the load and display pipeline
+//
+// Runs each image of a corpus through the viewer's own code: DecodeImageFile (open,
+// decode, OCIO, convert), UploadCurrentImage into an offscreen VulkanRenderer, then a
+// zoom-and-pan sweep of rendered frames. Prints a table and writes the figures as JSON
+// so builds can be gated on them.
+//
+//   miv_bench [--corpus DIR] [--generate] [--iterations N] [--frames N]
+//             [--size WxH] [--no-gpu] [--json FILE]
+//
+// Without --corpus a synthetic one (LDR, HDR, uncompressed huge and tiled huge images)
+// is written to ./miv_bench_corpus on first use; --generate rewrites it.
+
+#include "viewer.h"
+#include "vulkan_renderer.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// The viewer's globals, normally defined in main.cpp
+AppContext g_ctx;
+
+void CenterImage(bool resetZoom) {
+    g_ctx.offsetX = 0.0f;
+    g_ctx.offsetY = 0.0f;
+    if (resetZoom) g_ctx.zoomFactor = 1.0f;
+}
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Options {
+    fs::path corpus = "miv_bench_corpus";
+    bool corpusGiven = false;
+    bool generate = false;
+    int iterations = 3;
+    int frames = 240;
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    bool gpu = true;
+    std::string jsonPath = "miv_bench.json";
+};
+
+// Synthetic corpus: one image per path through the decoder and renderer
+struct CorpusImage {
+    const char* name;
+    int width;
+    int height;
+    int channels;
+    bool half;              // Stored as half floats (HDR), else 8-bit
+    int tileSize;           // 0 = scanline
+    const char* compression;
+};
+constexpr CorpusImage kCorpus[] = {
+    { "ldr-4k.jpg",       3840,  2160,  3, false, 0,   "jpeg:90" },  // Typical photo
+    { "ldr-4k.png",       3840,  2160,  4, false, 0,   "" },         // Lossless with alpha
+    { "hdr-4k.exr",       3840,  2160,  4, true,  0,   "zip" },      // HDR, CPU color path
+    { "huge-8k-raw.tif",  8192,  8192,  4, false, 0,   "none" },     // Uncompressed: read in place
+    { "tiled-16k.tif",    16384, 16384, 3, false, 256, "zip" },      // Tiled past the dense limit: paged
+};
+
+struct Percentiles {
+    double p50 = 0.0;
+    double p95 = 0.0;
+};
+
+struct Result {
+    std::string file;
+    bool ok = false;
+    std::string error;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool isHdr = false;
+    const char* path = "decoded";       // How the image reached the renderer
+    double decodeMs = 0.0;              // Median over iterations
+    Trace::StageTotals stages[Trace::kStageCount];
+    bool uploaded = false;
+    double uploadMs = 0.0;
+    uint32_t uploadFrames = 0;
+    uint32_t residentDownscale = 1;
+    uint32_t frames = 0;
+    Percentiles frameMs;
+    uint64_t peakVramBytes = 0;
+    uint64_t peakRssBytes = 0;
+};
+
+double ElapsedMs(uint64_t beginNs, uint64_t endNs) {
+    return static_cast<double>(endNs - beginNs) / 1.0e6;
+}
+
+double Median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+Percentiles FramePercentiles(std::vector<double> values) {
+    Percentiles p;
+    if (values.empty()) return p;
+    std::sort(values.begin(), values.end());
+    p.p50 = values[values.size() / 2];
+    p.p95 = values[std::min(values.size() - 1, values.size() * 95 / 100)];
+    return p;
+}
+
+// Peak resident set of the process so far
+uint64_t PeakRssBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // Kilobytes on Linux
+    }
+    return 0;
+#endif
+}
+
+std::wstring ToWide(const fs::path& path) {
+#ifdef _WIN32
+    return path.wstring();
+#else
+    const std::string narrow = path.string();
+    return std::wstring(narrow.begin(), narrow.end());
+#endif
+}
+
+// Smooth gradients with a little hash noise, so compressed files neither collapse to
+// nothing nor turn into incompressible static
+float PatternValue(int x, int y, int c, int width, int height, bool hdr) {
+    uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u ^
+                 static_cast<uint32_t>(c) * 83492791u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    const float noise = static_cast<float>(h & 0xff) / 255.0f - 0.5f;
+    const float u = static_cast<float>(x) / static_cast<float>(width);
+    const float v = static_cast<float>(y) / static_cast<float>(height);
+    float value = 0.0f;
+    switch (c) {
+        case 0: value = u; break;
+        case 1: value = v; break;
+        case 2: value = 0.5f + 0.5f * std::sin(12.0f * (u + v)); break;
+        default: value = 1.0f; break;  // Opaque alpha
+    }
+    if (c < 3) {
+        value += noise * 0.06f;
+        // HDR highlights well past 1.0 exercise the tone mapping
+        if (hdr) value *= 1.0f + 7.0f * u * v;
+    }
+    return hdr ? std::max(value, 0.0f) : std::clamp(value, 0.0f, 1.0f);
+}
+
+bool WriteCorpusImage(const CorpusImage& image, const fs::path& path, std::string& error) {
+    auto out = OIIO::ImageOutput::create(path.string());
+    if (!out) {
+        error = OIIO::geterror();
+        return false;
+    }
+    OIIO::ImageSpec spec(image.width, image.height, image.channels,
+                         image.half ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8);
+    if (image.tileSize > 0) {
+        spec.tile_width = image.tileSize;
+        spec.tile_height = image.tileSize;
+    }
+    if (image.compression[0] != '\0') {
+        spec.attribute("compression", image.compression);
+    }
+    if (!out->open(path.string(), spec)) {
+        error = out->geterror();
+        return false;
+    }
+
+    // Written in bands so even the largest image needs a few tens of megabytes
+    const int bandRows = image.tileSize > 0 ? image.tileSize : 256;
+    std::vector<float> band(static_cast<size_t>(image.width) * bandRows * image.channels);
+    bool ok = true;
+    for (int y0 = 0; y0 < image.height && ok; y0 += bandRows) {
+        const int y1 = std::min(image.height, y0 + bandRows);
+        float* dst = band.data();
+        for (int y = y0; y < y1; ++y) {
+            for (int x = 0; x < image.width; ++x) {
+                for (int c = 0; c < image.channels; ++c) {
+                    *dst++ = PatternValue(x, y, c, image.width, image.height, image.half);
+                }
+            }
+        }
+        ok = image.tileSize > 0
+            ? out->write_tiles(0, image.width, y0, y1, 0, 1, OIIO::TypeDesc::FLOAT, band.data())
+            : out->write_scanlines(y0, y1, 0, OIIO::TypeDesc::FLOAT, band.data());
+    }
+    if (!ok) {
+        error = out->geterror();
+    }
+    return out->close() && ok;
+}
+
+bool PrepareCorpus(const Options& options) {
+    std::error_code ec;
+    fs::create_directories(options.corpus, ec);
+    for (const CorpusImage& image : kCorpus) {
+        const fs::path path = options.corpus / image.name;
+        if (!options.generate && fs::exists(path, ec)) continue;
+        std::printf("generating %s (%dx%d)...\n", image.name, image.width, image.height);
+        std::fflush(stdout);
+        std::string error;
+        if (!WriteCorpusImage(image, path, error)) {
+            std::fprintf(stderr, "miv_bench: cannot write %s: %s\n", path.string().c_str(), error.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<fs::path> ListCorpus(const fs::path& dir) {
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() != ".json") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void SampleVram(const VulkanRenderer* renderer, Result& result) {
+    if (renderer) {
+        result.peakVramBytes = std::max<uint64_t>(result.peakVramBytes, renderer->GetDeviceLocalUsage());
+    }
+}
+
+void RunImage(const fs::path& file, const Options& options, VulkanRenderer* renderer, Result& result) {
+    result.file = file.filename().string();
+    const std::wstring path = ToWide(file);
+    const DecodeOptions decodeOptions = CurrentDecodeOptions();
+
+    // Decode: the median run is reported; the first also warms the file cache
+    std::vector<double> decodeRuns;
+    ImageData image;
+    for (int i = 0; i < options.iterations; ++i) {
+        if (renderer) renderer->CancelPendingUpload();
+        g_ctx.imageData.clear();
+        std::string error;
+        const uint64_t begin = Trace::Now();
+        const bool ok = DecodeImageFile(path, image, error, nullptr, decodeOptions);
+        const uint64_t end = Trace::Now();
+        if (!ok) {
+            result.error = error.empty() ? "decode failed" : error;
+            return;
+        }
+        decodeRuns.push_back(ElapsedMs(begin, end));
+        if (i + 1 == options.iterations) {
+            Trace::GetStageTotals(begin, result.stages);
+        }
+    }
+    result.ok = true;
+    result.decodeMs = Median(decodeRuns);
+    result.width = image.width;
+    result.height = image.height;
+    result.isHdr = image.isHdr;
+    result.path = image.paged ? "paged" : image.mapped ? "mapped" : "decoded";
+    result.peakRssBytes = PeakRssBytes();
+
+    if (!renderer) return;
+
+    // Upload through the viewer's own hand-off, rendering until the texture is complete
+    g_ctx.imageData = std::move(image);
+    const uint64_t uploadBegin = Trace::Now();
+    UploadCurrentImage();
+    constexpr uint32_t kMaxUploadFrames = 100000;
+    do {
+        renderer->Render(options.width, options.height, 1.0f, 0.0f, 0.0f, 0);
+        result.uploadFrames++;
+    } while (renderer->HasPendingUpload() && !renderer->IsDeviceLost() && result.uploadFrames < kMaxUploadFrames);
+    const uint64_t uploadEnd = Trace::Now();
+    result.uploadMs = ElapsedMs(uploadBegin, uploadEnd);
+    result.uploaded = !renderer->IsDeviceLost() && !renderer->HasPendingUpload();
+    result.residentDownscale = renderer->GetResidentDownscale();
+    Trace::StageTotals uploadStages[Trace::kStageCount];
+    Trace::GetStageTotals(uploadBegin, uploadStages);
+    for (Trace::Stage stage : { Trace::Stage::StagingCopy, Trace::Stage::Upload }) {
+        result.stages[static_cast<size_t>(stage)] = uploadStages[static_cast<size_t>(stage)];
+    }
+    SampleVram(renderer, result);
+
+    // Render: one zoom-in-and-back sweep with a sideways pan, paced only by the GPU
+    std::vector<double> frameTimes;
+    frameTimes.reserve(static_cast<size_t>(options.frames));
+    constexpr float kTwoPi = 6.28318530718f;
+    for (int i = 0; i < options.frames && !renderer->IsDeviceLost(); ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(options.frames);
+        const float zoom = 1.0f + 3.0f * (0.5f - 0.5f * std::cos(kTwoPi * t));
+        const float offsetX = 0.25f * static_cast<float>(options.width) * std::sin(kTwoPi * t);
+        const uint64_t begin = Trace::Now();
+        renderer->Render(options.width, options.height, zoom, offsetX, 0.0f, 0);
+        frameTimes.push_back(ElapsedMs(begin, Trace::Now()));
+        if (i % 16 == 0) SampleVram(renderer, result);
+    }
+    result.frames = static_cast<uint32_t>(frameTimes.size());
+    result.frameMs = FramePercentiles(std::move(frameTimes));
+    SampleVram(renderer, result);
+    result.peakRssBytes = PeakRssBytes();
+
+    // The renderer may still read the outgoing pixels or source
+    renderer->CancelPendingUpload();
+    g_ctx.imageData.clear();
+}
+
+double MegapixelsPerSecond(uint32_t width, uint32_t height, double ms) {
+    return ms > 0.0 ? static_cast<double>(width) * height / 1.0e6 / (ms / 1000.0) : 0.0;
+}
+
+// Texel bytes as the texture holds them (RGBA8 or RGBA16F) per second
+double GigabytesPerSecond(const Result& r, double ms) {
+    const double bytes = static_cast<double>(r.width) * r.height * (r.isHdr ? 8.0 : 4.0);
+    return ms > 0.0 ? bytes / 1.0e9 / (ms / 1000.0) : 0.0;
+}
+
+void AppendJsonString(std::string& json, const std::string& text) {
+    json += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') json += '\\';
+        json += (static_cast<unsigned char>(c) >= 32) ? c : '?';
+    }
+    json += '"';
+}
+
+std::string ToJson(const std::vector<Result>& results, const Options& options, bool gpu) {
+    char line[512];
+    std::string json = "{\n  \"schema\": 1,\n";
+    std::snprintf(line, sizeof(line),
+                  "  \"config\": {\"iterations\": %d, \"frames\": %d, \"width\": %u, \"height\": %u, \"gpu\": %s},\n",
+                  options.iterations, options.frames, options.width, options.height, gpu ? "true" : "false");
+    json += line;
+    json += "  \"images\": [";
+    uint64_t peakRss = 0;
+    uint64_t peakVram = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        peakRss = std::max(peakRss, r.peakRssBytes);
+        peakVram = std::max(peakVram, r.peakVramBytes);
+        json += i == 0 ? "\n    {\"file\": " : ",\n    {\"file\": ";
+        AppendJsonString(json, r.file);
+        if (!r.ok) {
+            json += ", \"ok\": false, \"error\": ";
+            AppendJsonString(json, r.error);
+            json += '}';
+            continue;
+        }
+        std::snprintf(line, sizeof(line),
+                      ", \"ok\": true, \"width\": %u, \"height\": %u, \"hdr\": %s, \"path\": \"%s\",\n"
+                      "     \"decode\": {\"ms\": %.3f, \"mpps\": %.2f, \"gbps\": %.3f},\n     \"stages\": {",
+                      r.width, r.height, r.isHdr ? "true" : "false", r.path,
+                      r.decodeMs, MegapixelsPerSecond(r.width, r.height, r.decodeMs), GigabytesPerSecond(r, r.decodeMs));
+        json += line;
+        bool firstStage = true;
+        for (size_t s = 0; s < Trace::kStageCount; ++s) {
+            if (r.stages[s].count == 0) continue;
+            std::snprintf(line, sizeof(line), "%s\"%s\": {\"count\": %u, \"busyMs\": %.3f}",
+                          firstStage ? "" : ", ", Trace::StageName(static_cast<Trace::Stage>(s)),
+                          r.stages[s].count, r.stages[s].busyMs);
+            json += line;
+            firstStage = false;
+        }
+        json += '}';
+        if (gpu) {
+            std::snprintf(line, sizeof(line),
+                          ",\n     \"upload\": {\"ok\": %s, \"ms\": %.3f, \"frames\": %u, \"gbps\": %.3f, \"downscale\": %u},\n"
+                          "     \"render\": {\"frames\": %u, \"p50Ms\": %.3f, \"p95Ms\": %.3f, \"fps\": %.1f}",
+                          r.uploaded ? "true" : "false", r.uploadMs, r.uploadFrames, GigabytesPerSecond(r, r.uploadMs),
+                          r.residentDownscale, r.frames, r.frameMs.p50, r.frameMs.p95,
+                          r.frameMs.p50 > 0.0 ? 1000.0 / r.frameMs.p50 : 0.0);
+            json += line;
+        }
+        std::snprintf(line, sizeof(line), ",\n     \"peakRssBytes\": %llu, \"peakVramBytes\": %llu}",
+                      static_cast<unsigned long long>(r.peakRssBytes), static_cast<unsigned long long>(r.peakVramBytes));
+        json += line;
+    }
+    std::snprintf(line, sizeof(line), "\n  ],\n  \"peakRssBytes\": %llu,\n  \"peakVramBytes\": %llu\n}\n",
+                  static_cast<unsigned long long>(peakRss), static_cast<unsigned long long>(peakVram));
+    json += line;
+    return json;
+}
+
+void PrintResult(const Result& r, bool gpu) {
+    if (!r.ok) {
+        std::printf("%-20s FAILED: %s\n", r.file.c_str(), r.error.c_str());
+        return;
+    }
+    std::printf("%-20s %5ux%-5u %-7s decode %8.1f ms %8.1f MP/s", r.file.c_str(), r.width, r.height, r.path,
+                r.decodeMs, MegapixelsPerSecond(r.width, r.height, r.decodeMs));
+    if (gpu) {
+        std::printf("  upload %8.1f ms %6.2f GB/s%s  frame p50 %6.2f p95 %6.2f ms", r.uploadMs,
+                    GigabytesPerSecond(r, r.uploadMs), r.uploaded ? "" : " (incomplete)", r.frameMs.p50, r.frameMs.p95);
+    }
+    std::printf("  rss %6.0f MB  vram %6.0f MB\n", static_cast<double>(r.peakRssBytes) / 1048576.0,
+                static_cast<double>(r.peakVramBytes) / 1048576.0);
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--corpus") == 0 && hasValue) {
+            options.corpus = argv[++i];
+            options.corpusGiven = true;
+        } else if (std::strcmp(arg, "--generate") == 0) {
+            options.generate = true;
+        } else if (std::strcmp(arg, "--iterations") == 0 && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            unsigned w = 0, h = 0;
+            if (std::sscanf(argv[++i], "%ux%u", &w, &h) != 2 || w == 0 || h == 0) return false;
+            options.width = w;
+            options.height = h;
+        } else if (std::strcmp(arg, "--no-gpu") == 0) {
+            options.gpu = false;
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: miv_bench [--corpus DIR] [--generate] [--iterations N] [--frames N]\n"
+                     "                 [--size WxH] [--no-gpu] [--json FILE]\n");
+        return 2;
+    }
+
+    Logger::Init(L"MinimalImageViewerBench");
+    Trace::NameThread("main");
+    Trace::SetEnabled(true);
+
+    if (!options.corpusGiven || options.generate) {
+        if (!PrepareCorpus(options)) return 1;
+    }
+    const std::vector<fs::path> files = ListCorpus(options.corpus);
+    if (files.empty()) {
+        std::fprintf(stderr, "miv_bench: no images in %s\n", options.corpus.string().c_str());
+        return 1;
+    }
+
+    bool gpu = false;
+    if (options.gpu) {
+        g_ctx.renderer = std::make_unique<VulkanRenderer>();
+        gpu = g_ctx.renderer->InitializeHeadless(options.width, options.height);
+        if (!gpu) {
+            std::fprintf(stderr, "miv_bench: no Vulkan device; measuring the CPU pipeline only\n");
+            g_ctx.renderer.reset();
+        }
+    }
+
+    std::vector<Result> results(files.size());
+    bool allOk = true;
+    for (size_t i = 0; i < files.size(); ++i) {
+        RunImage(files[i], options, g_ctx.renderer.get(), results[i]);
+        PrintResult(results[i], gpu);
+        std::fflush(stdout);
+        allOk = allOk && results[i].ok && (!gpu || results[i].uploaded);
+    }
+
+    const std::string json = ToJson(results, options, gpu);
+    int exitCode = allOk ? 0 : 1;
+    if (options.jsonPath == "-") {
+        std::fputs(json.c_str(), stdout);
+    } else if (FILE* file = std::fopen(options.jsonPath.c_str(), "wb")) {
+        const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+        if (std::fclose(file) != 0 || !written) exitCode = 1;
+    } else {
+        std::fprintf(stderr, "miv_bench: cannot write %s\n", options.jsonPath.c_str());
+        exitCode = 1;
+    }
+
+    if (g_ctx.renderer) {
+        g_ctx.renderer->Shutdown();
+        g_ctx.renderer.reset();
+    }
+    Logger::Shutdown();
+    return exitCode;
+}
@@ -0,0 +1,45 @@
+#version 450
+
+// Trilinear sample of the image texture; the sampler picks the mip level
+// from screen-space derivatives, so minified frames read small levels.
+layout(set = 0, binding = 0) uniform sampler2D imageTexture;
+
+// Display transform baked from OpenColorIO, indexed through a log2 shaper so
+// scene-linear values spread evenly over the lattice
+layout(set = 0, binding = 1) uniform sampler3D displayLut;
+
+// Follows the vertex stage's view transform (32 bytes)
+layout(push_constant) uniform ColorPush {
+    layout(offset = 32) float exposureScale;
+    float gammaExponent;
+    float shaperMin;
+    float shaperMax;
+    float lutScale;
+    float lutOffset;
+    uint mode;              // 0 = as sampled, 1 = through displayLut
+    uint linearizeOutput;   // The LUT encodes for the display; the sRGB target encodes again
+} pc;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 0) out vec4 outColor;
+
+vec3 srgbToLinear(vec3 c) {
+    return mix(c / 12.92, pow((c + 0.055) / 1.055, vec3(2.4)), greaterThan(c, vec3(0.04045)));
+}
+
+void main() {
+    vec4 texel = texture(imageTexture, inUV);
+    vec3 color = texel.rgb * pc.exposureScale;
+
+    if (pc.mode == 1u) {
+        vec3 shaped = (log2(max(color, vec3(exp2(pc.shaperMin)))) - pc.shaperMin) / (pc.shaperMax - pc.shaperMin);
+        color = texture(displayLut, clamp(shaped, 0.0, 1.0) * pc.lutScale + pc.lutOffset).rgb;
+    }
+
+    color = pow(max(color, vec3(0.0)), vec3(pc.gammaExponent));
+
+    if (pc.mode == 1u && pc.linearizeOutput != 0u) {
+        color = srgbToLinear(clamp(color, 0.0, 1.0));
+    }
+    outColor = vec4(color, texel.a);
+}
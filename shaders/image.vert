@@ -0,0 +1,23 @@
+#version 450
+
+// Textured quad for the displayed image. The four corners come from
+// gl_VertexIndex (triangle strip), so no vertex buffer is bound.
+layout(push_constant) uniform ImagePush {
+    vec2 viewportSize;  // Framebuffer size in pixels
+    vec2 center;        // Image centre in pixels
+    vec2 halfSize;      // Half the displayed, unrotated image size in pixels; negative x mirrors
+    vec2 rotation;      // cos, sin of the clockwise display rotation
+} pc;
+
+layout(location = 0) out vec2 outUV;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+    outUV = corner;
+
+    vec2 local = (corner * 2.0 - 1.0) * pc.halfSize;
+    vec2 rotated = vec2(local.x * pc.rotation.x - local.y * pc.rotation.y,
+                        local.x * pc.rotation.y + local.y * pc.rotation.x);
+    vec2 pixel = pc.center + rotated;
+    gl_Position = vec4(pixel / pc.viewportSize * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+// Glyph coverage lives in the atlas alpha; colour comes from the quad
+layout(set = 0, binding = 0) uniform sampler2D glyphAtlas;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float coverage = texture(glyphAtlas, inUV).a;
+    outColor = vec4(inColor.rgb, inColor.a * coverage);
+}
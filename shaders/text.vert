@@ -0,0 +1,23 @@
+#version 450
+
+// Overlay text: one instance per glyph (or backdrop) rectangle, read from a
+// per-frame vertex buffer. Corners come from gl_VertexIndex as in image.vert.
+layout(push_constant) uniform ImagePush {
+    vec2 viewportSize;  // Framebuffer size in pixels
+} pc;
+
+layout(location = 0) in vec4 inRect;    // x0, y0, x1, y1 in pixels
+layout(location = 1) in vec4 inUV;      // u0, v0, u1, v1 in the glyph atlas
+layout(location = 2) in vec4 inColor;
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+    outUV = mix(inUV.xy, inUV.zw, corner);
+    outColor = inColor;
+
+    vec2 pixel = mix(inRect.xy, inRect.zw, corner);
+    gl_Position = vec4(pixel / pc.viewportSize * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 450
+
+// Thumbnail grid: display-ready texels from the thumbnail atlas, tinted by the
+// quad colour. Solid fills sample the atlas's reserved white cell.
+layout(set = 0, binding = 0) uniform sampler2D thumbnailAtlas;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    outColor = texture(thumbnailAtlas, inUV) * inColor;
+}
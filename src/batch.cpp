@@ -0,0 +1,431 @@
+#include "batch.h"
+#include "viewer.h"
+#include "image_saver.h"
+#include "directory_indexer.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwctype>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Batch {
+
+namespace {
+    // Long side a thumbnail may reach before DecodeImagePreview's stand-in is too small
+    constexpr int kMaxThumbnailSize = 16384;
+    constexpr int kDefaultJpegQuality = 90;
+
+    struct Options {
+        std::vector<std::wstring> inputs;   // Files and folders as given
+        std::wstring outFolder;
+        std::wstring format = L"png";       // Output extension without the dot
+        int quality = kDefaultJpegQuality;
+        int thumbnail = 0;                  // Long side of the output; 0 keeps the full size
+        unsigned decoders = 0;              // 0 = derived from the hardware thread count
+        unsigned encoders = 0;
+        unsigned queueDepth = 0;
+        bool skipExisting = false;
+    };
+
+    // One decoded image on its way to an encoder
+    struct Item {
+        size_t index = 0;
+        ImageData image;
+        double decodeMs = 0.0;
+    };
+
+    // Fixed-capacity hand-off between the stages; Push blocks while it is full, which is
+    // what holds the decoders back when encoding is the slower side
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+        void Push(std::unique_ptr<Item> item) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notFull_.wait(lock, [this] { return items_.size() < capacity_; });
+            items_.push_back(std::move(item));
+            notEmpty_.notify_one();
+        }
+
+        // Null once the queue is closed and drained
+        std::unique_ptr<Item> Pop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmpty_.wait(lock, [this] { return !items_.empty() || closed_; });
+            if (items_.empty()) return nullptr;
+            std::unique_ptr<Item> item = std::move(items_.front());
+            items_.pop_front();
+            notFull_.notify_one();
+            return item;
+        }
+
+        // No more pushes; waiting encoders wake up and finish
+        void Close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            notEmpty_.notify_all();
+        }
+
+    private:
+        const size_t capacity_;
+        std::mutex mutex_;
+        std::condition_variable notFull_;
+        std::condition_variable notEmpty_;
+        std::deque<std::unique_ptr<Item>> items_;
+        bool closed_ = false;
+    };
+
+    std::string ToUtf8(const std::wstring& wstr) {
+        if (wstr.empty()) return std::string();
+        int size = WideCharToMultiByte(CP_UTF8, 0, wstr.data(), static_cast<int>(wstr.size()), nullptr, 0, nullptr, nullptr);
+        std::string out(static_cast<size_t>(std::max(size, 0)), '\0');
+        if (size > 0) {
+            WideCharToMultiByte(CP_UTF8, 0, wstr.data(), static_cast<int>(wstr.size()), out.data(), size, nullptr, nullptr);
+        }
+        return out;
+    }
+
+    std::wstring ToWide(const char* str) {
+        const int length = static_cast<int>(std::strlen(str));
+        if (length == 0) return std::wstring();
+        int size = MultiByteToWideChar(CP_UTF8, 0, str, length, nullptr, 0);
+        std::wstring out(static_cast<size_t>(std::max(size, 0)), L'\0');
+        if (size > 0) {
+            MultiByteToWideChar(CP_UTF8, 0, str, length, out.data(), size);
+        }
+        return out;
+    }
+
+    double MsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void PrintUsage() {
+        std::fprintf(stderr,
+            "Usage: minimalimageviewer --batch <file or folder>... --out <folder> [options]\n"
+            "  --format <ext>      Output format by extension: png, jpg, exr, tiff, ... (default png)\n"
+            "  --quality <1-100>   JPEG quality (default %d)\n"
+            "  --thumbnail <px>    Scale so the long side is at most <px>\n"
+            "  --decoders <n>      Files decoded at once (default: half the hardware threads)\n"
+            "  --encoders <n>      Files encoded at once (default: half the hardware threads)\n"
+            "  --queue <n>         Decoded images waiting for an encoder (default: 2 per encoder)\n"
+            "  --skip-existing     Leave outputs that already exist untouched\n",
+            kDefaultJpegQuality);
+    }
+
+    bool ParseCount(const char* text, int minimum, int maximum, int& out) {
+        char* end = nullptr;
+        const long value = std::strtol(text, &end, 10);
+        if (end == text || *end != '\0' || value < minimum || value > maximum) {
+            return false;
+        }
+        out = static_cast<int>(value);
+        return true;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        // argv[1] is --batch
+        for (int i = 2; i < argc; ++i) {
+            const char* arg = argv[i];
+            const bool hasValue = (i + 1 < argc);
+            int value = 0;
+            if (std::strcmp(arg, "--skip-existing") == 0) {
+                options.skipExisting = true;
+            } else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+                options.outFolder = ToWide(argv[++i]);
+            } else if (std::strcmp(arg, "--format") == 0 && hasValue) {
+                options.format = ToWide(argv[++i]);
+                if (!options.format.empty() && options.format.front() == L'.') {
+                    options.format.erase(0, 1);
+                }
+                std::transform(options.format.begin(), options.format.end(), options.format.begin(), ::towlower);
+            } else if (std::strcmp(arg, "--quality") == 0 && hasValue && ParseCount(argv[++i], 1, 100, value)) {
+                options.quality = value;
+            } else if (std::strcmp(arg, "--thumbnail") == 0 && hasValue && ParseCount(argv[++i], 1, kMaxThumbnailSize, value)) {
+                options.thumbnail = value;
+            } else if (std::strcmp(arg, "--decoders") == 0 && hasValue && ParseCount(argv[++i], 1, 256, value)) {
+                options.decoders = static_cast<unsigned>(value);
+            } else if (std::strcmp(arg, "--encoders") == 0 && hasValue && ParseCount(argv[++i], 1, 256, value)) {
+                options.encoders = static_cast<unsigned>(value);
+            } else if (std::strcmp(arg, "--queue") == 0 && hasValue && ParseCount(argv[++i], 1, 1024, value)) {
+                options.queueDepth = static_cast<unsigned>(value);
+            } else if (arg[0] == '-' && arg[1] == '-') {
+                std::fprintf(stderr, "Unknown or incomplete option: %s\n", arg);
+                return false;
+            } else {
+                options.inputs.push_back(ToWide(arg));
+            }
+        }
+
+        if (options.inputs.empty() || options.outFolder.empty() || options.format.empty()) {
+            return false;
+        }
+
+        const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        if (options.decoders == 0) options.decoders = std::max(1u, hardware / 2);
+        if (options.encoders == 0) options.encoders = std::max(1u, hardware / 2);
+        if (options.queueDepth == 0) options.queueDepth = 2 * options.encoders;
+        return true;
+    }
+
+    // Folders contribute the files the viewer would list in them, in name order
+    void CollectInputs(const Options& options, std::vector<std::wstring>& files) {
+        for (const std::wstring& input : options.inputs) {
+            const DWORD attributes = GetFileAttributesW(input.c_str());
+            if (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                std::vector<std::wstring> listed;
+                DirectoryIndexer::ScanFolder(input, listed);
+                std::sort(listed.begin(), listed.end());
+                files.insert(files.end(), listed.begin(), listed.end());
+            } else {
+                files.push_back(input);
+            }
+        }
+    }
+
+    std::wstring OutputPath(const Options& options, const std::wstring& input, const wchar_t* suffix) {
+        const size_t slash = input.find_last_of(L"\\/");
+        std::wstring stem = (slash == std::wstring::npos) ? input : input.substr(slash + 1);
+        const size_t dot = stem.find_last_of(L'.');
+        if (dot != std::wstring::npos && dot > 0) {
+            stem.resize(dot);
+        }
+
+        std::wstring path = options.outFolder;
+        if (path.back() != L'\\' && path.back() != L'/') {
+            path += L'\\';
+        }
+        return path + stem + suffix + L"." + options.format;
+    }
+
+    class Pipeline {
+    public:
+        Pipeline(const Options& options, std::vector<std::wstring> files)
+            : options_(options), files_(std::move(files)), queue_(options.queueDepth) {}
+
+        // Returns the number of files that failed
+        size_t Run() {
+            const auto start = std::chrono::steady_clock::now();
+
+            std::vector<std::thread> decoders;
+            std::vector<std::thread> encoders;
+            try {
+                for (unsigned i = 0; i < options_.encoders; ++i) {
+                    encoders.emplace_back(&Pipeline::encodeMain, this);
+                }
+                for (unsigned i = 0; i < options_.decoders; ++i) {
+                    decoders.emplace_back(&Pipeline::decodeMain, this);
+                }
+            } catch (const std::exception& e) {
+                // Whatever started still drains the whole list
+                Logger::Error("Batch: could not start all pipeline threads: %s", e.what());
+            }
+            if (decoders.empty()) {
+                decodeMain();
+            }
+            for (std::thread& t : decoders) t.join();
+            queue_.Close();
+            if (encoders.empty()) {
+                encodeMain();
+            }
+            for (std::thread& t : encoders) t.join();
+
+            const double seconds = MsSince(start) / 1000.0;
+            const size_t written = written_.load();
+            const double megapixels = static_cast<double>(pixels_.load()) / 1.0e6;
+            std::printf("%zu written, %zu skipped, %zu failed in %.2f s (%.1f files/s, %.1f MP/s)\n",
+                        written, skipped_.load(), failed_.load(), seconds,
+                        seconds > 0.0 ? static_cast<double>(written) / seconds : 0.0,
+                        seconds > 0.0 ? megapixels / seconds : 0.0);
+            Logger::Info("Batch: %zu written, %zu skipped, %zu failed in %.2f s", written, skipped_.load(), failed_.load(), seconds);
+            return failed_.load();
+        }
+
+    private:
+        void decodeMain() {
+            Trace::NameThread("batch decode");
+            for (;;) {
+                const size_t index = next_.fetch_add(1);
+                if (index >= files_.size()) break;
+                const std::wstring& input = files_[index];
+
+                if (options_.skipExisting && GetFileAttributesW(OutputPath(options_, input, L"").c_str()) != INVALID_FILE_ATTRIBUTES) {
+                    skipped_.fetch_add(1);
+                    report(input, "skipped", "output exists");
+                    continue;
+                }
+
+                auto item = std::make_unique<Item>();
+                item->index = index;
+                const auto start = std::chrono::steady_clock::now();
+                std::string error;
+                bool decoded = false;
+                // A stored MIP level or embedded thumbnail saves the full decode when it is big enough
+                if (options_.thumbnail > 0 && DecodeImagePreview(input, item->image) &&
+                    std::max(item->image.width, item->image.height) >= static_cast<uint32_t>(options_.thumbnail)) {
+                    item->image.isPreview = false;
+                    decoded = true;
+                }
+                if (!decoded) {
+                    decoded = DecodeImageFile(input, item->image, error);
+                }
+                if (decoded && !item->image.pixels) {
+                    decoded = false;
+                    error = "Decoder returned no pixels.";
+                }
+                if (decoded && options_.thumbnail > 0) {
+                    decoded = ResizeImageToFit(item->image, static_cast<uint32_t>(options_.thumbnail), error);
+                }
+                item->decodeMs = MsSince(start);
+
+                if (!decoded) {
+                    failed_.fetch_add(1);
+                    report(input, "failed", error.c_str());
+                    continue;
+                }
+                queue_.Push(std::move(item));
+            }
+        }
+
+        void encodeMain() {
+            Trace::NameThread("batch encode");
+            while (std::unique_ptr<Item> item = queue_.Pop()) {
+                const std::wstring& input = files_[item->index];
+                const ImageData& image = item->image;
+                const std::wstring outputPath = OutputPath(options_, input, L"");
+                // Written under another name and renamed, so a failure never leaves a truncated output
+                const std::wstring partialPath = OutputPath(options_, input, L".partial");
+
+                ImageSaver::Job job;
+                job.targetPath = partialPath;
+                job.sourcePath = input;
+                job.pixels = image.pixels->data();
+                job.owner = image.pixels;
+                job.width = image.width;
+                job.height = image.height;
+                job.isHdr = image.isHdr;
+                job.rotation = image.orientationRotation();
+                job.mirrored = image.orientationMirrored();
+                const bool sideways = (job.rotation % 180) != 0;
+                job.spec = OIIO::ImageSpec(static_cast<int>(sideways ? image.height : image.width),
+                                           static_cast<int>(sideways ? image.width : image.height), 4, OIIO::TypeDesc::UINT8);
+                ImageSaver::ChooseOutputFormat(job, outputPath);
+                // The pixels are written upright, so readers must not turn them again
+                job.spec.attribute("Orientation", 1);
+                if (options_.format == L"jpg" || options_.format == L"jpeg") {
+                    job.spec.attribute("Compression", "jpeg:" + std::to_string(options_.quality));
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                std::string error;
+                bool success = ImageSaver::Write(job, error);
+                if (success && !MoveFileExW(partialPath.c_str(), outputPath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+                    success = false;
+                    error = "Could not rename the finished file (error " + std::to_string(GetLastError()) + ").";
+                }
+                if (!success) {
+                    DeleteFileW(partialPath.c_str());
+                    failed_.fetch_add(1);
+                    report(input, "failed", error.c_str());
+                    continue;
+                }
+
+                written_.fetch_add(1);
+                pixels_.fetch_add(static_cast<uint64_t>(image.width) * image.height);
+                char detail[128];
+                std::snprintf(detail, sizeof(detail), "%ux%u, decode %.0f ms, encode %.0f ms",
+                              job.spec.width, job.spec.height, item->decodeMs, MsSince(start));
+                report(input, "ok", detail);
+            }
+        }
+
+        void report(const std::wstring& input, const char* status, const char* detail) {
+            const std::string path = ToUtf8(input);
+            std::lock_guard<std::mutex> lock(printMutex_);
+            std::printf("[%s] %s: %s\n", status, path.c_str(), detail);
+            if (std::strcmp(status, "failed") == 0) {
+                Logger::Warn("Batch: %s failed: %s", path.c_str(), detail);
+            }
+        }
+
+        const Options& options_;
+        const std::vector<std::wstring> files_;
+        BoundedQueue queue_;
+        std::mutex printMutex_;
+        std::atomic<size_t> next_{0};
+        std::atomic<size_t> written_{0};
+        std::atomic<size_t> skipped_{0};
+        std::atomic<size_t> failed_{0};
+        std::atomic<uint64_t> pixels_{0};
+    };
+}
+
+bool IsBatchCommandLine(int argc, char* argv[]) {
+    return argc > 1 && argv[1] != nullptr && std::strcmp(argv[1], "--batch") == 0;
+}
+
+int Run(int argc, char* argv[]) {
+#ifdef _WIN32
+    // The viewer is a GUI-subsystem program; borrow the console it was started from
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        FILE* stream = nullptr;
+        freopen_s(&stream, "CONOUT$", "w", stdout);
+        freopen_s(&stream, "CONOUT$", "w", stderr);
+    }
+#endif
+
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<std::wstring> files;
+    CollectInputs(options, files);
+    // Two inputs with the same name would race for one output file; the first one wins
+    std::vector<std::wstring> outputs;
+    std::vector<std::wstring> unique;
+    for (std::wstring& file : files) {
+        std::wstring output = OutputPath(options, file, L"");
+        std::transform(output.begin(), output.end(), output.begin(), ::towlower);
+        if (std::find(outputs.begin(), outputs.end(), output) != outputs.end()) {
+            std::fprintf(stderr, "Skipping %s: another input writes the same output\n", ToUtf8(file).c_str());
+            continue;
+        }
+        outputs.push_back(std::move(output));
+        unique.push_back(std::move(file));
+    }
+    files = std::move(unique);
+    if (files.empty()) {
+        std::fprintf(stderr, "No input images found.\n");
+        return 2;
+    }
+    if (!CreateDirectoryW(options.outFolder.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        std::fprintf(stderr, "Could not create the output folder %s\n", ToUtf8(options.outFolder).c_str());
+        return 2;
+    }
+
+    Logger::Info("Batch: %zu files, %u decoders, %u encoders, queue %u", files.size(),
+                 options.decoders, options.encoders, options.queueDepth);
+    Pipeline pipeline(options, std::move(files));
+    const size_t failures = pipeline.Run();
+    std::fflush(stdout);
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace Batch
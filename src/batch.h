@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * Batch - Headless convert and thumbnail mode
+ * "minimalimageviewer --batch <files or folders> --out <folder> ..." runs
+ * the viewer's own decode (DecodeImageFile with CPU color conversion, so
+ * OCIO applies exactly as on screen) and encode (ImageSaver::Write) over
+ * many files without creating a window or touching the GPU.
+ *
+ * Files flow through a bounded pipeline: decode threads read and convert
+ * one file each, a small queue holds finished images, and encode threads
+ * write them out. A full queue blocks the decoders, so memory stays at a
+ * few images regardless of how many files are given or which side is
+ * slower. Both stages still split each image into bands on the shared
+ * WorkerPool, so a single huge file keeps every core busy too.
+ */
+namespace Batch {
+
+// True when the command line asks for batch mode (first argument is --batch)
+bool IsBatchCommandLine(int argc, char* argv[]);
+
+// Run the batch described by the command line and return the process exit code:
+// 0 when every file was written, 1 when any failed, 2 for a usage error
+int Run(int argc, char* argv[]);
+
+} // namespace Batch
@@ -0,0 +1,239 @@
+#include "color_lut.h"
+#include "pixel_convert.h"
+#include "logging.h"
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace ColorLut {
+
+namespace {
+    // 65^3 RGBA16F is 2.2 MB: fine enough that trilinear filtering hides the lattice
+    constexpr uint32_t kEdgeLength = 65;
+    // Shaper range in stops: half's smallest normal up to 64x diffuse white for HDR;
+    // LDR texels never exceed 1
+    constexpr float kLog2Min = -14.0f;
+    constexpr float kLog2MaxHdr = 6.0f;
+    constexpr float kLog2MaxLdr = 0.0f;
+    // Bakes kept for reuse; neighbours in a folder usually share a transform
+    constexpr size_t kCachedBakes = 8;
+    // Lattice values from the GPU path must match the CPU processor this closely
+    constexpr float kVerifyTolerance = 1e-3f;
+
+    std::mutex g_cacheMutex;
+    std::deque<std::pair<std::string, std::shared_ptr<const Lut3D>>> g_cache;   // Newest at the back
+    std::atomic<uint64_t> g_nextId{ 1 };
+
+    // Shaper inverse (lattice coordinate -> linear), the sampler's sRGB decode undone
+    // for LDR textures, then the display transform itself
+    OCIO::ConstProcessorRcPtr CreateBakeProcessor(const OCIO::ConstProcessorRcPtr& processor, bool isHdr,
+                                                  float log2Min, float log2Max) {
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+        OCIO::AllocationTransformRcPtr shaper = OCIO::AllocationTransform::Create();
+        shaper->setAllocation(OCIO::ALLOCATION_LG2);
+        const float vars[2] = { log2Min, log2Max };
+        shaper->setVars(2, vars);
+        shaper->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+        group->appendTransform(shaper);
+
+        if (!isHdr) {
+            OCIO::ExponentWithLinearTransformRcPtr srgb = OCIO::ExponentWithLinearTransform::Create();
+            const double gamma[4] = { 2.4, 2.4, 2.4, 1.0 };
+            const double offset[4] = { 0.055, 0.055, 0.055, 0.0 };
+            srgb->setGamma(gamma);
+            srgb->setOffset(offset);
+            srgb->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+            group->appendTransform(srgb);
+        }
+
+        group->appendTransform(processor->createGroupTransform());
+        return OCIO::GetCurrentConfig()->getProcessor(group);
+    }
+
+    // Lattice point (r, g, b) through the CPU processor
+    void ReferencePoint(const OCIO::ConstCPUProcessorRcPtr& cpu, uint32_t n, uint32_t r, uint32_t g, uint32_t b,
+                        float out[3]) {
+        const float inv = 1.0f / static_cast<float>(n - 1);
+        out[0] = r * inv;
+        out[1] = g * inv;
+        out[2] = b * inv;
+        cpu->applyRGB(out);
+    }
+
+    bool Matches(const float* value, const float reference[3]) {
+        for (int c = 0; c < 3; ++c) {
+            if (!(std::abs(value[c] - reference[c]) <= kVerifyTolerance * std::max(1.0f, std::abs(reference[c])))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // OCIO's legacy GPU path: the whole transform baked into one 3D texture of RGB
+    // floats. Returned red-fastest; false when it needs more than that texture or
+    // does not reproduce the CPU processor.
+    bool ExtractGpuLattice(const OCIO::ConstProcessorRcPtr& bakeProcessor, const OCIO::ConstCPUProcessorRcPtr& cpu,
+                           uint32_t n, std::vector<float>& rgb) {
+        OCIO::ConstGPUProcessorRcPtr gpu = bakeProcessor->getOptimizedLegacyGPUProcessor(OCIO::OPTIMIZATION_DEFAULT, n);
+        OCIO::GpuShaderDescRcPtr desc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        desc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+        gpu->extractGpuShaderInfo(desc);
+        if (desc->getNum3DTextures() != 1 || desc->getNumTextures() != 0 || desc->getNumUniforms() != 0) {
+            return false;
+        }
+
+        const char* textureName = nullptr;
+        const char* samplerName = nullptr;
+        unsigned edgeLength = 0;
+        OCIO::Interpolation interpolation = OCIO::INTERP_LINEAR;
+        desc->get3DTexture(0, textureName, samplerName, edgeLength, interpolation);
+        const float* values = nullptr;
+        desc->get3DTextureValues(0, values);
+        if (edgeLength != n || values == nullptr) {
+            return false;
+        }
+
+        // Asymmetric points tell red-fastest from blue-fastest and catch partial bakes
+        const uint32_t points[][3] = {
+            { 1, 0, 0 }, { 0, 0, 1 }, { n - 1, n / 2, 3 }, { 5, n - 1, n / 3 }, { n / 2, 7, n - 1 }, { n - 2, n - 2, 1 },
+        };
+        bool redFastest = true;
+        bool blueFastest = true;
+        for (const auto& p : points) {
+            float reference[3];
+            ReferencePoint(cpu, n, p[0], p[1], p[2], reference);
+            const size_t redIndex = (static_cast<size_t>(p[2]) * n + p[1]) * n + p[0];
+            const size_t blueIndex = (static_cast<size_t>(p[0]) * n + p[1]) * n + p[2];
+            redFastest = redFastest && Matches(values + redIndex * 3, reference);
+            blueFastest = blueFastest && Matches(values + blueIndex * 3, reference);
+        }
+        if (!redFastest && !blueFastest) {
+            return false;
+        }
+
+        const size_t count = static_cast<size_t>(n) * n * n;
+        rgb.resize(count * 3);
+        if (redFastest) {
+            std::copy(values, values + count * 3, rgb.begin());
+            return true;
+        }
+        for (uint32_t b = 0; b < n; ++b) {
+            for (uint32_t g = 0; g < n; ++g) {
+                for (uint32_t r = 0; r < n; ++r) {
+                    const size_t src = ((static_cast<size_t>(r) * n + g) * n + b) * 3;
+                    const size_t dst = ((static_cast<size_t>(b) * n + g) * n + r) * 3;
+                    rgb[dst] = values[src];
+                    rgb[dst + 1] = values[src + 1];
+                    rgb[dst + 2] = values[src + 2];
+                }
+            }
+        }
+        return true;
+    }
+
+    // Fallback: every lattice point through the CPU processor, red fastest
+    void SampleLattice(const OCIO::ConstCPUProcessorRcPtr& cpu, uint32_t n, std::vector<float>& rgb) {
+        const float inv = 1.0f / static_cast<float>(n - 1);
+        rgb.resize(static_cast<size_t>(n) * n * n * 3);
+        float* p = rgb.data();
+        for (uint32_t b = 0; b < n; ++b) {
+            for (uint32_t g = 0; g < n; ++g) {
+                for (uint32_t r = 0; r < n; ++r, p += 3) {
+                    p[0] = r * inv;
+                    p[1] = g * inv;
+                    p[2] = b * inv;
+                }
+            }
+        }
+        OCIO::PackedImageDesc image(rgb.data(), static_cast<long>(n), static_cast<long>(n) * n, 3);
+        cpu->apply(image);
+    }
+}
+
+std::shared_ptr<const Lut3D> Bake(const OCIO::ConstProcessorRcPtr& processor, bool isHdr) {
+    // NASA Standard: Validate all input parameters
+    if (!processor) {
+        return nullptr;
+    }
+
+    std::string key;
+    try {
+        if (processor->isNoOp()) {
+            return nullptr;
+        }
+        key = std::string(processor->getCacheID()) + (isHdr ? "|hdr" : "|ldr");
+    } catch (...) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        for (const auto& entry : g_cache) {
+            if (entry.first == key) return entry.second;
+        }
+    }
+
+    const uint64_t startTicks = SDL_GetTicks();
+    const uint32_t n = kEdgeLength;
+    const float log2Max = isHdr ? kLog2MaxHdr : kLog2MaxLdr;
+    std::vector<float> rgb;
+    const char* method = "gpu";
+    try {
+        OCIO::ConstProcessorRcPtr bakeProcessor = CreateBakeProcessor(processor, isHdr, kLog2Min, log2Max);
+        OCIO::ConstCPUProcessorRcPtr cpu = bakeProcessor->getDefaultCPUProcessor();
+        bool extracted = false;
+        try {
+            extracted = ExtractGpuLattice(bakeProcessor, cpu, n, rgb);
+        } catch (...) {
+            extracted = false;
+        }
+        if (!extracted) {
+            method = "cpu";
+            SampleLattice(cpu, n, rgb);
+        }
+    } catch (const OCIO::Exception& e) {
+        Logger::Warn("ColorLut: cannot bake the display transform: %s", e.what());
+        return nullptr;
+    } catch (...) {
+        Logger::Warn("ColorLut: cannot bake the display transform");
+        return nullptr;
+    }
+
+    auto lut = std::make_shared<Lut3D>();
+    lut->id = g_nextId.fetch_add(1, std::memory_order_relaxed);
+    lut->edgeLength = n;
+    lut->log2Min = kLog2Min;
+    lut->log2Max = log2Max;
+    const size_t count = static_cast<size_t>(n) * n * n;
+    std::vector<float> rgbaFloat(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+        rgbaFloat[i * 4] = rgb[i * 3];
+        rgbaFloat[i * 4 + 1] = rgb[i * 3 + 1];
+        rgbaFloat[i * 4 + 2] = rgb[i * 3 + 2];
+        rgbaFloat[i * 4 + 3] = 1.0f;
+    }
+    lut->rgba.resize(count * 4);
+    PixelConvert::FloatToHalf(rgbaFloat.data(), lut->rgba.data(), rgbaFloat.size());
+
+    Logger::Info("ColorLut: baked %u^3 %s LUT (%s) in %llu ms", n, isHdr ? "HDR" : "LDR", method,
+                 static_cast<unsigned long long>(SDL_GetTicks() - startTicks));
+
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    for (const auto& entry : g_cache) {
+        if (entry.first == key) return entry.second;    // Baked concurrently by another worker
+    }
+    g_cache.emplace_back(std::move(key), lut);
+    if (g_cache.size() > kCachedBakes) {
+        g_cache.pop_front();
+    }
+    return lut;
+}
+
+} // namespace ColorLut
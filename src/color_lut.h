@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ocio_shim.h"
+
+/**
+ * ColorLut - OpenColorIO display transforms baked for the fragment shader
+ * The transform from the file's color space to the display is sampled on a
+ * 3D lattice behind a log2 shaper, so scene-linear HDR values spread evenly
+ * over the lattice instead of crowding its first cells. The renderer applies
+ * it per pixel (VulkanRenderer::SetColorLut), which keeps decoding free of
+ * per-pixel color work and makes exposure and gamma changes immediate.
+ *
+ * OCIO's legacy GPU path bakes the lattice; it is checked against the CPU
+ * processor and sampled on the CPU instead when the two disagree.
+ */
+namespace ColorLut {
+
+struct Lut3D {
+    uint64_t id = 0;                // Distinct per baked transform, for the renderer's re-upload check
+    uint32_t edgeLength = 0;
+    float log2Min = 0.0f;           // Shaper range mapped onto the lattice's [0,1]
+    float log2Max = 0.0f;
+    std::vector<uint16_t> rgba;     // Half-float RGBA, red varying fastest
+};
+
+// Bake 'processor' for texels as the sampler returns them: HDR textures hold the
+// file's values, LDR (sRGB-format) textures are decoded by the sampler and the
+// bake re-encodes them first. Null when there is nothing to bake or OCIO fails.
+// Thread-safe; the most recent bakes are shared between images.
+std::shared_ptr<const Lut3D> Bake(const OCIO::ConstProcessorRcPtr& processor, bool isHdr);
+
+} // namespace ColorLut
@@ -0,0 +1,465 @@
+#include "directory_indexer.h"
+#include "logging.h"
+
+#include <OpenImageIO/imageio.h>
+#include <shlwapi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <utility>
+
+// Streamed listings go out in batches: big enough to keep event traffic low on
+// 10k-entry folders, frequent enough that the first images show up at once
+constexpr size_t kBatchSize = 512;
+constexpr uint64_t kBatchIntervalMS = 50;
+
+// ReadDirectoryChangesW is limited to 64 KB on network shares
+constexpr DWORD kNotifyBufferBytes = 64 * 1024;
+
+struct DirectoryIndexer::Watch {
+    std::wstring folder;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    HANDLE event = nullptr;
+    OVERLAPPED overlapped{};
+    std::vector<DWORD> buffer = std::vector<DWORD>(kNotifyBufferBytes / sizeof(DWORD));
+    bool pending = false;
+
+    bool IsOpen() const { return directory != INVALID_HANDLE_VALUE; }
+
+    bool Open(const std::wstring& path) {
+        Close();
+        directory = CreateFileW(path.c_str(), FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (directory == INVALID_HANDLE_VALUE) return false;
+
+        event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!event) {
+            Close();
+            return false;
+        }
+        folder = path;
+        return Arm();
+    }
+
+    bool Arm() {
+        ResetEvent(event);
+        overlapped = OVERLAPPED{};
+        overlapped.hEvent = event;
+        const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+        pending = ReadDirectoryChangesW(directory, buffer.data(), kNotifyBufferBytes, FALSE, filter,
+                                        nullptr, &overlapped, nullptr) != FALSE;
+        return pending;
+    }
+
+    void Close() {
+        if (directory != INVALID_HANDLE_VALUE) {
+            if (pending) {
+                // The kernel writes into buffer until the cancel completes
+                CancelIoEx(directory, &overlapped);
+                DWORD bytes = 0;
+                GetOverlappedResult(directory, &overlapped, &bytes, TRUE);
+            }
+            CloseHandle(directory);
+            directory = INVALID_HANDLE_VALUE;
+        }
+        if (event) {
+            CloseHandle(event);
+            event = nullptr;
+        }
+        pending = false;
+        folder.clear();
+    }
+};
+
+static std::wstring JoinPath(const std::wstring& folder, const wchar_t* name, size_t length) {
+    std::wstring path = folder;
+    if (!path.empty() && path.back() != L'\\' && path.back() != L'/') {
+        path += L'\\';
+    }
+    path.append(name, length);
+    return path;
+}
+
+// Lower-case extensions without the dot, from every format plugin OIIO knows
+static const std::vector<std::wstring>& KnownExtensions() {
+    static const std::vector<std::wstring> extensions = [] {
+        std::vector<std::wstring> list;
+
+        // "tiff:tif,tiff;jpeg:jpg,jpe,jpeg;..."
+        std::string formats;
+        OIIO::getattribute("extension_list", formats);
+        std::wstring current;
+        bool inExtensions = false;
+        for (char c : formats) {
+            if (c == ':') {
+                inExtensions = true;
+            } else if (c == ',' || c == ';') {
+                if (!current.empty()) list.push_back(current);
+                current.clear();
+                inExtensions = (c == ',');
+            } else if (inExtensions) {
+                current += static_cast<wchar_t>(std::towlower(static_cast<unsigned char>(c)));
+            }
+        }
+        if (!current.empty()) list.push_back(current);
+
+        if (list.empty()) {
+            list = { L"bmp", L"dpx", L"exr", L"gif", L"hdr", L"jpeg", L"jpg", L"png",
+                     L"psd", L"tga", L"tif", L"tiff", L"webp" };
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        return list;
+    }();
+    return extensions;
+}
+
+// First bytes of the formats people commonly save without an extension
+static bool HasImageSignature(const std::wstring& path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    unsigned char b[12] = {};
+    DWORD read = 0;
+    const BOOL ok = ReadFile(file, b, sizeof(b), &read, nullptr);
+    CloseHandle(file);
+    if (!ok || read < 4) return false;
+
+    auto starts = [&](const char* magic, size_t length) {
+        return read >= length && memcmp(b, magic, length) == 0;
+    };
+    return starts("\x89PNG", 4) ||
+           starts("\xFF\xD8\xFF", 3) ||
+           starts("II*\0", 4) || starts("MM\0*", 4) ||
+           starts("\x76\x2F\x31\x01", 4) ||                 // OpenEXR
+           starts("SDPX", 4) || starts("XPDS", 4) ||
+           starts("\x80\x2A\x5F\xD7", 4) ||                 // Cineon
+           starts("GIF8", 4) ||
+           starts("8BPS", 4) ||
+           starts("#?", 2) ||                               // Radiance HDR
+           (starts("RIFF", 4) && read >= 12 && memcmp(b + 8, "WEBP", 4) == 0) ||
+           (read >= 12 && memcmp(b + 4, "ftyp", 4) == 0);   // HEIF/AVIF
+}
+
+bool DirectoryIndexer::IsCandidate(const std::wstring& path) {
+    const wchar_t* dot = PathFindExtensionW(path.c_str());
+    if (*dot == L'.') {
+        std::wstring ext(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+        const auto& known = KnownExtensions();
+        if (std::binary_search(known.begin(), known.end(), ext)) return true;
+
+        // NASA Standard: Only sniff names that carry no real extension (none, or a frame
+        // number) so sidecar files in large folders never cost an open
+        if (!std::all_of(ext.begin(), ext.end(), [](wchar_t c) { return c >= L'0' && c <= L'9'; })) {
+            return false;
+        }
+    }
+    return HasImageSignature(path);
+}
+
+void DirectoryIndexer::ScanFolder(const std::wstring& folder, std::vector<std::wstring>& out) {
+    WIN32_FIND_DATAW fd{};
+    const std::wstring search = JoinPath(folder, L"*", 1);
+    HANDLE find = FindFirstFileExW(search.c_str(), FindExInfoBasic, &fd, FindExSearchNameMatch,
+                                   nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) return;
+
+    do {
+        if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+        std::wstring path = JoinPath(folder, fd.cFileName, wcslen(fd.cFileName));
+        if (IsCandidate(path)) {
+            out.push_back(std::move(path));
+        }
+    } while (FindNextFileW(find, &fd));
+    FindClose(find);
+}
+
+DirectoryIndexer::DirectoryIndexer() = default;
+
+DirectoryIndexer::~DirectoryIndexer() {
+    Shutdown();
+}
+
+bool DirectoryIndexer::Start() {
+    if (running_) return true;
+
+    changeEvent_ = SDL_RegisterEvents(1);
+    if (changeEvent_ == 0) {
+        Logger::Error("DirectoryIndexer: SDL_RegisterEvents failed: %s", SDL_GetError());
+        return false;
+    }
+
+    wakeEvent_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (!wakeEvent_) {
+        Logger::Error("DirectoryIndexer: CreateEvent failed: %lu", GetLastError());
+        return false;
+    }
+
+    try {
+        stopping_ = false;
+        worker_ = std::thread(&DirectoryIndexer::workerMain, this);
+    } catch (const std::exception& e) {
+        Logger::Error("DirectoryIndexer: failed to start worker thread: %s", e.what());
+        CloseHandle(wakeEvent_);
+        wakeEvent_ = nullptr;
+        return false;
+    }
+
+    running_ = true;
+    Logger::Info("DirectoryIndexer: worker started");
+    return true;
+}
+
+void DirectoryIndexer::Shutdown() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        changes_.clear();
+    }
+    // Abort an enumeration in flight at its next entry
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    SetEvent(wakeEvent_);
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    CloseHandle(wakeEvent_);
+    wakeEvent_ = nullptr;
+
+    running_ = false;
+    Logger::Info("DirectoryIndexer: worker stopped");
+}
+
+void DirectoryIndexer::Index(const std::wstring& folder) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pendingFolder_ = folder;
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        changes_.clear();
+    }
+    folder_ = folder;
+    SetEvent(wakeEvent_);
+}
+
+bool DirectoryIndexer::TakeChanges(std::vector<Change>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eventPosted_ = false;
+    if (changes_.empty()) return false;
+
+    out = std::move(changes_);
+    changes_.clear();
+    return true;
+}
+
+void DirectoryIndexer::workerMain() {
+    Watch watch;
+    std::deque<std::wstring> toValidate;
+    std::wstring folder;
+    uint64_t generation = 0;
+    bool rescan = false;
+
+    for (;;) {
+        bool switched = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) break;
+
+            const uint64_t latest = generation_.load(std::memory_order_acquire);
+            if (latest != generation) {
+                generation = latest;
+                folder = pendingFolder_;
+                switched = true;
+            }
+        }
+
+        if (switched) {
+            toValidate.clear();
+            watch.Close();
+            rescan = !folder.empty();
+        }
+
+        if (rescan) {
+            rescan = false;
+            // Arm the watch first so nothing created during the listing is missed
+            if (!watch.IsOpen() && !watch.Open(folder)) {
+                Logger::WarnW(L"DirectoryIndexer: cannot watch %ls (error %lu)", folder.c_str(), GetLastError());
+            }
+            if (!enumerate(folder, generation, toValidate)) continue;
+        }
+
+        HANDLE handles[2] = { wakeEvent_, watch.event };
+        const DWORD handleCount = watch.pending ? 2 : 1;
+        const DWORD timeout = toValidate.empty() ? INFINITE : 0;
+        const DWORD wait = WaitForMultipleObjects(handleCount, handles, FALSE, timeout);
+
+        if (wait == WAIT_OBJECT_0 + 1) {
+            if (!drainNotifications(watch, generation, toValidate)) {
+                // The change buffer overflowed: start the listing over
+                publish(generation, { Change{ Change::Kind::Reset, std::wstring() } });
+                toValidate.clear();
+                rescan = true;
+            }
+        } else if (wait == WAIT_TIMEOUT) {
+            // Idle: nothing new from the folder, so spend the time validating
+            validateNext(generation, toValidate);
+        } else if (wait == WAIT_FAILED) {
+            Logger::Error("DirectoryIndexer: wait failed: %lu", GetLastError());
+            break;
+        }
+    }
+
+    watch.Close();
+}
+
+bool DirectoryIndexer::enumerate(const std::wstring& folder, uint64_t generation, std::deque<std::wstring>& toValidate) {
+    const uint64_t start = SDL_GetTicks();
+    uint64_t lastFlush = start;
+    size_t found = 0;
+    std::vector<Change> batch;
+
+    WIN32_FIND_DATAW fd{};
+    const std::wstring search = JoinPath(folder, L"*", 1);
+    HANDLE find = FindFirstFileExW(search.c_str(), FindExInfoBasic, &fd, FindExSearchNameMatch,
+                                   nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE) {
+        Logger::WarnW(L"DirectoryIndexer: cannot list %ls (error %lu)", folder.c_str(), GetLastError());
+        return true;
+    }
+
+    do {
+        if (isStale(generation)) {
+            FindClose(find);
+            return false;
+        }
+        if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+
+        std::wstring path = JoinPath(folder, fd.cFileName, wcslen(fd.cFileName));
+        if (!IsCandidate(path)) continue;
+
+        toValidate.push_back(path);
+        batch.push_back(Change{ Change::Kind::Added, std::move(path) });
+        ++found;
+
+        const uint64_t now = SDL_GetTicks();
+        if (batch.size() >= kBatchSize || now - lastFlush >= kBatchIntervalMS) {
+            publish(generation, std::move(batch));
+            batch.clear();
+            lastFlush = now;
+        }
+    } while (FindNextFileW(find, &fd));
+    FindClose(find);
+
+    publish(generation, std::move(batch));
+    Logger::InfoW(L"DirectoryIndexer: %zu candidates in %ls (%llu ms)", found, folder.c_str(),
+                  static_cast<unsigned long long>(SDL_GetTicks() - start));
+    return true;
+}
+
+void DirectoryIndexer::validateNext(uint64_t generation, std::deque<std::wstring>& toValidate) {
+    const std::wstring path = std::move(toValidate.front());
+    toValidate.pop_front();
+
+    const std::string utf8Path = [&] {
+        const int size = WideCharToMultiByte(CP_UTF8, 0, path.c_str(), static_cast<int>(path.size()), nullptr, 0, nullptr, nullptr);
+        std::string out(static_cast<size_t>(std::max(size, 0)), '\0');
+        WideCharToMultiByte(CP_UTF8, 0, path.c_str(), static_cast<int>(path.size()), out.data(), size, nullptr, nullptr);
+        return out;
+    }();
+
+    // Same check the listing used to run up front: can any plugin open it?
+    auto in = OIIO::ImageInput::open(utf8Path);
+    if (in) {
+        in->close();
+    }
+    OIIO::geterror();
+
+    if (!in) {
+        publish(generation, { Change{ Change::Kind::Removed, path } });
+    }
+}
+
+bool DirectoryIndexer::drainNotifications(Watch& watch, uint64_t generation, std::deque<std::wstring>& toValidate) {
+    DWORD bytes = 0;
+    watch.pending = false;
+    if (!GetOverlappedResult(watch.directory, &watch.overlapped, &bytes, FALSE)) {
+        const DWORD error = GetLastError();
+        if (error == ERROR_NOTIFY_ENUM_DIR) {
+            watch.Arm();
+            return false;
+        }
+        // Folder deleted or share dropped: keep the listing, stop watching
+        Logger::WarnW(L"DirectoryIndexer: watch on %ls ended (error %lu)", watch.folder.c_str(), error);
+        watch.Close();
+        return true;
+    }
+    if (bytes == 0) {
+        watch.Arm();
+        return false;
+    }
+
+    std::vector<Change> changes;
+    const uint8_t* cursor = reinterpret_cast<const uint8_t*>(watch.buffer.data());
+    for (;;) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+        std::wstring path = JoinPath(watch.folder, info->FileName, info->FileNameLength / sizeof(wchar_t));
+
+        switch (info->Action) {
+            case FILE_ACTION_ADDED:
+            case FILE_ACTION_RENAMED_NEW_NAME:
+                if (IsCandidate(path)) {
+                    toValidate.push_back(path);
+                    changes.push_back(Change{ Change::Kind::Added, std::move(path) });
+                }
+                break;
+
+            case FILE_ACTION_REMOVED:
+            case FILE_ACTION_RENAMED_OLD_NAME:
+                changes.push_back(Change{ Change::Kind::Removed, std::move(path) });
+                break;
+
+            case FILE_ACTION_MODIFIED:
+                if (IsCandidate(path)) {
+                    changes.push_back(Change{ Change::Kind::Modified, std::move(path) });
+                }
+                break;
+        }
+
+        if (info->NextEntryOffset == 0) break;
+        cursor += info->NextEntryOffset;
+    }
+
+    // Re-arm before publishing so the gap without a pending read stays short
+    if (!watch.Arm()) {
+        Logger::WarnW(L"DirectoryIndexer: failed to re-arm watch on %ls (error %lu)", watch.folder.c_str(), GetLastError());
+    }
+    publish(generation, std::move(changes));
+    return true;
+}
+
+void DirectoryIndexer::publish(uint64_t generation, std::vector<Change>&& changes) {
+    if (changes.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Dropped: a newer folder or shutdown arrived meanwhile
+        if (stopping_ || isStale(generation)) return;
+
+        changes_.insert(changes_.end(), std::make_move_iterator(changes.begin()), std::make_move_iterator(changes.end()));
+        // One queued event covers everything until the main thread takes it
+        if (eventPosted_) return;
+        eventPosted_ = true;
+    }
+
+    SDL_Event event{};
+    event.type = changeEvent_;
+    if (!SDL_PushEvent(&event)) {
+        Logger::Warn("DirectoryIndexer: SDL_PushEvent failed: %s", SDL_GetError());
+        std::lock_guard<std::mutex> lock(mutex_);
+        eventPosted_ = false;
+    }
+}
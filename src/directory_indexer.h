@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * DirectoryIndexer - Background listing of the folder being browsed
+ * Enumerates the folder off the SDL event loop, accepting entries by file
+ * extension (or by a few signature bytes when the extension is unknown)
+ * and streaming them to the main thread in batches through a registered
+ * SDL event. Once the listing is out, candidates are validated with OIIO
+ * one at a time and any that fail are withdrawn again.
+ *
+ * The folder is watched with ReadDirectoryChangesW for as long as it is
+ * indexed, so files copied in, renamed or deleted elsewhere show up as
+ * changes rather than forcing a rescan. Indexing a new folder supersedes
+ * the old one and discards any changes not yet taken.
+ */
+class DirectoryIndexer {
+public:
+    struct Change {
+        enum class Kind {
+            Reset,      // Forget the listing; a full rescan follows
+            Added,
+            Removed,
+            Modified
+        };
+        Kind kind = Kind::Added;
+        std::wstring path;
+    };
+
+    DirectoryIndexer();
+    ~DirectoryIndexer();
+
+    DirectoryIndexer(const DirectoryIndexer&) = delete;
+    DirectoryIndexer& operator=(const DirectoryIndexer&) = delete;
+
+    // Start the worker thread and register the change event. Call after SDL_Init().
+    bool Start();
+    void Shutdown();
+    bool IsRunning() const { return running_; }
+
+    // Enumerate and watch 'folder', superseding the previous folder
+    void Index(const std::wstring& folder);
+
+    // Main thread: folder passed to the latest Index() call
+    const std::wstring& GetFolder() const { return folder_; }
+
+    // Main thread: take the changes published since the last call. Returns false if none.
+    bool TakeChanges(std::vector<Change>& out);
+
+    // SDL event type pushed when changes are waiting (0 if registration failed)
+    Uint32 GetChangeEventType() const { return changeEvent_; }
+
+    // Cheap filter used for every entry: known extension, else signature bytes
+    static bool IsCandidate(const std::wstring& path);
+
+    // Synchronous listing with the same filter, for when the worker is unavailable
+    static void ScanFolder(const std::wstring& folder, std::vector<std::wstring>& out);
+
+private:
+    struct Watch;
+
+    void workerMain();
+    bool enumerate(const std::wstring& folder, uint64_t generation, std::deque<std::wstring>& toValidate);
+    void validateNext(uint64_t generation, std::deque<std::wstring>& toValidate);
+    bool drainNotifications(Watch& watch, uint64_t generation, std::deque<std::wstring>& toValidate);
+    void publish(uint64_t generation, std::vector<Change>&& changes);
+    bool isStale(uint64_t generation) const {
+        return generation != generation_.load(std::memory_order_acquire);
+    }
+
+    std::thread worker_;
+    std::mutex mutex_;
+    HANDLE wakeEvent_ = nullptr;               // Signaled by Index() and Shutdown()
+
+    // Protected by mutex_
+    bool stopping_ = false;
+    std::wstring pendingFolder_;
+    std::vector<Change> changes_;
+    bool eventPosted_ = false;                 // A change event is queued and not yet taken
+
+    std::atomic<uint64_t> generation_{0};
+    std::wstring folder_;                      // Main thread copy of the indexed folder
+    Uint32 changeEvent_ = 0;
+    bool running_ = false;
+};
@@ -0,0 +1,120 @@
+#include "image_cache.h"
+#include "mapped_image.h"
+#include "logging.h"
+
+#include <cwctype>
+
+ImageCache::ImageCache(uint64_t budgetBytes)
+    : budgetBytes_(budgetBytes ? budgetBytes : DefaultBudget()) {
+}
+
+uint64_t ImageCache::DefaultBudget() {
+    constexpr uint64_t kMinBudget = UINT64_C(256) * 1024 * 1024;
+    constexpr uint64_t kMaxBudget = UINT64_C(8) * 1024 * 1024 * 1024;
+
+    uint64_t budget = kMinBudget;
+#ifdef _WIN32
+    MEMORYSTATUSEX memStatus = {};
+    memStatus.dwLength = sizeof(memStatus);
+    if (GlobalMemoryStatusEx(&memStatus)) {
+        budget = memStatus.ullTotalPhys / 4;
+    }
+#endif
+    return std::clamp(budget, kMinBudget, kMaxBudget);
+}
+
+uint64_t ImageCache::SizeOf(const ImageData& image) {
+    return (image.pixels ? image.pixels->size() : 0) + (image.mapped ? image.mapped->GetMappedBytes() : 0);
+}
+
+void ImageCache::SetBudget(uint64_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budgetBytes_ = budgetBytes;
+    evictLocked();
+}
+
+uint64_t ImageCache::GetBudget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budgetBytes_;
+}
+
+uint64_t ImageCache::GetUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usedBytes_;
+}
+
+void ImageCache::Put(const std::wstring& path, ImageData&& image) {
+    if (path.empty() || !image.isValid()) return;
+    // Paged images hold a worker thread and cache tiles the byte budget cannot see, and
+    // reopening one reads no pixels; they are dropped rather than kept
+    if (image.paged) return;
+
+    const uint64_t size = SizeOf(image);
+    std::wstring key = makeKey(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+        usedBytes_ -= SizeOf(it->second->image);
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    // NASA Standard: Never let a single entry exceed the budget
+    if (size > budgetBytes_) return;
+
+    lru_.push_front(Entry{key, std::move(image)});
+    index_[std::move(key)] = lru_.begin();
+    usedBytes_ += size;
+    evictLocked();
+}
+
+bool ImageCache::Take(const std::wstring& path, ImageData& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(makeKey(path));
+    if (it == index_.end()) return false;
+
+    usedBytes_ -= SizeOf(it->second->image);
+    out = std::move(it->second->image);
+    lru_.erase(it->second);
+    index_.erase(it);
+    return true;
+}
+
+bool ImageCache::Contains(const std::wstring& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(makeKey(path)) != index_.end();
+}
+
+void ImageCache::Remove(const std::wstring& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(makeKey(path));
+    if (it == index_.end()) return;
+
+    usedBytes_ -= SizeOf(it->second->image);
+    lru_.erase(it->second);
+    index_.erase(it);
+}
+
+void ImageCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    usedBytes_ = 0;
+}
+
+std::wstring ImageCache::makeKey(const std::wstring& path) {
+    // Windows paths are case-insensitive; match the _wcsicmp lookups elsewhere
+    std::wstring key = path;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+    return key;
+}
+
+void ImageCache::evictLocked() {
+    while (usedBytes_ > budgetBytes_ && !lru_.empty()) {
+        Entry& victim = lru_.back();
+        usedBytes_ -= SizeOf(victim.image);
+        index_.erase(victim.key);
+        lru_.pop_back();
+    }
+}
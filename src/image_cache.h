@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "viewer.h"
+
+/**
+ * ImageCache - LRU cache of decoded ImageData bounded by a byte budget
+ * Holds recently viewed and prefetched neighbours so Left/Right navigation
+ * only pays for a texture upload. Entries are moved in and out rather than
+ * copied: the displayed image lives in g_ctx.imageData and is stashed back
+ * here when the viewer steps away from it. Pixel buffers are shared, so an
+ * entry a save is still reading only drops the cache's reference on eviction.
+ *
+ * Thread-safe; the decode worker inserts prefetched images concurrently.
+ */
+class ImageCache {
+public:
+    explicit ImageCache(uint64_t budgetBytes = 0);
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    // Default budget: a quarter of physical memory, clamped to [256 MB, 8 GB]
+    static uint64_t DefaultBudget();
+
+    void SetBudget(uint64_t budgetBytes);
+    uint64_t GetBudget() const;
+    uint64_t GetUsedBytes() const;
+
+    // Insert (or replace) an entry and evict least-recently-used ones over budget.
+    // Images larger than the whole budget, and paged images, are not cached.
+    void Put(const std::wstring& path, ImageData&& image);
+
+    // Move an entry out of the cache. Returns false on a miss.
+    bool Take(const std::wstring& path, ImageData& out);
+
+    bool Contains(const std::wstring& path) const;
+    void Remove(const std::wstring& path);
+    void Clear();
+
+    // Decoded pixels, plus the file a mapped image keeps in view
+    static uint64_t SizeOf(const ImageData& image);
+
+private:
+    struct Entry {
+        std::wstring key;
+        ImageData image;
+    };
+
+    static std::wstring makeKey(const std::wstring& path);
+    void evictLocked();
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;   // Front = most recently used
+    std::unordered_map<std::wstring, std::list<Entry>::iterator> index_;
+    uint64_t budgetBytes_ = 0;
+    uint64_t usedBytes_ = 0;
+};
@@ -1,6 +1,12 @@
 #include "viewer.h"
 #include "vulkan_renderer.h"
+#include "image_loader.h"
+#include "image_saver.h"
+#include "thumbnail_grid.h"
+#include "sequence_player.h"
 #include "logging.h"
+#include "trace.h"
+#include <cstdio>
 
 extern AppContext g_ctx;
 
@@ -73,6 +79,134 @@ static HFONT CreateMessageFontForDpi(HWND hwnd) {
         return cap;
     }
 
+    // Text for the renderer's HUD; the glyph atlas is ASCII, so anything else shows as '?'
+    std::string BuildOverlayText(const AppContext& ctx) {
+        std::string text;
+        char line[128];
+
+        if (ctx.showInfoOverlay && ctx.showFps) {
+            std::snprintf(line, sizeof(line), "%.1f FPS", ctx.fps);
+            text += line;
+        }
+
+        const bool playing = ctx.sequencePlayer && ctx.sequencePlayer->IsPlaying();
+        if (ctx.showInfoOverlay || ctx.showFilePath) {
+            const std::wstring* path = nullptr;
+            const std::wstring frame = playing ? ctx.sequencePlayer->GetShownPath() : std::wstring();
+            const bool inGrid = ctx.thumbnailGrid && ctx.thumbnailGrid->GetMode() == ThumbnailGrid::Mode::Grid;
+            if (inGrid && ctx.thumbnailGrid->GetSelected() < static_cast<int>(ctx.imageFiles.size())) {
+                // The grid hides the image; name what Enter would open instead
+                path = &ctx.imageFiles[ctx.thumbnailGrid->GetSelected()];
+            } else if (!frame.empty()) {
+                path = &frame;
+            } else if (!ctx.currentFilePathOverride.empty()) {
+                path = &ctx.currentFilePathOverride;
+            } else if (ctx.currentImageIndex >= 0 && ctx.currentImageIndex < static_cast<int>(ctx.imageFiles.size())) {
+                path = &ctx.imageFiles[ctx.currentImageIndex];
+            }
+            if (path) {
+                if (!text.empty()) text += '\n';
+                for (const wchar_t c : *path) {
+                    text += (c >= 32 && c < 127) ? static_cast<char>(c) : '?';
+                }
+            }
+        }
+
+        if (ctx.showInfoOverlay) {
+            if (ctx.imageData.isValid()) {
+                std::snprintf(line, sizeof(line), "%ux%u %s  zoom %.0f%%  rotation %d",
+                              ctx.imageData.displayWidth(), ctx.imageData.displayHeight(), ctx.imageData.isHdr ? "HDR" : "LDR",
+                              ctx.zoomFactor * 100.0f, ctx.rotationAngle);
+                if (!text.empty()) text += '\n';
+                text += line;
+                if (ctx.imageData.exposure != 0.0f || ctx.imageData.gamma != kDefaultGamma) {
+                    std::snprintf(line, sizeof(line), "  exposure %+.1f EV  gamma %.1f",
+                                  ctx.imageData.exposure, ctx.imageData.gamma);
+                    text += line;
+                }
+                const uint32_t downscale = ctx.renderer ? ctx.renderer->GetResidentDownscale() : 1;
+                if (downscale > 1) {
+                    std::snprintf(line, sizeof(line), "  shown at 1/%u", downscale);
+                    text += line;
+                }
+            }
+            const char* status = nullptr;
+            if (ctx.imageLoader && ctx.imageLoader->IsBusy()) {
+                status = "Loading...";
+            } else if (ctx.renderer && ctx.renderer->HasPendingUpload()) {
+                status = "Uploading...";
+            }
+            if (status) {
+                if (!text.empty()) text += '\n';
+                text += status;
+            }
+        }
+
+        if (ctx.showPerfOverlay) {
+            Trace::StageStats stats[Trace::kStageCount];
+            Trace::GetStageStats(stats);
+            if (!text.empty()) text += '\n';
+            if (ctx.renderer) {
+                std::snprintf(line, sizeof(line), "present: %s, %s pacing\n", ctx.renderer->GetPresentModeName(),
+                              ctx.renderer->IsLowLatency() ? "low latency" : "smooth");
+                text += line;
+            }
+            const PixelPool::Stats pool = PixelPool::Shared().GetStats();
+            const uint64_t allocations = pool.reused + pool.fresh;
+            std::snprintf(line, sizeof(line), "pixels: %llu MB live, %llu MB pooled, %.0f%% reused%s\n",
+                          static_cast<unsigned long long>(pool.liveBytes >> 20),
+                          static_cast<unsigned long long>(pool.freeBytes >> 20),
+                          allocations ? 100.0 * static_cast<double>(pool.reused) / static_cast<double>(allocations) : 0.0,
+                          pool.largePages ? ", large pages" : "");
+            text += line;
+            std::snprintf(line, sizeof(line), "%-12s %7s %7s %7s", "stage (ms)", "p50", "p95", "max");
+            text += line;
+            for (size_t i = 0; i < Trace::kStageCount; ++i) {
+                if (stats[i].count == 0) continue;
+                std::snprintf(line, sizeof(line), "\n%-12s %7.2f %7.2f %7.2f",
+                              Trace::StageName(static_cast<Trace::Stage>(i)),
+                              stats[i].p50Ms, stats[i].p95Ms, stats[i].maxMs);
+                text += line;
+            }
+        }
+
+        // Shown while playing with or without the info HUD: playback drops frames rather than slowing
+        if (playing) {
+            const SequencePlayer::Stats stats = ctx.sequencePlayer->GetStats();
+            std::snprintf(line, sizeof(line), "Frame %zu/%zu  %.3g fps  cached %u/%u  dropped %llu",
+                          stats.frame + 1, stats.frameCount, stats.fps, stats.resident, stats.slots,
+                          static_cast<unsigned long long>(stats.dropped));
+            if (!text.empty()) text += '\n';
+            text += line;
+            if (stats.skipped > 0) {
+                // Undecodable or mismatched frames are passed over; say so rather than look like drops
+                std::snprintf(line, sizeof(line), "  skipped %llu", static_cast<unsigned long long>(stats.skipped));
+                text += line;
+            }
+        }
+
+        // Shown even with the info HUD off: it is the only sign a save is still running
+        if (ctx.imageSaver && ctx.imageSaver->IsBusy()) {
+            std::snprintf(line, sizeof(line), "Saving... %d%%", ctx.imageSaver->GetProgress());
+            if (!text.empty()) text += '\n';
+            text += line;
+        }
+        return text;
+    }
+
+    // Hand the renderer this frame's grid or filmstrip; none when both are off
+    void UpdateThumbnailGrid(int clientWidth, int clientHeight, const AppContext& ctx) {
+        static std::vector<VulkanRenderer::GridQuad> s_quads;
+        bool coverImage = false;
+        s_quads.clear();
+        if (ctx.thumbnailGrid && ctx.renderer->SupportsThumbnailGrid()) {
+            ctx.thumbnailGrid->BuildQuads(static_cast<uint32_t>(clientWidth), static_cast<uint32_t>(clientHeight),
+                                          ctx.imageFiles, ctx.currentImageIndex, s_quads);
+            coverImage = ctx.thumbnailGrid->GetMode() == ThumbnailGrid::Mode::Grid;
+        }
+        ctx.renderer->SetThumbnailGrid(s_quads, coverImage);
+    }
+
     // RAII guard for SDL mutex shared access
     struct MutexSharedGuard {
         SDL_Mutex* lock;
@@ -93,25 +227,15 @@ static HFONT CreateMessageFontForDpi(HWND hwnd) {
 }
 
 void DrawImage(HDC hdc, const RECT& clientRect, const AppContext& ctx) {
-#ifdef HAVE_DATADOG
-    auto drawSpan = Logger::CreateSpan("image.draw");
-    drawSpan.set_tag("client_width", std::to_string(clientRect.right - clientRect.left));
-    drawSpan.set_tag("client_height", std::to_string(clientRect.bottom - clientRect.top));
-    drawSpan.set_tag("zoom_factor", std::to_string(g_ctx.zoomFactor));
-    drawSpan.set_tag("rotation_angle", std::to_string(g_ctx.rotationAngle));
-    drawSpan.set_tag("offset_x", std::to_string(g_ctx.offsetX));
-    drawSpan.set_tag("offset_y", std::to_string(g_ctx.offsetY));
-#endif
-    
+    // Per-frame cost goes to the trace rings; a span with tags per frame cost more than the frame
+    Trace::Scope frameTrace(Trace::Stage::Frame);
+
     MutexSharedGuard guard(g_ctx.renderLock);
     RenderInProgressGuard rip(g_ctx.renderInProgress);
 
     int clientWidth = clientRect.right - clientRect.left;
     int clientHeight = clientRect.bottom - clientRect.top;
     if (clientWidth <= 0 || clientHeight <= 0) {
-#ifdef HAVE_DATADOG
-        drawSpan.set_tag("skipped_reason", "invalid_client_dimensions");
-#endif
         return;
     }
     
@@ -123,10 +247,6 @@ void DrawImage(HDC hdc, const RECT& clientRect, const AppContext& ctx) {
 
     // When no image is loaded, draw a startup overlay with instructions and OCIO status.
     if (!g_ctx.imageData.isValid()) {
-#ifdef HAVE_DATADOG
-        drawSpan.set_tag("no_image", "true");
-        drawSpan.set_tag("ocio_enabled", g_ctx.ocioEnabled ? "true" : "false");
-#endif
         if (hdc) {
             HBRUSH bg = CreateSolidBrush(RGB(0, 0, 0));
             FillRect(hdc, &clientRect, bg);
@@ -164,55 +284,39 @@ void DrawImage(HDC hdc, const RECT& clientRect, const AppContext& ctx) {
 
             SelectObject(hdc, old);
             DeleteObject(font);
+        } else if (g_ctx.renderer && !g_ctx.rendererNeedsReset && !g_ctx.renderer->IsDeviceLost()) {
+            // The renderer draws its cached instructional screen when it has no texture
+            g_ctx.renderer->SetOverlayText(BuildOverlayText(ctx));
+            UpdateThumbnailGrid(clientWidth, clientHeight, ctx);
+            g_ctx.renderer->Render(static_cast<uint32_t>(clientWidth), static_cast<uint32_t>(clientHeight),
+                                   1.0f, 0.0f, 0.0f, 0);
+            if (g_ctx.renderer->IsDeviceLost() || g_ctx.renderer->IsSwapchainOutOfDate()) {
+                g_ctx.rendererNeedsReset = true;
+            }
         }
         return;
     }
 
     if (g_ctx.renderer && !g_ctx.rendererNeedsReset) {
-#ifdef HAVE_DATADOG
-        auto renderSpan = Logger::CreateChildSpan(drawSpan, "vulkan.render");
-        renderSpan.set_tag("image_width", std::to_string(ctx.imageData.width));
-        renderSpan.set_tag("image_height", std::to_string(ctx.imageData.height));
-        renderSpan.set_tag("is_hdr", ctx.imageData.isHdr ? "true" : "false");
-#endif
-        
         // Log current view parameters at the start of a draw
         Logger::Info("Draw: client=%dx%d zoom=%.3f offset=(%.2f,%.2f) rot=%d",
                      clientWidth, clientHeight, g_ctx.zoomFactor, g_ctx.offsetX, g_ctx.offsetY, g_ctx.rotationAngle);
         // If the device is already lost, do not issue any Vulkan commands this frame.
         if (g_ctx.renderer->IsDeviceLost()) {
             Logger::Warn("Render skipped: device lost flagged — scheduling reset");
-#ifdef HAVE_DATADOG
-            renderSpan.set_tag("skipped_reason", "device_lost");
-            drawSpan.set_tag("skipped_reason", "device_lost");
-#endif
             g_ctx.rendererNeedsReset = true;
             return;
         }
 
-        // Re-upload texture ONLY when image data changes. Zoom now affects rendering only.
-        static uint32_t s_lastImageWidth = 0;
-        static uint32_t s_lastImageHeight = 0;
-        static bool s_lastIsHdr = false;
-
-        const bool imageChanged = (ctx.imageData.width != s_lastImageWidth || 
-                                  ctx.imageData.height != s_lastImageHeight ||
-                                  ctx.imageData.isHdr != s_lastIsHdr);
-
-        if (imageChanged) {
-            const void* pixelData = ctx.imageData.pixels.data();
-
-            g_ctx.renderer->UpdateImageFromData(
-                pixelData, ctx.imageData.width, ctx.imageData.height, ctx.imageData.isHdr);
-
-            s_lastImageWidth = ctx.imageData.width;
-            s_lastImageHeight = ctx.imageData.height;
-            s_lastIsHdr = ctx.imageData.isHdr;
+        // Images are uploaded where they are installed (ApplyDecodedImage, renderer rebuilds);
+        // a flipbook shows its own frames
+        if (IsSequencePlaying()) {
+            g_ctx.sequencePlayer->Update(g_ctx.renderer.get());
         }
 
         // Compute dynamic cap for current orientation
-        const bool rotated = (g_ctx.rotationAngle == 90 || g_ctx.rotationAngle == 270);
-        const float dynCap = ComputeDynamicZoomCap(ctx.imageData.width, ctx.imageData.height, rotated);
+        const bool rotated = (DisplayRotation() % 180 != 0);
+        const float dynCap = ComputeDynamicZoomCap(ctx.imageData.displayWidth(), ctx.imageData.displayHeight(), rotated);
 
         // Enforce a conservative state cap every frame so zoom-out always responds after hitting limits
         const float stateCap = dynCap * kStateHeadroom;
@@ -239,26 +343,18 @@ void DrawImage(HDC hdc, const RECT& clientRect, const AppContext& ctx) {
         // Log critical state before potentially dangerous Vulkan renderer call
         Logger::LogCriticalState(safeZoom, ctx.offsetX, ctx.offsetY, "before_vulkan_render");
         
+        g_ctx.renderer->SetOverlayText(BuildOverlayText(ctx));
+        g_ctx.renderer->SetDisplayAdjustments(ctx.imageData.exposure, ctx.imageData.gamma);
+        UpdateThumbnailGrid(clientWidth, clientHeight, ctx);
         g_ctx.renderer->Render(static_cast<uint32_t>(clientWidth), static_cast<uint32_t>(clientHeight),
-                               safeZoom, ctx.offsetX, ctx.offsetY, ctx.rotationAngle);
+                               safeZoom, ctx.offsetX, ctx.offsetY, DisplayRotation(), DisplayMirrored());
 
         // Check for non-throwing error states and defer reset to main loop
         if (g_ctx.renderer->IsDeviceLost() || g_ctx.renderer->IsSwapchainOutOfDate()) {
             Logger::Warn("Renderer signaled reset: deviceLost=%d swapchainOutOfDate=%d",
                          g_ctx.renderer->IsDeviceLost() ? 1 : 0,
                          g_ctx.renderer->IsSwapchainOutOfDate() ? 1 : 0);
-#ifdef HAVE_DATADOG
-            renderSpan.set_tag("needs_reset", "true");
-            renderSpan.set_tag("device_lost", g_ctx.renderer->IsDeviceLost() ? "true" : "false");
-            renderSpan.set_tag("swapchain_out_of_date", g_ctx.renderer->IsSwapchainOutOfDate() ? "true" : "false");
-#endif
             g_ctx.rendererNeedsReset = true;
-            s_lastImageWidth = 0;
-            s_lastImageHeight = 0;
-        } else {
-#ifdef HAVE_DATADOG
-            renderSpan.set_tag("needs_reset", "false");
-#endif
         }
     }
 }
@@ -291,10 +387,10 @@ void FitImageToWindow() {
 
     float clientWidth = static_cast<float>(clientRect.right - clientRect.left);
     float clientHeight = static_cast<float>(clientRect.bottom - clientRect.top);
-    float imageWidth = static_cast<float>(g_ctx.imageData.width);
-    float imageHeight = static_cast<float>(g_ctx.imageData.height);
+    float imageWidth = static_cast<float>(g_ctx.imageData.displayWidth());
+    float imageHeight = static_cast<float>(g_ctx.imageData.displayHeight());
 
-    if (g_ctx.rotationAngle == 90 || g_ctx.rotationAngle == 270) {
+    if (DisplayRotation() % 180 != 0) {
         std::swap(imageWidth, imageHeight);
     }
 
@@ -303,8 +399,8 @@ void FitImageToWindow() {
     g_ctx.zoomFactor = std::min(clientWidth / imageWidth, clientHeight / imageHeight);
 
     // Enforce dynamic cap derived from image dimensions plus global bounds
-    const bool rotated = (g_ctx.rotationAngle == 90 || g_ctx.rotationAngle == 270);
-    const float dynCap = ComputeDynamicZoomCap(g_ctx.imageData.width, g_ctx.imageData.height, rotated);
+    const bool rotated = (DisplayRotation() % 180 != 0);
+    const float dynCap = ComputeDynamicZoomCap(g_ctx.imageData.displayWidth(), g_ctx.imageData.displayHeight(), rotated);
     if (g_ctx.zoomFactor > dynCap) g_ctx.zoomFactor = dynCap;
     if (g_ctx.zoomFactor < kMinZoom) g_ctx.zoomFactor = kMinZoom;
 
@@ -320,7 +416,7 @@ void FitImageToWindow() {
     fitSpan.set_tag("client_height", std::to_string(clientHeight));
 #endif
     
-    // SDL3 will trigger a redraw automatically
+    RequestRedraw();
 }
 
 void ZoomImage(float factor) {
@@ -353,8 +449,8 @@ void ZoomImage(float factor) {
     
     Logger::Info("Zoom request: factor=%.3f currentZoom=%.3f", factor, g_ctx.zoomFactor);
 
-    const bool rotated = (g_ctx.rotationAngle == 90 || g_ctx.rotationAngle == 270);
-    const float dynCap = ComputeDynamicZoomCap(g_ctx.imageData.width, g_ctx.imageData.height, rotated);
+    const bool rotated = (DisplayRotation() % 180 != 0);
+    const float dynCap = ComputeDynamicZoomCap(g_ctx.imageData.displayWidth(), g_ctx.imageData.displayHeight(), rotated);
 
     // Keep user-visible state comfortably below the theoretical cap.
     const float stateCap = dynCap * kStateHeadroom;
@@ -389,7 +485,7 @@ void ZoomImage(float factor) {
     zoomSpan.set_tag("zoom_direction", factor > 1.0f ? "in" : "out");
 #endif
     
-    // SDL3 will trigger a redraw automatically
+    RequestRedraw();
 }
 
 void RotateImage(bool clockwise) {
@@ -415,7 +511,15 @@ void RotateImage(bool clockwise) {
     rotateSpan.set_tag("new_angle", std::to_string(g_ctx.rotationAngle));
 #endif
     
-    // SDL3 will trigger a redraw automatically
+    RequestRedraw();
+}
+
+int DisplayRotation() {
+    return (g_ctx.rotationAngle + g_ctx.imageData.orientationRotation()) % 360;
+}
+
+bool DisplayMirrored() {
+    return g_ctx.imageData.orientationMirrored();
 }
 
 bool IsPointInImage(POINT pt, const RECT& /* clientRect */) {
@@ -453,7 +557,7 @@ bool IsPointInImage(POINT pt, const RECT& /* clientRect */) {
         return false;
     }
 
-    double rad = -g_ctx.rotationAngle * 3.1415926535 / 180.0;
+    double rad = -DisplayRotation() * 3.1415926535 / 180.0;
     float cosTheta = static_cast<float>(cos(rad));
     float sinTheta = static_cast<float>(sin(rad));
 
@@ -465,16 +569,20 @@ bool IsPointInImage(POINT pt, const RECT& /* clientRect */) {
         return false;
     }
 
-    float localX = unrotatedX + g_ctx.imageData.width / 2.0f;
-    float localY = unrotatedY + g_ctx.imageData.height / 2.0f;
+    float localX = unrotatedX + g_ctx.imageData.displayWidth() / 2.0f;
+    float localY = unrotatedY + g_ctx.imageData.displayHeight() / 2.0f;
     
     // Final validation of local coordinates
     if (!std::isfinite(localX) || !std::isfinite(localY)) {
         return false;
     }
 
-    return localX >= 0 && localX < static_cast<float>(g_ctx.imageData.width) && 
-           localY >= 0 && localY < static_cast<float>(g_ctx.imageData.height);
+    return localX >= 0 && localX < static_cast<float>(g_ctx.imageData.displayWidth()) && 
+           localY >= 0 && localY < static_cast<float>(g_ctx.imageData.displayHeight());
+}
+
+void RequestRedraw() {
+    g_ctx.needsRedraw = true;
 }
 
 // Compatibility functions
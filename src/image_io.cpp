@@ -6,8 +6,21 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <functional>
 
 #include "vulkan_renderer.h"
+#include "image_loader.h"
+#include "image_saver.h"
+#include "image_cache.h"
+#include "directory_indexer.h"
+#include "thumbnail_grid.h"
+#include "sequence_player.h"
+#include "pixel_convert.h"
+#include "trace.h"
+#include "paged_image.h"
+#include "mapped_image.h"
+#include "color_lut.h"
+#include "worker_pool.h"
 #include "logging.h"
 
 #ifdef _WIN32
@@ -43,105 +56,43 @@ static HWND GetHWNDFromSDL() {
 }
 #endif
 
-static bool IsImageFile(const wchar_t* filePath) {
-    // Clear any previous errors first
-    OIIO::geterror();
-
-    std::string utf8Path = wstring_to_utf8(filePath);
-    auto in = OIIO::ImageInput::open(utf8Path);
-    if (!in) {
-        // Clear any pending error to prevent the warning
-        OIIO::geterror();
-        return false;
+// Target size of one conversion band (float RGBA working set on the OCIO path),
+// grown on many-core machines so every pool thread gets a slice worth waking for
+constexpr uint64_t kBandBytes = UINT64_C(8) * 1024 * 1024;
+constexpr uint64_t kBandBytesPerThread = UINT64_C(2) * 1024 * 1024;
+
+// Rows per band; tiled files need bands aligned to the tile height
+static int ComputeBandRows(const OIIO::ImageSpec& spec, unsigned concurrency) {
+    const uint64_t bandBytes = std::max(kBandBytes, kBandBytesPerThread * concurrency);
+    const uint64_t rowBytes = std::max<uint64_t>(static_cast<uint64_t>(spec.width) * 4 * sizeof(float), 1);
+    int rows = static_cast<int>(std::clamp<uint64_t>(bandBytes / rowBytes, 1, static_cast<uint64_t>(spec.height)));
+    if (spec.tile_width > 0 && spec.tile_height > 0) {
+        rows = ((rows + spec.tile_height - 1) / spec.tile_height) * spec.tile_height;
     }
-    in->close();
-
-    // Clear any errors from the close operation
-    OIIO::geterror();
-    return true;
+    return rows;
 }
 
-void LoadImageFromFile(const wchar_t* filePath) {
-#ifdef HAVE_DATADOG
-    auto loadSpan = Logger::CreateSpan("image.load");
-    
-    // Convert to UTF-8 for tagging
-    std::string utf8Path = wstring_to_utf8(filePath);
-    loadSpan.set_tag("file_path", utf8Path);
-#else
-    // Convert to UTF-8 for logging even without datadog
-    std::string utf8Path = wstring_to_utf8(filePath);
-#endif
-    
-    g_ctx.imageData.clear();
-    g_ctx.currentFilePathOverride.clear();
-
-    // Clear any previous OpenImageIO errors
-    OIIO::geterror();
-
-    auto in = OIIO::ImageInput::open(utf8Path);
-    if (!in) {
-        // Clear any pending error and show what went wrong
-        std::string error = OIIO::geterror();
-#ifdef HAVE_DATADOG
-        loadSpan.set_tag("success", "false");
-        loadSpan.set_tag("error", error);
-#endif
-        if (!error.empty()) {
-            std::wstring werror(error.begin(), error.end());
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_WARNING, "Image Load Error", 
-                                ("Failed to open image: " + error).c_str(), g_ctx.window);
-        }
-        CenterImage(true);
-        return;
-    }
-
-    const OIIO::ImageSpec& spec = in->spec();
-
-    // NASA Standard: Validate all input parameters and bounds
-    if (spec.width <= 0 || spec.height <= 0 || spec.width > 65536 || spec.height > 65536) {
-        OIIO::geterror(); // Clear any errors
-#ifdef HAVE_DATADOG
-        loadSpan.set_tag("success", "false");
-        loadSpan.set_tag("error", "Invalid image dimensions");
-#endif
-        CenterImage(true);
-        return;
-    }
-
-    uint32_t width = static_cast<uint32_t>(spec.width);
-    uint32_t height = static_cast<uint32_t>(spec.height);
-
-    // NASA Standard: Validate computed values
-    if (width == 0 || height == 0) {
-        OIIO::geterror();
-#ifdef HAVE_DATADOG
-        loadSpan.set_tag("success", "false");
-        loadSpan.set_tag("error", "Zero dimensions after validation");
-#endif
-        CenterImage(true);
-        return;
-    }
-
-    // Channels are always converted to 4 (RGBA)
-
-    // NASA Standard: Prevent integer overflow in memory calculations
-    const uint64_t maxPixels = UINT64_C(0x7FFFFFFF) / 16; // Conservative limit
-    if (static_cast<uint64_t>(width) * static_cast<uint64_t>(height) > maxPixels) {
-        OIIO::geterror();
-#ifdef HAVE_DATADOG
-        loadSpan.set_tag("success", "false");
-        loadSpan.set_tag("error", "Image too large for memory");
-#endif
-        CenterImage(true);
-        return;
+// Read rows [y0, y1) of the first 'channels' channels as 'format' into 'data'
+// with the given pixel/row strides, for both scanline and tiled files
+static bool ReadBand(OIIO::ImageInput* in, const OIIO::ImageSpec& spec, uint32_t y0, uint32_t y1, int channels,
+                     OIIO::TypeDesc format, void* data, OIIO::stride_t xstride, OIIO::stride_t ystride) {
+    Trace::Scope decodeTrace(Trace::Stage::Decode);
+    const int ybegin = spec.y + static_cast<int>(y0);
+    const int yend = spec.y + static_cast<int>(y1);
+    if (spec.tile_width > 0 && spec.tile_height > 0) {
+        return in->read_tiles(0, 0, spec.x, spec.x + spec.width, ybegin, yend,
+                              spec.z, spec.z + std::max(spec.depth, 1), 0, channels,
+                              format, data, xstride, ystride, OIIO::AutoStride);
     }
+    return in->read_scanlines(0, 0, ybegin, yend, spec.z, 0, channels, format, data, xstride, ystride);
+}
 
+// HDR sources are decoded to RGBA16F, everything else to RGBA8
+static bool IsHdrSource(const OIIO::ImageSpec& spec, const std::string& utf8Path) {
     // Determine if this is an HDR format
-    bool isHdr = false;
-    std::string formatName = spec.format.c_str();
+    const std::string formatName = spec.format.c_str();
     if (formatName == "half" || formatName == "float" || formatName == "double") {
-        isHdr = true;
+        return true;
     }
 
     // Check file extension for HDR formats
@@ -153,24 +104,14 @@ void LoadImageFromFile(const wchar_t* filePath) {
         lowerPath.find(".pfm") != std::string::npos ||
         lowerPath.find(".tiff") != std::string::npos ||
         lowerPath.find(".tif") != std::string::npos) {
-        isHdr = true;
+        return true;
     }
+    return false;
+}
 
-    g_ctx.imageData.width = width;
-    g_ctx.imageData.height = height;
-    g_ctx.imageData.isHdr = isHdr;
-    g_ctx.imageData.channels = 4; // Always convert to RGBA
-    
-    // Tag image properties
-#ifdef HAVE_DATADOG
-    loadSpan.set_tag("width", std::to_string(width));
-    loadSpan.set_tag("height", std::to_string(height));
-    loadSpan.set_tag("is_hdr", isHdr ? "true" : "false");
-    loadSpan.set_tag("channels", "4");
-    loadSpan.set_tag("original_channels", std::to_string(spec.nchannels));
-    loadSpan.set_tag("format", formatName);
-#endif
-
+// Processor from the file's color space to the display space; null when no
+// conversion is needed or OCIO cannot provide one
+static OCIO::ConstProcessorRcPtr CreateDisplayProcessor(const OIIO::ImageSpec& spec, bool isHdr) {
     // Initialize OpenColorIO with comprehensive error handling (NASA coding standard)
     OCIO::ConstConfigRcPtr config = nullptr;
 
@@ -286,210 +227,853 @@ void LoadImageFromFile(const wchar_t* filePath) {
         }
     }
 
+    return processor;
+}
+
+// Processor for converting pixels at decode time; null skips color conversion
+static OCIO::ConstCPUProcessorRcPtr CreateCpuProcessor(const OCIO::ConstProcessorRcPtr& processor) {
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor = nullptr;
+    if (processor) {
+        try {
+            cpuProcessor = processor->getDefaultCPUProcessor();
+        } catch (...) {
+            // No CPU processor available, skip color conversion
+            cpuProcessor = nullptr;
+        }
+    }
+    return cpuProcessor;
+}
+
+// The display transform for 'out': baked for the renderer when it applies color on
+// the GPU (the pixels then stay as the file has them), otherwise a CPU processor
+static OCIO::ConstCPUProcessorRcPtr PrepareDisplayTransform(const OCIO::ConstProcessorRcPtr& processor, bool isHdr,
+                                                            const DecodeOptions& options, ImageData& out) {
+    out.colorTransform = processor;
+    if (options.gpuColor && processor) {
+        out.displayLut = ColorLut::Bake(processor, isHdr);
+        if (out.displayLut) {
+            return nullptr;
+        }
+    }
+    return CreateCpuProcessor(processor);
+}
+
+bool DecodeImageFile(const std::wstring& filePath, ImageData& out, std::string& error,
+                     const std::function<bool()>& isCancelled, const DecodeOptions& options) {
+#ifdef HAVE_DATADOG
+    auto loadSpan = Logger::CreateSpan("image.load");
+
+    // Convert to UTF-8 for tagging
+    std::string utf8Path = wstring_to_utf8(filePath);
+    loadSpan.set_tag("file_path", utf8Path);
+#else
+    // Convert to UTF-8 for logging even without datadog
+    std::string utf8Path = wstring_to_utf8(filePath);
+#endif
+
+    out.clear();
+    error.clear();
+
+    // NASA Standard: Cancellation is checked between every expensive stage
+    auto cancelled = [&]() { return isCancelled && isCancelled(); };
+
+    // Clear any previous OpenImageIO errors
+    OIIO::geterror();
+
+    std::unique_ptr<OIIO::ImageInput> in;
+    {
+        Trace::Scope openTrace(Trace::Stage::Open);
+        in = OIIO::ImageInput::open(utf8Path);
+    }
+    if (!in) {
+        // Clear any pending error and report what went wrong
+        error = OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", error);
+#endif
+        return false;
+    }
+
+    const OIIO::ImageSpec& spec = in->spec();
+
+    // NASA Standard: Validate all input parameters and bounds. The 65536 limit applies
+    // to dense decodes only, below: tiled files past it can still be paged.
+    if (spec.width <= 0 || spec.height <= 0) {
+        OIIO::geterror(); // Clear any errors
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Invalid image dimensions");
+#endif
+        return false;
+    }
+
+    uint32_t width = static_cast<uint32_t>(spec.width);
+    uint32_t height = static_cast<uint32_t>(spec.height);
+
+    // NASA Standard: Validate computed values
+    if (width == 0 || height == 0) {
+        OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Zero dimensions after validation");
+#endif
+        return false;
+    }
+
+    // Channels are always converted to 4 (RGBA)
+
+    const bool isHdr = IsHdrSource(spec, utf8Path);
+    const std::string formatName = spec.format.c_str();
+
+    out.filePath = filePath;
+    out.width = width;
+    out.height = height;
+    out.isHdr = isHdr;
+    out.channels = 4; // Always convert to RGBA
+    out.sourceSpec = std::make_shared<const OIIO::ImageSpec>(spec);
+    // Camera files are stored sensor-up; the renderer turns them upright as it draws
+    out.orientation = std::clamp(spec.get_int_attribute("Orientation", 1), 1, 8);
+    
+    // Tag image properties
+#ifdef HAVE_DATADOG
+    loadSpan.set_tag("width", std::to_string(width));
+    loadSpan.set_tag("height", std::to_string(height));
+    loadSpan.set_tag("is_hdr", isHdr ? "true" : "false");
+    loadSpan.set_tag("channels", "4");
+    loadSpan.set_tag("original_channels", std::to_string(spec.nchannels));
+    loadSpan.set_tag("format", formatName);
+#endif
+
+    const int fileChannels = std::min(spec.nchannels, 4);
+    const uint64_t pixelCount = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    if (options.maxPixels != 0 && pixelCount > options.maxPixels) {
+        in->close();
+        OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Over the caller's pixel limit");
+#endif
+        return false;
+    }
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor =
+        PrepareDisplayTransform(CreateDisplayProcessor(spec, isHdr), isHdr, options, out);
+
+    // Tiled files past the dense texture limit are not decoded here: the renderer's
+    // sparse texture asks for the tiles it samples and only those are read
+    const uint64_t pagedThresholdPixels = UINT64_C(67108864); // 8K x 8K, as the renderer
+
+    // Uncompressed files in a layout read in place are not decoded at all: the renderer
+    // converts rows from the file mapping as it uploads them. Only when no CPU color
+    // conversion is due, since the mapped texels reach the GPU as the file has them.
+    if (options.mappedRows && !cpuProcessor && (pixelCount <= pagedThresholdPixels || options.allowPaged)) {
+        auto mapped = std::make_shared<MappedImage>();
+        if (mapped->Open(filePath, isHdr) && mapped->GetWidth() == width && mapped->GetHeight() == height) {
+            in->close();
+            out.mapped = std::move(mapped);
+            OIIO::geterror();
+#ifdef HAVE_DATADOG
+            loadSpan.set_tag("mapped", "true");
+            loadSpan.set_tag("success", "true");
+#endif
+            return true;
+        }
+    }
+
+    if (options.allowPaged && spec.tile_width > 0 && spec.tile_height > 0 && fileChannels > 0 &&
+        pixelCount > pagedThresholdPixels) {
+        in->close();
+        auto paged = std::make_shared<PagedImage>();
+        if (paged->Open(utf8Path, width, height, spec.x, spec.y, fileChannels, isHdr, cpuProcessor)) {
+            out.paged = std::move(paged);
+            out.isTiled = true;
+            out.tileSize = static_cast<uint32_t>(spec.tile_width);
+            OIIO::geterror();
+#ifdef HAVE_DATADOG
+            loadSpan.set_tag("paged", "true");
+            loadSpan.set_tag("success", "true");
+#endif
+            return true;
+        }
+        // Fall back to a full decode
+        in = OIIO::ImageInput::open(utf8Path);
+        if (!in) {
+            error = OIIO::geterror();
+            out.clear();
+            return false;
+        }
+    }
+
+    // NASA Standard: Validate bounds of the dense texture
+    if (width > 65536 || height > 65536) {
+        OIIO::geterror();
+        out.clear();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Invalid image dimensions");
+#endif
+        return false;
+    }
+
+    // NASA Standard: Prevent integer overflow in memory calculations
+    const uint64_t maxPixels = UINT64_C(0xFFFFFFFF) / 8; // Final RGBA16F buffer stays under 4 GB
+    if (static_cast<uint64_t>(width) * static_cast<uint64_t>(height) > maxPixels) {
+        OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Image too large for memory");
+#endif
+        return false;
+    }
+
+    // Stream the image in row bands straight into the final RGBA buffer.
+    // Only the OCIO path needs a float working set, and only one band of it.
+    const size_t bytesPerChannel = isHdr ? sizeof(uint16_t) : sizeof(uint8_t);
+    const uint64_t pixelDataSize = pixelCount * 4 * bytesPerChannel;
+
+    // NASA Standard: Check for overflow before allocation
+    if (fileChannels <= 0 || pixelDataSize > SIZE_MAX) {
+        OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Image data size exceeds limits");
+#endif
+        return false;
+    }
+
+    // Pooled and left uninitialised: the bands below write every byte
+    std::shared_ptr<PixelBuffer> pixels = PixelBuffer::Allocate(static_cast<size_t>(pixelDataSize));
+    if (!pixels) {
+        // NASA Standard: Handle memory allocation failure
+        OIIO::geterror();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Memory allocation failed for pixels");
+#endif
+        out.clear();
+        return false;
+    }
+
+    WorkerPool& pool = WorkerPool::Shared();
+    const int bandRows = ComputeBandRows(spec, pool.GetConcurrency());
+    const OIIO::stride_t pixelStride = static_cast<OIIO::stride_t>(4 * bytesPerChannel);
+    const OIIO::stride_t rowStride = pixelStride * static_cast<OIIO::stride_t>(width);
+    const OIIO::TypeDesc targetFormat = isHdr ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8;
+
+    std::vector<float> bandPixels;
+    if (cpuProcessor) {
+        try {
+            bandPixels.resize(static_cast<size_t>(width) * static_cast<size_t>(bandRows) * 4);
+        } catch (const std::bad_alloc& e) {
+            // Not enough memory for the working band; load without color conversion
+            cpuProcessor = nullptr;
+        }
+    }
+
+    // Per-pixel passes run on the shared pool in slices of at least ~64K pixels
+    const size_t grainRows = std::max<size_t>(1, 65536 / width);
+
+    bool readSuccess = true;
+    bool firstBand = true;
+    for (uint32_t y0 = 0; y0 < height; y0 += static_cast<uint32_t>(bandRows)) {
+        if (cancelled()) {
+            readSuccess = false;
+            break;
+        }
+
+        const uint32_t y1 = std::min(height, y0 + static_cast<uint32_t>(bandRows));
+        const uint32_t rows = y1 - y0;
+        const size_t bandPixelCount = static_cast<size_t>(width) * rows;
+        uint8_t* dst = pixels->data() + static_cast<size_t>(y0) * static_cast<size_t>(rowStride);
+
+        if (!cpuProcessor) {
+            // No color conversion: OIIO converts to UINT8/HALF directly into the final buffer
+            if (!ReadBand(in.get(), spec, y0, y1, fileChannels, targetFormat, dst, pixelStride, rowStride)) {
+                readSuccess = false;
+                break;
+            }
+            if (fileChannels < 4) {
+                pool.ParallelFor(rows, grainRows, [&](size_t r0, size_t r1) {
+                    Trace::Scope convertTrace(Trace::Stage::Convert);
+                    const size_t first = r0 * width;
+                    const size_t count = (r1 - r0) * width;
+                    if (isHdr) {
+                        PixelConvert::ExpandToRGBA(reinterpret_cast<uint16_t*>(dst) + first * 4, count, fileChannels, PixelConvert::kHalfOne);
+                    } else {
+                        PixelConvert::ExpandToRGBA(dst + first * 4, count, fileChannels, static_cast<uint8_t>(255));
+                    }
+                });
+            }
+            continue;
+        }
+
+        if (!ReadBand(in.get(), spec, y0, y1, fileChannels, OIIO::TypeDesc::FLOAT, bandPixels.data(),
+                      static_cast<OIIO::stride_t>(4 * sizeof(float)),
+                      static_cast<OIIO::stride_t>(4 * sizeof(float) * width))) {
+            readSuccess = false;
+            break;
+        }
+        if (fileChannels < 4) {
+            pool.ParallelFor(rows, grainRows, [&](size_t r0, size_t r1) {
+                PixelConvert::ExpandToRGBA(bandPixels.data() + r0 * width * 4, (r1 - r0) * width, fileChannels, 1.0f);
+            });
+        }
+
+        // Validate HDR pixel data before color conversion; non-finite input skips OCIO
+        if (firstBand && isHdr) {
+            const size_t checkCount = std::min<size_t>(100, bandPixelCount * 4);
+            for (size_t i = 0; i < checkCount; ++i) {
+                if (!std::isfinite(bandPixels[i])) {
+                    cpuProcessor = nullptr;
+                    break;
+                }
+            }
+        }
+        firstBand = false;
+
+        // Color convert and pack each slice of rows on the pool; the CPU processor is
+        // thread-safe and every slice gets its own PackedImageDesc
+        std::atomic<bool> colorFailed{false};
+        pool.ParallelFor(rows, grainRows, [&](size_t r0, size_t r1) {
+            float* src = bandPixels.data() + r0 * width * 4;
+            const size_t count = (r1 - r0) * width * 4;
+            if (cpuProcessor) {
+                Trace::Scope ocioTrace(Trace::Stage::Ocio);
+                try {
+                    OCIO::PackedImageDesc imgDesc(src, static_cast<long>(width), static_cast<long>(r1 - r0), 4);
+                    cpuProcessor->apply(imgDesc);
+                } catch (...) {
+                    colorFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+            Trace::Scope convertTrace(Trace::Stage::Convert);
+            if (isHdr) {
+                PixelConvert::FloatToHalf(src, reinterpret_cast<uint16_t*>(dst) + r0 * width * 4, count);
+            } else {
+                PixelConvert::FloatToUnorm8(src, dst + r0 * width * 4, count);
+            }
+        });
+        if (colorFailed.load(std::memory_order_relaxed)) {
+            // Color conversion failed, continue the remaining bands without it
+            cpuProcessor = nullptr;
+        }
+    }
+
+    if (readSuccess) {
+        out.pixels = std::move(pixels);
+    } else {
+        out.clear();
+    }
+
+    in->close();
+
+    // Clear any errors from image processing operations
+    OIIO::geterror();
+
+    if (cancelled()) {
+        out.clear();
+#ifdef HAVE_DATADOG
+        loadSpan.set_tag("success", "false");
+        loadSpan.set_tag("error", "Cancelled");
+#endif
+        return false;
+    }
+
+#ifdef HAVE_DATADOG
+    loadSpan.set_tag("success", out.isValid() ? "true" : "false");
+#endif
+    return out.isValid();
+}
+
+// Previews: long side of the stand-in, and the source size below which none is made
+constexpr int kPreviewMaxDimension = 1024;
+constexpr int kPreviewMinSourceDimension = 2048;
+// A stand-in whose shape differs by more than this would visibly jump when replaced
+constexpr double kPreviewAspectTolerance = 0.02;
+
+bool DecodeImagePreview(const std::wstring& filePath, ImageData& out,
+                        const std::function<bool()>& isCancelled, const DecodeOptions& options) {
+    out.clear();
+    auto cancelled = [&]() { return isCancelled && isCancelled(); };
+
+    const std::string utf8Path = wstring_to_utf8(filePath);
+    OIIO::geterror();
+    auto in = OIIO::ImageInput::open(utf8Path);
+    if (!in) {
+        OIIO::geterror();
+        return false;
+    }
+
+    // Copied: seeking to another MIP level replaces in->spec()
+    const OIIO::ImageSpec spec = in->spec();
+    // Past 65536 only a paged (tiled) image can follow the preview
+    const bool pageable = options.allowPaged && spec.tile_width > 0 && spec.tile_height > 0;
+    if (spec.width <= 0 || spec.height <= 0 ||
+        ((spec.width > 65536 || spec.height > 65536) && !pageable) ||
+        std::max(spec.width, spec.height) < kPreviewMinSourceDimension) {
+        in->close();
+        return false;
+    }
+    const bool isHdr = IsHdrSource(spec, utf8Path);
+
+    std::vector<float> rgba;
+    int previewWidth = 0;
+    int previewHeight = 0;
+    int channels = 0;
+    bool sceneReferred = true;      // Same color space as the file, so it gets the same conversion
+
+    // A stored MIP level is the full image's own pixels at a lower resolution
+    for (int level = 1; !cancelled() && in->seek_subimage(0, level); ++level) {
+        const OIIO::ImageSpec& levelSpec = in->spec();
+        if (std::max(levelSpec.width, levelSpec.height) > kPreviewMaxDimension) {
+            continue;
+        }
+        channels = std::min(levelSpec.nchannels, 4);
+        rgba.resize(static_cast<size_t>(levelSpec.width) * levelSpec.height * 4);
+        if (channels > 0 &&
+            in->read_image(0, level, 0, channels, OIIO::TypeDesc::FLOAT, rgba.data(),
+                           static_cast<OIIO::stride_t>(4 * sizeof(float)))) {
+            previewWidth = levelSpec.width;
+            previewHeight = levelSpec.height;
+        }
+        break;
+    }
+
+    // Otherwise the embedded thumbnail (EXIF, EXR preview, ...), which is display-referred
+    if (previewWidth == 0 && !cancelled()) {
+        OIIO::ImageBuf thumbnail;
+        if (in->get_thumbnail(thumbnail, 0) && thumbnail.initialized()) {
+            const OIIO::ImageSpec& thumbSpec = thumbnail.spec();
+            channels = std::min(thumbSpec.nchannels, 4);
+            OIIO::ROI roi = thumbnail.roi();
+            roi.chend = roi.chbegin + channels;
+            if (channels > 0 && thumbSpec.width > 0 && thumbSpec.height > 0) {
+                rgba.resize(static_cast<size_t>(thumbSpec.width) * thumbSpec.height * 4);
+                if (thumbnail.get_pixels(roi, OIIO::TypeDesc::FLOAT, rgba.data(),
+                                         static_cast<OIIO::stride_t>(4 * sizeof(float)))) {
+                    previewWidth = thumbSpec.width;
+                    previewHeight = thumbSpec.height;
+                    sceneReferred = false;
+                }
+            }
+        }
+    }
+
+    in->close();
+    OIIO::geterror();
+    if (previewWidth == 0 || previewHeight == 0 || cancelled()) {
+        return false;
+    }
+
+    const double fullAspect = static_cast<double>(spec.width) / spec.height;
+    const double previewAspect = static_cast<double>(previewWidth) / previewHeight;
+    if (std::abs(previewAspect / fullAspect - 1.0) > kPreviewAspectTolerance) {
+        return false;   // Padded or cropped thumbnail
+    }
+
+    const size_t pixelCount = static_cast<size_t>(previewWidth) * previewHeight;
+    PixelConvert::ExpandToRGBA(rgba.data(), pixelCount, channels, 1.0f);
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor = nullptr;
+    if (sceneReferred) {
+        cpuProcessor = PrepareDisplayTransform(CreateDisplayProcessor(spec, isHdr), isHdr, options, out);
+    } else if (options.gpuColor && isHdr) {
+        // Display-referred floats in a linear texture: decode them so the sRGB target
+        // shows them as encoded, like the full image's LUT output
+        for (size_t i = 0; i < pixelCount * 4; ++i) {
+            if ((i & 3) == 3) continue;
+            const float v = std::max(rgba[i], 0.0f);
+            rgba[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+        }
+    }
+    if (cpuProcessor) {
+        try {
+            OCIO::PackedImageDesc imgDesc(rgba.data(), static_cast<long>(previewWidth), static_cast<long>(previewHeight), 4);
+            cpuProcessor->apply(imgDesc);
+        } catch (...) {
+            // Show the unconverted pixels; the full decode replaces them shortly
+        }
+    }
+
+    std::shared_ptr<PixelBuffer> pixels = PixelBuffer::Allocate(pixelCount * 4 * (isHdr ? sizeof(uint16_t) : sizeof(uint8_t)));
+    if (!pixels) {
+        return false;
+    }
     if (isHdr) {
-        // HDR: Read as RGBA16F (half float)
-        // NASA Standard: Check for overflow before allocation
-        const uint64_t pixelCount = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
-        const uint64_t pixelDataSize = pixelCount * 4 * sizeof(uint16_t);
+        PixelConvert::FloatToHalf(rgba.data(), reinterpret_cast<uint16_t*>(pixels->data()), pixelCount * 4);
+    } else {
+        PixelConvert::FloatToUnorm8(rgba.data(), pixels->data(), pixelCount * 4);
+    }
+    out.pixels = std::move(pixels);
+
+    out.filePath = filePath;
+    out.width = static_cast<uint32_t>(previewWidth);
+    out.height = static_cast<uint32_t>(previewHeight);
+    out.isHdr = isHdr;
+    out.channels = 4;
+    out.isPreview = true;
+    out.fullWidth = static_cast<uint32_t>(spec.width);
+    out.fullHeight = static_cast<uint32_t>(spec.height);
+    out.orientation = std::clamp(spec.get_int_attribute("Orientation", 1), 1, 8);
+    return true;
+}
+
+bool ResizeImageToFit(ImageData& image, uint32_t maxSide, std::string& error) {
+    const uint32_t longSide = std::max(image.width, image.height);
+    if (maxSide == 0 || longSide <= maxSide) {
+        return true;
+    }
+    if (!image.pixels) {
+        error = "Only decoded pixels can be scaled.";
+        return false;
+    }
+    const double scale = static_cast<double>(maxSide) / static_cast<double>(longSide);
+    const int width = std::max(1, static_cast<int>(image.width * scale + 0.5));
+    const int height = std::max(1, static_cast<int>(image.height * scale + 0.5));
+    const OIIO::TypeDesc format = image.isHdr ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8;
+
+    const OIIO::ImageSpec sourceSpec(static_cast<int>(image.width), static_cast<int>(image.height), 4, format);
+    // OIIO wants a mutable pointer but only reads the source
+    const OIIO::ImageBuf source(sourceSpec, const_cast<uint8_t*>(image.pixels->data()));
+    OIIO::ImageBuf scaled(OIIO::ImageSpec(width, height, 4, format));
+    if (!OIIO::ImageBufAlgo::resize(scaled, source)) {
+        error = "Resize failed: " + scaled.geterror();
+        return false;
+    }
+
+    std::shared_ptr<PixelBuffer> pixels = PixelBuffer::Allocate(static_cast<size_t>(width) * height * 4 * format.size());
+    if (!pixels) {
+        error = "Out of memory for the scaled image.";
+        return false;
+    }
+    if (!scaled.get_pixels(scaled.roi(), format, pixels->data())) {
+        error = "Resize failed: " + scaled.geterror();
+        return false;
+    }
+    image.pixels = std::move(pixels);
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    return true;
+}
+
+// Number of neighbours decoded ahead in the direction of travel
+constexpr int kPrefetchDepth = 3;
+
+// On screen, possibly still as a preview
+static bool IsShowingImage(const std::wstring& filePath) {
+    return g_ctx.imageData.isValid() && !g_ctx.imageData.filePath.empty() &&
+           _wcsicmp(g_ctx.imageData.filePath.c_str(), filePath.c_str()) == 0;
+}
+
+// On screen at full resolution
+static bool IsCurrentImage(const std::wstring& filePath) {
+    return IsShowingImage(filePath) && !g_ctx.imageData.isPreview;
+}
+
+DecodeOptions CurrentDecodeOptions() {
+    DecodeOptions options;
+    if (g_ctx.renderer) {
+        options.allowPaged = g_ctx.renderer->SupportsSparseTextures();
+        options.gpuColor = g_ctx.renderer->SupportsColorLut();
+        options.mappedRows = g_ctx.renderer->SupportsRowSources();
+    }
+    return options;
+}
+
+void UploadCurrentImage() {
+    if (!g_ctx.renderer || !g_ctx.imageData.isValid()) {
+        return;
+    }
+    // A new image ends a flipbook; the renderer would end its ring anyway
+    StopSequencePlayback(false);
+    const ImageData& image = g_ctx.imageData;
+
+    // Queued behind the texture below, so the outgoing image keeps its own transform
+    if (image.displayLut) {
+        const ColorLut::Lut3D& lut = *image.displayLut;
+        g_ctx.renderer->SetColorLut(lut.rgba.data(), lut.edgeLength, lut.log2Min, lut.log2Max, lut.id);
+    } else {
+        g_ctx.renderer->SetColorLut(nullptr, 0, 0.0f, 0.0f, 0);
+    }
+
+    if (image.paged) {
+        g_ctx.renderer->UpdateImageFromSource(image.paged.get(), image.width, image.height, image.isHdr);
+    } else if (image.mapped) {
+        // Past the dense limit the rows path declines and the sparse texture reads tiles instead
+        if (!g_ctx.renderer->UpdateImageFromRows(image.mapped.get(), image.width, image.height, image.isHdr)) {
+            g_ctx.renderer->UpdateImageFromSource(image.mapped.get(), image.width, image.height, image.isHdr);
+        }
+    } else {
+        g_ctx.renderer->UpdateImageFromData(image.pixels->data(), image.width, image.height, image.isHdr);
+    }
+    if (g_ctx.renderer->TakeUploadFailure()) {
+        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_WARNING, "Image Display Error",
+                                 "Not enough video memory to show this image.", g_ctx.window);
+    }
+}
+
+// Main thread: install a decoded image and upload it to the GPU
+static void ApplyDecodedImage(ImageData&& image, const std::wstring& filePath, bool success, const std::string& error) {
+    // The pixels being replaced may be freed below; stop any upload still reading them
+    if (g_ctx.renderer) {
+        g_ctx.renderer->CancelPendingUpload();
+    }
+
+    // Full resolution replacing its own preview keeps the zoom, pan and rotation in place;
+    // the preview laid out at the full image's size, so nothing on screen moves
+    const bool refining = success && !image.isPreview && g_ctx.imageData.isPreview && IsShowingImage(filePath);
+    // Exposure and gamma are viewing settings: they stay put while flipping through images
+    const float exposure = g_ctx.imageData.exposure;
+    const float gamma = g_ctx.imageData.gamma;
+
+    // Keep the image we're leaving around for the trip back; a save still writing its
+    // pixels holds its own reference to them
+    if (g_ctx.imageLoader && g_ctx.imageData.isValid() && !g_ctx.imageData.filePath.empty() &&
+        !g_ctx.imageData.isPreview && !IsCurrentImage(filePath)) {
+        g_ctx.imageLoader->Cache().Put(g_ctx.imageData.filePath, std::move(g_ctx.imageData));
+    }
+
+    g_ctx.imageData = std::move(image);
+    g_ctx.imageData.exposure = exposure;
+    g_ctx.imageData.gamma = gamma;
+    g_ctx.currentFilePathOverride.clear();
+    RequestRedraw();
+
+    if (!success) {
+        g_ctx.imageData.clear();
+        Logger::WarnW(L"Image load failed: %ls", filePath.c_str());
+        if (!error.empty()) {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_WARNING, "Image Load Error",
+                                     ("Failed to open image: " + error).c_str(), g_ctx.window);
+        }
+        CenterImage(true);
+        return;
+    }
+
+    // Upload to Vulkan if renderer exists and image data is valid
+    if (g_ctx.renderer && g_ctx.imageData.isValid()) {
+#ifdef HAVE_DATADOG
+        auto uploadSpan = Logger::CreateSpan("vulkan.upload");
+#endif
+        UploadCurrentImage();
+    }
+
+    if (!refining) {
+        CenterImage(true);
+    }
+}
+
+void LoadImageFromFile(const wchar_t* filePath) {
+    // NASA Standard: Validate all input parameters
+    if (filePath == nullptr) {
+        return;
+    }
+
+    if (g_ctx.imageLoader && g_ctx.imageLoader->IsRunning()) {
+        // Still displayed and resident on the GPU: nothing to do
+        if (IsCurrentImage(filePath)) {
+            g_ctx.imageLoader->Cancel();
+            return;
+        }
+        // Its preview is up and the full decode is still running: let it finish
+        if (IsShowingImage(filePath) && g_ctx.imageLoader->IsBusy()) {
+            return;
+        }
+
+        // Cached neighbour: drop any older request and only pay for the upload
+        ImageData cached;
+        if (g_ctx.imageLoader->Cache().Take(filePath, cached)) {
+            g_ctx.imageLoader->Cancel();
+            ApplyDecodedImage(std::move(cached), filePath, true, std::string());
+            return;
+        }
+
+        // Decode on the background worker; the result arrives via HandleImageLoadComplete()
+        g_ctx.imageLoader->Request(filePath);
+        return;
+    }
+
+    // Synchronous fallback when no worker is available
+    ImageData image;
+    std::string error;
+    const bool success = DecodeImageFile(filePath, image, error, nullptr, CurrentDecodeOptions());
+    ApplyDecodedImage(std::move(image), filePath, success, error);
+}
+
+// Startup decodes before the device has said what it supports (see main); a result
+// leaning on something it turned out not to have must be decoded again
+static bool RendererCanShow(const ImageData& image) {
+    if (!g_ctx.renderer) {
+        return true;
+    }
+    if (image.paged && !g_ctx.renderer->SupportsSparseTextures()) {
+        return false;
+    }
+    if (image.mapped && !g_ctx.renderer->SupportsRowSources()) {
+        return false;
+    }
+    return !image.displayLut || g_ctx.renderer->SupportsColorLut();
+}
+
+void HandleImageLoadComplete() {
+    if (!g_ctx.imageLoader) {
+        return;
+    }
+
+    ImageLoader::Result result;
+    if (!g_ctx.imageLoader->TakeResult(result)) {
+        return; // Superseded by a newer request
+    }
+    if (result.success && !RendererCanShow(result.image)) {
+        Logger::InfoW(L"Decoding %ls again for what the renderer supports", result.path.c_str());
+        g_ctx.imageLoader->Request(result.path);
+        return;
+    }
+    ApplyDecodedImage(std::move(result.image), result.path, result.success, result.error);
+}
+
+void CancelImageLoad() {
+    if (g_ctx.imageLoader) {
+        g_ctx.imageLoader->Cancel();
+        g_ctx.imageLoader->CancelPrefetch();
+    }
+}
 
-        if (pixelDataSize > SIZE_MAX || pixelDataSize > 0x40000000) { // 1GB limit
-            OIIO::geterror();
-#ifdef HAVE_DATADOG
-            loadSpan.set_tag("success", "false");
-            loadSpan.set_tag("error", "HDR image data size exceeds limits");
-#endif
-            CenterImage(true);
-            return;
-        }
+void InvalidateCachedImage(const wchar_t* filePath) {
+    if (filePath == nullptr) {
+        return;
+    }
+    if (g_ctx.imageLoader) {
+        g_ctx.imageLoader->Cache().Remove(filePath);
+    }
+    // Force the next LoadImageFromFile to decode the file again
+    if (IsCurrentImage(filePath)) {
+        g_ctx.imageData.filePath.clear();
+    }
+}
 
-        try {
-            g_ctx.imageData.pixels.resize(static_cast<size_t>(pixelDataSize));
-        } catch (const std::bad_alloc& e) {
-            // NASA Standard: Handle memory allocation failure
-            OIIO::geterror();
-#ifdef HAVE_DATADOG
-            loadSpan.set_tag("success", "false");
-            loadSpan.set_tag("error", "Memory allocation failed for HDR pixels");
-#endif
-            CenterImage(true);
-            return;
-        }
+void PrefetchNeighbours(int direction) {
+    if (!g_ctx.imageLoader || g_ctx.imageFiles.size() < 2 || g_ctx.currentImageIndex < 0) {
+        return;
+    }
 
-        std::vector<float> floatPixels;
-        try {
-            floatPixels.resize(static_cast<size_t>(pixelCount * 4), 1.0f);
-        } catch (const std::bad_alloc& e) {
-            // NASA Standard: Handle memory allocation failure
-            OIIO::geterror();
-#ifdef HAVE_DATADOG
-            loadSpan.set_tag("success", "false");
-            loadSpan.set_tag("error", "Memory allocation failed for float pixels");
-#endif
-            g_ctx.imageData.clear();
-            CenterImage(true);
-            return;
-        }
+    // NASA Standard: Bound prefetch depth by what the cache can actually hold
+    const int count = static_cast<int>(g_ctx.imageFiles.size());
+    int depth = std::min(kPrefetchDepth, count - 1);
+    const uint64_t imageBytes = ImageCache::SizeOf(g_ctx.imageData);
+    if (imageBytes > 0) {
+        const uint64_t fits = g_ctx.imageLoader->Cache().GetBudget() / imageBytes;
+        depth = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(depth), fits > 1 ? fits - 1 : 0));
+    }
 
-        // Read image with proper channel handling - ensure we get RGBA
-        bool readSuccess = false;
+    const int step = direction < 0 ? -1 : 1;
+    std::vector<std::wstring> paths;
+    for (int k = 1; k <= depth; ++k) {
+        const int index = ((g_ctx.currentImageIndex + step * k) % count + count) % count;
+        paths.push_back(g_ctx.imageFiles[index]);
+    }
+    g_ctx.imageLoader->Prefetch(paths);
+}
 
-        // First try to read as RGBA directly
-        if (spec.nchannels >= 4) {
-            readSuccess = in->read_image(0, 0, 0, 4, OIIO::TypeDesc::FLOAT, floatPixels.data());
-        } else {
-            // For images with fewer channels, read and expand to RGBA
-            std::vector<float> tempPixels(width * height * spec.nchannels);
-            if (in->read_image(0, 0, 0, spec.nchannels, OIIO::TypeDesc::FLOAT, tempPixels.data())) {
-                // Convert to RGBA format
-                for (uint32_t y = 0; y < height; ++y) {
-                    for (uint32_t x = 0; x < width; ++x) {
-                        uint32_t srcIdx = (y * width + x) * spec.nchannels;
-                        uint32_t dstIdx = (y * width + x) * 4;
-
-                        // Copy RGB channels
-                        floatPixels[dstIdx + 0] = (spec.nchannels > 0) ? tempPixels[srcIdx + 0] : 0.0f; // R
-                        floatPixels[dstIdx + 1] = (spec.nchannels > 1) ? tempPixels[srcIdx + 1] : 0.0f; // G
-                        floatPixels[dstIdx + 2] = (spec.nchannels > 2) ? tempPixels[srcIdx + 2] : 0.0f; // B
-                        floatPixels[dstIdx + 3] = (spec.nchannels > 3) ? tempPixels[srcIdx + 3] : 1.0f; // A
-                    }
-                }
-                readSuccess = true;
-            }
-        }
+// Listing order: Explorer's natural sort, so frame_9 comes before frame_10
+static bool ListingLess(const std::wstring& a, const std::wstring& b) {
+    return StrCmpLogicalW(a.c_str(), b.c_str()) < 0;
+}
 
-        if (readSuccess) {
-            // Clear any potential read warnings
-            OIIO::geterror();
-            // Apply color space conversion if processor exists and is safe
-            if (processor) {
-                try {
-                    // Validate pixel data before color conversion
-                    bool validPixelData = true;
-                    for (size_t i = 0; i < std::min(size_t(100), floatPixels.size()); i += 4) {
-                        if (!std::isfinite(floatPixels[i]) || !std::isfinite(floatPixels[i+1]) || 
-                            !std::isfinite(floatPixels[i+2]) || !std::isfinite(floatPixels[i+3])) {
-                            validPixelData = false;
-                            break;
-                        }
-                    }
+static bool ListingEqual(const std::wstring& a, const std::wstring& b) {
+    return _wcsicmp(a.c_str(), b.c_str()) == 0;
+}
 
-                    if (validPixelData) {
-                        OCIO::PackedImageDesc imgDesc(floatPixels.data(), width, height, 4, 
-                                                    OCIO::BIT_DEPTH_F32, sizeof(float) * 4, 0, 0);
-                        OCIO::ConstCPUProcessorRcPtr cpuProcessor = processor->getDefaultCPUProcessor();
-                        if (cpuProcessor) {
-                            cpuProcessor->apply(imgDesc);
-                        }
-                    }
-                } catch (const OCIO::Exception& e) {
-                    // Color conversion failed, continue without it
-                } catch (...) {
-                    // Any other exception, skip color conversion
-                }
-            }
+// Position 'path' holds, or would hold, in the sorted listing
+static size_t ListingPosition(const std::wstring& path, bool& found) {
+    auto it = std::lower_bound(g_ctx.imageFiles.begin(), g_ctx.imageFiles.end(), path, ListingLess);
+    found = (it != g_ctx.imageFiles.end() && ListingEqual(*it, path));
+    return static_cast<size_t>(std::distance(g_ctx.imageFiles.begin(), it));
+}
 
-            // Convert float to half precision for GPU storage
-            uint16_t* halfPixels = reinterpret_cast<uint16_t*>(g_ctx.imageData.pixels.data());
-            for (size_t i = 0; i < floatPixels.size(); ++i) {
-                // Use proper IEEE 754 half conversion
-                float val = floatPixels[i];
-                uint32_t bits = *(uint32_t*)&val;
-
-                uint32_t sign = (bits >> 31) & 0x1;
-                int32_t exp = ((bits >> 23) & 0xff) - 127 + 15;
-                uint32_t mantissa = (bits >> 13) & 0x3ff;
-
-                if (exp <= 0) {
-                    halfPixels[i] = static_cast<uint16_t>(sign << 15);
-                } else if (exp >= 31) {
-                    halfPixels[i] = static_cast<uint16_t>((sign << 15) | 0x7c00);
-                } else {
-                    halfPixels[i] = static_cast<uint16_t>((sign << 15) | (exp << 10) | mantissa);
-                }
-            }
-        }
-    } else {
-        // LDR: Read as RGBA8 sRGB
-        size_t pixelDataSize = width * height * 4 * sizeof(uint8_t);
-        g_ctx.imageData.pixels.resize(pixelDataSize);
+static void SetCurrentIndexFromPath(const std::wstring& path) {
+    bool found = false;
+    const size_t position = path.empty() ? 0 : ListingPosition(path, found);
+    g_ctx.currentImageIndex = found ? static_cast<int>(position) : -1;
+}
 
-        std::vector<float> floatPixels(width * height * 4, 1.0f);
+void NavigateImage(int direction) {
+    if (g_ctx.imageFiles.empty()) {
+        return;
+    }
 
-        // Read image with proper channel handling - ensure we get RGBA
-        bool readSuccess = false;
+    const int count = static_cast<int>(g_ctx.imageFiles.size());
+    const int step = direction < 0 ? -1 : 1;
+    if (g_ctx.currentImageIndex < 0 && !g_ctx.imageData.filePath.empty()) {
+        // Displayed file left the listing: step from where it would have been
+        bool found = false;
+        const int position = static_cast<int>(ListingPosition(g_ctx.imageData.filePath, found));
+        g_ctx.currentImageIndex = step > 0 ? position - 1 : position;
+    }
+    g_ctx.currentImageIndex = ((g_ctx.currentImageIndex + step) % count + count) % count;
+    LoadImageFromFile(g_ctx.imageFiles[g_ctx.currentImageIndex].c_str());
+    PrefetchNeighbours(step);
+}
 
-        // First try to read as RGBA directly
-        if (spec.nchannels >= 4) {
-            readSuccess = in->read_image(0, 0, 0, 4, OIIO::TypeDesc::FLOAT, floatPixels.data());
-        } else {
-            // For images with fewer channels, read and expand to RGBA
-            std::vector<float> tempPixels(width * height * spec.nchannels);
-            if (in->read_image(0, 0, 0, spec.nchannels, OIIO::TypeDesc::FLOAT, tempPixels.data())) {
-                // Convert to RGBA format
-                for (uint32_t y = 0; y < height; ++y) {
-                    for (uint32_t x = 0; x < width; ++x) {
-                        uint32_t srcIdx = (y * width + x) * spec.nchannels;
-                        uint32_t dstIdx = (y * width + x) * 4;
-
-                        // Copy RGB channels
-                        floatPixels[dstIdx + 0] = (spec.nchannels > 0) ? tempPixels[srcIdx + 0] : 0.0f; // R
-                        floatPixels[dstIdx + 1] = (spec.nchannels > 1) ? tempPixels[srcIdx + 1] : 0.0f; // G
-                        floatPixels[dstIdx + 2] = (spec.nchannels > 2) ? tempPixels[srcIdx + 2] : 0.0f; // B
-                        floatPixels[dstIdx + 3] = (spec.nchannels > 3) ? tempPixels[srcIdx + 3] : 1.0f; // A
-                    }
-                }
-                readSuccess = true;
-            }
-        }
+void OpenImageAt(int index) {
+    // NASA Standard: Validate all bounds and indices
+    if (index < 0 || index >= static_cast<int>(g_ctx.imageFiles.size())) {
+        return;
+    }
+    if (index == g_ctx.currentImageIndex && g_ctx.imageData.isValid()) {
+        return;
+    }
 
-        if (readSuccess) {
-            // Clear any potential read warnings
-            OIIO::geterror();
-            // Apply color space conversion if processor exists
-            if (processor) {
-                try {
-                    OCIO::PackedImageDesc imgDesc(floatPixels.data(), width, height, 4, 
-                                                OCIO::BIT_DEPTH_F32, sizeof(float) * 4, 0, 0);
-                    OCIO::ConstCPUProcessorRcPtr cpuProcessor = processor->getDefaultCPUProcessor();
-                    cpuProcessor->apply(imgDesc);
-                } catch (const OCIO::Exception& e) {
-                    // Color conversion failed, continue without it
-                }
-            }
+    const int step = index >= g_ctx.currentImageIndex ? 1 : -1;
+    g_ctx.currentImageIndex = index;
+    LoadImageFromFile(g_ctx.imageFiles[index].c_str());
+    PrefetchNeighbours(step);
+}
 
-            // Convert to 8-bit RGBA
-            uint8_t* bytePixels = g_ctx.imageData.pixels.data();
-            for (size_t i = 0; i < floatPixels.size(); ++i) {
-                float val = clamp(floatPixels[i], 0.0f, 1.0f);
-                bytePixels[i] = static_cast<uint8_t>(val * 255.0f + 0.5f);
-            }
-        } else {
-            g_ctx.imageData.clear();
-        }
+bool StartSequencePlayback() {
+    if (!g_ctx.sequencePlayer || !g_ctx.renderer || g_ctx.sequencePlayer->IsPlaying()) {
+        return false;
+    }
+    size_t first = 0;
+    std::vector<std::wstring> frames = SequencePlayer::FindSequence(g_ctx.imageFiles, g_ctx.currentImageIndex, first);
+    if (frames.empty()) {
+        Logger::Info("Sequence: the current image is not one of a numbered sequence");
+        return false;
     }
 
-    in->close();
+    // Loads and prefetches of stills would compete with the frame decodes
+    CancelImageLoad();
+    DecodeOptions options;
+    options.gpuColor = g_ctx.renderer->SupportsColorLut();
+    if (!g_ctx.sequencePlayer->Play(std::move(frames), first, options)) {
+        return false;
+    }
+    RequestRedraw();
+    return true;
+}
 
-    // Clear any errors from image processing operations
-    OIIO::geterror();
+void StopSequencePlayback(bool openShownFrame) {
+    if (!IsSequencePlaying()) {
+        return;
+    }
+    const std::wstring shown = g_ctx.sequencePlayer->GetShownPath();
+    g_ctx.sequencePlayer->Stop(g_ctx.renderer.get());
+    RequestRedraw();
+    if (!openShownFrame || shown.empty()) {
+        return;
+    }
 
-    // Upload to Vulkan if renderer exists and image data is valid
-    if (g_ctx.renderer && g_ctx.imageData.isValid()) {
-#ifdef HAVE_DATADOG
-        auto uploadSpan = Logger::CreateChildSpan(loadSpan, "vulkan.upload");
-#endif
-        g_ctx.renderer->UpdateImageFromData(
-            g_ctx.imageData.pixels.data(),
-            g_ctx.imageData.width,
-            g_ctx.imageData.height,
-            g_ctx.imageData.isHdr
-        );
+    // The frame stays on screen from the ring; opening it makes it the image to zoom, save and step from
+    bool found = false;
+    const size_t position = ListingPosition(shown, found);
+    if (found) {
+        OpenImageAt(static_cast<int>(position));
     }
-    
-#ifdef HAVE_DATADOG
-    loadSpan.set_tag("success", "true");
-#endif
-    CenterImage(true);
+}
+
+bool IsSequencePlaying() {
+    return g_ctx.sequencePlayer && g_ctx.sequencePlayer->IsPlaying();
 }
 
 void GetImagesInDirectory(const wchar_t* filePath) {
@@ -511,8 +1095,6 @@ void GetImagesInDirectory(const wchar_t* filePath) {
     dirSpan.set_tag("file_path", utf8Path);
 #endif
 
-    g_ctx.imageFiles.clear();
-
     // NASA Standard: Validate string length before copying
     size_t pathLength = wcsnlen(filePath, MAX_PATH);
     if (pathLength >= MAX_PATH) {
@@ -533,35 +1115,29 @@ void GetImagesInDirectory(const wchar_t* filePath) {
     }
 
     PathRemoveFileSpecW(folder);
+    const std::wstring path(filePath);
 
-    WIN32_FIND_DATAW fd{};
-    wchar_t searchPath[MAX_PATH] = { 0 };
-    if (!PathCombineW(searchPath, folder, L"*.*")) {
-#ifdef HAVE_DATADOG
-        dirSpan.set_tag("success", "false");
-        dirSpan.set_tag("error", "Path combination failed");
-#endif
-        return; // Path combination failed
-    }
+    if (g_ctx.directoryIndexer && g_ctx.directoryIndexer->IsRunning()) {
+        // Same folder: the watch has kept the listing current, only the cursor moves
+        if (_wcsicmp(g_ctx.directoryIndexer->GetFolder().c_str(), folder) != 0) {
+            g_ctx.imageFiles.clear();
+            g_ctx.directoryIndexer->Index(folder);
+        }
 
-    HANDLE hFind = FindFirstFileW(searchPath, &fd);
-    if (hFind != INVALID_HANDLE_VALUE) {
-        do {
-            if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-                wchar_t fullPath[MAX_PATH] = { 0 };
-                PathCombineW(fullPath, folder, fd.cFileName);
-                if (IsImageFile(fullPath)) {
-                    g_ctx.imageFiles.push_back(fullPath);
-                }
-            }
-        } while (FindNextFileW(hFind, &fd));
-        FindClose(hFind);
+        // The opened file is navigable right away; the rest streams in via HandleDirectoryChanges()
+        bool found = false;
+        const size_t position = ListingPosition(path, found);
+        if (!found && DirectoryIndexer::IsCandidate(path)) {
+            g_ctx.imageFiles.insert(g_ctx.imageFiles.begin() + position, path);
+        }
+        SetCurrentIndexFromPath(path);
+    } else {
+        // Synchronous fallback when no worker is available
+        g_ctx.imageFiles.clear();
+        DirectoryIndexer::ScanFolder(folder, g_ctx.imageFiles);
+        std::sort(g_ctx.imageFiles.begin(), g_ctx.imageFiles.end(), ListingLess);
+        SetCurrentIndexFromPath(path);
     }
-
-    auto it = std::find_if(g_ctx.imageFiles.begin(), g_ctx.imageFiles.end(),
-        [&](const std::wstring& s) { return _wcsicmp(s.c_str(), filePath) == 0; }
-    );
-    g_ctx.currentImageIndex = (it != g_ctx.imageFiles.end()) ? static_cast<int>(std::distance(g_ctx.imageFiles.begin(), it)) : -1;
     
 #ifdef HAVE_DATADOG
     dirSpan.set_tag("success", "true");
@@ -570,6 +1146,74 @@ void GetImagesInDirectory(const wchar_t* filePath) {
 #endif
 }
 
+void HandleDirectoryChanges() {
+    std::vector<DirectoryIndexer::Change> changes;
+    if (!g_ctx.directoryIndexer || !g_ctx.directoryIndexer->TakeChanges(changes)) {
+        return;
+    }
+
+    // Re-find the current entry afterwards; insertions and removals shift indices
+    const bool haveCurrent = g_ctx.currentImageIndex >= 0 &&
+                             g_ctx.currentImageIndex < static_cast<int>(g_ctx.imageFiles.size());
+    const std::wstring current = haveCurrent ? g_ctx.imageFiles[g_ctx.currentImageIndex] : g_ctx.imageData.filePath;
+    const size_t previousCount = g_ctx.imageFiles.size();
+
+    // Streamed batches are merged in bulk rather than inserted one at a time
+    auto& files = g_ctx.imageFiles;
+    std::vector<std::wstring> added;
+    auto flushAdded = [&] {
+        if (added.empty()) return;
+        std::sort(added.begin(), added.end(), ListingLess);
+        const size_t middle = files.size();
+        files.insert(files.end(), std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()));
+        std::inplace_merge(files.begin(), files.begin() + middle, files.end(), ListingLess);
+        files.erase(std::unique(files.begin(), files.end(), ListingEqual), files.end());
+        added.clear();
+    };
+
+    for (auto& change : changes) {
+        switch (change.kind) {
+            case DirectoryIndexer::Change::Kind::Reset:
+                added.clear();
+                files.clear();
+                break;
+
+            case DirectoryIndexer::Change::Kind::Added:
+                added.push_back(std::move(change.path));
+                break;
+
+            case DirectoryIndexer::Change::Kind::Modified:
+                InvalidateCachedImage(change.path.c_str());
+                if (g_ctx.thumbnailGrid) g_ctx.thumbnailGrid->Invalidate(change.path);
+                // A file still being copied in may only now pass the filter
+                added.push_back(std::move(change.path));
+                break;
+
+            case DirectoryIndexer::Change::Kind::Removed: {
+                flushAdded();
+                bool found = false;
+                const size_t position = ListingPosition(change.path, found);
+                if (found) {
+                    files.erase(files.begin() + position);
+                    InvalidateCachedImage(change.path.c_str());
+                    if (g_ctx.thumbnailGrid) g_ctx.thumbnailGrid->Invalidate(change.path);
+                }
+                break;
+            }
+        }
+    }
+    flushAdded();
+
+    SetCurrentIndexFromPath(current);
+    if (files.size() != previousCount) {
+        PrefetchNeighbours(+1);
+    }
+    // The grid and filmstrip draw the listing itself
+    if (g_ctx.thumbnailGrid && g_ctx.thumbnailGrid->GetMode() != ThumbnailGrid::Mode::Off) {
+        RequestRedraw();
+    }
+}
+
 void DeleteCurrentImage() {
 #ifdef HAVE_DATADOG
     auto deleteSpan = Logger::CreateSpan("image.delete");
@@ -668,13 +1312,16 @@ void DeleteCurrentImage() {
 #ifdef HAVE_DATADOG
             deleteSpan.set_tag("success", "true");
 #endif
+            InvalidateCachedImage(pFromBuffer.data());
             g_ctx.imageFiles.erase(g_ctx.imageFiles.begin() + g_ctx.currentImageIndex);
             if (g_ctx.imageFiles.empty()) {
+                CancelImageLoad();
+                if (g_ctx.renderer) {
+                    g_ctx.renderer->CancelPendingUpload();
+                }
                 g_ctx.imageData.clear();
                 g_ctx.currentImageIndex = -1;
-                if (g_ctx.window) {
-                    // SDL3 will trigger a redraw automatically
-                }
+                RequestRedraw();
             }
             else {
                 if (g_ctx.currentImageIndex >= static_cast<int>(g_ctx.imageFiles.size())) {
@@ -707,62 +1354,139 @@ void DeleteCurrentImage() {
     }
 }
 
-// Helper function to get rendered image data from Vulkan renderer
-static std::vector<uint8_t> GetRenderedImageData(uint32_t& outWidth, uint32_t& outHeight) {
-    if (!g_ctx.renderer || !g_ctx.imageData.isValid()) {
-        return {};
+// Mapped images keep their texels in the file, but saving and copying need them in
+// memory. Converts them once and re-uploads from the copy, which also releases the
+// mapping so the file can be replaced in place.
+static bool ResolveMappedPixels() {
+    ImageData& image = g_ctx.imageData;
+    if (!image.mapped) {
+        return true;
+    }
+    const size_t pixelSize = image.isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    std::shared_ptr<PixelBuffer> pixels = PixelBuffer::Allocate(static_cast<size_t>(image.width) * image.height * pixelSize);
+    if (!pixels || !image.mapped->ReadRows(0, image.height, pixels->data())) {
+        return false;
     }
+    image.pixels = std::move(pixels);
+    // The renderer may still read the mapping; it moves to the copy before the mapping goes
+    std::shared_ptr<MappedImage> mapped = std::move(image.mapped);
+    image.mapped.reset();
+    UploadCurrentImage();
+    return true;
+}
 
-    // Get the current viewport dimensions for rendering
-    outWidth = g_ctx.imageData.width;
-    outHeight = g_ctx.imageData.height;
+static void ShowSaveError(const char* title, const std::string& message) {
+#ifdef _WIN32
+    HWND hwnd = GetHWNDFromSDL();
+    MessageBoxA(hwnd, message.c_str(), title, MB_ICONERROR);
+#else
+    SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, title, message.c_str(), g_ctx.window);
+#endif
+}
 
-    // Apply rotation to dimensions
-    if (g_ctx.rotationAngle == 90 || g_ctx.rotationAngle == 270) {
-        std::swap(outWidth, outHeight);
+// Point 'job' at the displayed pixels, oriented as on screen. Fails for images
+// that are never fully in memory (paged) and for previews, which are not the real pixels.
+static bool PrepareSaveJob(ImageSaver::Job& job) {
+    ImageData& image = g_ctx.imageData;
+    if (!image.isValid() || image.isPreview || !ResolveMappedPixels() || !image.pixels) {
+        return false;
+    }
+    job.sourcePath = image.filePath;
+    job.pixels = image.pixels->data();
+    job.owner = image.pixels;
+    // Left unconverted for the GPU: exports go through the same transform the screen does
+    if (image.displayLut && image.colorTransform) {
+        job.colorProcessor = CreateCpuProcessor(image.colorTransform);
     }
+    job.width = image.width;
+    job.height = image.height;
+    job.isHdr = image.isHdr;
+    job.rotation = DisplayRotation();
+    job.mirrored = DisplayMirrored();
+    // Format and metadata are filled in by the caller
+    const bool sideways = job.rotation % 180 != 0;
+    job.spec = OIIO::ImageSpec(static_cast<int>(sideways ? image.height : image.width),
+                               static_cast<int>(sideways ? image.width : image.height), 4, OIIO::TypeDesc::UINT8);
+    return true;
+}
 
-    // For now, return the source image data
-    // In a full implementation, you would render the current view to a buffer
-    std::vector<uint8_t> result;
+// Main thread: swap a finished temporary over the original and show the saved file
+static void FinishSave(const ImageSaver::Result& result) {
+    const ImageSaver::Job& job = result.job;
+    const bool replacing = !job.replacePath.empty();
+    if (!result.success) {
+        if (replacing) {
+            DeleteFileW(job.targetPath.c_str());
+        }
+        std::string message = replacing ? "Failed to save image to temporary file." : "Failed to save image.";
+        if (!result.error.empty()) {
+            message += "\n" + result.error;
+        }
+        ShowSaveError(replacing ? "Save Error" : "Save As Error", message);
+        return;
+    }
 
-    if (g_ctx.imageData.isHdr) {
-        // Convert HDR to LDR for saving
-        size_t pixelCount = outWidth * outHeight * 4;
-        result.resize(pixelCount);
+    const std::wstring& savedPath = replacing ? job.replacePath : job.targetPath;
+    if (replacing &&
+        !ReplaceFileW(job.replacePath.c_str(), job.targetPath.c_str(), nullptr, REPLACEFILE_IGNORE_MERGE_ERRORS,
+                      nullptr, nullptr)) {
+        DeleteFileW(job.targetPath.c_str());
+        ShowSaveError("Save Error", "Failed to replace the original file.");
+        return;
+    }
+    InvalidateCachedImage(savedPath.c_str());
 
-        const uint16_t* halfPixels = reinterpret_cast<const uint16_t*>(g_ctx.imageData.pixels.data());
+    // The user may have moved on while it was written; only the image saved is refreshed
+    if (IsShowingImage(job.sourcePath)) {
+        LoadImageFromFile(savedPath.c_str());
+        if (replacing) {
+            g_ctx.rotationAngle = 0;
+        } else {
+            GetImagesInDirectory(savedPath.c_str());
+        }
+    }
+    RequestRedraw();
+}
 
-        for (size_t i = 0; i < pixelCount; ++i) {
-            // Convert half to float then to 8-bit
-            uint16_t halfVal = halfPixels[i];
-            uint32_t sign = (halfVal >> 15) & 0x1;
-            uint32_t exp = (halfVal >> 10) & 0x1f;
-            uint32_t mantissa = halfVal & 0x3ff;
+// Write on the save worker, or right here when it is unavailable
+static void SubmitSave(const ImageSaver::Job& job) {
+    if (g_ctx.imageSaver && g_ctx.imageSaver->IsRunning()) {
+        if (!g_ctx.imageSaver->Submit(job)) {
+            ShowSaveError("Save Error", "Another save is still in progress.");
+            return;
+        }
+        RequestRedraw();
+        return;
+    }
 
-            float floatVal;
-            if (exp == 0) {
-                floatVal = (sign ? -1.0f : 1.0f) * (mantissa / 1024.0f) * std::pow(2.0f, -14.0f);
-            } else if (exp == 31) {
-                floatVal = (mantissa == 0) ? (sign ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity()) : std::numeric_limits<float>::quiet_NaN();
-            } else {
-                floatVal = (sign ? -1.0f : 1.0f) * (1.0f + mantissa / 1024.0f) * std::pow(2.0f, static_cast<float>(exp - 15));
-            }
+    ImageSaver::Result result;
+    result.job = job;
+    result.success = ImageSaver::Write(job, result.error);
+    result.job.pixels = nullptr;
+    result.job.owner.reset();
+    FinishSave(result);
+}
 
-            // Tone mapping for display (simple Reinhard)
-            floatVal = floatVal / (1.0f + floatVal);
-            result[i] = static_cast<uint8_t>(clamp(floatVal * 255.0f, 0.0f, 255.0f));
-        }
-    } else {
-        result = g_ctx.imageData.pixels;
+static bool SaveInProgress() {
+    if (g_ctx.imageSaver && g_ctx.imageSaver->IsBusy()) {
+        ShowSaveError("Save", "Another save is still in progress.");
+        return true;
     }
+    return false;
+}
 
-    return result;
+void HandleSaveEvent() {
+    ImageSaver::Result result;
+    if (g_ctx.imageSaver && g_ctx.imageSaver->TakeResult(result)) {
+        FinishSave(result);
+    }
+    // Progress shows in the HUD
+    RequestRedraw();
 }
 
 void SaveImageAs() {
     // NASA Standard: Validate image data state
-    if (!g_ctx.imageData.isValid()) {
+    if (!g_ctx.imageData.isValid() || SaveInProgress()) {
         return;
     }
 
@@ -782,83 +1506,16 @@ void SaveImageAs() {
 
     if (!GetSaveFileNameW(&ofn)) return;
 
-    std::string utf8Path = wstring_to_utf8(ofn.lpstrFile);
-
-    // Determine if we should save as HDR based on file extension
-    std::string lowerPath = utf8Path;
-    std::transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(), ::tolower);
-    bool saveAsHdr = (lowerPath.find(".exr") != std::string::npos || 
-                      lowerPath.find(".hdr") != std::string::npos ||
-                      lowerPath.find(".tiff") != std::string::npos);
-
-    uint32_t width, height;
-    std::vector<uint8_t> imageData = GetRenderedImageData(width, height);
-
-    if (imageData.empty()) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not get image data to save.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not get image data to save.", g_ctx.window);
-#endif
-        return;
-    }
-
-    auto out = OIIO::ImageOutput::create(utf8Path);
-    if (!out) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not create output file.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not create output file.", g_ctx.window);
-#endif
-        return;
-    }
-
-    OIIO::ImageSpec spec(width, height, 4, saveAsHdr ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8);
-
-    // Set color space metadata
-    if (saveAsHdr) {
-        spec.attribute("oiio:ColorSpace", std::string("Linear"));
-    } else {
-        spec.attribute("oiio:ColorSpace", std::string("sRGB"));
-    }
-
-    if (!out->open(utf8Path, spec)) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not open output file.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not open output file.", g_ctx.window);
-#endif
+    ImageSaver::Job job;
+    if (!PrepareSaveJob(job)) {
+        ShowSaveError("Save Error", "Could not get image data to save.");
         return;
     }
+    job.targetPath = ofn.lpstrFile;
+    // Half-float linear for HDR-capable formats, 8-bit sRGB otherwise
+    ImageSaver::ChooseOutputFormat(job, job.targetPath);
 
-    bool success = false;
-    if (saveAsHdr && g_ctx.imageData.isHdr) {
-        // Save HDR data directly
-        success = out->write_image(OIIO::TypeDesc::HALF, g_ctx.imageData.pixels.data());
-    } else {
-        // Save LDR data
-        success = out->write_image(OIIO::TypeDesc::UINT8, imageData.data());
-    }
-
-    out->close();
-
-    // Clear any save operation errors/warnings
-    OIIO::geterror();
-
-    if (success) {
-        LoadImageFromFile(ofn.lpstrFile);
-        GetImagesInDirectory(ofn.lpstrFile);
-    } else {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Failed to save image.", L"Save As Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save As Error", "Failed to save image.", g_ctx.window);
-#endif
-    }
+    SubmitSave(job);
 }
 
 void SaveImage() {
@@ -876,118 +1533,47 @@ void SaveImage() {
 #endif
         return;
     }
+    if (SaveInProgress()) {
+        return;
+    }
 
     const auto& originalPath = g_ctx.imageFiles[g_ctx.currentImageIndex];
-    std::string utf8Path = wstring_to_utf8(originalPath);
 
-    // Get the original file format
-    auto in = OIIO::ImageInput::open(utf8Path);
-    if (!in) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not open original file to determine format.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not open original file to determine format.", g_ctx.window);
-#endif
+    // The header read at load time says which format to write back
+    const std::shared_ptr<const OIIO::ImageSpec> originalSpec = g_ctx.imageData.sourceSpec;
+    if (!originalSpec) {
+        ShowSaveError("Save Error", "Could not determine the original file's format.");
         return;
     }
 
-    const OIIO::ImageSpec& originalSpec = in->spec();
-    in->close();
-
-    uint32_t width, height;
-    std::vector<uint8_t> imageData = GetRenderedImageData(width, height);
-
-    if (imageData.empty()) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not get image data to save.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not get image data to save.", g_ctx.window);
-#endif
+    ImageSaver::Job job;
+    if (!PrepareSaveJob(job)) {
+        ShowSaveError("Save Error", "Could not get image data to save.");
         return;
     }
 
     // NASA Standard: Validate path length before concatenation
     if (originalPath.length() > MAX_PATH - 20) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"File path too long for temporary file creation.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "File path too long for temporary file creation.", g_ctx.window);
-#endif
+        ShowSaveError("Save Error", "File path too long for temporary file creation.");
         return;
     }
 
-    std::wstring tempPath = originalPath + L".tmp_save";
-    std::string utf8TempPath = wstring_to_utf8(tempPath);
-
-    auto out = OIIO::ImageOutput::create(utf8TempPath);
-    if (!out) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not create output file.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not create output file.", g_ctx.window);
-#endif
-        return;
-    }
+    job.targetPath = originalPath + L".tmp_save";
+    job.replacePath = originalPath;
 
     // Preserve original format characteristics
-    OIIO::ImageSpec spec(width, height, 4, originalSpec.format);
+    job.spec.set_format(originalSpec->format);
 
     // Copy important attributes from original
-    for (const auto& attr : originalSpec.extra_attribs) {
+    for (const auto& attr : originalSpec->extra_attribs) {
         if (attr.name() != "ImageDescription" && attr.name() != "DateTime") {
-            spec.attribute(attr.name(), attr.type(), attr.data());
+            job.spec.attribute(attr.name(), attr.type(), attr.data());
         }
     }
+    // The pixels are written upright, so readers must not turn them again
+    job.spec.attribute("Orientation", 1);
 
-    if (!out->open(utf8TempPath, spec)) {
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Could not open temporary file for writing.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Could not open temporary file for writing.", g_ctx.window);
-#endif
-        return;
-    }
-
-    bool success = false;
-    if (g_ctx.imageData.isHdr && originalSpec.format == OIIO::TypeDesc::HALF) {
-        success = out->write_image(OIIO::TypeDesc::HALF, g_ctx.imageData.pixels.data());
-    } else {
-        success = out->write_image(OIIO::TypeDesc::UINT8, imageData.data());
-    }
-
-    out->close();
-
-    // Clear any save operation errors/warnings
-    OIIO::geterror();
-
-    if (success) {
-        if (ReplaceFileW(originalPath.c_str(), tempPath.c_str(), nullptr, REPLACEFILE_IGNORE_MERGE_ERRORS, nullptr, nullptr)) {
-            LoadImageFromFile(originalPath.c_str());
-            g_ctx.rotationAngle = 0;
-            // SDL3 will trigger a redraw automatically
-        } else {
-            DeleteFileW(tempPath.c_str());
-#ifdef _WIN32
-            HWND hwnd = GetHWNDFromSDL();
-            MessageBoxW(hwnd, L"Failed to replace the original file.", L"Save Error", MB_ICONERROR);
-#else
-            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Failed to replace the original file.", g_ctx.window);
-#endif
-        }
-    } else {
-        DeleteFileW(tempPath.c_str());
-#ifdef _WIN32
-        HWND hwnd = GetHWNDFromSDL();
-        MessageBoxW(hwnd, L"Failed to save image to temporary file.", L"Save Error", MB_ICONERROR);
-#else
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Save Error", "Failed to save image to temporary file.", g_ctx.window);
-#endif
-    }
+    SubmitSave(job);
 }
 
 // UTF-8 wrapper functions for compatibility
@@ -1086,13 +1672,13 @@ void HandleCopy() {
 #endif
     EmptyClipboard();
 
-    uint32_t width, height;
-    std::vector<uint8_t> imageData = GetRenderedImageData(width, height);
-
-    if (imageData.empty()) {
+    ImageSaver::Job job;
+    if (!PrepareSaveJob(job)) {
         CloseClipboard();
         return;
     }
+    const uint32_t width = static_cast<uint32_t>(job.spec.width);
+    const uint32_t height = static_cast<uint32_t>(job.spec.height);
 
     // NASA Standard: Validate dimensions to prevent overflow
     if (width == 0 || height == 0 || width > 65536 || height > 65536) {
@@ -1123,9 +1709,13 @@ void HandleCopy() {
         char* lpGlobal = static_cast<char*>(GlobalLock(hGlobal));
         if (lpGlobal) {
             memcpy(lpGlobal, &bi.bmiHeader, sizeof(BITMAPINFOHEADER));
-            memcpy(lpGlobal + sizeof(BITMAPINFOHEADER), imageData.data(), dwBmpSize);
+            // Oriented, tonemapped and swizzled to BGRA straight into the clipboard's memory
+            uint8_t* dibPixels = reinterpret_cast<uint8_t*>(lpGlobal + sizeof(BITMAPINFOHEADER));
+            const bool converted = ImageSaver::ConvertRows(job, 0, height, dibPixels, static_cast<size_t>(width) * 4, true);
             GlobalUnlock(hGlobal);
-            SetClipboardData(CF_DIB, hGlobal);
+            if (!converted || !SetClipboardData(CF_DIB, hGlobal)) {
+                GlobalFree(hGlobal);
+            }
         }
     }
 
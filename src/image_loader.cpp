@@ -0,0 +1,267 @@
+#include "image_loader.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <utility>
+
+ImageLoader::ImageLoader() = default;
+
+ImageLoader::~ImageLoader() {
+    Shutdown();
+}
+
+bool ImageLoader::Start() {
+    if (running_) return true;
+
+    completionEvent_ = SDL_RegisterEvents(1);
+    if (completionEvent_ == 0) {
+        Logger::Error("ImageLoader: SDL_RegisterEvents failed: %s", SDL_GetError());
+        return false;
+    }
+
+    try {
+        stopping_ = false;
+        worker_ = std::thread(&ImageLoader::workerMain, this);
+    } catch (const std::exception& e) {
+        Logger::Error("ImageLoader: failed to start worker thread: %s", e.what());
+        return false;
+    }
+
+    running_ = true;
+    Logger::Info("ImageLoader: decode worker started");
+    return true;
+}
+
+void ImageLoader::Shutdown() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        hasPending_ = false;
+        prefetchQueue_.clear();
+    }
+    // Abort any decode in flight so join() doesn't wait for a full read
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    prefetchGeneration_.fetch_add(1, std::memory_order_acq_rel);
+    cv_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    running_ = false;
+    busy_.store(false, std::memory_order_release);
+    Logger::Info("ImageLoader: decode worker stopped");
+}
+
+static bool SamePath(const std::wstring& a, const std::wstring& b) {
+    return !a.empty() && _wcsicmp(a.c_str(), b.c_str()) == 0;
+}
+
+uint64_t ImageLoader::Request(const std::wstring& path) {
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        hasCompleted_ = false;
+        completed_ = Result{};
+
+        if (SamePath(prefetchInFlight_, path)) {
+            // Already decoding as a prefetch: adopt it rather than starting over
+            adoptedGeneration_ = generation;
+            hasPending_ = false;
+        } else {
+            adoptedGeneration_ = 0;
+            pendingPath_ = path;
+            pendingGeneration_ = generation;
+            hasPending_ = true;
+            // Foreground work pre-empts any prefetch in flight
+            prefetchGeneration_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+    busy_.store(true, std::memory_order_release);
+    cv_.notify_one();
+    return generation;
+}
+
+void ImageLoader::SetDecodeOptions(const DecodeOptions& options) {
+    bool pathChanged = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pathChanged = options_.gpuColor != options.gpuColor || options_.mappedRows != options.mappedRows;
+        options_ = options;
+    }
+    // Cached neighbours were decoded for the other path
+    if (pathChanged) {
+        cache_.Clear();
+    }
+}
+
+void ImageLoader::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        hasPending_ = false;
+        hasCompleted_ = false;
+        completed_ = Result{};
+        if (adoptedGeneration_ != 0) {
+            adoptedGeneration_ = 0;
+            prefetchGeneration_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+    busy_.store(false, std::memory_order_release);
+}
+
+void ImageLoader::Prefetch(const std::vector<std::wstring>& paths) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prefetchQueue_.clear();
+
+        bool keepInFlight = prefetchInFlight_.empty() || adoptedGeneration_ != 0;
+        for (const auto& path : paths) {
+            if (SamePath(prefetchInFlight_, path)) {
+                keepInFlight = true;
+                continue;
+            }
+            if (!cache_.Contains(path)) {
+                prefetchQueue_.push_back(path);
+            }
+        }
+
+        // The in-flight neighbour is no longer wanted (direction changed or jumped away)
+        if (!keepInFlight) {
+            prefetchGeneration_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+    cv_.notify_one();
+}
+
+void ImageLoader::CancelPrefetch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prefetchQueue_.clear();
+    if (!prefetchInFlight_.empty() && adoptedGeneration_ == 0) {
+        prefetchGeneration_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+bool ImageLoader::TakeResult(Result& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasCompleted_) return false;
+
+    hasCompleted_ = false;
+    if (isStale(completed_.generation)) {
+        completed_ = Result{};
+        return false;
+    }
+
+    out = std::move(completed_);
+    completed_ = Result{};
+    if (!out.isPreview && !hasPending_ && adoptedGeneration_ == 0) {
+        busy_.store(false, std::memory_order_release);
+    }
+    return true;
+}
+
+void ImageLoader::workerMain() {
+    Trace::NameThread("decode");
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || hasPending_ || !prefetchQueue_.empty(); });
+        if (stopping_) return;
+
+        // Foreground requests always win over prefetch
+        if (hasPending_) {
+            runForeground(lock);
+        } else {
+            runPrefetch(lock);
+        }
+    }
+}
+
+void ImageLoader::runForeground(std::unique_lock<std::mutex>& lock) {
+    Result result;
+    result.path = std::move(pendingPath_);
+    result.generation = pendingGeneration_;
+    hasPending_ = false;
+    const DecodeOptions options = options_;
+    lock.unlock();
+
+    const uint64_t generation = result.generation;
+    if (!isStale(generation)) {
+        // Something on screen first: a stored MIP level or thumbnail costs a fraction of the decode
+        const uint64_t start = SDL_GetTicks();
+        Result preview;
+        preview.path = result.path;
+        preview.generation = generation;
+        preview.isPreview = true;
+        preview.success = DecodeImagePreview(preview.path, preview.image,
+                                             [this, generation] { return isStale(generation); }, options);
+        if (preview.success) {
+            Logger::InfoW(L"ImageLoader: preview %ux%u of %ls in %llu ms", preview.image.width, preview.image.height,
+                          preview.path.c_str(), static_cast<unsigned long long>(SDL_GetTicks() - start));
+            publish(std::move(preview));
+        }
+
+        result.success = DecodeImageFile(result.path, result.image, result.error,
+                                         [this, generation] { return isStale(generation); }, options);
+        publish(std::move(result));
+    }
+
+    lock.lock();
+}
+
+void ImageLoader::runPrefetch(std::unique_lock<std::mutex>& lock) {
+    std::wstring path = std::move(prefetchQueue_.front());
+    prefetchQueue_.pop_front();
+    if (cache_.Contains(path)) return;
+
+    prefetchInFlight_ = path;
+    adoptedGeneration_ = 0;
+    const uint64_t prefetchGeneration = prefetchGeneration_.load(std::memory_order_acquire);
+    const DecodeOptions options = options_;
+    lock.unlock();
+
+    Result result;
+    result.path = path;
+    result.success = DecodeImageFile(path, result.image, result.error, [this, prefetchGeneration] {
+        return prefetchGeneration != prefetchGeneration_.load(std::memory_order_acquire);
+    }, options);
+
+    lock.lock();
+    const uint64_t adopted = adoptedGeneration_;
+    prefetchInFlight_.clear();
+    adoptedGeneration_ = 0;
+
+    if (adopted != 0) {
+        // A foreground request attached to this decode while it ran
+        result.generation = adopted;
+        lock.unlock();
+        publish(std::move(result));
+        lock.lock();
+        return;
+    }
+
+    if (result.success && prefetchGeneration == prefetchGeneration_.load(std::memory_order_acquire)) {
+        Logger::InfoW(L"ImageLoader: prefetched %ls", path.c_str());
+        cache_.Put(path, std::move(result.image));
+    }
+}
+
+void ImageLoader::publish(Result&& result) {
+    const uint64_t generation = result.generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Dropped: a newer request or a cancel arrived while decoding
+        if (stopping_ || isStale(result.generation)) return;
+        completed_ = std::move(result);
+        hasCompleted_ = true;
+    }
+
+    SDL_Event event{};
+    event.type = completionEvent_;
+    event.user.code = static_cast<Sint32>(generation & 0x7FFFFFFF);
+    if (!SDL_PushEvent(&event)) {
+        Logger::Warn("ImageLoader: SDL_PushEvent failed: %s", SDL_GetError());
+    }
+}
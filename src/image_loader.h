@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <deque>
+
+#include "viewer.h"
+#include "image_cache.h"
+
+/**
+ * ImageLoader - Background decode worker for LoadImageFromFile
+ * Runs DecodeImageFile() off the SDL event loop and hands the finished
+ * ImageData back to the main thread through a registered SDL event.
+ *
+ * Only the most recent request matters: issuing a new request (or calling
+ * Cancel) bumps a generation counter, which aborts the decode in flight at
+ * its next cancellation point and discards any result not yet taken.
+ *
+ * When idle, the worker decodes prefetch requests into the owned ImageCache.
+ * A foreground request for the path currently being prefetched adopts that
+ * decode instead of restarting it; any other foreground request aborts it.
+ */
+class ImageLoader {
+public:
+    struct Result {
+        uint64_t generation = 0;
+        std::wstring path;
+        ImageData image;
+        bool success = false;
+        std::string error;   // User-facing open error (empty if none)
+        bool isPreview = false;   // Reduced-size stand-in; the full result follows
+    };
+
+    ImageLoader();
+    ~ImageLoader();
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    // Start the worker thread and register the completion event. Call after SDL_Init().
+    bool Start();
+    void Shutdown();
+    bool IsRunning() const { return running_; }
+
+    // Queue a decode, superseding any pending or in-flight request. Returns its generation.
+    uint64_t Request(const std::wstring& path);
+
+    // Drop the pending and in-flight requests without queueing a new one.
+    void Cancel();
+
+    // Replace the prefetch queue (nearest first). Paths already cached are skipped.
+    void Prefetch(const std::vector<std::wstring>& paths);
+    void CancelPrefetch();
+
+    // What decodes may leave to the renderer (paged sources, GPU color); follows the renderer
+    void SetDecodeOptions(const DecodeOptions& options);
+
+    // Decoded neighbours; also receives the displayed image when navigating away
+    ImageCache& Cache() { return cache_; }
+
+    // True while a request has been issued and its result not yet taken.
+    bool IsBusy() const { return busy_.load(std::memory_order_acquire); }
+
+    // Main thread: take the finished result. Returns false if none or superseded.
+    // A preview result leaves the loader busy until the full-resolution one is taken.
+    bool TakeResult(Result& out);
+
+    // SDL event type pushed when a result is ready (0 if registration failed)
+    Uint32 GetCompletionEventType() const { return completionEvent_; }
+
+private:
+    void workerMain();
+    void runForeground(std::unique_lock<std::mutex>& lock);
+    void runPrefetch(std::unique_lock<std::mutex>& lock);
+    void publish(Result&& result);
+    bool isStale(uint64_t generation) const {
+        return generation != generation_.load(std::memory_order_acquire);
+    }
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Protected by mutex_
+    bool stopping_ = false;
+    bool hasPending_ = false;
+    std::wstring pendingPath_;
+    uint64_t pendingGeneration_ = 0;
+    bool hasCompleted_ = false;
+    Result completed_;
+    std::deque<std::wstring> prefetchQueue_;
+    std::wstring prefetchInFlight_;          // Empty when no prefetch is decoding
+    uint64_t adoptedGeneration_ = 0;         // Foreground generation adopting the in-flight prefetch
+    DecodeOptions options_;
+
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<uint64_t> prefetchGeneration_{0};
+    ImageCache cache_;
+    std::atomic<bool> busy_{false};
+    Uint32 completionEvent_ = 0;
+    bool running_ = false;
+};
@@ -0,0 +1,418 @@
+#include "image_saver.h"
+#include "pixel_convert.h"
+#include "worker_pool.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+    // Source bytes behind one written strip; bounds the tonemap buffers too
+    constexpr uint64_t kStripBytes = UINT64_C(16) * 1024 * 1024;
+
+    enum EventCode : Sint32 {
+        kProgressEvent = 0,
+        kCompletedEvent = 1,
+    };
+
+    // Output row y starts at origin + y * yStride and steps xStride per pixel, so every
+    // orientation is a stride pattern over the stored, unrotated buffer
+    struct OrientedLayout {
+        const uint8_t* origin = nullptr;
+        OIIO::stride_t xStride = 0;
+        OIIO::stride_t yStride = 0;
+        OIIO::stride_t pixelSize = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    OrientedLayout OrientPixels(const ImageSaver::Job& job) {
+        OrientedLayout layout;
+        const int quarterTurns = ((job.rotation / 90) % 4 + 4) % 4;
+        const bool sideways = (quarterTurns % 2) != 0;
+        layout.width = sideways ? job.height : job.width;
+        layout.height = sideways ? job.width : job.height;
+        layout.pixelSize = job.isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+
+        // Mirroring walks the stored rows right to left; the rotation is applied afterwards
+        const OIIO::stride_t rowStep = layout.pixelSize * static_cast<OIIO::stride_t>(job.width);
+        const OIIO::stride_t columnStep = job.mirrored ? -layout.pixelSize : layout.pixelSize;
+        const OIIO::stride_t firstColumn = job.mirrored ? layout.pixelSize * static_cast<OIIO::stride_t>(job.width - 1) : 0;
+        const OIIO::stride_t lastRow = rowStep * static_cast<OIIO::stride_t>(job.height - 1);
+        const OIIO::stride_t lastColumn = firstColumn + columnStep * static_cast<OIIO::stride_t>(job.width - 1);
+
+        const uint8_t* base = job.pixels;
+        switch (quarterTurns) {
+            case 1:
+                layout.origin = base + lastRow + firstColumn;
+                layout.xStride = -rowStep;
+                layout.yStride = columnStep;
+                break;
+            case 2:
+                layout.origin = base + lastRow + lastColumn;
+                layout.xStride = -columnStep;
+                layout.yStride = -rowStep;
+                break;
+            case 3:
+                layout.origin = base + lastColumn;
+                layout.xStride = rowStep;
+                layout.yStride = -columnStep;
+                break;
+            default:
+                layout.origin = base + firstColumn;
+                layout.xStride = columnStep;
+                layout.yStride = rowStep;
+                break;
+        }
+        return layout;
+    }
+
+    // Copy output row 'y' into 'dst' as tightly packed source texels
+    void GatherRow(const OrientedLayout& layout, uint32_t y, uint8_t* dst) {
+        const uint8_t* src = layout.origin + static_cast<OIIO::stride_t>(y) * layout.yStride;
+        const size_t pixelSize = static_cast<size_t>(layout.pixelSize);
+        if (layout.xStride == layout.pixelSize) {
+            std::memcpy(dst, src, static_cast<size_t>(layout.width) * pixelSize);
+            return;
+        }
+        for (uint32_t x = 0; x < layout.width; ++x, src += layout.xStride) {
+            std::memcpy(dst + static_cast<size_t>(x) * pixelSize, src, pixelSize);
+        }
+    }
+
+    // Output row 'y' as RGBA floats through the job's display transform, as a CPU decode
+    // converts them. 'texels' holds one row of source texels. Throws what OCIO throws.
+    void TransformRow(const ImageSaver::Job& job, const OrientedLayout& layout, uint32_t y,
+                      std::vector<uint16_t>& texels, float* dst) {
+        const size_t count = static_cast<size_t>(layout.width) * 4;
+        GatherRow(layout, y, reinterpret_cast<uint8_t*>(texels.data()));
+        if (job.isHdr) {
+            PixelConvert::HalfToFloat(texels.data(), dst, count);
+        } else {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(texels.data());
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = bytes[i] * (1.0f / 255.0f);
+            }
+        }
+#ifndef PORTABLE_NO_OCIO
+        OCIO::PackedImageDesc desc(dst, static_cast<long>(layout.width), 1, 4);
+        job.colorProcessor->apply(desc);
+#endif
+    }
+
+    // Output rows [y0, y0 + rows) as display-transformed RGBA floats, tightly packed
+    bool TransformRows(const ImageSaver::Job& job, const OrientedLayout& layout, uint32_t y0, uint32_t rows, float* dst) {
+        return WorkerPool::Shared().ParallelFor(rows, 16, [&](size_t r0, size_t r1) {
+            std::vector<uint16_t> texels(static_cast<size_t>(layout.width) * 4);
+            for (size_t r = r0; r < r1; ++r) {
+                TransformRow(job, layout, static_cast<uint32_t>(y0 + r), texels, dst + r * layout.width * 4);
+            }
+        });
+    }
+
+    std::string ToUtf8(const std::wstring& wstr) {
+        if (wstr.empty()) return std::string();
+        int size = WideCharToMultiByte(CP_UTF8, 0, wstr.data(), static_cast<int>(wstr.size()), nullptr, 0, nullptr, nullptr);
+        std::string out(static_cast<size_t>(std::max(size, 0)), '\0');
+        if (size > 0) {
+            WideCharToMultiByte(CP_UTF8, 0, wstr.data(), static_cast<int>(wstr.size()), out.data(), size, nullptr, nullptr);
+        }
+        return out;
+    }
+}
+
+ImageSaver::ImageSaver() = default;
+
+ImageSaver::~ImageSaver() {
+    Shutdown();
+}
+
+bool ImageSaver::Start() {
+    if (running_) return true;
+
+    event_ = SDL_RegisterEvents(1);
+    if (event_ == 0) {
+        Logger::Error("ImageSaver: SDL_RegisterEvents failed: %s", SDL_GetError());
+        return false;
+    }
+
+    try {
+        stopping_ = false;
+        worker_ = std::thread(&ImageSaver::workerMain, this);
+    } catch (const std::exception& e) {
+        Logger::Error("ImageSaver: failed to start worker thread: %s", e.what());
+        return false;
+    }
+
+    running_ = true;
+    Logger::Info("ImageSaver: encode worker started");
+    return true;
+}
+
+void ImageSaver::Shutdown() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        if (hasJob_) {
+            Logger::Info("ImageSaver: waiting for the save in progress");
+        }
+    }
+    cv_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    running_ = false;
+    busy_.store(false, std::memory_order_release);
+    Logger::Info("ImageSaver: encode worker stopped");
+}
+
+bool ImageSaver::Submit(const Job& job) {
+    if (job.pixels == nullptr || job.width == 0 || job.height == 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || busy_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        job_ = job;
+        hasJob_ = true;
+        hasCompleted_ = false;
+        progress_.store(0, std::memory_order_relaxed);
+        busy_.store(true, std::memory_order_release);
+    }
+    cv_.notify_one();
+    return true;
+}
+
+bool ImageSaver::TakeResult(Result& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasCompleted_) return false;
+
+    out = std::move(completed_);
+    completed_ = Result{};
+    hasCompleted_ = false;
+    busy_.store(false, std::memory_order_release);
+    return true;
+}
+
+void ImageSaver::postEvent(Sint32 code) {
+    SDL_Event event{};
+    event.type = event_;
+    event.user.code = code;
+    if (!SDL_PushEvent(&event)) {
+        Logger::Warn("ImageSaver: SDL_PushEvent failed: %s", SDL_GetError());
+    }
+}
+
+void ImageSaver::workerMain() {
+    Trace::NameThread("encode");
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        // A queued save still runs when stopping; Shutdown() waits for it
+        cv_.wait(lock, [this] { return stopping_ || hasJob_; });
+        if (!hasJob_) return;
+
+        Result result;
+        result.job = job_;
+        lock.unlock();
+
+        const uint64_t start = SDL_GetTicks();
+        result.success = Write(result.job, result.error, [this](int percent) {
+            progress_.store(percent, std::memory_order_relaxed);
+            postEvent(kProgressEvent);
+        });
+        if (result.success) {
+            Logger::InfoW(L"ImageSaver: wrote %ls in %llu ms", result.job.targetPath.c_str(),
+                          static_cast<unsigned long long>(SDL_GetTicks() - start));
+        } else {
+            Logger::Error("ImageSaver: save failed: %s", result.error.c_str());
+        }
+        // Released here rather than with the result: the viewer may have moved on,
+        // and the buffer goes back to the pool as soon as nothing reads it
+        result.job.pixels = nullptr;
+        result.job.owner.reset();
+
+        lock.lock();
+        hasJob_ = false;
+        job_ = Job{};
+        completed_ = std::move(result);
+        hasCompleted_ = true;
+        lock.unlock();
+        postEvent(kCompletedEvent);
+        lock.lock();
+    }
+}
+
+void ImageSaver::ChooseOutputFormat(Job& job, const std::wstring& path) {
+    std::wstring lowerPath = path;
+    std::transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(), ::towlower);
+    const bool saveAsHdr = (lowerPath.find(L".exr") != std::wstring::npos ||
+                            lowerPath.find(L".hdr") != std::wstring::npos ||
+                            lowerPath.find(L".tiff") != std::wstring::npos);
+
+    job.spec.set_format(saveAsHdr ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8);
+    job.spec.attribute("oiio:ColorSpace", std::string(saveAsHdr ? "Linear" : "sRGB"));
+}
+
+bool ImageSaver::Write(const Job& job, std::string& error, const std::function<void(int)>& progress) {
+    // NASA Standard: Validate all input parameters
+    if (job.pixels == nullptr || job.width == 0 || job.height == 0) {
+        error = "No image data to save.";
+        return false;
+    }
+    const OrientedLayout layout = OrientPixels(job);
+    if (job.spec.width != static_cast<int>(layout.width) || job.spec.height != static_cast<int>(layout.height) ||
+        job.spec.nchannels != 4) {
+        error = "Output size does not match the image.";
+        return false;
+    }
+
+    const std::string utf8Path = ToUtf8(job.targetPath);
+    auto out = OIIO::ImageOutput::create(utf8Path);
+    if (!out) {
+        error = "Could not create output file: " + OIIO::geterror();
+        return false;
+    }
+    if (!out->open(utf8Path, job.spec)) {
+        error = "Could not open output file: " + out->geterror();
+        return false;
+    }
+
+    const uint32_t outWidth = layout.width;
+    const uint32_t outHeight = layout.height;
+    const OIIO::stride_t pixelSize = layout.pixelSize;
+
+    // HDR written to an integer format is tonemapped, as the viewer shows it on SDR.
+    // Pixels waiting for a display transform go through it: into floats for a float
+    // format, otherwise on the way to 8 bits with the tonemap.
+    const bool floatOutput = job.spec.format.is_floating_point();
+    const bool transformFloat = job.colorProcessor && floatOutput;
+    const bool tonemap = !transformFloat && ((job.isHdr && !floatOutput) || job.colorProcessor);
+    const OIIO::TypeDesc sourceType = job.isHdr ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8;
+    const uint64_t stripPixelBytes = transformFloat ? 4 * sizeof(float) : static_cast<uint64_t>(pixelSize);
+    const uint32_t stripRows = static_cast<uint32_t>(std::clamp<uint64_t>(
+        kStripBytes / (static_cast<uint64_t>(outWidth) * stripPixelBytes), 1, outHeight));
+
+    std::vector<uint8_t> ldrStrip;
+    std::vector<float> floatStrip;
+    if (tonemap || transformFloat) {
+        try {
+            if (transformFloat) {
+                floatStrip.resize(static_cast<size_t>(outWidth) * stripRows * 4);
+            } else {
+                ldrStrip.resize(static_cast<size_t>(outWidth) * stripRows * 4);
+            }
+        } catch (const std::bad_alloc&) {
+            out->close();
+            error = "Out of memory for the conversion buffer.";
+            return false;
+        }
+    }
+
+    bool success = true;
+    int reported = -1;
+    for (uint32_t y0 = 0; y0 < outHeight && success; y0 += stripRows) {
+        const uint32_t rows = std::min(stripRows, outHeight - y0);
+        if (transformFloat) {
+            success = TransformRows(job, layout, y0, rows, floatStrip.data()) &&
+                      out->write_scanlines(static_cast<int>(y0), static_cast<int>(y0 + rows), 0,
+                                           OIIO::TypeDesc::FLOAT, floatStrip.data());
+        } else if (!tonemap) {
+            const uint8_t* first = layout.origin + static_cast<OIIO::stride_t>(y0) * layout.yStride;
+            success = out->write_scanlines(static_cast<int>(y0), static_cast<int>(y0 + rows), 0, sourceType,
+                                           first, layout.xStride, layout.yStride);
+        } else {
+            success = ConvertRows(job, y0, rows, ldrStrip.data(), static_cast<size_t>(outWidth) * 4, false) &&
+                      out->write_scanlines(static_cast<int>(y0), static_cast<int>(y0 + rows), 0,
+                                           OIIO::TypeDesc::UINT8, ldrStrip.data());
+        }
+
+        const int percent = static_cast<int>(static_cast<uint64_t>(y0 + rows) * 100 / outHeight);
+        if (success && progress && percent != reported) {
+            reported = percent;
+            progress(percent);
+        }
+    }
+
+    if (!success) {
+        error = out->geterror();
+    }
+    if (!out->close() && success) {
+        success = false;
+        error = out->geterror();
+    }
+    // Clear any save operation errors/warnings
+    OIIO::geterror();
+    if (!success && error.empty()) {
+        error = "The encoder reported an error.";
+    }
+    return success;
+}
+
+bool ImageSaver::ConvertRows(const Job& job, uint32_t y0, uint32_t rows, uint8_t* dst, size_t dstPitch, bool bgra) {
+    // NASA Standard: Validate all input parameters
+    if (job.pixels == nullptr || job.width == 0 || job.height == 0 || dst == nullptr) {
+        return false;
+    }
+    const OrientedLayout layout = OrientPixels(job);
+    if (y0 >= layout.height || rows > layout.height - y0 || dstPitch < static_cast<size_t>(layout.width) * 4) {
+        return false;
+    }
+
+    const uint32_t width = layout.width;
+    return WorkerPool::Shared().ParallelFor(rows, 16, [&](size_t r0, size_t r1) {
+        // HDR rows are gathered into upright half texels so the tonemap kernel runs on a plain span
+        std::vector<uint16_t> halfRow(job.isHdr || job.colorProcessor ? static_cast<size_t>(width) * 4 : 0);
+        std::vector<float> floatRow(job.colorProcessor ? static_cast<size_t>(width) * 4 : 0);
+        for (size_t r = r0; r < r1; ++r) {
+            const uint8_t* src = layout.origin + static_cast<OIIO::stride_t>(y0 + r) * layout.yStride;
+            uint8_t* out = dst + r * dstPitch;
+            if (job.colorProcessor) {
+                // Quantized as a CPU-converted decode stores them, then tonemapped the same way
+                TransformRow(job, layout, static_cast<uint32_t>(y0 + r), halfRow, floatRow.data());
+                if (job.isHdr) {
+                    PixelConvert::FloatToHalf(floatRow.data(), halfRow.data(), floatRow.size());
+                    PixelConvert::HalfToUnorm8Tonemapped(halfRow.data(), out, width);
+                } else {
+                    PixelConvert::FloatToUnorm8(floatRow.data(), out, floatRow.size());
+                }
+                if (bgra) {
+                    for (uint32_t x = 0; x < width; ++x) {
+                        std::swap(out[x * 4 + 0], out[x * 4 + 2]);
+                    }
+                }
+            } else if (job.isHdr) {
+                GatherRow(layout, static_cast<uint32_t>(y0 + r), reinterpret_cast<uint8_t*>(halfRow.data()));
+                PixelConvert::HalfToUnorm8Tonemapped(halfRow.data(), out, width);
+                if (bgra) {
+                    for (uint32_t x = 0; x < width; ++x) {
+                        std::swap(out[x * 4 + 0], out[x * 4 + 2]);
+                    }
+                }
+            } else if (!bgra && layout.xStride == layout.pixelSize) {
+                std::memcpy(out, src, static_cast<size_t>(width) * 4);
+            } else {
+                const int red = bgra ? 2 : 0;
+                const int blue = bgra ? 0 : 2;
+                for (uint32_t x = 0; x < width; ++x, src += layout.xStride) {
+                    out[x * 4 + red] = src[0];
+                    out[x * 4 + 1] = src[1];
+                    out[x * 4 + blue] = src[2];
+                    out[x * 4 + 3] = src[3];
+                }
+            }
+        }
+    });
+}
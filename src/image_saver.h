@@ -0,0 +1,117 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <OpenImageIO/imageio.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pixel_buffer.h"
+#include "ocio_shim.h"
+
+/**
+ * ImageSaver - Background encode worker for SaveImage and SaveImageAs
+ * Encoding a photo takes a moment but a 500 MB TIFF takes many seconds, so
+ * saves run off the SDL event loop the way decodes do. Nothing is copied up
+ * front: the job writes scanline strips straight from the displayed image's
+ * buffer, with the display rotation folded into the strides OIIO reads it
+ * through, together with any mirroring from the file's orientation. Only
+ * HDR pixels written to an integer file pass through a strip-sized
+ * tonemap buffer. ConvertRows() is the same pass for other 8-bit
+ * destinations such as the clipboard. Pixels the viewer left for the GPU's
+ * display transform carry it as 'colorProcessor' and go through it strip by
+ * strip, so what is written matches the screen and a CPU-converted decode.
+ *
+ * The job holds a reference to the buffer it reads ('owner'), so the viewer
+ * may move on to another image mid-save. Progress and completion
+ * are posted as one SDL event type; the main thread takes the result and
+ * finishes the save (swapping a temporary over the original, reloading).
+ */
+class ImageSaver {
+public:
+    struct Job {
+        std::wstring targetPath;            // File the encoder writes
+        std::wstring replacePath;           // Non-empty: targetPath is a temporary to swap over this file
+        std::wstring sourcePath;            // Image the pixels belong to
+        OIIO::ImageSpec spec;               // Output size (rotated), format and metadata
+        const uint8_t* pixels = nullptr;    // RGBA8, or RGBA16F when isHdr; width x height, unrotated
+        std::shared_ptr<const PixelBuffer> owner;   // Keeps 'pixels' alive while the job reads them
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool isHdr = false;
+        int rotation = 0;                   // Clockwise degrees applied on the way out: 0, 90, 180 or 270
+        bool mirrored = false;              // Flipped left-right before the rotation
+        // Display transform still to apply: the pixels were left as the file stores them
+        // for the GPU to convert. Null when they are display-ready already.
+        OCIO::ConstCPUProcessorRcPtr colorProcessor;
+    };
+
+    struct Result {
+        Job job;                            // As submitted; 'pixels' no longer valid, 'owner' released
+        bool success = false;
+        std::string error;                  // Encoder message when it failed
+    };
+
+    ImageSaver();
+    ~ImageSaver();
+
+    ImageSaver(const ImageSaver&) = delete;
+    ImageSaver& operator=(const ImageSaver&) = delete;
+
+    // Start the worker thread and register the event. Call after SDL_Init().
+    bool Start();
+    // Waits for a save in flight: a half-written file is worse than a slower exit
+    void Shutdown();
+    bool IsRunning() const { return running_; }
+
+    // Queue 'job'. False while another save has not been taken yet.
+    bool Submit(const Job& job);
+
+    // True from Submit() until the result is taken
+    bool IsBusy() const { return busy_.load(std::memory_order_acquire); }
+    // Percentage of scanlines written by the save in flight
+    int GetProgress() const { return progress_.load(std::memory_order_relaxed); }
+
+    // Main thread: take the finished result. False while the save is still running.
+    bool TakeResult(Result& out);
+
+    // SDL event type pushed on progress and on completion (0 if registration failed)
+    Uint32 GetEventType() const { return event_; }
+
+    // Set 'job.spec' format and color space for the file type of 'path', as Save As
+    // chooses them: half-float linear for EXR, Radiance HDR and TIFF, 8-bit sRGB otherwise
+    static void ChooseOutputFormat(Job& job, const std::wstring& path);
+
+    // Encode 'job' on the calling thread. 'progress' (may be null) receives percentages.
+    static bool Write(const Job& job, std::string& error, const std::function<void(int)>& progress = nullptr);
+
+    // Output rows [y0, y0 + rows) of 'job' as 8-bit texels, 'dstPitch' bytes apart: oriented,
+    // HDR tonemapped and, with 'bgra', swapped to BGRA in one pass. Runs on the shared pool.
+    static bool ConvertRows(const Job& job, uint32_t y0, uint32_t rows, uint8_t* dst, size_t dstPitch, bool bgra);
+
+private:
+    void workerMain();
+    void postEvent(Sint32 code);
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Protected by mutex_
+    bool stopping_ = false;
+    bool hasJob_ = false;
+    bool hasCompleted_ = false;
+    Job job_;
+    Result completed_;
+
+    std::atomic<bool> busy_{false};
+    std::atomic<int> progress_{0};
+    Uint32 event_ = 0;
+    bool running_ = false;
+};
@@ -6,6 +6,7 @@
 #include <thread>
 #include <vector>
 #include <algorithm>
+#include <chrono>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/async.h>
@@ -46,6 +47,8 @@ namespace {
         std::wstring spdFile;    // spdlog rotating file path
         std::wstring dumpDir;    // crash-dumps directory
         std::string glogPrefix;  // utf-8 prefix for glog destinations
+        std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> sink; // file sink behind the async queue
+        std::atomic<std::thread::id> sinkThread{}; // the async pool thread that writes the sink
 #ifdef HAVE_BREAKPAD
         std::unique_ptr<google_breakpad::ExceptionHandler> eh;
 #endif
@@ -113,6 +116,34 @@ namespace {
     }
 #endif
 
+    // Messages the async queue holds before the oldest are overwritten
+    constexpr size_t kLogQueueSlots = 8192;
+    // Info lines reach the disk at least this often; warnings and errors flush at once
+    constexpr auto kLogFlushInterval = std::chrono::seconds(2);
+    // Longest a crash path waits for the sink thread to empty the queue
+    constexpr auto kLogDrainTimeout = std::chrono::milliseconds(1500);
+
+    // Put everything logged so far on disk before a crash path writes a dump or aborts.
+    // Bounded: if the sink thread is the one that crashed, the queue never empties and
+    // the handler moves on rather than hanging.
+    static void DrainLog() noexcept {
+        try {
+            // On the sink thread itself nothing can drain, and the sink's mutex may be held
+            // further up this stack; flushing it here would deadlock
+            if (S().sinkThread.load(std::memory_order_acquire) == std::this_thread::get_id()) return;
+            if (auto logger = spdlog::default_logger()) logger->flush();
+            auto pool = spdlog::thread_pool();
+            if (!pool) return;
+            const auto deadline = std::chrono::steady_clock::now() + kLogDrainTimeout;
+            while (pool->queue_size() > 0 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            // The sink lock waits out a write still in progress on the sink thread
+            if (pool->queue_size() == 0 && S().sink) S().sink->flush();
+        } catch (...) {
+        }
+    }
+
     // printf-style format to std::string for spdlog
     static std::string vformat(const char* fmt, va_list ap) {
         if (!fmt) return {};
@@ -557,18 +588,23 @@ bool Init(const wchar_t* appName) {
     S().glogPrefix = "./glog_";
 #endif
 
-    // Initialize spdlog async rotating logger
+    // Initialize spdlog async rotating logger. Callers only format and enqueue; the one
+    // pool thread does all file I/O. A full queue overwrites its oldest message instead
+    // of blocking the caller, so a stalled (network) disk never stalls the UI thread.
     try {
-        spdlog::init_thread_pool(8192, 1);
-        auto sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+        spdlog::init_thread_pool(kLogQueueSlots, 1, [] {
+            S().sinkThread.store(std::this_thread::get_id(), std::memory_order_release);
+        });
+        S().sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
             w2u(S().spdFile).c_str(), 10 * 1024 * 1024, 5, true);
         auto logger = std::make_shared<spdlog::async_logger>(
-            "minimalimageviewer", sink, spdlog::thread_pool(),
-            spdlog::async_overflow_policy::block);
+            "minimalimageviewer", S().sink, spdlog::thread_pool(),
+            spdlog::async_overflow_policy::overrun_oldest);
         spdlog::set_default_logger(logger);
         spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
         spdlog::set_level(spdlog::level::info);
-        spdlog::flush_on(spdlog::level::info);
+        spdlog::flush_on(spdlog::level::warn);
+        spdlog::flush_every(kLogFlushInterval);
     } catch (...) {
         return false;
     }
@@ -624,6 +660,7 @@ void InstallCrashHandlers() {
                       std::string(path.begin(), path.end()),
                       std::string(id.begin(), id.end()),
                       succeeded ? "true" : "false");
+        DrainLog();
         return succeeded;
     };
     try {
@@ -646,6 +683,7 @@ void InstallCrashHandlers() {
                       ep && ep->ExceptionRecord ? ep->ExceptionRecord->ExceptionCode : 0u,
                       (void*)(ep && ep->ExceptionRecord ? ep->ExceptionRecord->ExceptionAddress : nullptr));
         LogBacktrace();
+        DrainLog();
 #ifdef HAVE_BREAKPAD
         if (S().eh) {
             if (S().eh->WriteMinidumpForException(ep)) {
@@ -659,6 +697,7 @@ void InstallCrashHandlers() {
         {
             WriteMinidumpWin(ep);
         }
+        DrainLog();
         return EXCEPTION_EXECUTE_HANDLER;
     };
     SetUnhandledExceptionFilter(sehHandler);
@@ -669,6 +708,7 @@ void InstallCrashHandlers() {
         spdlog::error("std::terminate called");
         LogBacktrace();
         DumpNow("std::terminate");
+        DrainLog();
         google::LogMessage(__FILE__, __LINE__, google::GLOG_FATAL).stream()
             << "std::terminate called";
         std::abort();
@@ -682,10 +722,13 @@ void LogStackTrace() noexcept {
 
 void DumpNow(const char* reason) noexcept {
     if (reason) spdlog::error("DumpNow: {}", reason);
+    // The dump is read next to the log, so the lines leading up to it go to disk first
+    DrainLog();
 #ifdef HAVE_BREAKPAD
     if (S().eh) {
         if (S().eh->WriteMinidump()) {
             spdlog::error("Breakpad WriteMinidump: OK");
+            DrainLog();
             return;
         }
     }
@@ -693,6 +736,7 @@ void DumpNow(const char* reason) noexcept {
 #ifdef _WIN32
     WriteMinidumpWin(nullptr);
 #endif
+    DrainLog();
 }
 
 void LogCriticalState(float zoomFactor, float offsetX, float offsetY, const char* context) noexcept {
@@ -729,11 +773,20 @@ void LogCriticalState(float zoomFactor, float offsetX, float offsetY, const char
 
 void Shutdown() {
     if (!S().initialized.load(std::memory_order_acquire)) return;
+    if (auto pool = spdlog::thread_pool()) {
+        const size_t dropped = pool->overrun_counter();
+        if (dropped > 0) spdlog::warn("{} log messages were overwritten while the log queue was full", dropped);
+    }
     spdlog::shutdown();
+    S().sink.reset();
     google::ShutdownGoogleLogging();
     S().initialized.store(false, std::memory_order_release);
 }
 
+const std::wstring& GetLogDirectory() noexcept {
+    return S().dir;
+}
+
 void Info(const char* fmt, ...) noexcept {
     va_list ap; va_start(ap, fmt);
     auto msg = vformat(fmt, ap);
@@ -9,6 +9,7 @@
 namespace dd = datadog::tracing;
 #endif
 #include <cstdint>
+#include <string>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -36,7 +37,12 @@ void LogCriticalState(float zoomFactor, float offsetX, float offsetY, const char
 // Flush and close the log file.
 void Shutdown();
 
-// Logging helpers (printf-style, UTF-8). Thread-safe; each call flushes.
+// Directory the log file is written to; empty before Init(). Reports saved beside it are found together.
+const std::wstring& GetLogDirectory() noexcept;
+
+// Logging helpers (printf-style, UTF-8). Thread-safe and asynchronous: a call formats the
+// message and queues it for a background writer. Warnings and errors are flushed at once,
+// info every couple of seconds; crash handlers and DumpNow() drain the queue first.
 void Info(const char* fmt, ...) noexcept;
 void Warn(const char* fmt, ...) noexcept;
 void Error(const char* fmt, ...) noexcept;
@@ -4,12 +4,18 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include "ocio_shim.h"
 #include "vulkan_renderer.h"
+#include "image_loader.h"
+#include "image_saver.h"
+#include "batch.h"
+#include "paged_image.h"
+#include "directory_indexer.h"
+#include "thumbnail_grid.h"
+#include "sequence_player.h"
+#include "pixel_convert.h"
+#include "worker_pool.h"
 #include "logging.h"
-#include "text_renderer.h"
-
-namespace OCIO = OCIO_NAMESPACE;
+#include "trace.h"
 
 AppContext g_ctx;
 
@@ -49,6 +55,42 @@ void CenterImage(bool resetZoom) {
 }
 
 void HandleSDLEvent(const SDL_Event& event) {
+    // Registered event types are runtime values, so they can't be switch cases
+    if (g_ctx.imageLoader && event.type == g_ctx.imageLoader->GetCompletionEventType()) {
+        HandleImageLoadComplete();
+        RequestRedraw();
+        return;
+    }
+    if (g_ctx.imageSaver && event.type == g_ctx.imageSaver->GetEventType()) {
+        HandleSaveEvent();
+        return;
+    }
+    if (g_ctx.directoryIndexer && event.type == g_ctx.directoryIndexer->GetChangeEventType()) {
+        HandleDirectoryChanges();
+        return;
+    }
+    if (g_ctx.thumbnailGrid && event.type == g_ctx.thumbnailGrid->GetReadyEventType()) {
+        g_ctx.thumbnailGrid->HandleReady(g_ctx.renderer.get());
+        if (g_ctx.thumbnailGrid->GetMode() != ThumbnailGrid::Mode::Off) {
+            RequestRedraw();
+        }
+        return;
+    }
+    if (PagedImage::GetReadyEventType() != 0 && event.type == PagedImage::GetReadyEventType()) {
+        // Tiles of a paged image were decoded; the next frame uploads them
+        RequestRedraw();
+        return;
+    }
+
+    // When the event was queued, on the trace clock; the frame that answers it measures from here
+    const bool isInput = event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_DOWN ||
+                         event.type == SDL_EVENT_MOUSE_MOTION || event.type == SDL_EVENT_MOUSE_WHEEL;
+    uint64_t inputNs = 0;
+    if (isInput && Trace::IsEnabled()) {
+        const uint64_t ticksNs = SDL_GetTicksNS();
+        inputNs = Trace::Now() - (ticksNs - std::min<uint64_t>(event.common.timestamp, ticksNs));
+    }
+
     switch (event.type) {
         case SDL_EVENT_DROP_FILE:
             if (event.drop.data) {
@@ -60,10 +102,12 @@ void HandleSDLEvent(const SDL_Event& event) {
             
         case SDL_EVENT_KEY_DOWN:
             HandleKeyboardEvent(event.key);
+            RequestRedraw();
             break;
             
         case SDL_EVENT_MOUSE_BUTTON_DOWN:
             HandleMouseEvent(event.button);
+            RequestRedraw();
             break;
             
         case SDL_EVENT_MOUSE_MOTION:
@@ -77,49 +121,82 @@ void HandleSDLEvent(const SDL_Event& event) {
         case SDL_EVENT_WINDOW_RESIZED:
             FitImageToWindow();
             break;
+
+        case SDL_EVENT_WINDOW_EXPOSED:
+        case SDL_EVENT_WINDOW_SHOWN:
+        case SDL_EVENT_WINDOW_RESTORED:
+        case SDL_EVENT_WINDOW_MAXIMIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_DISPLAY_CHANGED:
+            RequestRedraw();
+            break;
+    }
+
+    if (inputNs != 0 && g_ctx.needsRedraw && g_ctx.renderer) {
+        g_ctx.renderer->NoteInput(inputNs);
     }
 }
 
+// Milliseconds since the process was created: startup is measured from the launch
+// itself, DLL loading included, rather than from main()
+static double MillisecondsSinceLaunch() {
+    FILETIME creation{}, exitTime{}, kernelTime{}, userTime{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    FILETIME now{};
+    GetSystemTimePreciseAsFileTime(&now);
+    const uint64_t created = (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+    const uint64_t current = (static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+    return current > created ? static_cast<double>(current - created) / 10000.0 : 0.0;   // 100 ns units
+}
+
+// Frames that must be drawn whether or not input arrives: an upload streaming
+// in over several frames, or a renderer waiting to be rebuilt
+static bool NeedsContinuousRedraw() {
+    if (g_ctx.rendererNeedsReset) return true;
+    // A playing flipbook draws every frame so the clock, not input, decides what is shown
+    return g_ctx.renderer && (g_ctx.renderer->HasPendingUpload() || g_ctx.renderer->HasPendingThumbnails() ||
+                              IsSequencePlaying());
+}
+
 int main(int argc, char* argv[]) {
     // Initialize logging and crash handlers as early as possible
     Logger::Init(L"MinimalImageViewer");
     Logger::InstallCrashHandlers();
     Logger::Info("SDL3 Application starting");
 
+    // MIV_TRACE=<file.json> records from startup and writes a Chrome trace on exit
+    Trace::NameThread("main");
+    const char* traceEnv = SDL_getenv("MIV_TRACE");
+    const std::wstring tracePath = (traceEnv && *traceEnv) ? utf8_to_wstring(traceEnv) : std::wstring();
+    if (!tracePath.empty()) {
+        g_ctx.traceAtStartup = true;
+        Trace::SetEnabled(true);
+    }
+
+    // --batch converts files headlessly: no window, no GPU, just decode and encode
+    if (Batch::IsBatchCommandLine(argc, argv)) {
+        const int exitCode = Batch::Run(argc, argv);
+        WorkerPool::Shared().Shutdown();
+        if (!tracePath.empty()) {
+            std::string traceError;
+            if (!Trace::ExportChromeTrace(tracePath, traceError)) {
+                Logger::Warn("Trace export failed: %s", traceError.c_str());
+            }
+        }
+        Logger::Shutdown();
+        return exitCode;
+    }
+
 #ifdef HAVE_DATADOG
     auto appSpan = Logger::CreateSpan("application.startup");
     appSpan.set_tag("sdl_version", "3");
 #endif
 
-    // Create splash screen window first
-    SDL_Window* splashWindow = nullptr;
-    SDL_Renderer* splashRenderer = nullptr;
-    TextRenderer* tr = nullptr;  // Global scope for entire splash sequence
-    
-    // Helper lambda to update splash screen with text and progress
-    auto updateSplash = [&](const std::string& status, int progressWidth) {
-        if (splashRenderer && tr) {
-            SDL_Surface* textSurface = tr->CreateSplashScreenSurface(400, 300, status);
-            if (textSurface) {
-                SDL_Texture* textTexture = SDL_CreateTextureFromSurface(splashRenderer, textSurface);
-                if (textTexture) {
-                    SDL_SetRenderDrawBlendMode(splashRenderer, SDL_BLENDMODE_BLEND);
-                    SDL_RenderClear(splashRenderer);
-                    SDL_RenderTexture(splashRenderer, textTexture, nullptr, nullptr);
-                    
-                    // Draw progress bar
-                    SDL_SetRenderDrawColor(splashRenderer, 0, 150, 200, 255);
-                    SDL_FRect progress = {50, 220, static_cast<float>(progressWidth), 20};
-                    SDL_RenderFillRect(splashRenderer, &progress);
-                    
-                    SDL_RenderPresent(splashRenderer);
-                    SDL_DestroyTexture(textTexture);
-                }
-                SDL_DestroySurface(textSurface);
-            }
-        }
-    };
-    
+    // Nonzero when the renderer cannot start; the workers already running are still shut down below
+    int exitCode = 0;
+
     try {
         // Initialize SDL3
         std::cout << "[INIT] Initializing SDL3..." << std::endl;
@@ -128,125 +205,24 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         std::cout << "[INIT] SDL3 initialized successfully" << std::endl;
-        
-        // Create splash screen
-        splashWindow = SDL_CreateWindow("Minimal Image Viewer - Initializing...", 
-                                       400, 300, SDL_WINDOW_BORDERLESS);
-        if (splashWindow) {
-            SDL_SetWindowPosition(splashWindow, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
-            splashRenderer = SDL_CreateRenderer(splashWindow, nullptr);
-            
-            if (splashRenderer) {
-                // Initialize TextRenderer for splash screen - single instance for all splash updates
-                tr = new TextRenderer();
-                if (tr->Initialize()) {
-                    // Create splash screen surface with text
-                    SDL_Surface* textSurface = tr->CreateSplashScreenSurface(400, 300, "Initializing...");
-                    if (textSurface) {
-                        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(splashRenderer, textSurface);
-                        if (textTexture) {
-                            SDL_SetRenderDrawBlendMode(splashRenderer, SDL_BLENDMODE_BLEND);
-                            SDL_RenderClear(splashRenderer);
-                            SDL_RenderTexture(splashRenderer, textTexture, nullptr, nullptr);
-                            
-                            // Draw initial progress bar (0%)
-                            SDL_SetRenderDrawColor(splashRenderer, 0, 150, 200, 255);
-                            SDL_FRect progress = {50, 220, 0, 20};
-                            SDL_RenderFillRect(splashRenderer, &progress);
-                            
-                            SDL_RenderPresent(splashRenderer);
-                            SDL_DestroyTexture(textTexture);
-                        }
-                        SDL_DestroySurface(textSurface);
-                    }
-                } else {
-                    Logger::Warn("TextRenderer init failed; showing splash without text");
-                    // Fallback to simple rectangles
-                    SDL_SetRenderDrawColor(splashRenderer, 30, 30, 30, 255);
-                    SDL_RenderClear(splashRenderer);
-                    SDL_SetRenderDrawColor(splashRenderer, 70, 70, 70, 255);
-                    SDL_FRect titleRect = {0, 0, 400, 80};
-                    SDL_RenderFillRect(splashRenderer, &titleRect);
-                    SDL_RenderPresent(splashRenderer);
-                    delete tr;
-                    tr = nullptr;
-                }
-            }
-        }
 
-        // Update splash: COM initialization (25%)
-        updateSplash("Initializing COM...", 75);
-        
         // Initialize COM for Windows file operations
 #ifdef _WIN32
         std::cout << "[INIT] Initializing COM for Windows file operations..." << std::endl;
         if (FAILED(CoInitialize(nullptr))) {
             Logger::Error("Failed to initialize COM");
-            if (splashRenderer) SDL_DestroyRenderer(splashRenderer);
-            if (splashWindow) SDL_DestroyWindow(splashWindow);
             SDL_Quit();
             return 1;
         }
         std::cout << "[INIT] COM initialized successfully" << std::endl;
 #endif
 
-        // Update splash: OpenColorIO initialization (50%)
-        updateSplash("Initializing OpenColorIO...", 150);
-        
-        // Initialize OpenColorIO
-        std::cout << "[INIT] Initializing OpenColorIO..." << std::endl;
-        try {
-            g_ctx.ocioConfig = OCIO::GetCurrentConfig();
-            if (g_ctx.ocioConfig) {
-                bool hasBasicSpaces = false;
-                try {
-                    int numSpaces = g_ctx.ocioConfig->getNumColorSpaces();
-                    hasBasicSpaces = (numSpaces > 0);
-                } catch (...) {
-                    hasBasicSpaces = false;
-                }
-                if (!hasBasicSpaces) {
-                    g_ctx.ocioConfig = OCIO::Config::CreateRaw();
-                }
-            }
-        } catch (const OCIO::Exception& e) {
-            try {
-                g_ctx.ocioConfig = OCIO::Config::CreateRaw();
-            } catch (...) {
-                g_ctx.ocioConfig = nullptr;
-            }
-        } catch (...) {
-            try {
-                g_ctx.ocioConfig = OCIO::Config::CreateRaw();
-            } catch (...) {
-                g_ctx.ocioConfig = nullptr;
-            }
-        }
-
-        // Check OCIO environment
-        const char* ocioEnv = SDL_getenv("OCIO");
-        g_ctx.ocioEnabled = (ocioEnv && *ocioEnv && g_ctx.ocioConfig);
-        g_ctx.displayDevice = "sRGB";
-
-        if (!g_ctx.ocioEnabled) {
-            Logger::Info("OpenColorIO: disabled (no $OCIO or no config)");
-            std::cout << "[INIT] OpenColorIO: disabled (no $OCIO environment variable or config)" << std::endl;
-        } else {
-            Logger::Info("OpenColorIO: enabled");
-            std::cout << "[INIT] OpenColorIO: enabled with color management" << std::endl;
-        }
-
-        // Update splash: Creating main window (75%)
-        updateSplash("Creating main window...", 225);
-        
-        // Create SDL window
+        // The main window is the first thing on screen; there is no splash to draw and wait on
         std::cout << "[INIT] Creating main application window..." << std::endl;
         g_ctx.window = SDL_CreateWindow("Minimal Image Viewer", 1280, 720, 
                                        SDL_WINDOW_RESIZABLE | SDL_WINDOW_VULKAN);
         if (!g_ctx.window) {
             Logger::Error("SDL_CreateWindow failed: %s", SDL_GetError());
-            if (splashRenderer) SDL_DestroyRenderer(splashRenderer);
-            if (splashWindow) SDL_DestroyWindow(splashWindow);
             SDL_Quit();
             return 1;
         }
@@ -261,127 +237,190 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        // Update splash: Vulkan initialization (93%)
-        updateSplash("Initializing Vulkan...", 280);
-        
-        // Initialize Vulkan renderer
+        // The Vulkan device and the fonts are made on worker threads while this one starts
+        // the decode of the command-line file and the other workers; FinishInitialize() below
+        // waits for them and reports any failure
         std::cout << "[INIT] Initializing Vulkan renderer..." << std::endl;
         Logger::Info("Initializing Vulkan renderer...");
         g_ctx.renderer = std::make_unique<VulkanRenderer>();
-        if (!g_ctx.renderer->Initialize(g_ctx.window)) {
-            Logger::Error("Failed to initialize Vulkan renderer");
-            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", 
-                                   "Failed to initialize Vulkan renderer.", g_ctx.window);
-            if (splashRenderer) SDL_DestroyRenderer(splashRenderer);
-            if (splashWindow) SDL_DestroyWindow(splashWindow);
-            SDL_DestroyMutex(g_ctx.renderLock);
-            SDL_DestroyWindow(g_ctx.window);
-            SDL_Quit();
-            return 1;
+        g_ctx.renderer->SetLowLatency(g_ctx.lowLatencyPacing);
+        g_ctx.renderer->BeginInitialize(g_ctx.window);
+
+        // OpenColorIO reads its config with the first decode that converts color, on the
+        // decode thread; $OCIO alone says whether color management was asked for
+        const char* ocioEnv = SDL_getenv("OCIO");
+        g_ctx.ocioEnabled = (ocioEnv && *ocioEnv);
+        g_ctx.displayDevice = "sRGB";
+
+        if (!g_ctx.ocioEnabled) {
+            Logger::Info("OpenColorIO: disabled (no $OCIO)");
+            std::cout << "[INIT] OpenColorIO: disabled (no $OCIO environment variable)" << std::endl;
+        } else {
+            Logger::Info("OpenColorIO: enabled; config loads with the first color-managed image");
+            std::cout << "[INIT] OpenColorIO: enabled with color management" << std::endl;
         }
 
-        Logger::Info("Vulkan renderer initialized successfully");
-        std::cout << "[INIT] Vulkan renderer initialized successfully" << std::endl;
-
-        // Finalize splash: Complete initialization (100%)
-        if (splashRenderer && tr) {
-            SDL_Surface* textSurface = tr->CreateSplashScreenSurface(400, 300, "Ready!");
-            if (textSurface) {
-                SDL_Texture* textTexture = SDL_CreateTextureFromSurface(splashRenderer, textSurface);
-                if (textTexture) {
-                    SDL_SetRenderDrawBlendMode(splashRenderer, SDL_BLENDMODE_BLEND);
-                    SDL_RenderClear(splashRenderer);
-                    SDL_RenderTexture(splashRenderer, textTexture, nullptr, nullptr);
-                    
-                    // Draw complete progress bar (100%) - green for complete
-                    SDL_SetRenderDrawColor(splashRenderer, 0, 200, 100, 255);
-                    SDL_FRect progress = {50, 220, 300, 20};
-                    SDL_RenderFillRect(splashRenderer, &progress);
-                    
-                    SDL_RenderPresent(splashRenderer);
-                    SDL_DestroyTexture(textTexture);
-                }
-                SDL_DestroySurface(textSurface);
+        // Start the background decode worker so loads never block the event loop
+        g_ctx.imageLoader = std::make_unique<ImageLoader>();
+        if (!g_ctx.imageLoader->Start()) {
+            Logger::Warn("Image loader worker unavailable; decoding on the main thread");
+            g_ctx.imageLoader.reset();
+        } else {
+            // Until the device says what it supports, decode the way that leaves the most to it:
+            // paged and mapped sources, and color as a LUT. A result the renderer turns out not
+            // to support is decoded again by HandleImageLoadComplete().
+            DecodeOptions startupOptions;
+            startupOptions.allowPaged = true;
+            startupOptions.gpuColor = true;
+            startupOptions.mappedRows = true;
+            g_ctx.imageLoader->SetDecodeOptions(startupOptions);
+
+            // Decode the command-line file while the device is created
+            if (argc > 1) {
+                std::cout << "[INIT] Loading image from command line: " << argv[1] << std::endl;
+                LoadImageFromFile(argv[1]);
             }
         }
-        
-        // Brief pause to show completion
-        SDL_Delay(500);
-        
-        // Clean up TextRenderer before destroying splash window
-        if (tr) {
-            Logger::Info("Cleaning up splash TextRenderer...");
-            tr->Shutdown();  // Explicit shutdown before delete
-            delete tr;
-            tr = nullptr;
-            Logger::Info("Splash TextRenderer cleaned up successfully");
+
+        // Saves encode in the background so a large write never stalls the window
+        g_ctx.imageSaver = std::make_unique<ImageSaver>();
+        if (!g_ctx.imageSaver->Start()) {
+            Logger::Warn("Image saver worker unavailable; saving on the main thread");
+            g_ctx.imageSaver.reset();
         }
-        
-        // Clean up splash screen
-        if (splashRenderer) {
-            SDL_DestroyRenderer(splashRenderer);
-            splashRenderer = nullptr;
+
+        // Folder listings stream in and stay current without blocking navigation
+        g_ctx.directoryIndexer = std::make_unique<DirectoryIndexer>();
+        if (!g_ctx.directoryIndexer->Start()) {
+            Logger::Warn("Directory indexer unavailable; listing folders on the main thread");
+            g_ctx.directoryIndexer.reset();
         }
-        if (splashWindow) {
-            SDL_DestroyWindow(splashWindow);
-            splashWindow = nullptr;
+
+        // Thumbnails for the grid and filmstrip come from a persistent cache or background decodes
+        g_ctx.thumbnailGrid = std::make_unique<ThumbnailGrid>();
+        if (!g_ctx.thumbnailGrid->Start()) {
+            Logger::Warn("Thumbnail loader unavailable; grid and filmstrip disabled");
+            g_ctx.thumbnailGrid.reset();
         }
-        
-        std::cout << "[INIT] Initialization complete - starting main application" << std::endl;
-        
-        // Process command line arguments
+
+        // Sequence playback starts its decode workers only while a flipbook plays
+        g_ctx.sequencePlayer = std::make_unique<SequencePlayer>();
+        Logger::Info("Pixel conversion kernels: %s", PixelConvert::ActiveKernelName());
+
         if (argc > 1) {
-            std::cout << "[INIT] Loading image from command line: " << argv[1] << std::endl;
-            LoadImageFromFile(argv[1]);
             GetImagesInDirectory(argv[1]);
         }
 
+        // Swapchain and pipelines, on the window's thread
+        if (!g_ctx.renderer->FinishInitialize()) {
+            Logger::Error("Failed to initialize Vulkan renderer");
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", 
+                                   "Failed to initialize Vulkan renderer.", g_ctx.window);
+            g_ctx.renderer.reset();
+            exitCode = 1;
+        } else {
+            Logger::Info("Vulkan renderer initialized successfully (%.1f ms after launch)", MillisecondsSinceLaunch());
+            std::cout << "[INIT] Vulkan renderer initialized successfully" << std::endl;
+
+            // Later decodes use what the device actually supports
+            if (g_ctx.imageLoader) {
+                // Gigapixel tiled files are paged in only where a sparse texture can show them,
+                // and color is left to the GPU when the renderer applies display LUTs
+                g_ctx.imageLoader->SetDecodeOptions(CurrentDecodeOptions());
+            } else if (argc > 1) {
+                std::cout << "[INIT] Loading image from command line: " << argv[1] << std::endl;
+                LoadImageFromFile(argv[1]);
+            }
+            std::cout << "[INIT] Initialization complete - starting main application" << std::endl;
+        }
+
         // Initialize FPS timer
         g_ctx.fpsLastTimeMS = SDL_GetTicks();
 
+        // Launch to first pixels is what startup is measured by: the command-line image once it
+        // is on screen, or the first frame when there is none
+        bool awaitingFirstPixels = true;
+        const bool firstPixelsAreImage = argc > 1;
+
         // Main event loop
-        bool running = true;
+        bool running = exitCode == 0;
         std::vector<std::string> pendingDrops;
 
         SDL_Event event;
+        auto dispatchEvent = [&](const SDL_Event& e) {
+            switch (e.type) {
+                case SDL_EVENT_QUIT:
+                    running = false;
+                    break;
+
+                case SDL_EVENT_DROP_BEGIN:
+                    pendingDrops.clear();
+                    break;
+
+                case SDL_EVENT_DROP_FILE:
+                    if (e.drop.data) {
+                        pendingDrops.emplace_back(e.drop.data);
+                        Logger::Info("Dropped file: %s at (%.1f, %.1f)", 
+                                   e.drop.data, e.drop.x, e.drop.y);
+                    }
+                    break;
+
+                case SDL_EVENT_DROP_COMPLETE:
+                    for (const auto& path : pendingDrops) {
+                        Logger::Info("Processing dropped file: %s", path.c_str());
+                        LoadImageFromFile(path.c_str());
+                        GetImagesInDirectory(path.c_str());
+                        break; // Only load the first file for now
+                    }
+                    pendingDrops.clear();
+                    RequestRedraw();
+                    break;
+
+                default:
+                    HandleSDLEvent(e);
+                    break;
+            }
+        };
+
         while (running) {
-            while (SDL_PollEvent(&event)) {
-                switch (event.type) {
-                    case SDL_EVENT_QUIT:
-                        running = false;
-                        break;
-
-                    case SDL_EVENT_DROP_BEGIN:
-                        pendingDrops.clear();
-                        break;
-
-                    case SDL_EVENT_DROP_FILE:
-                        if (event.drop.data) {
-                            pendingDrops.emplace_back(event.drop.data);
-                            Logger::Info("Dropped file: %s at (%.1f, %.1f)", 
-                                       event.drop.data, event.drop.x, event.drop.y);
-                        }
-                        break;
-
-                    case SDL_EVENT_DROP_COMPLETE:
-                        for (const auto& path : pendingDrops) {
-                            Logger::Info("Processing dropped file: %s", path.c_str());
-                            LoadImageFromFile(path.c_str());
-                            GetImagesInDirectory(path.c_str());
-                            break; // Only load the first file for now
-                        }
-                        pendingDrops.clear();
-                        break;
-
-                    default:
-                        HandleSDLEvent(event);
-                        break;
+            // NASA Standard: Idle on the event queue instead of spinning. Block until
+            // input, a window event or a loader completion arrives; wake once more
+            // after a burst of frames so the FPS title settles.
+            bool haveEvent = false;
+            if (g_ctx.needsRedraw || NeedsContinuousRedraw()) {
+                haveEvent = SDL_PollEvent(&event);
+            } else {
+                Sint32 timeoutMS = -1;
+                if (g_ctx.showFps && g_ctx.fpsFrameCount > 0) {
+                    const uint64_t sinceTitle = SDL_GetTicks() - g_ctx.fpsLastTimeMS;
+                    timeoutMS = sinceTitle >= 1000 ? 0 : static_cast<Sint32>(1000 - sinceTitle);
                 }
+                haveEvent = SDL_WaitEventTimeout(&event, timeoutMS);
             }
 
-            // FPS accounting
-            ++g_ctx.fpsFrameCount;
+            for (; haveEvent; haveEvent = SDL_PollEvent(&event)) {
+                dispatchEvent(event);
+            }
+
+            // Low latency: wait for the last frame to reach the screen, then take the input
+            // that arrived meanwhile so this frame answers it
+            if ((g_ctx.needsRedraw || NeedsContinuousRedraw()) && g_ctx.renderer && !g_ctx.rendererNeedsReset) {
+                g_ctx.renderer->PaceFrame();
+                while (SDL_PollEvent(&event)) {
+                    dispatchEvent(event);
+                }
+            }
+
+            // FPS accounting covers frames actually drawn
+            const bool drawFrame = g_ctx.needsRedraw || NeedsContinuousRedraw();
             uint64_t now = SDL_GetTicks();
+            if (drawFrame) {
+                // Restart the window after idling so the first frame doesn't average in the sleep
+                if (g_ctx.fpsFrameCount == 0 && now - g_ctx.fpsLastTimeMS >= 1000) {
+                    g_ctx.fpsLastTimeMS = now;
+                }
+                ++g_ctx.fpsFrameCount;
+            }
             uint64_t elapsed = now - g_ctx.fpsLastTimeMS;
             if (elapsed >= 1000) {
                 g_ctx.fps = static_cast<float>(g_ctx.fpsFrameCount) * 1000.0f / static_cast<float>(elapsed);
@@ -405,15 +444,31 @@ int main(int argc, char* argv[]) {
                 const bool deviceLost = (g_ctx.renderer && g_ctx.renderer->IsDeviceLost());
                 if (g_ctx.renderer && deviceLost) {
                     Logger::Warn("Reset: device lost detected — performing full renderer rebuild");
+                    // The texture ring goes with the device
+                    if (g_ctx.sequencePlayer) {
+                        g_ctx.sequencePlayer->Stop(nullptr);
+                    }
                     g_ctx.renderer->Shutdown();
                     g_ctx.renderer.reset();
                     g_ctx.renderer = std::make_unique<VulkanRenderer>();
+                    g_ctx.renderer->SetLowLatency(g_ctx.lowLatencyPacing);
                     if (!g_ctx.renderer->Initialize(g_ctx.window)) {
                         Logger::Error("Reset: VulkanRenderer re-initialization FAILED after device lost");
                         g_ctx.renderer.reset();
                     } else {
                         Logger::Info("Reset: VulkanRenderer re-initialized after device lost");
                     }
+                    if (g_ctx.imageLoader) {
+                        g_ctx.imageLoader->SetDecodeOptions(CurrentDecodeOptions());
+                    }
+                    if (g_ctx.thumbnailGrid) {
+                        g_ctx.thumbnailGrid->ResetAtlas();
+                    }
+                    // The texture went with the old device; the image on screen is installed again
+                    if (g_ctx.renderer) {
+                        UploadCurrentImage();
+                        RequestRedraw();
+                    }
                 } else if (g_ctx.renderer) {
                     int w, h;
                     SDL_GetWindowSize(g_ctx.window, &w, &h);
@@ -427,12 +482,25 @@ int main(int argc, char* argv[]) {
                 SDL_UnlockMutex(g_ctx.renderLock);
             }
 
-            // Render frame
-            if (g_ctx.renderer) {
-                DrawImage(); // This will be implemented in image_drawing.cpp
+            // Render frame; clear the flag first so state changed while drawing schedules another
+            if (drawFrame) {
+                g_ctx.needsRedraw = false;
+                if (g_ctx.renderer) {
+                    DrawImage();
+                }
             }
 
-            SDL_Delay(1);
+            if (awaitingFirstPixels && g_ctx.renderer && drawFrame &&
+                (!firstPixelsAreImage || (g_ctx.imageData.isValid() && !g_ctx.renderer->HasPendingUpload()))) {
+                awaitingFirstPixels = false;
+                const double launchMs = MillisecondsSinceLaunch();
+                Logger::Info("Startup: first %s on screen %.1f ms after launch",
+                             firstPixelsAreImage ? "image" : "frame", launchMs);
+                if (Trace::IsEnabled() && launchMs > 0.0) {
+                    const uint64_t nowNs = Trace::Now();
+                    Trace::Record(Trace::Stage::Startup, nowNs - static_cast<uint64_t>(launchMs * 1e6), nowNs);
+                }
+            }
         }
 
     } catch (const std::exception& e) {
@@ -448,14 +516,34 @@ int main(int argc, char* argv[]) {
     // Cleanup - VERY IMPORTANT: Clean up in reverse order of initialization
     Logger::Info("Shutting down application");
     
-    // 1. Clean up any remaining TextRenderer instances first (before SDL shutdown)
-    if (tr) {
-        Logger::Info("Emergency cleanup of splash TextRenderer...");
-        tr->Shutdown();
-        delete tr;
-        tr = nullptr;
+    // 1. Finish any save still writing, stop the directory watch, thumbnail and sequence workers,
+    //    then the decode worker and its thread pool before the renderer they feed
+    if (g_ctx.imageSaver) {
+        Logger::Info("Stopping image saver...");
+        g_ctx.imageSaver->Shutdown();
+        g_ctx.imageSaver.reset();
     }
-    
+    if (g_ctx.directoryIndexer) {
+        Logger::Info("Stopping directory indexer...");
+        g_ctx.directoryIndexer->Shutdown();
+        g_ctx.directoryIndexer.reset();
+    }
+    if (g_ctx.thumbnailGrid) {
+        Logger::Info("Stopping thumbnail loader...");
+        g_ctx.thumbnailGrid->Shutdown();
+        g_ctx.thumbnailGrid.reset();
+    }
+    if (g_ctx.sequencePlayer) {
+        g_ctx.sequencePlayer->Stop(g_ctx.renderer.get());
+        g_ctx.sequencePlayer.reset();
+    }
+    if (g_ctx.imageLoader) {
+        Logger::Info("Stopping image loader...");
+        g_ctx.imageLoader->Shutdown();
+        g_ctx.imageLoader.reset();
+    }
+    WorkerPool::Shared().Shutdown();
+
     // 2. Shutdown Vulkan renderer
     if (g_ctx.renderer) {
         Logger::Info("Shutting down Vulkan renderer...");
@@ -492,8 +580,16 @@ int main(int argc, char* argv[]) {
     SDL_Quit();
     Logger::Info("SDL shut down successfully");
     
-    // 7. Logger shutdown last
+    // 7. Write the startup-requested trace now every worker has finished, then the logger last
+    if (!tracePath.empty()) {
+        std::string traceError;
+        if (Trace::ExportChromeTrace(tracePath, traceError)) {
+            Logger::InfoW(L"Trace written to %ls", tracePath.c_str());
+        } else {
+            Logger::Warn("Trace export failed: %s", traceError.c_str());
+        }
+    }
     Logger::Shutdown();
     
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,879 @@
+#include "mapped_image.h"
+#include "pixel_convert.h"
+#include "logging.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // Smallest file worth mapping: anything shorter has no room for a header and pixels
+    constexpr uint64_t kMinFileBytes = 16;
+    // Largest header field list parsed (TIFF strips, EXR channels); real files stay far below
+    constexpr uint32_t kMaxListEntries = 1u << 20;
+
+    uint16_t Load16(const uint8_t* p, bool bigEndian) {
+        return bigEndian ? static_cast<uint16_t>((p[0] << 8) | p[1])
+                         : static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t Load32(const uint8_t* p, bool bigEndian) {
+        return bigEndian ? (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+                           (static_cast<uint32_t>(p[2]) << 8) | p[3]
+                         : p[0] | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+                           (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint64_t Load64LE(const uint8_t* p) {
+        return static_cast<uint64_t>(Load32(p, false)) | (static_cast<uint64_t>(Load32(p + 4, false)) << 32);
+    }
+
+    float LoadF32(const uint8_t* p, bool bigEndian) {
+        const uint32_t bits = Load32(p, bigEndian);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool IsSpace(uint8_t c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Next PNM header token; '#' starts a comment running to the end of the line
+    bool NextToken(const uint8_t* data, uint64_t size, uint64_t& pos, std::string& token) {
+        while (pos < size && (IsSpace(data[pos]) || data[pos] == '#')) {
+            if (data[pos] == '#') {
+                while (pos < size && data[pos] != '\n' && data[pos] != '\r') ++pos;
+            } else {
+                ++pos;
+            }
+        }
+        token.clear();
+        while (pos < size && !IsSpace(data[pos]) && token.size() < 32) {
+            token.push_back(static_cast<char>(data[pos++]));
+        }
+        return !token.empty() && token.size() < 32;
+    }
+
+    bool ParseUint(const std::string& token, uint32_t maxValue, uint32_t& out) {
+        char* end = nullptr;
+        const unsigned long value = std::strtoul(token.c_str(), &end, 10);
+        if (end == token.c_str() || *end != '\0' || value == 0 || value > maxValue) {
+            return false;
+        }
+        out = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    bool ValidDimensions(uint32_t width, uint32_t height) {
+        return width > 0 && height > 0 && width <= 65536 && height <= 65536;
+    }
+
+    // Stored channel index for R, G, B, A of grey, grey+alpha, RGB and RGBA pixels
+    void DefaultOrder(uint32_t channels, uint8_t order[4], uint8_t none) {
+        if (channels <= 2) {
+            order[0] = order[1] = order[2] = 0;
+            order[3] = channels == 2 ? 1 : none;
+        } else {
+            order[0] = 0;
+            order[1] = 1;
+            order[2] = 2;
+            order[3] = channels >= 4 ? 3 : none;
+        }
+    }
+
+    // Byte of a 32-bit DDS channel mask; -1 unless it selects exactly one whole byte
+    int MaskByte(uint32_t mask) {
+        for (int b = 0; b < 4; ++b) {
+            if (mask == (0xffu << (8 * b))) return b;
+        }
+        return -1;
+    }
+
+    constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+}
+
+MappedImage::~MappedImage() {
+    Close();
+}
+
+bool MappedImage::Open(const std::wstring& filePath, bool isHdr) {
+    // NASA Standard: Validate all input parameters
+    if (filePath.empty()) {
+        return false;
+    }
+
+    Close();
+
+    // Others may keep writing, renaming or deleting the file; the view holds its own reference
+    HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(kMinFileBytes) ||
+        static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return false;
+    }
+
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<uint64_t>(fileSize.QuadPart);
+    isHdr_ = isHdr;
+    pixelSize_ = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+
+    bool parsed = false;
+    const bool read = guardedRead([&] {
+        if (data_[0] == 'P' && (data_[1] == '5' || data_[1] == '6' || data_[1] == 'f' || data_[1] == 'F')) {
+            parsed = parsePnm();
+        } else if (std::memcmp(data_, "DDS ", 4) == 0) {
+            parsed = parseDds();
+        } else if (std::memcmp(data_, "SDPX", 4) == 0 || std::memcmp(data_, "XPDS", 4) == 0) {
+            parsed = parseDpx();
+        } else if (std::memcmp(data_, "II", 2) == 0 || std::memcmp(data_, "MM", 2) == 0) {
+            parsed = parseTiff();
+        } else if (Load32(data_, false) == 20000630) {
+            parsed = parseExr();
+        }
+    });
+    if (!read || !parsed) {
+        Close();
+        return false;
+    }
+
+    Logger::Info("MappedImage: %s %ux%u read in place (%s)", formatName_, width_, height_,
+                 directPitch_ != 0 ? "texture layout" : "converted per row");
+    return true;
+}
+
+void MappedImage::Close() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    formatName_ = "";
+    width_ = 0;
+    height_ = 0;
+    rowOffsets_.clear();
+    directPitch_ = 0;
+    unreadable_.store(false, std::memory_order_relaxed);
+}
+
+bool MappedImage::guardedRead(const std::function<void()>& read) {
+    // A mapped file that goes away raises EXCEPTION_IN_PAGE_ERROR on the next fault
+    // instead of returning an error. No objects with destructors live in this frame,
+    // as __try requires; C++ exceptions from 'read' pass through the filter.
+    __try {
+        read();
+        return true;
+    } __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
+        return false;
+    }
+}
+
+void MappedImage::markUnreadable() {
+    if (!unreadable_.exchange(true, std::memory_order_acq_rel)) {
+        Logger::Error("MappedImage: %s %ux%u can no longer be read; its file or volume went away",
+                      formatName_, width_, height_);
+    }
+}
+
+bool MappedImage::parsePnm() {
+    const bool pfm = data_[1] == 'f' || data_[1] == 'F';
+    const uint32_t channels = (data_[1] == '6' || data_[1] == 'F') ? 3 : 1;
+
+    uint64_t pos = 2;
+    std::string token;
+    if (!NextToken(data_, size_, pos, token) || !ParseUint(token, 65536, width_) ||
+        !NextToken(data_, size_, pos, token) || !ParseUint(token, 65536, height_) ||
+        !NextToken(data_, size_, pos, token)) {
+        return false;
+    }
+
+    uint32_t sampleBytes = 4;
+    if (pfm) {
+        // The scale's sign gives the byte order; its magnitude is only a hint for readers
+        char* end = nullptr;
+        const double scale = std::strtod(token.c_str(), &end);
+        if (end == token.c_str() || *end != '\0' || scale == 0.0 || !std::isfinite(scale)) {
+            return false;
+        }
+        encoding_ = Encoding::F32;
+        bigEndian_ = scale > 0.0;
+        formatName_ = "PFM";
+    } else {
+        if (!ParseUint(token, 65535, maxValue_)) {
+            return false;
+        }
+        encoding_ = maxValue_ < 256 ? Encoding::U8 : Encoding::U16;
+        sampleBytes = maxValue_ < 256 ? 1 : 2;
+        bigEndian_ = true;
+        formatName_ = "PNM";
+    }
+
+    // A single whitespace byte separates the header from the samples
+    if (pos >= size_ || !IsSpace(data_[pos])) {
+        return false;
+    }
+    ++pos;
+
+    uint8_t order[4];
+    DefaultOrder(channels, order, kNoChannel);
+    setInterleaved(channels, sampleBytes, order);
+
+    // PFM stores rows bottom to top
+    const uint64_t rowBytes = static_cast<uint64_t>(width_) * channels * sampleBytes;
+    rowOffsets_.resize(height_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        const uint32_t stored = pfm ? height_ - 1 - y : y;
+        rowOffsets_[y] = pos + stored * rowBytes;
+    }
+    return finishLayout(rowBytes);
+}
+
+bool MappedImage::parseDds() {
+    constexpr uint64_t kHeaderEnd = 4 + 124;
+    if (size_ < kHeaderEnd) {
+        return false;
+    }
+    const uint8_t* header = data_ + 4;
+    if (Load32(header, false) != 124) {
+        return false;
+    }
+    height_ = Load32(header + 8, false);
+    width_ = Load32(header + 12, false);
+    const uint8_t* pf = header + 72;
+    const uint32_t pfFlags = Load32(pf + 4, false);
+    const uint32_t caps2 = Load32(header + 108, false);
+    // Cube maps and volumes are not 2D images
+    if (!ValidDimensions(width_, height_) || (caps2 & (0x200u | 0x200000u)) != 0) {
+        return false;
+    }
+
+    uint64_t dataOffset = kHeaderEnd;
+    uint32_t channels = 0;
+    uint32_t sampleBytes = 1;
+    uint8_t order[4];
+    encoding_ = Encoding::U8;
+    maxValue_ = 255;
+
+    if (pfFlags & 0x4u) {           // DDPF_FOURCC
+        const uint32_t fourCC = Load32(pf + 8, false);
+        uint32_t format = 0;
+        if (fourCC == MakeFourCC('D', 'X', '1', '0')) {
+            if (size_ < kHeaderEnd + 20) {
+                return false;
+            }
+            const uint8_t* dx10 = data_ + kHeaderEnd;
+            const uint32_t dimension = Load32(dx10 + 4, false);
+            const uint32_t miscFlags = Load32(dx10 + 8, false);
+            const uint32_t arraySize = Load32(dx10 + 12, false);
+            if (dimension != 3 || arraySize != 1 || (miscFlags & 0x4u) != 0) {   // 2D, single, not a cube
+                return false;
+            }
+            format = Load32(dx10, false);
+            dataOffset = kHeaderEnd + 20;
+        } else if (fourCC == 113) {     // D3DFMT_A16B16G16R16F
+            format = 10;
+        } else if (fourCC == 116) {     // D3DFMT_A32B32G32R32F
+            format = 2;
+        } else {
+            return false;               // Block-compressed or a layout not handled here
+        }
+
+        switch (format) {
+        case 28: case 29:               // R8G8B8A8_UNORM(_SRGB)
+            channels = 4;
+            DefaultOrder(4, order, kNoChannel);
+            break;
+        case 87: case 91:               // B8G8R8A8_UNORM(_SRGB)
+        case 88: case 93:               // B8G8R8X8_UNORM(_SRGB)
+            channels = 4;
+            order[0] = 2;
+            order[1] = 1;
+            order[2] = 0;
+            order[3] = (format == 87 || format == 91) ? 3 : kNoChannel;
+            break;
+        case 61:                        // R8_UNORM
+            channels = 1;
+            DefaultOrder(1, order, kNoChannel);
+            break;
+        case 10:                        // R16G16B16A16_FLOAT
+            channels = 4;
+            sampleBytes = 2;
+            encoding_ = Encoding::F16;
+            DefaultOrder(4, order, kNoChannel);
+            break;
+        case 2:                         // R32G32B32A32_FLOAT
+        case 6:                         // R32G32B32_FLOAT
+            channels = format == 2 ? 4 : 3;
+            sampleBytes = 4;
+            encoding_ = Encoding::F32;
+            DefaultOrder(channels, order, kNoChannel);
+            break;
+        default:
+            return false;
+        }
+    } else if (pfFlags & 0x40u) {   // DDPF_RGB: byte-aligned channel masks only
+        const uint32_t bits = Load32(pf + 12, false);
+        if (bits != 24 && bits != 32) {
+            return false;
+        }
+        channels = bits / 8;
+        const int r = MaskByte(Load32(pf + 16, false));
+        const int g = MaskByte(Load32(pf + 20, false));
+        const int b = MaskByte(Load32(pf + 24, false));
+        const int a = (pfFlags & 0x1u) ? MaskByte(Load32(pf + 28, false)) : -1;
+        if (r < 0 || g < 0 || b < 0 || r >= static_cast<int>(channels) || g >= static_cast<int>(channels) ||
+            b >= static_cast<int>(channels) || a >= static_cast<int>(channels)) {
+            return false;
+        }
+        order[0] = static_cast<uint8_t>(r);
+        order[1] = static_cast<uint8_t>(g);
+        order[2] = static_cast<uint8_t>(b);
+        order[3] = a >= 0 ? static_cast<uint8_t>(a) : kNoChannel;
+    } else if (pfFlags & 0x20000u) { // DDPF_LUMINANCE: L8 or L8A8
+        const uint32_t bits = Load32(pf + 12, false);
+        const bool withAlpha = (pfFlags & 0x1u) != 0;
+        if (bits != (withAlpha ? 16u : 8u) || MaskByte(Load32(pf + 16, false)) != 0 ||
+            (withAlpha && MaskByte(Load32(pf + 28, false)) != 1)) {
+            return false;
+        }
+        channels = withAlpha ? 2 : 1;
+        DefaultOrder(channels, order, kNoChannel);
+    } else {
+        return false;
+    }
+
+    setInterleaved(channels, sampleBytes, order);
+    formatName_ = "DDS";
+
+    // Only the top level of a mip chain or array is read; it comes first
+    const uint64_t rowBytes = static_cast<uint64_t>(width_) * channels * sampleBytes;
+    rowOffsets_.resize(height_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        rowOffsets_[y] = dataOffset + y * rowBytes;
+    }
+    return finishLayout(rowBytes);
+}
+
+bool MappedImage::parseDpx() {
+    constexpr uint64_t kElementOffset = 780;
+    if (size_ < kElementOffset + 40) {
+        return false;
+    }
+    bigEndian_ = data_[0] == 'S';
+    const uint32_t imageOffset = Load32(data_ + 4, bigEndian_);
+    const uint16_t orientation = Load16(data_ + 768, bigEndian_);
+    const uint16_t elements = Load16(data_ + 770, bigEndian_);
+    width_ = Load32(data_ + 772, bigEndian_);
+    height_ = Load32(data_ + 776, bigEndian_);
+    if (!ValidDimensions(width_, height_) || orientation != 0 || elements != 1) {
+        return false;
+    }
+
+    const uint8_t* element = data_ + kElementOffset;
+    const uint32_t dataSign = Load32(element, bigEndian_);
+    const uint8_t descriptor = element[20];
+    const uint8_t bitDepth = element[23];
+    const uint16_t packing = Load16(element + 24, bigEndian_);
+    const uint16_t rle = Load16(element + 26, bigEndian_);
+    uint32_t dataOffset = Load32(element + 28, bigEndian_);
+    uint32_t eolPadding = Load32(element + 32, bigEndian_);
+    if (dataOffset == 0 || dataOffset == UINT32_MAX) dataOffset = imageOffset;
+    if (eolPadding == UINT32_MAX) eolPadding = 0;
+    if (dataSign != 0 || rle != 0) {
+        return false;
+    }
+
+    uint32_t channels = 0;
+    switch (descriptor) {
+    case 6: channels = 1; break;    // Luma
+    case 50: channels = 3; break;   // RGB
+    case 51: channels = 4; break;   // RGBA
+    default: return false;
+    }
+
+    uint64_t rowBytes = 0;
+    uint8_t order[4];
+    DefaultOrder(channels, order, kNoChannel);
+    if (bitDepth == 10) {
+        // One RGB pixel per 32-bit word, padded in the low (method A) or high (method B) bits
+        if (descriptor != 50 || (packing != 1 && packing != 2)) {
+            return false;
+        }
+        encoding_ = Encoding::Dpx10;
+        maxValue_ = 1023;
+        hasAlpha_ = false;
+        srcStep_ = 4;
+        const uint32_t base = packing == 1 ? 2 : 0;
+        srcShift_[0] = base + 20;
+        srcShift_[1] = base + 10;
+        srcShift_[2] = base;
+        rowBytes = static_cast<uint64_t>(width_) * 4;
+    } else if (bitDepth == 8 || bitDepth == 16) {
+        const uint32_t sampleBytes = bitDepth / 8;
+        encoding_ = bitDepth == 8 ? Encoding::U8 : Encoding::U16;
+        maxValue_ = bitDepth == 8 ? 255 : 65535;
+        setInterleaved(channels, sampleBytes, order);
+        // Lines end on a 32-bit boundary
+        rowBytes = (static_cast<uint64_t>(width_) * channels * sampleBytes + 3) & ~uint64_t(3);
+    } else {
+        return false;
+    }
+    formatName_ = "DPX";
+
+    const uint64_t pitch = rowBytes + eolPadding;
+    rowOffsets_.resize(height_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        rowOffsets_[y] = dataOffset + y * pitch;
+    }
+    return finishLayout(rowBytes);
+}
+
+bool MappedImage::parseTiff() {
+    bigEndian_ = data_[0] == 'M';
+    if (size_ < 8 || Load16(data_ + 2, bigEndian_) != 42) {
+        return false;   // BigTIFF (43) is left to the decoder
+    }
+    const uint64_t ifd = Load32(data_ + 4, bigEndian_);
+    if (ifd + 2 > size_) {
+        return false;
+    }
+    const uint32_t entryCount = Load16(data_ + ifd, bigEndian_);
+    if (ifd + 2 + static_cast<uint64_t>(entryCount) * 12 > size_) {
+        return false;
+    }
+
+    // Values of a SHORT or LONG entry, inline or at its offset
+    auto readValues = [&](const uint8_t* entry, std::vector<uint32_t>& values) {
+        const uint16_t type = Load16(entry + 2, bigEndian_);
+        const uint32_t count = Load32(entry + 4, bigEndian_);
+        const uint32_t valueBytes = type == 3 ? 2 : (type == 4 ? 4 : 0);
+        if (valueBytes == 0 || count == 0 || count > kMaxListEntries) {
+            return false;
+        }
+        const uint64_t total = static_cast<uint64_t>(count) * valueBytes;
+        const uint8_t* p = entry + 8;
+        if (total > 4) {
+            const uint64_t offset = Load32(entry + 8, bigEndian_);
+            if (offset + total > size_) return false;
+            p = data_ + offset;
+        }
+        values.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            values[i] = valueBytes == 2 ? Load16(p + i * 2, bigEndian_) : Load32(p + i * 4, bigEndian_);
+        }
+        return true;
+    };
+
+    uint32_t compression = 1;
+    uint32_t photometric = UINT32_MAX;
+    uint32_t samplesPerPixel = 1;
+    uint32_t rowsPerStrip = UINT32_MAX;
+    uint32_t planar = 1;
+    uint32_t sampleFormat = 1;
+    std::vector<uint32_t> bitsPerSample{ 1 };
+    std::vector<uint32_t> stripOffsets;
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const uint8_t* entry = data_ + ifd + 2 + i * 12;
+        const uint16_t tag = Load16(entry, bigEndian_);
+        switch (tag) {
+        case 256: case 257: case 259: case 262: case 277: case 278: case 284: case 339:
+            if (!readValues(entry, values)) return false;
+            if (tag == 256) width_ = values[0];
+            else if (tag == 257) height_ = values[0];
+            else if (tag == 259) compression = values[0];
+            else if (tag == 262) photometric = values[0];
+            else if (tag == 277) samplesPerPixel = values[0];
+            else if (tag == 278) rowsPerStrip = values[0];
+            else if (tag == 284) planar = values[0];
+            else if (std::any_of(values.begin(), values.end(), [&](uint32_t v) { return v != values[0]; })) {
+                return false;   // Mixed sample formats
+            } else {
+                sampleFormat = values[0];
+            }
+            break;
+        case 258:
+            if (!readValues(entry, bitsPerSample)) return false;
+            break;
+        case 273:
+            if (!readValues(entry, stripOffsets)) return false;
+            break;
+        case 317:               // Predictor: only meaningful with compression
+            if (!readValues(entry, values) || values[0] != 1) return false;
+            break;
+        case 322: case 323:     // Tiled layouts are read through the decoder's tile path
+            return false;
+        default:
+            break;
+        }
+    }
+
+    if (!ValidDimensions(width_, height_) || compression != 1 || stripOffsets.empty() ||
+        samplesPerPixel == 0 || (planar != 1 && samplesPerPixel > 1) ||
+        (!(photometric == 1 && samplesPerPixel <= 2) && !(photometric == 2 && samplesPerPixel >= 3))) {
+        return false;
+    }
+    const uint32_t bits = bitsPerSample[0];
+    if (std::any_of(bitsPerSample.begin(), bitsPerSample.end(), [&](uint32_t b) { return b != bits; })) {
+        return false;
+    }
+    if (sampleFormat == 1 && bits == 8) {
+        encoding_ = Encoding::U8;
+        maxValue_ = 255;
+    } else if (sampleFormat == 1 && bits == 16) {
+        encoding_ = Encoding::U16;
+        maxValue_ = 65535;
+    } else if (sampleFormat == 3 && bits == 16) {
+        encoding_ = Encoding::F16;
+    } else if (sampleFormat == 3 && bits == 32) {
+        encoding_ = Encoding::F32;
+    } else {
+        return false;
+    }
+
+    // Samples past the fourth are skipped, as the decoder reads only four channels
+    const uint32_t sampleBytes = bits / 8;
+    uint8_t order[4];
+    DefaultOrder(std::min(samplesPerPixel, 4u), order, kNoChannel);
+    setInterleaved(samplesPerPixel, sampleBytes, order);
+    formatName_ = "TIFF";
+
+    const uint64_t rowBytes = static_cast<uint64_t>(width_) * samplesPerPixel * sampleBytes;
+    rowsPerStrip = std::clamp(rowsPerStrip, 1u, height_);
+    if (stripOffsets.size() < (height_ + rowsPerStrip - 1) / rowsPerStrip) {
+        return false;
+    }
+    rowOffsets_.resize(height_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        rowOffsets_[y] = stripOffsets[y / rowsPerStrip] + static_cast<uint64_t>(y % rowsPerStrip) * rowBytes;
+    }
+    return finishLayout(rowBytes);
+}
+
+bool MappedImage::parseExr() {
+    const uint32_t version = Load32(data_ + 4, false);
+    // Version 2, single-part scanlines: no tiles (0x200), deep data (0x800) or parts (0x1000)
+    if ((version & 0xffu) != 2 || (version & (0x200u | 0x800u | 0x1000u)) != 0) {
+        return false;
+    }
+
+    struct Channel {
+        std::string name;
+        uint32_t bytes = 0;
+        int32_t pixelType = 0;
+    };
+    std::vector<Channel> channels;
+    int32_t window[4] = {};
+    bool haveWindow = false;
+    int compression = -1;
+
+    // Null-terminated string starting at 'pos'
+    auto readString = [&](uint64_t& pos, std::string& out) {
+        out.clear();
+        while (pos < size_ && data_[pos] != 0 && out.size() < 256) {
+            out.push_back(static_cast<char>(data_[pos++]));
+        }
+        if (pos >= size_ || data_[pos] != 0) return false;
+        ++pos;
+        return true;
+    };
+
+    uint64_t pos = 8;
+    std::string name;
+    std::string type;
+    for (;;) {
+        if (!readString(pos, name)) return false;
+        if (name.empty()) break;    // End of header
+        if (!readString(pos, type) || pos + 4 > size_) return false;
+        const uint32_t attrSize = Load32(data_ + pos, false);
+        pos += 4;
+        if (pos + attrSize > size_) return false;
+        const uint8_t* value = data_ + pos;
+
+        if (name == "channels" && type == "chlist") {
+            uint64_t c = pos;
+            const uint64_t end = pos + attrSize;
+            std::string channelName;
+            while (c < end) {
+                if (!readString(c, channelName)) return false;
+                if (channelName.empty()) break;
+                if (c + 16 > end || channels.size() >= kMaxListEntries) return false;
+                Channel channel;
+                channel.name = channelName;
+                channel.pixelType = static_cast<int32_t>(Load32(data_ + c, false));
+                channel.bytes = channel.pixelType == 1 ? 2 : 4;      // HALF, else UINT / FLOAT
+                const int32_t xSampling = static_cast<int32_t>(Load32(data_ + c + 8, false));
+                const int32_t ySampling = static_cast<int32_t>(Load32(data_ + c + 12, false));
+                if (xSampling != 1 || ySampling != 1) return false;
+                channels.push_back(channel);
+                c += 16;
+            }
+        } else if (name == "compression" && attrSize >= 1) {
+            compression = value[0];
+        } else if (name == "dataWindow" && type == "box2i" && attrSize >= 16) {
+            for (int i = 0; i < 4; ++i) {
+                window[i] = static_cast<int32_t>(Load32(value + i * 4, false));
+            }
+            haveWindow = true;
+        } else if (name == "tiles") {
+            return false;
+        }
+        pos += attrSize;
+    }
+
+    if (compression != 0 || !haveWindow || channels.empty() ||
+        window[2] < window[0] || window[3] < window[1]) {
+        return false;
+    }
+    width_ = static_cast<uint32_t>(static_cast<int64_t>(window[2]) - window[0] + 1);
+    height_ = static_cast<uint32_t>(static_cast<int64_t>(window[3]) - window[1] + 1);
+    if (!ValidDimensions(width_, height_)) {
+        return false;
+    }
+
+    // Uncompressed blocks hold one scanline: each channel's samples in turn, channels
+    // sorted by name. Only plain RGB(A) or Y(A) images are read here.
+    int r = -1, g = -1, b = -1, a = -1, luma = -1;
+    uint64_t rowBytes = 0;
+    for (size_t i = 0; i < channels.size(); ++i) {
+        const std::string& n = channels[i].name;
+        int* slot = n == "R" ? &r : n == "G" ? &g : n == "B" ? &b : n == "A" ? &a : n == "Y" ? &luma : nullptr;
+        if (slot == nullptr || *slot >= 0) {
+            return false;
+        }
+        *slot = static_cast<int>(i);
+        rowBytes += static_cast<uint64_t>(width_) * channels[i].bytes;
+    }
+    if (luma >= 0) {
+        if (r >= 0 || g >= 0 || b >= 0) return false;
+        r = g = b = luma;
+    } else if (r < 0 || g < 0 || b < 0) {
+        return false;
+    }
+    const int32_t pixelType = channels[r].pixelType;
+    for (const Channel& channel : channels) {
+        if (channel.pixelType != pixelType) return false;
+    }
+    if (pixelType != 1 && pixelType != 2) {
+        return false;   // UINT samples
+    }
+    encoding_ = pixelType == 1 ? Encoding::F16 : Encoding::F32;
+    bigEndian_ = false;
+    const uint32_t sampleBytes = channels[r].bytes;
+    srcStep_ = sampleBytes;
+    const int picked[4] = { r, g, b, a };
+    for (int c = 0; c < 4; ++c) {
+        if (picked[c] >= 0) {
+            srcOffset_[c] = static_cast<uint32_t>(picked[c]) * width_ * sampleBytes;
+        }
+    }
+    hasAlpha_ = a >= 0;
+    formatName_ = "EXR";
+
+    // The header ends with a null byte, followed by one offset per scanline block
+    const uint64_t tableOffset = pos;
+    if (tableOffset + static_cast<uint64_t>(height_) * 8 > size_) {
+        return false;
+    }
+    rowOffsets_.resize(height_);
+    for (uint32_t y = 0; y < height_; ++y) {
+        const uint64_t block = Load64LE(data_ + tableOffset + static_cast<uint64_t>(y) * 8);
+        if (block > size_ || size_ - block < 8 + rowBytes) {
+            return false;
+        }
+        rowOffsets_[y] = block + 8;
+    }
+    // Spot-check block headers (y, byte count) at both ends rather than touching every page
+    for (uint32_t y : { 0u, height_ - 1 }) {
+        const uint8_t* block = data_ + rowOffsets_[y] - 8;
+        if (static_cast<int32_t>(Load32(block, false)) != window[1] + static_cast<int32_t>(y) ||
+            Load32(block + 4, false) != rowBytes) {
+            return false;
+        }
+    }
+    return finishLayout(rowBytes);
+}
+
+void MappedImage::setInterleaved(uint32_t channels, uint32_t sampleBytes, const uint8_t order[4]) {
+    srcStep_ = channels * sampleBytes;
+    for (int c = 0; c < 4; ++c) {
+        srcOffset_[c] = order[c] != kNoChannel ? order[c] * sampleBytes : 0;
+    }
+    hasAlpha_ = order[3] != kNoChannel;
+}
+
+bool MappedImage::finishLayout(uint64_t storedRowBytes) {
+    if (rowOffsets_.size() != height_ || storedRowBytes == 0) {
+        return false;
+    }
+    for (uint64_t offset : rowOffsets_) {
+        if (offset > size_ || size_ - offset < storedRowBytes) {
+            return false;   // Truncated file
+        }
+    }
+
+    // Rows usable as texture texels: four samples in RGBA order, evenly spaced top-down rows
+    directPitch_ = 0;
+    const uint32_t sampleBytes = pixelSize_ / 4;
+    const bool sameTexels = isHdr_ ? (encoding_ == Encoding::F16 && !bigEndian_)
+                                   : (encoding_ == Encoding::U8 && maxValue_ == 255);
+    const bool rgbaOrder = hasAlpha_ && srcStep_ == pixelSize_ && srcOffset_[0] == 0 &&
+                           srcOffset_[1] == sampleBytes && srcOffset_[2] == 2 * sampleBytes &&
+                           srcOffset_[3] == 3 * sampleBytes;
+    if (sameTexels && rgbaOrder) {
+        const uint64_t pitch = height_ > 1 ? rowOffsets_[1] - rowOffsets_[0] : storedRowBytes;
+        bool uniform = height_ == 1 || (rowOffsets_[1] > rowOffsets_[0] && pitch >= storedRowBytes);
+        for (uint32_t y = 2; uniform && y < height_; ++y) {
+            uniform = rowOffsets_[y] - rowOffsets_[y - 1] == pitch;
+        }
+        if (uniform) {
+            directPitch_ = pitch;
+        }
+    }
+    return true;
+}
+
+float MappedImage::loadSample(const uint8_t* pixel, int channel) const {
+    switch (encoding_) {
+    case Encoding::U8:
+        return pixel[srcOffset_[channel]] * (1.0f / static_cast<float>(maxValue_));
+    case Encoding::U16:
+        return Load16(pixel + srcOffset_[channel], bigEndian_) * (1.0f / static_cast<float>(maxValue_));
+    case Encoding::F16:
+        return PixelConvert::HalfToFloat(Load16(pixel + srcOffset_[channel], bigEndian_));
+    case Encoding::F32:
+        return LoadF32(pixel + srcOffset_[channel], bigEndian_);
+    case Encoding::Dpx10:
+        return ((Load32(pixel, bigEndian_) >> srcShift_[channel]) & 0x3ffu) * (1.0f / 1023.0f);
+    }
+    return 0.0f;
+}
+
+void MappedImage::convertSpan(uint32_t srcY, uint32_t x0, uint32_t step, uint32_t count, uint8_t* dst,
+                              std::vector<float>& scratch) const {
+    const uint8_t* row = data_ + rowOffsets_[srcY];
+    if (directPitch_ != 0 && step == 1) {
+        std::memcpy(dst, row + static_cast<size_t>(x0) * pixelSize_, static_cast<size_t>(count) * pixelSize_);
+        return;
+    }
+
+    const uint8_t* p = row + static_cast<size_t>(x0) * srcStep_;
+    const size_t stride = static_cast<size_t>(step) * srcStep_;
+
+    // 8-bit into RGBA8 and half into RGBA16F only reorder samples
+    if (!isHdr_ && encoding_ == Encoding::U8 && maxValue_ == 255) {
+        for (uint32_t i = 0; i < count; ++i, p += stride, dst += 4) {
+            dst[0] = p[srcOffset_[0]];
+            dst[1] = p[srcOffset_[1]];
+            dst[2] = p[srcOffset_[2]];
+            dst[3] = hasAlpha_ ? p[srcOffset_[3]] : 255;
+        }
+        return;
+    }
+    if (isHdr_ && encoding_ == Encoding::F16) {
+        uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+        for (uint32_t i = 0; i < count; ++i, p += stride, out += 4) {
+            out[0] = Load16(p + srcOffset_[0], bigEndian_);
+            out[1] = Load16(p + srcOffset_[1], bigEndian_);
+            out[2] = Load16(p + srcOffset_[2], bigEndian_);
+            out[3] = hasAlpha_ ? Load16(p + srcOffset_[3], bigEndian_) : PixelConvert::kHalfOne;
+        }
+        return;
+    }
+
+    // Everything else is normalized to float, then packed like a decoded image
+    scratch.resize(static_cast<size_t>(count) * 4);
+    float* out = scratch.data();
+    for (uint32_t i = 0; i < count; ++i, p += stride, out += 4) {
+        out[0] = loadSample(p, 0);
+        out[1] = loadSample(p, 1);
+        out[2] = loadSample(p, 2);
+        out[3] = hasAlpha_ ? loadSample(p, 3) : 1.0f;
+    }
+    if (isHdr_) {
+        PixelConvert::FloatToHalf(scratch.data(), reinterpret_cast<uint16_t*>(dst), scratch.size());
+    } else {
+        PixelConvert::FloatToUnorm8(scratch.data(), dst, scratch.size());
+    }
+}
+
+bool MappedImage::ReadRows(uint32_t y, uint32_t count, uint8_t* dst) {
+    // NASA Standard: Validate all input parameters
+    if (data_ == nullptr || dst == nullptr || y >= height_ || count > height_ - y ||
+        unreadable_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const size_t rowBytes = static_cast<size_t>(width_) * pixelSize_;
+    std::vector<float> scratch;
+    const bool read = guardedRead([&] {
+        for (uint32_t r = 0; r < count; ++r) {
+            convertSpan(y + r, 0, 1, width_, dst + r * rowBytes, scratch);
+        }
+    });
+    if (!read) {
+        markUnreadable();
+    }
+    return read;
+}
+
+const uint8_t* MappedImage::GetDirectRows(size_t& rowPitch) const {
+    if (data_ == nullptr || directPitch_ == 0 || unreadable_.load(std::memory_order_acquire)) {
+        rowPitch = 0;
+        return nullptr;
+    }
+    rowPitch = static_cast<size_t>(directPitch_);
+    return data_ + rowOffsets_[0];
+}
+
+bool MappedImage::ReadTile(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t* dst) {
+    // NASA Standard: Validate all input parameters
+    if (data_ == nullptr || dst == nullptr || width == 0 || height == 0 || level >= 16 ||
+        unreadable_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const uint32_t step = 1u << level;
+    const uint32_t x0 = static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(x) << level, width_ - 1));
+    // Texels of the span inside the image; an edge tile repeats its last one
+    const uint32_t inside = std::min(width, (width_ - 1 - x0) / step + 1);
+    const size_t rowBytes = static_cast<size_t>(width) * pixelSize_;
+    std::vector<float> scratch;
+    const bool read = guardedRead([&] {
+        for (uint32_t row = 0; row < height; ++row) {
+            const uint32_t srcY = static_cast<uint32_t>(
+                std::min<uint64_t>((static_cast<uint64_t>(y) + row) << level, height_ - 1));
+            uint8_t* out = dst + row * rowBytes;
+            convertSpan(srcY, x0, step, inside, out, scratch);
+            for (uint32_t i = inside; i < width; ++i) {
+                std::memcpy(out + static_cast<size_t>(i) * pixelSize_, out + static_cast<size_t>(inside - 1) * pixelSize_,
+                            pixelSize_);
+            }
+        }
+    });
+    if (!read) {
+        markUnreadable();
+    }
+    return read;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tile_residency.h"
+#include "vulkan_staging.h"
+
+/**
+ * MappedImage - An uncompressed file read in place through a memory mapping
+ * Binary PNM/PFM, uncompressed DDS, DPX, strip TIFF and scanline EXR files keep
+ * their pixels at fixed offsets after a short header, so nothing is decoded up
+ * front: the file is mapped read-only and the renderer converts rows straight
+ * from the mapping into upload staging as the image streams in. Pages are
+ * faulted in by that copy, so a load runs at disk speed instead of decoder
+ * speed, and without a second full-size copy of the pixels in memory.
+ *
+ * When the file already holds the texture's texels (RGBA8, or little-endian
+ * RGBA16F for HDR) GetDirectRows() exposes them for a zero-copy import.
+ * Open() declines every other layout, and those files are decoded as before.
+ * The mapping stays open while the image is shown or cached; other processes
+ * may still rename, delete or rewrite the file. When its pages can no longer
+ * be read (a network share or removable drive went away) reads fail instead
+ * of faulting, and keep failing: the image keeps what was already uploaded.
+ */
+class MappedImage : public TileSource, public RowSource {
+public:
+    MappedImage() = default;
+    ~MappedImage() override;
+
+    MappedImage(const MappedImage&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+
+    // Map 'filePath' and parse its header. False, with nothing mapped, when the file is
+    // not one of the layouts understood here. Texels convert to RGBA16F (isHdr) or RGBA8.
+    bool Open(const std::wstring& filePath, bool isHdr);
+    void Close();
+
+    uint32_t GetWidth() const { return width_; }
+    uint32_t GetHeight() const { return height_; }
+    bool IsHdr() const { return isHdr_; }
+    uint64_t GetMappedBytes() const { return size_; }
+    const char* GetFormatName() const { return formatName_; }
+
+    // RowSource: rows converted from the mapping; safe from any thread
+    bool ReadRows(uint32_t y, uint32_t count, uint8_t* dst) override;
+    const uint8_t* GetDirectRows(size_t& rowPitch) const override;
+
+    // TileSource: levels past 0 point-sample level 0, so sparse uploads never wait
+    bool ReadTile(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t* dst) override;
+
+private:
+    enum class Encoding : uint8_t {
+        U8,         // Unsigned integer samples, normalized by maxValue_
+        U16,
+        F16,
+        F32,
+        Dpx10,      // Three 10-bit samples per 32-bit word, shifted by srcShift_
+    };
+
+    bool parsePnm();
+    bool parseDds();
+    bool parseDpx();
+    bool parseTiff();
+    bool parseExr();
+    // Channels 'order' (stored index for R, G, B, A; A may be kNoChannel) of pixels
+    // 'channels' samples wide
+    void setInterleaved(uint32_t channels, uint32_t sampleBytes, const uint8_t order[4]);
+    // Check every row against the file size and decide whether rows can be used as is
+    bool finishLayout(uint64_t storedRowBytes);
+    // Run 'read' over the view; false when it hit a page the file could not supply
+    static bool guardedRead(const std::function<void()>& read);
+    void markUnreadable();
+
+    float loadSample(const uint8_t* pixel, int channel) const;
+    // 'count' texels of row 'srcY' starting at 'x0', 'step' pixels apart, in the output format
+    void convertSpan(uint32_t srcY, uint32_t x0, uint32_t step, uint32_t count, uint8_t* dst,
+                     std::vector<float>& scratch) const;
+
+    static constexpr uint8_t kNoChannel = 0xff;
+
+    const uint8_t* data_ = nullptr;     // Read-only view of the whole file
+    uint64_t size_ = 0;
+    const char* formatName_ = "";
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    bool isHdr_ = false;
+    uint32_t pixelSize_ = 4;            // Output texel bytes
+
+    // Stored layout
+    Encoding encoding_ = Encoding::U8;
+    bool bigEndian_ = false;
+    uint32_t maxValue_ = 255;           // Integer encodings: the sample value meaning 1.0
+    uint32_t srcStep_ = 0;              // Bytes from one pixel's samples to the next
+    uint32_t srcOffset_[4] = {};        // Byte offset of each output channel's sample
+    uint32_t srcShift_[4] = {};         // Dpx10: bit position of each sample in the word
+    bool hasAlpha_ = false;             // Otherwise opaque
+    std::vector<uint64_t> rowOffsets_;  // File offset of each row, top to bottom
+    uint64_t directPitch_ = 0;          // Non-zero when rows are already texture texels
+    std::atomic<bool> unreadable_{false};   // A read faulted; the view is not touched again
+};
@@ -14,6 +14,7 @@ namespace OCIO {
 // Minimal stand-ins to satisfy type usage in this app
 using ConstConfigRcPtr = void*;
 using ConstProcessorRcPtr = void*;
+using ConstCPUProcessorRcPtr = void*;
 
 struct Config {
     static ConstConfigRcPtr CreateRaw() { return nullptr; }
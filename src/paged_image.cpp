@@ -0,0 +1,214 @@
+#include "paged_image.h"
+#include "pixel_convert.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Requests beyond this drop the oldest; the view that made them has long moved on
+    constexpr size_t kMaxQueuedTiles = 512;
+    // Decoded tiles waiting for the renderer to take them
+    constexpr size_t kMaxReadyTiles = 256;
+    // File tiles kept decoded by OIIO across every paged image
+    constexpr float kTileCacheMB = 1024.0f;
+
+    // Process-wide, so neighbours share one memory bound and file handles are pooled
+    auto SharedTileCache() {
+        static auto cache = [] {
+            auto created = OIIO::ImageCache::create(true);
+            created->attribute("max_memory_MB", kTileCacheMB);
+            // Files stored without MIP levels get them generated on demand
+            created->attribute("automip", 1);
+            return created;
+        }();
+        return cache;
+    }
+}
+
+PagedImage::~PagedImage() {
+    Close();
+}
+
+bool PagedImage::Open(const std::string& utf8Path, uint32_t width, uint32_t height, int originX, int originY,
+                      int channels, bool isHdr, OCIO::ConstCPUProcessorRcPtr processor) {
+    // NASA Standard: Validate all input parameters
+    if (utf8Path.empty() || width == 0 || height == 0 || channels <= 0 || channels > 4) {
+        return false;
+    }
+
+    Close();
+    path_ = utf8Path;
+    width_ = width;
+    height_ = height;
+    originX_ = originX;
+    originY_ = originY;
+    channels_ = channels;
+    isHdr_ = isHdr;
+    pixelSize_ = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    processor_ = processor;
+
+    // Drop tiles cached from an older version of the file
+    SharedTileCache()->invalidate(OIIO::ustring(path_));
+
+    try {
+        stopping_ = false;
+        worker_ = std::thread(&PagedImage::workerMain, this);
+    } catch (const std::exception& e) {
+        Logger::Error("PagedImage: failed to start worker thread: %s", e.what());
+        return false;
+    }
+
+    Logger::Info("PagedImage: %s opened for paged reads (%ux%u)", path_.c_str(), width_, height_);
+    return true;
+}
+
+void PagedImage::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        requests_.clear();
+        requested_.clear();
+        ready_.clear();
+        readyOrder_.clear();
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool PagedImage::ReadTile(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t* dst) {
+    if (dst == nullptr || width == 0 || height == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The main loop is rendering, so completions from here on need a new event
+    eventPosted_ = false;
+
+    const uint64_t key = makeKey(level, x, y);
+    auto it = ready_.find(key);
+    if (it != ready_.end()) {
+        const size_t bytes = static_cast<size_t>(width) * height * pixelSize_;
+        const bool matches = it->second.size() == bytes;
+        if (matches) {
+            std::memcpy(dst, it->second.data(), bytes);
+        }
+        ready_.erase(it);
+        if (matches) return true;
+    }
+
+    if (requested_.insert(key).second) {
+        if (requests_.size() >= kMaxQueuedTiles) {
+            requested_.erase(requests_.front().key);
+            requests_.pop_front();
+        }
+        requests_.push_back(Request{ key, level, x, y, width, height });
+        cv_.notify_one();
+    }
+    return false;
+}
+
+Uint32 PagedImage::GetReadyEventType() {
+    static const Uint32 type = SDL_RegisterEvents(1);
+    return type;
+}
+
+void PagedImage::workerMain() {
+    std::vector<uint8_t> pixels;
+    std::vector<float> scratch;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || !requests_.empty(); });
+        if (stopping_) return;
+
+        // Newest first: the current view before tiles already panned past
+        const Request request = requests_.back();
+        requests_.pop_back();
+        lock.unlock();
+
+        const bool decoded = decode(request, pixels, scratch);
+
+        lock.lock();
+        requested_.erase(request.key);
+        if (stopping_) return;
+        if (!decoded && !reportedFailure_) {
+            reportedFailure_ = true;
+            Logger::Warn("PagedImage: failed to read level %u at %u,%u of %s",
+                         request.level, request.x, request.y, path_.c_str());
+        }
+
+        // Unreadable regions are handed over blank so the renderer stops asking for them
+        ready_[request.key] = std::move(pixels);
+        pixels = std::vector<uint8_t>();
+        readyOrder_.push_back(request.key);
+        while (readyOrder_.size() > kMaxReadyTiles) {
+            ready_.erase(readyOrder_.front());
+            readyOrder_.pop_front();
+        }
+
+        if (!eventPosted_ && GetReadyEventType() != 0) {
+            eventPosted_ = true;
+            SDL_Event event{};
+            event.type = GetReadyEventType();
+            if (!SDL_PushEvent(&event)) {
+                eventPosted_ = false;
+                Logger::Warn("PagedImage: SDL_PushEvent failed: %s", SDL_GetError());
+            }
+        }
+    }
+}
+
+bool PagedImage::decode(const Request& request, std::vector<uint8_t>& out, std::vector<float>& scratch) {
+    const size_t pixelCount = static_cast<size_t>(request.width) * request.height;
+    out.assign(pixelCount * pixelSize_, 0);
+
+    auto cache = SharedTileCache();
+    const OIIO::ustring file(path_);
+    const int level = static_cast<int>(request.level);
+    const int scale = 1 << level;
+    const int x0 = originX_ / scale + static_cast<int>(request.x);
+    const int y0 = originY_ / scale + static_cast<int>(request.y);
+    const int x1 = x0 + static_cast<int>(request.width);
+    const int y1 = y0 + static_cast<int>(request.height);
+
+    if (!processor_) {
+        // No color conversion: OIIO converts to UINT8/HALF straight into the tile
+        const OIIO::TypeDesc format = isHdr_ ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8;
+        const OIIO::stride_t xstride = static_cast<OIIO::stride_t>(pixelSize_);
+        if (!cache->get_pixels(file, 0, level, x0, x1, y0, y1, 0, 1, 0, channels_, format, out.data(),
+                               xstride, xstride * static_cast<OIIO::stride_t>(request.width))) {
+            cache->geterror();
+            return false;
+        }
+        if (isHdr_) {
+            PixelConvert::ExpandToRGBA(reinterpret_cast<uint16_t*>(out.data()), pixelCount, channels_, PixelConvert::kHalfOne);
+        } else {
+            PixelConvert::ExpandToRGBA(out.data(), pixelCount, channels_, static_cast<uint8_t>(255));
+        }
+        return true;
+    }
+
+    scratch.resize(pixelCount * 4);
+    const OIIO::stride_t xstride = static_cast<OIIO::stride_t>(4 * sizeof(float));
+    if (!cache->get_pixels(file, 0, level, x0, x1, y0, y1, 0, 1, 0, channels_, OIIO::TypeDesc::FLOAT, scratch.data(),
+                           xstride, xstride * static_cast<OIIO::stride_t>(request.width))) {
+        cache->geterror();
+        return false;
+    }
+    PixelConvert::ExpandToRGBA(scratch.data(), pixelCount, channels_, 1.0f);
+    try {
+        OCIO::PackedImageDesc imgDesc(scratch.data(), static_cast<long>(request.width), static_cast<long>(request.height), 4);
+        processor_->apply(imgDesc);
+    } catch (...) {
+        // Keep the unconverted pixels rather than dropping the tile
+    }
+    if (isHdr_) {
+        PixelConvert::FloatToHalf(scratch.data(), reinterpret_cast<uint16_t*>(out.data()), pixelCount * 4);
+    } else {
+        PixelConvert::FloatToUnorm8(scratch.data(), out.data(), pixelCount * 4);
+    }
+    return true;
+}
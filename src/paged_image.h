@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <OpenImageIO/imagecache.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ocio_shim.h"
+#include "tile_residency.h"
+
+/**
+ * PagedImage - A tiled file decoded region by region as the view needs it
+ * Gigapixel EXR/TIFF files are opened without reading any pixels. The
+ * renderer's sparse texture asks for tiles at the resolution level it is
+ * sampling; each request is decoded on this image's worker thread through
+ * the process-wide OIIO::ImageCache, which reads only the file tiles and
+ * MIP level involved (synthesizing levels for files stored without them).
+ *
+ * Finished tiles wait in a small ready set until the renderer takes them;
+ * a registered SDL event wakes the main loop when some are waiting. The
+ * newest requests are decoded first, so the current view fills in before
+ * tiles the user has already panned past.
+ */
+class PagedImage : public TileSource {
+public:
+    PagedImage() = default;
+    ~PagedImage() override;
+
+    PagedImage(const PagedImage&) = delete;
+    PagedImage& operator=(const PagedImage&) = delete;
+
+    // Prepare 'utf8Path' for on-demand reads of its first 'channels' channels, converted
+    // to RGBA16F (isHdr) or RGBA8. 'processor' converts to the display space (may be null).
+    bool Open(const std::string& utf8Path, uint32_t width, uint32_t height, int originX, int originY,
+              int channels, bool isHdr, OCIO::ConstCPUProcessorRcPtr processor);
+    void Close();
+
+    uint32_t GetWidth() const { return width_; }
+    uint32_t GetHeight() const { return height_; }
+    bool IsHdr() const { return isHdr_; }
+
+    // TileSource: main thread; hands over a decoded region or queues it
+    bool ReadTile(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t* dst) override;
+
+    // SDL event type pushed when requested tiles are ready (0 if registration failed)
+    static Uint32 GetReadyEventType();
+
+private:
+    struct Request {
+        uint64_t key = 0;
+        uint32_t level = 0;
+        uint32_t x = 0, y = 0;
+        uint32_t width = 0, height = 0;
+    };
+
+    static uint64_t makeKey(uint32_t level, uint32_t x, uint32_t y) {
+        return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(x) << 24) | y;
+    }
+
+    void workerMain();
+    bool decode(const Request& request, std::vector<uint8_t>& out, std::vector<float>& scratch);
+
+    std::string path_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    int originX_ = 0;
+    int originY_ = 0;
+    int channels_ = 4;
+    bool isHdr_ = false;
+    uint32_t pixelSize_ = 4;
+    OCIO::ConstCPUProcessorRcPtr processor_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Protected by mutex_
+    bool stopping_ = false;
+    std::deque<Request> requests_;                              // Newest at the back
+    std::unordered_set<uint64_t> requested_;                    // Queued or decoding
+    std::unordered_map<uint64_t, std::vector<uint8_t>> ready_;
+    std::deque<uint64_t> readyOrder_;                           // Oldest first; may name taken tiles
+    bool eventPosted_ = false;                                  // Ready event queued and not yet seen
+    bool reportedFailure_ = false;
+};
@@ -0,0 +1,256 @@
+#include "pixel_buffer.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+    // Committed up front either way: the decoder writes every byte, and a large-page
+    // block cannot be committed later
+    uint8_t* AllocateBlock(size_t capacity, size_t largePageSize, bool& largePages) {
+        largePages = false;
+#ifdef _WIN32
+        if (largePageSize != 0 && capacity % largePageSize == 0) {
+            void* data = VirtualAlloc(nullptr, capacity, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (data != nullptr) {
+                largePages = true;
+                return static_cast<uint8_t*>(data);
+            }
+            // Physical memory too fragmented for large pages right now; small ones still work
+        }
+        return static_cast<uint8_t*>(VirtualAlloc(nullptr, capacity, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+        (void)largePageSize;
+        // Capacities are whole multiples of 64 KB, as aligned_alloc requires
+        return static_cast<uint8_t*>(std::aligned_alloc(64 * 1024, capacity));
+#endif
+    }
+
+    void ReleaseBlock(uint8_t* data) {
+#ifdef _WIN32
+        VirtualFree(data, 0, MEM_RELEASE);
+#else
+        std::free(data);
+#endif
+    }
+}
+
+std::shared_ptr<PixelBuffer> PixelBuffer::Allocate(size_t bytes) {
+    // NASA Standard: Validate input parameters
+    if (bytes == 0) {
+        return nullptr;
+    }
+
+    size_t capacity = 0;
+    bool largePages = false;
+    uint8_t* data = PixelPool::Shared().acquire(bytes, capacity, largePages);
+    if (data == nullptr) {
+        Logger::Warn("PixelBuffer: no memory for %zu bytes of pixels", bytes);
+        return nullptr;
+    }
+
+    PixelBuffer* buffer = new (std::nothrow) PixelBuffer(data, bytes, capacity, largePages);
+    if (buffer == nullptr) {
+        PixelPool::Shared().release(data, capacity, largePages);
+        return nullptr;
+    }
+    try {
+        return std::shared_ptr<PixelBuffer>(buffer);
+    } catch (const std::bad_alloc&) {
+        // shared_ptr deleted the buffer, which gave its block back
+        return nullptr;
+    }
+}
+
+PixelBuffer::~PixelBuffer() {
+    if (data_ != nullptr) {
+        PixelPool::Shared().release(data_, capacity_, largePages_);
+    }
+}
+
+PixelPool& PixelPool::Shared() {
+    // Never destroyed: images held by globals let go of their buffers after static
+    // destruction has begun
+    static PixelPool* pool = new PixelPool();
+    return *pool;
+}
+
+PixelPool::PixelPool() : retainBudget_(DefaultRetainBudget()) {
+#ifdef _WIN32
+    // Large pages need SeLockMemoryPrivilege, which only accounts granted "Lock pages in memory" hold
+    HANDLE token = nullptr;
+    if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        if (LookupPrivilegeValueW(nullptr, L"SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+            AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+            GetLastError() == ERROR_SUCCESS) {
+            largePageSize_ = GetLargePageMinimum();
+        }
+        CloseHandle(token);
+    }
+#endif
+    if (largePageSize_ != 0) {
+        Logger::Info("PixelPool: large pages of %zu KB for pixel buffers", largePageSize_ / 1024);
+    } else {
+        Logger::Info("PixelPool: large pages unavailable (no SeLockMemoryPrivilege); using small pages");
+    }
+}
+
+uint64_t PixelPool::DefaultRetainBudget() {
+    constexpr uint64_t kMinBudget = UINT64_C(128) * 1024 * 1024;
+    constexpr uint64_t kMaxBudget = UINT64_C(2) * 1024 * 1024 * 1024;
+
+    uint64_t budget = kMinBudget;
+#ifdef _WIN32
+    MEMORYSTATUSEX memStatus = {};
+    memStatus.dwLength = sizeof(memStatus);
+    if (GlobalMemoryStatusEx(&memStatus)) {
+        budget = memStatus.ullTotalPhys / 16;
+    }
+#endif
+    return std::clamp(budget, kMinBudget, kMaxBudget);
+}
+
+void PixelPool::SetRetainBudget(uint64_t bytes) {
+    std::vector<uint8_t*> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retainBudget_ = bytes;
+        trimLocked(retainBudget_, released);
+    }
+    for (uint8_t* data : released) {
+        ReleaseBlock(data);
+    }
+}
+
+void PixelPool::Trim() {
+    std::vector<uint8_t*> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trimLocked(0, released);
+    }
+    for (uint8_t* data : released) {
+        ReleaseBlock(data);
+    }
+}
+
+PixelPool::Stats PixelPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.liveBytes = liveBytes_;
+    stats.freeBytes = freeBytes_;
+    stats.reused = reused_;
+    stats.fresh = fresh_;
+    stats.largePages = largePageSize_ != 0;
+    return stats;
+}
+
+size_t PixelPool::classCapacity(size_t bytes) const {
+    // NASA Standard: Bound size arithmetic before it can overflow
+    if (bytes > (SIZE_MAX >> 2)) {
+        return 0;
+    }
+
+    // Four classes per power of two: at most a fifth of a block goes unused
+    size_t capacity = kMinClassBytes;
+    if (bytes > kMinClassBytes) {
+        size_t power = kMinClassBytes;
+        while (power * 2 < bytes) {
+            power *= 2;
+        }
+        const size_t step = power / 4;
+        capacity = power + ((bytes - power + step - 1) / step) * step;
+    }
+
+    // Whole reservations: large pages for blocks that big, the allocation granularity otherwise
+    const size_t granularity = (largePageSize_ != 0 && capacity >= largePageSize_) ? largePageSize_ : kMinClassBytes;
+    return (capacity + granularity - 1) / granularity * granularity;
+}
+
+uint8_t* PixelPool::acquire(size_t bytes, size_t& capacity, bool& largePages) {
+    capacity = classCapacity(bytes);
+    if (capacity == 0) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // The most recently released block of the class: its pages are the likeliest still resident
+        size_t best = free_.size();
+        for (size_t i = 0; i < free_.size(); ++i) {
+            if (free_[i].capacity == capacity && (best == free_.size() || free_[i].released > free_[best].released)) {
+                best = i;
+            }
+        }
+        if (best != free_.size()) {
+            const FreeBlock block = free_[best];
+            free_[best] = free_.back();
+            free_.pop_back();
+            freeBytes_ -= block.capacity;
+            liveBytes_ += block.capacity;
+            ++reused_;
+            largePages = block.largePages;
+            return block.data;
+        }
+    }
+
+    // Outside the lock: committing hundreds of megabytes, large pages above all, takes a while
+    uint8_t* data = AllocateBlock(capacity, largePageSize_, largePages);
+    if (data == nullptr) {
+        // Blocks kept for other sizes may be what stands in the way
+        Trim();
+        data = AllocateBlock(capacity, largePageSize_, largePages);
+        if (data == nullptr) {
+            return nullptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    liveBytes_ += capacity;
+    ++fresh_;
+    return data;
+}
+
+void PixelPool::release(uint8_t* data, size_t capacity, bool largePages) {
+    std::vector<uint8_t*> released;
+    bool kept = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        liveBytes_ -= capacity;
+        // Called from destructors: a block the lists cannot take is simply freed
+        try {
+            if (capacity <= retainBudget_) {
+                free_.push_back(FreeBlock{ data, capacity, largePages, ++releaseCounter_ });
+                freeBytes_ += capacity;
+                kept = true;
+                trimLocked(retainBudget_, released);
+            }
+        } catch (const std::bad_alloc&) {
+        }
+    }
+    // Outside the lock: unmapping a large block is not free either
+    if (!kept) {
+        ReleaseBlock(data);
+    }
+    for (uint8_t* block : released) {
+        ReleaseBlock(block);
+    }
+}
+
+void PixelPool::trimLocked(uint64_t keepBytes, std::vector<uint8_t*>& released) {
+    while (freeBytes_ > keepBytes && !free_.empty()) {
+        auto oldest = std::min_element(free_.begin(), free_.end(),
+                                       [](const FreeBlock& a, const FreeBlock& b) { return a.released < b.released; });
+        released.push_back(oldest->data);
+        freeBytes_ -= oldest->capacity;
+        *oldest = free_.back();
+        free_.pop_back();
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * PixelBuffer - Shared, immutable decoded pixels
+ * A decoder fills a buffer from Allocate() once and publishes it as
+ * shared_ptr<const PixelBuffer>. The image on screen, the decode cache, a save
+ * in flight and a clipboard copy then read the same bytes, and whichever lets
+ * go last hands the block back to the pool.
+ *
+ * Blocks come from PixelPool in size classes, four per power of two, so a new
+ * image near the size of one let go reuses its block with the pages already
+ * committed and faulted in: steady-state navigation neither allocates nor
+ * takes a page fault per 4 KB of pixels. Memory is never zeroed for the decoder.
+ */
+class PixelBuffer {
+public:
+    // 'bytes' of uninitialised memory; null when the system cannot provide it
+    static std::shared_ptr<PixelBuffer> Allocate(size_t bytes);
+
+    ~PixelBuffer();
+
+    PixelBuffer(const PixelBuffer&) = delete;
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    PixelBuffer(uint8_t* data, size_t size, size_t capacity, bool largePages)
+        : data_(data), size_(size), capacity_(capacity), largePages_(largePages) {}
+
+    uint8_t* data_;
+    size_t size_;
+    size_t capacity_;           // Size class of the block behind data_
+    bool largePages_;
+};
+
+/**
+ * PixelPool - Size-class allocator behind PixelBuffer
+ * Blocks are whole VirtualAlloc reservations, so they are page aligned and
+ * never fragment the heap. Released blocks are kept for reuse up to a retain
+ * budget and given back to the system oldest first beyond it. When the process
+ * may lock memory (SeLockMemoryPrivilege), blocks of at least the large-page
+ * size use large pages: committed up front and mapped with far fewer TLB entries.
+ *
+ * Thread-safe; decode workers allocate while the main thread releases.
+ */
+class PixelPool {
+public:
+    struct Stats {
+        uint64_t liveBytes = 0;     // Blocks held by buffers
+        uint64_t freeBytes = 0;     // Blocks kept for reuse
+        uint64_t reused = 0;        // Allocations served from a kept block
+        uint64_t fresh = 0;         // Allocations that went to the system
+        bool largePages = false;    // Large pages are available to the pool
+    };
+
+    static PixelPool& Shared();
+
+    PixelPool(const PixelPool&) = delete;
+    PixelPool& operator=(const PixelPool&) = delete;
+
+    // Default: a sixteenth of physical memory, clamped to [128 MB, 2 GB]
+    static uint64_t DefaultRetainBudget();
+    void SetRetainBudget(uint64_t bytes);
+    // Give every kept block back to the system
+    void Trim();
+
+    Stats GetStats() const;
+
+private:
+    friend class PixelBuffer;
+
+    static constexpr size_t kMinClassBytes = 64 * 1024;     // VirtualAlloc granularity
+
+    struct FreeBlock {
+        uint8_t* data = nullptr;
+        size_t capacity = 0;
+        bool largePages = false;
+        uint64_t released = 0;      // Release order; the oldest goes first
+    };
+
+    PixelPool();
+    size_t classCapacity(size_t bytes) const;
+    uint8_t* acquire(size_t bytes, size_t& capacity, bool& largePages);
+    void release(uint8_t* data, size_t capacity, bool largePages);
+    // Take the oldest kept blocks out until at most 'keepBytes' remain; the caller frees them unlocked
+    void trimLocked(uint64_t keepBytes, std::vector<uint8_t*>& released);
+
+    mutable std::mutex mutex_;
+    std::vector<FreeBlock> free_;
+    uint64_t freeBytes_ = 0;
+    uint64_t liveBytes_ = 0;
+    uint64_t retainBudget_ = 0;
+    uint64_t releaseCounter_ = 0;
+    uint64_t reused_ = 0;
+    uint64_t fresh_ = 0;
+    size_t largePageSize_ = 0;      // 0 when large pages cannot be used
+};
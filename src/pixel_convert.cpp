@@ -0,0 +1,441 @@
+#include "pixel_convert.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define PIXEL_CONVERT_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define PIXEL_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang only emit AVX/F16C instructions inside functions that opt in;
+// MSVC accepts the intrinsics anywhere.
+#if defined(PIXEL_CONVERT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PIXEL_CONVERT_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#else
+#define PIXEL_CONVERT_TARGET_AVX2
+#endif
+
+namespace PixelConvert {
+
+// ---------------------------------------------------------------------------
+// Scalar reference implementations (also handle the tails of the SIMD loops)
+// ---------------------------------------------------------------------------
+
+uint16_t FloatToHalf(float value) noexcept {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    bits &= 0x7FFFFFFF;
+
+    if (bits >= 0x47800000) {
+        // >= 65536 (or Inf/NaN): overflow to Inf, keep NaN quiet
+        return sign | static_cast<uint16_t>(bits > 0x7F800000 ? 0x7E00 : 0x7C00);
+    }
+    if (bits < 0x38800000) {
+        // Below the smallest normal half: let the FPU round the mantissa
+        // into position by adding 0.5 (denormal magic), then strip it off
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f += 0.5f;
+        uint32_t rounded;
+        std::memcpy(&rounded, &f, sizeof(rounded));
+        return sign | static_cast<uint16_t>(rounded - 0x3F000000);
+    }
+
+    // Normal range: rebias exponent, round to nearest even on the dropped 13 bits
+    const uint32_t mantissaOdd = (bits >> 13) & 1;
+    bits += 0xC8000FFFu + mantissaOdd;   // ((15 - 127) << 23) + 0xFFF
+    return sign | static_cast<uint16_t>(bits >> 13);
+}
+
+float HalfToFloat(uint16_t value) noexcept {
+    constexpr uint32_t kShiftedExp = 0x7C00u << 13;
+    uint32_t bits = (value & 0x7FFFu) << 13;
+    const uint32_t exp = bits & kShiftedExp;
+    bits += (127 - 15) << 23;
+
+    if (exp == kShiftedExp) {
+        bits += (128 - 16) << 23;            // Inf/NaN
+    } else if (exp == 0) {
+        // Denormal: renormalize through the FPU
+        bits += 1 << 23;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f -= 6.103515625e-05f;               // 2^-14
+        std::memcpy(&bits, &f, sizeof(bits));
+    }
+    bits |= static_cast<uint32_t>(value & 0x8000u) << 16;
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static inline uint8_t QuantizeUnorm8(float value) noexcept {
+    // NaN fails both comparisons and lands on 0
+    float v = value > 0.0f ? value : 0.0f;
+    v = v < 1.0f ? v : 1.0f;
+    return static_cast<uint8_t>(v * 255.0f + 0.5f);
+}
+
+// Largest finite half. Reinhard inputs are clamped to it so +Inf maps to white
+// rather than Inf/Inf = NaN, which quantizes to black.
+static constexpr float kReinhardMax = 65504.0f;
+
+static inline float Reinhard(float value) noexcept {
+    float v = value > 0.0f ? value : 0.0f;
+    v = v < kReinhardMax ? v : kReinhardMax;
+    return v / (1.0f + v);
+}
+
+static void FloatToHalfScalar(const float* src, uint16_t* dst, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) dst[i] = FloatToHalf(src[i]);
+}
+
+static void HalfToFloatScalar(const uint16_t* src, float* dst, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) dst[i] = HalfToFloat(src[i]);
+}
+
+static void FloatToUnorm8Scalar(const float* src, uint8_t* dst, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) dst[i] = QuantizeUnorm8(src[i]);
+}
+
+static void HalfToUnorm8TonemappedScalar(const uint16_t* src, uint8_t* dst, size_t pixelCount) noexcept {
+    for (size_t p = 0; p < pixelCount; ++p, src += 4, dst += 4) {
+        dst[0] = QuantizeUnorm8(Reinhard(HalfToFloat(src[0])));
+        dst[1] = QuantizeUnorm8(Reinhard(HalfToFloat(src[1])));
+        dst[2] = QuantizeUnorm8(Reinhard(HalfToFloat(src[2])));
+        dst[3] = QuantizeUnorm8(HalfToFloat(src[3]));
+    }
+}
+
+#if defined(PIXEL_CONVERT_X86)
+// ---------------------------------------------------------------------------
+// SSE2 (x86-64 baseline): integer bit manipulation, same rounding as scalar
+// ---------------------------------------------------------------------------
+
+static inline __m128i FloatToHalf4SSE2(__m128 f) noexcept {
+    const __m128i f16Max = _mm_set1_epi32(0x47800000);
+    const __m128i minNormal = _mm_set1_epi32(0x38800000);
+    const __m128i denormMagic = _mm_set1_epi32(0x3F000000);
+    const __m128i normalBias = _mm_set1_epi32(static_cast<int>(0xC8000FFFu));
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 sign = _mm_and_ps(f, signMask);
+    const __m128 absF = _mm_xor_ps(f, sign);
+    const __m128i absBits = _mm_castps_si128(absF);
+
+    const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+    const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absBits);
+    const __m128i isDenormal = _mm_cmpgt_epi32(minNormal, absBits);
+    const __m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x0200)),
+                                          _mm_set1_epi32(0x7C00));
+
+    const __m128 denormSum = _mm_add_ps(absF, _mm_castsi128_ps(denormMagic));
+    const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(denormSum), denormMagic);
+
+    const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd), 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isDenormal, denormal),
+                                        _mm_andnot_si128(isDenormal, normal));
+    const __m128i joined = _mm_or_si128(_mm_and_si128(isRegular, finite),
+                                        _mm_andnot_si128(isRegular, infOrNan));
+
+    // Sign lands as 0xFFFF8000, which packs_epi32 narrows losslessly
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+static inline __m128 HalfToFloat4SSE2(__m128i h) noexcept {
+    const __m128i expMantissa = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expMantissa), 16);
+    // Scaling by 2^112 rebiases the exponent and renormalizes denormals in one multiply
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMantissa, 13)),
+                                     _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i wasInfNan = _mm_cmpgt_epi32(expMantissa, _mm_set1_epi32(0x7BFF));
+    const __m128 infNanExp = _mm_and_ps(_mm_castsi128_ps(wasInfNan), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+    return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infNanExp));
+}
+
+static inline __m128i QuantizeUnorm8x4SSE2(__m128 v) noexcept {
+    // maxps returns the second operand for NaN, so NaN clamps to 0
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+static void FloatToHalfSSE2(const float* src, uint16_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i lo = FloatToHalf4SSE2(_mm_loadu_ps(src + i));
+        const __m128i hi = FloatToHalf4SSE2(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    FloatToHalfScalar(src + i, dst + i, count - i);
+}
+
+static void HalfToFloatSSE2(const uint16_t* src, float* dst, size_t count) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i, HalfToFloat4SSE2(_mm_unpacklo_epi16(h, zero)));
+        _mm_storeu_ps(dst + i + 4, HalfToFloat4SSE2(_mm_unpackhi_epi16(h, zero)));
+    }
+    HalfToFloatScalar(src + i, dst + i, count - i);
+}
+
+static void FloatToUnorm8SSE2(const float* src, uint8_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = QuantizeUnorm8x4SSE2(_mm_loadu_ps(src + i));
+        const __m128i b = QuantizeUnorm8x4SSE2(_mm_loadu_ps(src + i + 4));
+        const __m128i c = QuantizeUnorm8x4SSE2(_mm_loadu_ps(src + i + 8));
+        const __m128i d = QuantizeUnorm8x4SSE2(_mm_loadu_ps(src + i + 12));
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+    FloatToUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+static inline __m128 TonemapPixelSSE2(__m128 v, __m128 alphaMask) noexcept {
+    const __m128 one = _mm_set1_ps(1.0f);
+    v = _mm_max_ps(v, _mm_setzero_ps());
+    const __m128 clamped = _mm_min_ps(v, _mm_set1_ps(kReinhardMax));
+    const __m128 mapped = _mm_div_ps(clamped, _mm_add_ps(one, clamped));
+    return _mm_or_ps(_mm_and_ps(alphaMask, v), _mm_andnot_ps(alphaMask, mapped));
+}
+
+static void HalfToUnorm8TonemappedSSE2(const uint16_t* src, uint8_t* dst, size_t pixelCount) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    size_t p = 0;
+    for (; p + 4 <= pixelCount; p += 4) {
+        const __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + p * 4));
+        const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + p * 4 + 8));
+        const __m128i a = QuantizeUnorm8x4SSE2(TonemapPixelSSE2(HalfToFloat4SSE2(_mm_unpacklo_epi16(h0, zero)), alphaMask));
+        const __m128i b = QuantizeUnorm8x4SSE2(TonemapPixelSSE2(HalfToFloat4SSE2(_mm_unpackhi_epi16(h0, zero)), alphaMask));
+        const __m128i c = QuantizeUnorm8x4SSE2(TonemapPixelSSE2(HalfToFloat4SSE2(_mm_unpacklo_epi16(h1, zero)), alphaMask));
+        const __m128i d = QuantizeUnorm8x4SSE2(TonemapPixelSSE2(HalfToFloat4SSE2(_mm_unpackhi_epi16(h1, zero)), alphaMask));
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + p * 4), packed);
+    }
+    HalfToUnorm8TonemappedScalar(src + p * 4, dst + p * 4, pixelCount - p);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 + F16C: hardware conversion (vcvtps2ph honours RNE and denormals)
+// ---------------------------------------------------------------------------
+
+PIXEL_CONVERT_TARGET_AVX2
+static inline __m128i QuantizeUnorm8x8AVX2(__m256 v) noexcept {
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    const __m256i i32 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, _mm256_set1_ps(255.0f)),
+                                                          _mm256_set1_ps(0.5f)));
+    return _mm_packs_epi32(_mm256_castsi256_si128(i32), _mm256_extracti128_si256(i32, 1));
+}
+
+PIXEL_CONVERT_TARGET_AVX2
+static void FloatToHalfAVX2(const float* src, uint16_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i lo = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        const __m128i hi = _mm256_cvtps_ph(_mm256_loadu_ps(src + i + 8), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), hi);
+    }
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+    FloatToHalfScalar(src + i, dst + i, count - i);
+}
+
+PIXEL_CONVERT_TARGET_AVX2
+static void HalfToFloatAVX2(const uint16_t* src, float* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    HalfToFloatScalar(src + i, dst + i, count - i);
+}
+
+PIXEL_CONVERT_TARGET_AVX2
+static void FloatToUnorm8AVX2(const float* src, uint8_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = QuantizeUnorm8x8AVX2(_mm256_loadu_ps(src + i));
+        const __m128i b = QuantizeUnorm8x8AVX2(_mm256_loadu_ps(src + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+    }
+    FloatToUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+PIXEL_CONVERT_TARGET_AVX2
+static inline __m256 TonemapPixelsAVX2(__m256 v) noexcept {
+    v = _mm256_max_ps(v, _mm256_setzero_ps());
+    const __m256 clamped = _mm256_min_ps(v, _mm256_set1_ps(kReinhardMax));
+    const __m256 mapped = _mm256_div_ps(clamped, _mm256_add_ps(_mm256_set1_ps(1.0f), clamped));
+    return _mm256_blend_ps(mapped, v, 0x88);   // Lanes 3 and 7 are alpha
+}
+
+PIXEL_CONVERT_TARGET_AVX2
+static void HalfToUnorm8TonemappedAVX2(const uint16_t* src, uint8_t* dst, size_t pixelCount) noexcept {
+    size_t p = 0;
+    for (; p + 4 <= pixelCount; p += 4) {
+        const __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + p * 4));
+        const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + p * 4 + 8));
+        const __m128i a = QuantizeUnorm8x8AVX2(TonemapPixelsAVX2(_mm256_cvtph_ps(h0)));
+        const __m128i b = QuantizeUnorm8x8AVX2(TonemapPixelsAVX2(_mm256_cvtph_ps(h1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + p * 4), _mm_packus_epi16(a, b));
+    }
+    HalfToUnorm8TonemappedScalar(src + p * 4, dst + p * 4, pixelCount - p);
+}
+
+static bool CpuHasAvx2F16c() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave || !avx || !f16c) return false;
+    // NASA Standard: Confirm the OS saves YMM state before using 256-bit registers
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;   // AVX2
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+#endif
+}
+
+#elif defined(PIXEL_CONVERT_NEON)
+// ---------------------------------------------------------------------------
+// NEON (ARM64 baseline): fcvtn/fcvtl honour FPCR rounding (RNE by default)
+// ---------------------------------------------------------------------------
+
+static inline uint16x4_t QuantizeUnorm8x4NEON(float32x4_t v) noexcept {
+    // fmaxnm returns the number when one operand is NaN
+    v = vminq_f32(vmaxnmq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    return vmovn_u32(vcvtq_u32_f32(vmlaq_n_f32(vdupq_n_f32(0.5f), v, 255.0f)));
+}
+
+static void FloatToHalfNEON(const float* src, uint16_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float16x4_t lo = vcvt_f16_f32(vld1q_f32(src + i));
+        const float16x4_t hi = vcvt_f16_f32(vld1q_f32(src + i + 4));
+        vst1q_u16(dst + i, vcombine_u16(vreinterpret_u16_f16(lo), vreinterpret_u16_f16(hi)));
+    }
+    FloatToHalfScalar(src + i, dst + i, count - i);
+}
+
+static void HalfToFloatNEON(const uint16_t* src, float* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t h = vld1q_u16(src + i);
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(h))));
+        vst1q_f32(dst + i + 4, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(h))));
+    }
+    HalfToFloatScalar(src + i, dst + i, count - i);
+}
+
+static void FloatToUnorm8NEON(const float* src, uint8_t* dst, size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t w = vcombine_u16(QuantizeUnorm8x4NEON(vld1q_f32(src + i)),
+                                          QuantizeUnorm8x4NEON(vld1q_f32(src + i + 4)));
+        vst1_u8(dst + i, vmovn_u16(w));
+    }
+    FloatToUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+static inline float32x4_t TonemapPixelNEON(float32x4_t v, uint32x4_t alphaMask) noexcept {
+    v = vmaxnmq_f32(v, vdupq_n_f32(0.0f));
+    const float32x4_t clamped = vminq_f32(v, vdupq_n_f32(kReinhardMax));
+    const float32x4_t mapped = vdivq_f32(clamped, vaddq_f32(vdupq_n_f32(1.0f), clamped));
+    return vbslq_f32(alphaMask, v, mapped);
+}
+
+static void HalfToUnorm8TonemappedNEON(const uint16_t* src, uint8_t* dst, size_t pixelCount) noexcept {
+    static const uint32_t kAlphaLanes[4] = {0, 0, 0, 0xFFFFFFFFu};
+    const uint32x4_t alphaMask = vld1q_u32(kAlphaLanes);
+    size_t p = 0;
+    for (; p + 2 <= pixelCount; p += 2) {
+        const uint16x8_t h = vld1q_u16(src + p * 4);
+        const float32x4_t a = vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(h)));
+        const float32x4_t b = vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(h)));
+        const uint16x8_t w = vcombine_u16(QuantizeUnorm8x4NEON(TonemapPixelNEON(a, alphaMask)),
+                                          QuantizeUnorm8x4NEON(TonemapPixelNEON(b, alphaMask)));
+        vst1_u8(dst + p * 4, vmovn_u16(w));
+    }
+    HalfToUnorm8TonemappedScalar(src + p * 4, dst + p * 4, pixelCount - p);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Runtime dispatch
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct KernelTable {
+    void (*floatToHalf)(const float*, uint16_t*, size_t) noexcept;
+    void (*halfToFloat)(const uint16_t*, float*, size_t) noexcept;
+    void (*floatToUnorm8)(const float*, uint8_t*, size_t) noexcept;
+    void (*halfToUnorm8Tonemapped)(const uint16_t*, uint8_t*, size_t) noexcept;
+    const char* name;
+};
+
+KernelTable SelectKernels() noexcept {
+#if defined(PIXEL_CONVERT_X86)
+    if (CpuHasAvx2F16c()) {
+        return {FloatToHalfAVX2, HalfToFloatAVX2, FloatToUnorm8AVX2, HalfToUnorm8TonemappedAVX2, "avx2-f16c"};
+    }
+    return {FloatToHalfSSE2, HalfToFloatSSE2, FloatToUnorm8SSE2, HalfToUnorm8TonemappedSSE2, "sse2"};
+#elif defined(PIXEL_CONVERT_NEON)
+    return {FloatToHalfNEON, HalfToFloatNEON, FloatToUnorm8NEON, HalfToUnorm8TonemappedNEON, "neon"};
+#else
+    return {FloatToHalfScalar, HalfToFloatScalar, FloatToUnorm8Scalar, HalfToUnorm8TonemappedScalar, "scalar"};
+#endif
+}
+
+const KernelTable& Kernels() noexcept {
+    static const KernelTable table = SelectKernels();
+    return table;
+}
+
+} // namespace
+
+void FloatToHalf(const float* src, uint16_t* dst, size_t count) noexcept {
+    if (!src || !dst || count == 0) return;
+    Kernels().floatToHalf(src, dst, count);
+}
+
+void HalfToFloat(const uint16_t* src, float* dst, size_t count) noexcept {
+    if (!src || !dst || count == 0) return;
+    Kernels().halfToFloat(src, dst, count);
+}
+
+void FloatToUnorm8(const float* src, uint8_t* dst, size_t count) noexcept {
+    if (!src || !dst || count == 0) return;
+    Kernels().floatToUnorm8(src, dst, count);
+}
+
+void HalfToUnorm8Tonemapped(const uint16_t* rgbaSrc, uint8_t* rgbaDst, size_t pixelCount) noexcept {
+    if (!rgbaSrc || !rgbaDst || pixelCount == 0) return;
+    Kernels().halfToUnorm8Tonemapped(rgbaSrc, rgbaDst, pixelCount);
+}
+
+const char* ActiveKernelName() noexcept {
+    return Kernels().name;
+}
+
+} // namespace PixelConvert
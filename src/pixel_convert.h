@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized pixel format conversion kernels.
+// The best implementation for the running CPU is selected once at first use:
+// F16C/AVX2 on x86-64 when available, SSE2 otherwise, NEON on ARM64, and a
+// scalar path elsewhere. All paths round to nearest even and preserve
+// half-precision denormals, infinities and NaNs.
+namespace PixelConvert {
+
+// IEEE binary32 -> binary16 (round to nearest even; overflow becomes infinity)
+void FloatToHalf(const float* src, uint16_t* dst, size_t count) noexcept;
+
+// IEEE binary16 -> binary32 (exact)
+void HalfToFloat(const uint16_t* src, float* dst, size_t count) noexcept;
+
+// Float [0,1] -> 8-bit unorm: clamp(v, 0, 1) * 255 + 0.5, NaN maps to 0
+void FloatToUnorm8(const float* src, uint8_t* dst, size_t count) noexcept;
+
+// RGBA16F -> RGBA8 for display/export: Reinhard x/(1+x) on RGB, alpha clamped
+void HalfToUnorm8Tonemapped(const uint16_t* rgbaSrc, uint8_t* rgbaDst, size_t pixelCount) noexcept;
+
+// Scalar single-value conversions (for callers converting a handful of values)
+uint16_t FloatToHalf(float value) noexcept;
+float HalfToFloat(uint16_t value) noexcept;
+
+// Name of the kernel set in use ("avx2-f16c", "sse2", "neon" or "scalar")
+const char* ActiveKernelName() noexcept;
+
+// IEEE half 1.0, used as the default alpha for RGBA16F
+constexpr uint16_t kHalfOne = 0x3c00;
+
+// Fill in the channels the file didn't provide (in place, RGBA layout):
+// grey replicates into G/B, grey+alpha keeps its alpha, missing alpha is opaque
+template<typename T>
+void ExpandToRGBA(T* rgba, size_t pixelCount, int channels, T opaque) noexcept {
+    if (channels >= 4) return;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        T* p = rgba + i * 4;
+        if (channels == 1) {
+            p[1] = p[0];
+            p[2] = p[0];
+            p[3] = opaque;
+        } else if (channels == 2) {
+            p[3] = p[1];
+            p[1] = p[0];
+            p[2] = p[0];
+        } else {
+            p[3] = opaque;
+        }
+    }
+}
+
+} // namespace PixelConvert
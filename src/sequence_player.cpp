@@ -0,0 +1,423 @@
+#include "sequence_player.h"
+#include "vulkan_renderer.h"
+#include "color_lut.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cwctype>
+#include <utility>
+
+namespace {
+    // Fewer frames than this are numbered files, not a sequence
+    constexpr size_t kMinFrames = 2;
+    // Longer digit runs are dates, hashes or camera counters, not frame numbers
+    constexpr size_t kMaxFrameDigits = 9;
+
+    // Split 'path' around the last run of digits in its file name, ignoring the extension
+    bool SplitFrameNumber(const std::wstring& path, std::wstring& prefix, uint64_t& number, std::wstring& suffix) {
+        const size_t slash = path.find_last_of(L"\\/");
+        const size_t nameStart = slash == std::wstring::npos ? 0 : slash + 1;
+        const size_t dot = path.find_last_of(L'.');
+        size_t digitsEnd = (dot != std::wstring::npos && dot > nameStart) ? dot : path.size();
+
+        while (digitsEnd > nameStart && !std::iswdigit(path[digitsEnd - 1])) --digitsEnd;
+        size_t digitsStart = digitsEnd;
+        while (digitsStart > nameStart && std::iswdigit(path[digitsStart - 1])) --digitsStart;
+        if (digitsStart == digitsEnd || digitsEnd - digitsStart > kMaxFrameDigits) {
+            return false;
+        }
+
+        prefix.assign(path, 0, digitsStart);
+        suffix.assign(path, digitsEnd, std::wstring::npos);
+        number = 0;
+        for (size_t i = digitsStart; i < digitsEnd; ++i) {
+            number = number * 10 + static_cast<uint64_t>(path[i] - L'0');
+        }
+        return true;
+    }
+
+    // Frame rate the file records: OpenEXR's FramesPerSecond, or the DPX header's; 0 if neither
+    double RecordedFps(const OIIO::ImageSpec& spec) {
+        const OIIO::ParamValue* rational = spec.find_attribute("FramesPerSecond", OIIO::TypeRational);
+        if (rational) {
+            const int* ratio = static_cast<const int*>(rational->data());
+            if (ratio[0] > 0 && ratio[1] > 0) {
+                return static_cast<double>(ratio[0]) / static_cast<double>(ratio[1]);
+            }
+        }
+        const float dpxRate = spec.get_float_attribute("dpx:FrameRate", 0.0f);
+        return dpxRate > 0.0f ? static_cast<double>(dpxRate) : 0.0;
+    }
+}
+
+std::vector<std::wstring> SequencePlayer::FindSequence(const std::vector<std::wstring>& files, int index,
+                                                       size_t& position) {
+    std::vector<std::wstring> frames;
+    position = 0;
+    // NASA Standard: Validate all bounds and indices
+    if (index < 0 || index >= static_cast<int>(files.size())) {
+        return frames;
+    }
+
+    std::wstring prefix;
+    std::wstring suffix;
+    uint64_t number = 0;
+    if (!SplitFrameNumber(files[index], prefix, number, suffix)) {
+        return frames;
+    }
+
+    // Padding may differ (frame_9, frame_10); the name around the number may not
+    std::vector<std::pair<uint64_t, size_t>> numbered;
+    std::wstring otherPrefix;
+    std::wstring otherSuffix;
+    for (size_t i = 0; i < files.size(); ++i) {
+        uint64_t otherNumber = 0;
+        if (SplitFrameNumber(files[i], otherPrefix, otherNumber, otherSuffix) &&
+            _wcsicmp(otherPrefix.c_str(), prefix.c_str()) == 0 && _wcsicmp(otherSuffix.c_str(), suffix.c_str()) == 0) {
+            numbered.emplace_back(otherNumber, i);
+        }
+    }
+    if (numbered.size() < kMinFrames) {
+        return frames;
+    }
+
+    std::stable_sort(numbered.begin(), numbered.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    frames.reserve(numbered.size());
+    for (const auto& [frameNumber, fileIndex] : numbered) {
+        if (fileIndex == static_cast<size_t>(index)) {
+            position = frames.size();
+        }
+        frames.push_back(files[fileIndex]);
+    }
+    return frames;
+}
+
+SequencePlayer::SequencePlayer() = default;
+
+SequencePlayer::~SequencePlayer() {
+    Stop(nullptr);
+}
+
+bool SequencePlayer::Play(std::vector<std::wstring> frames, size_t first, const DecodeOptions& options) {
+    if (playing_ || frames.empty() || first >= frames.size()) {
+        return false;
+    }
+
+    frames_ = std::move(frames);
+    options_ = options;
+    // The ring holds pixels, not paged or mapped sources
+    options_.allowPaged = false;
+    options_.mappedRows = false;
+
+    firstPosition_ = first;
+    slots_ = 0;
+    slotPositions_.clear();
+    fps_ = kDefaultFps;
+    haveShown_ = false;
+    shownPosition_ = first;
+    shownCount_ = 0;
+    dropped_ = 0;
+    mismatched_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decoded_.clear();
+        nextDecode_ = first;
+        duePosition_ = first;
+        // Until the ring is sized, decode as far ahead as the largest one could hold
+        decodeLimit_ = first + kMaxSlots;
+        failed_ = 0;
+    }
+    stalePosition_.store(first, std::memory_order_release);
+    stopping_.store(false, std::memory_order_release);
+
+    // Half the cores decode; OIIO and the main thread's uploads share the rest
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned workerCount = std::clamp(hardware / 2, 1u, kMaxWorkers);
+    try {
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers_.emplace_back(&SequencePlayer::workerMain, this, i);
+        }
+    } catch (const std::exception& e) {
+        Logger::Error("SequencePlayer: failed to start worker threads: %s", e.what());
+        playing_ = true;
+        Stop(nullptr);
+        return false;
+    }
+
+    playing_ = true;
+    Logger::InfoW(L"Sequence: playing %zu frames from %ls with %u decode workers",
+                  frames_.size(), frames_[first].c_str(), workerCount);
+    return true;
+}
+
+void SequencePlayer::Stop(VulkanRenderer* renderer) {
+    if (!playing_) return;
+
+    stopping_.store(true, std::memory_order_release);
+    {
+        // Taken so a worker between its check and its wait cannot miss the wake-up
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    decoded_.clear();
+
+    if (renderer) {
+        renderer->EndSequence();
+    }
+    slots_ = 0;
+    slotPositions_.clear();
+    playing_ = false;
+
+    if (mismatched_ > 0) {
+        Logger::Warn("Sequence: %llu frames differed in size or format from the first and were skipped",
+                     static_cast<unsigned long long>(mismatched_));
+    }
+    Logger::Info("Sequence: stopped after %llu frames shown, %llu dropped, %llu undecodable",
+                 static_cast<unsigned long long>(shownCount_), static_cast<unsigned long long>(dropped_),
+                 static_cast<unsigned long long>(failed_ - mismatched_));
+}
+
+void SequencePlayer::Update(VulkanRenderer* renderer) {
+    if (!playing_ || renderer == nullptr) {
+        return;
+    }
+
+    bool stuck = false;
+    if (slots_ == 0) {
+        // Nothing decodes: stop rather than redraw an unchanging image forever
+        std::lock_guard<std::mutex> lock(mutex_);
+        stuck = failed_ >= std::min<uint64_t>(frames_.size(), kMaxSlots);
+    }
+    if (stuck) {
+        Logger::Warn("Sequence: none of the first frames could be decoded; playback stopped");
+        Stop(renderer);
+        return;
+    }
+
+    // The first frame decoded sizes the ring as it is uploaded
+    uploadDecoded(renderer);
+    if (!playing_) return;
+    showDue(renderer);
+    updateWindow();
+}
+
+bool SequencePlayer::beginRing(VulkanRenderer* renderer, const ImageData& frame) {
+    slots_ = renderer->BeginSequence(kMaxSlots, frame.width, frame.height, frame.isHdr);
+    if (slots_ == 0) {
+        return false;
+    }
+    slotPositions_.assign(slots_, kEmptySlot);
+    width_ = frame.width;
+    height_ = frame.height;
+    isHdr_ = frame.isHdr;
+
+    // One transform for the whole sequence, taking effect with its first frame
+    if (frame.displayLut) {
+        const ColorLut::Lut3D& lut = *frame.displayLut;
+        renderer->SetColorLut(lut.rgba.data(), lut.edgeLength, lut.log2Min, lut.log2Max, lut.id);
+    } else {
+        renderer->SetColorLut(nullptr, 0, 0.0f, 0.0f, 0);
+    }
+
+    const double recorded = frame.sourceSpec ? RecordedFps(*frame.sourceSpec) : 0.0;
+    if (recorded >= 1.0 && recorded <= 240.0) {
+        fps_ = recorded;
+    }
+    Logger::Info("Sequence: %ux%u %s at %.3g fps, %u texture slots", width_, height_, isHdr_ ? "HDR" : "LDR",
+                 fps_, slots_);
+    return true;
+}
+
+void SequencePlayer::uploadDecoded(VulkanRenderer* renderer) {
+    for (uint32_t uploads = 0; uploads < kUploadsPerUpdate; ) {
+        uint64_t position = 0;
+        ImageData frame;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Overtaken by the frame on screen: it can never be shown
+            while (!decoded_.empty() && haveShown_ && decoded_.begin()->first <= shownPosition_) {
+                decoded_.erase(decoded_.begin());
+            }
+
+            auto it = decoded_.begin();
+            for (; it != decoded_.end(); ++it) {
+                if (slots_ == 0) break;
+                // The slot on screen is refilled once the clock moves off it
+                const uint32_t slot = static_cast<uint32_t>(it->first % slots_);
+                if (!(haveShown_ && slotPositions_[slot] == shownPosition_)) break;
+            }
+            if (it == decoded_.end()) return;
+            position = it->first;
+            frame = std::move(it->second);
+            decoded_.erase(it);
+        }
+
+        if (slots_ == 0 && !beginRing(renderer, frame)) {
+            Logger::Warn("Sequence: no texture ring for %ux%u frames; playback stopped", frame.width, frame.height);
+            Stop(renderer);
+            return;
+        }
+        if (frame.width != width_ || frame.height != height_ || frame.isHdr != isHdr_ || !frame.pixels) {
+            // A failure like an undecodable frame, so playback does not wait on it to start
+            if (mismatched_++ == 0) {
+                Logger::WarnW(L"Sequence: %ls is %ux%u %ls, not %ux%u %ls like the first frame; skipped",
+                              frames_[position % frames_.size()].c_str(), frame.width, frame.height,
+                              frame.isHdr ? L"HDR" : L"LDR", width_, height_, isHdr_ ? L"HDR" : L"LDR");
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++failed_;
+            continue;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(position % slots_);
+        const uint64_t held = slotPositions_[slot];
+        // A later frame already waiting in the slot wins; this one arrived too late for it
+        if (held != kEmptySlot && held > position && (!haveShown_ || held > shownPosition_)) {
+            continue;
+        }
+        slotPositions_[slot] = kEmptySlot;
+        if (renderer->UploadSequenceFrame(slot, frame.pixels->data())) {
+            slotPositions_[slot] = position;
+        }
+        ++uploads;
+    }
+}
+
+void SequencePlayer::showDue(VulkanRenderer* renderer) {
+    if (slots_ == 0) return;
+
+    const uint64_t now = SDL_GetTicksNS();
+    if (!haveShown_) {
+        // The clock starts with the first frame on screen, so a slow first decode is not counted
+        // as drops. Playback starts on the frame it was asked to unless that one failed to decode.
+        uint64_t start = kEmptySlot;
+        for (const uint64_t held : slotPositions_) {
+            start = std::min(start, held);
+        }
+        if (start == kEmptySlot) return;
+        if (start != firstPosition_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (failed_ == 0) return;
+        }
+        renderer->ShowSequenceFrame(static_cast<uint32_t>(start % slots_));
+        haveShown_ = true;
+        dropped_ += start - firstPosition_;
+        shownPosition_ = start;
+        clockStartNs_ = now;
+        clockStartPosition_ = start;
+        ++shownCount_;
+        stalePosition_.store(shownPosition_ + 1, std::memory_order_release);
+        return;
+    }
+
+    const uint64_t due = clockStartPosition_ +
+        static_cast<uint64_t>(static_cast<double>(now - clockStartNs_) * 1e-9 * fps_);
+    if (due <= shownPosition_) return;
+
+    // The latest resident frame that is due; the ones skipped to reach it are dropped
+    uint64_t best = kEmptySlot;
+    for (uint32_t slot = 0; slot < slots_; ++slot) {
+        const uint64_t held = slotPositions_[slot];
+        if (held != kEmptySlot && held > shownPosition_ && held <= due && (best == kEmptySlot || held > best)) {
+            best = held;
+        }
+    }
+    if (best == kEmptySlot) return;
+
+    renderer->ShowSequenceFrame(static_cast<uint32_t>(best % slots_));
+    dropped_ += best - shownPosition_ - 1;
+    shownPosition_ = best;
+    ++shownCount_;
+    stalePosition_.store(shownPosition_ + 1, std::memory_order_release);
+}
+
+void SequencePlayer::updateWindow() {
+    uint64_t due = shownPosition_;
+    if (haveShown_) {
+        const uint64_t now = SDL_GetTicksNS();
+        due = clockStartPosition_ + static_cast<uint64_t>(static_cast<double>(now - clockStartNs_) * 1e-9 * fps_);
+    }
+    const uint64_t ring = slots_ > 0 ? slots_ : kMaxSlots;
+    // Behind the clock the ring runs from the frame due; the slot on screen is never reused early
+    const uint64_t base = haveShown_ ? std::max(shownPosition_, due) : firstPosition_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        duePosition_ = haveShown_ ? std::max(due, shownPosition_ + 1) : firstPosition_;
+        decodeLimit_ = base + ring;
+    }
+    cv_.notify_all();
+}
+
+SequencePlayer::Stats SequencePlayer::GetStats() const {
+    Stats stats;
+    stats.frameCount = frames_.size();
+    stats.frame = frames_.empty() ? 0 : static_cast<size_t>(shownPosition_ % frames_.size());
+    stats.fps = fps_;
+    stats.slots = slots_;
+    for (const uint64_t held : slotPositions_) {
+        if (held != kEmptySlot && (!haveShown_ || held > shownPosition_)) {
+            ++stats.resident;
+        }
+    }
+    stats.shown = shownCount_;
+    stats.dropped = dropped_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.skipped = failed_;
+    }
+    return stats;
+}
+
+std::wstring SequencePlayer::GetShownPath() const {
+    if (!haveShown_ || frames_.empty()) return std::wstring();
+    return frames_[shownPosition_ % frames_.size()];
+}
+
+void SequencePlayer::workerMain(unsigned index) {
+    static const char* const kThreadNames[kMaxWorkers] = { "sequence 0", "sequence 1", "sequence 2", "sequence 3" };
+    Trace::NameThread(kThreadNames[index]);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        // Frames already due when a worker is free would only be shown late; start past them
+        cv_.wait(lock, [this] {
+            return stopping_.load(std::memory_order_acquire) ||
+                   std::max(nextDecode_, duePosition_) < decodeLimit_;
+        });
+        if (stopping_.load(std::memory_order_acquire)) return;
+
+        const uint64_t position = std::max(nextDecode_, duePosition_);
+        nextDecode_ = position + 1;
+        const std::wstring& path = frames_[position % frames_.size()];
+        lock.unlock();
+
+        // Abandoned once the frame on screen has passed it
+        auto isCancelled = [this, position] {
+            return stopping_.load(std::memory_order_acquire) ||
+                   position < stalePosition_.load(std::memory_order_acquire);
+        };
+        ImageData frame;
+        std::string error;
+        const bool decoded = DecodeImageFile(path, frame, error, isCancelled, options_);
+
+        lock.lock();
+        if (stopping_.load(std::memory_order_acquire)) return;
+        if (isCancelled()) continue;
+        if (!decoded) {
+            // Shown as a drop: the clock passes over it
+            if (failed_++ == 0) {
+                Logger::WarnW(L"Sequence: could not decode %ls", path.c_str());
+            }
+            continue;
+        }
+        decoded_.emplace(position, std::move(frame));
+    }
+}
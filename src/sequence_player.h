@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "viewer.h"
+
+/**
+ * SequencePlayer - Flipbook playback of numbered frames
+ * FindSequence() gathers the files named like the current one around its frame
+ * number (shot_0001.exr, shot_0002.exr, ...) from the folder listing. While they
+ * play, a ring of decode workers runs ahead of the frame on screen into a ring
+ * of renderer texture slots, and Update() shows whichever resident frame the
+ * clock has reached at the sequence's frame rate. A frame that is not resident
+ * when its time comes is dropped rather than waited for: the clock keeps going,
+ * so slow decodes cost frames, never time.
+ *
+ * Frames are counted by playback position, which keeps increasing across loops:
+ * position p is frame p % frameCount and lives in slot p % slots. Workers decode
+ * at most one ring ahead of the later of the frame shown and the frame due, and
+ * skip positions already due, since those could only be shown late.
+ */
+class SequencePlayer {
+public:
+    struct Stats {
+        size_t frame = 0;           // Frame on screen, 0-based
+        size_t frameCount = 0;
+        double fps = 0.0;
+        uint32_t resident = 0;      // Frames uploaded ahead of the one on screen
+        uint32_t slots = 0;         // Texture ring size; 0 until the first frame is decoded
+        uint64_t shown = 0;
+        uint64_t dropped = 0;       // Frames whose time passed before they were resident
+        uint64_t skipped = 0;       // Frames that failed to decode or differ in size or format
+    };
+
+    // The frames numbered like files[index] in the listing, in frame order; empty when it
+    // has no numbered siblings. 'position' receives where files[index] is among them.
+    static std::vector<std::wstring> FindSequence(const std::vector<std::wstring>& files, int index, size_t& position);
+
+    SequencePlayer();
+    ~SequencePlayer();
+
+    SequencePlayer(const SequencePlayer&) = delete;
+    SequencePlayer& operator=(const SequencePlayer&) = delete;
+
+    // Start decoding 'frames' from 'first'. The texture ring is sized from the first
+    // decoded frame, and the image on screen stays until that frame is shown.
+    bool Play(std::vector<std::wstring> frames, size_t first, const DecodeOptions& options);
+    // Join the workers and end the renderer's ring, keeping the frame on screen.
+    // 'renderer' may be null when it was rebuilt and the ring went with it.
+    void Stop(VulkanRenderer* renderer);
+    bool IsPlaying() const { return playing_; }
+
+    // Main thread, every frame while playing: upload decoded frames into free slots
+    // and show the latest frame due. Stops playback if the ring cannot be made.
+    void Update(VulkanRenderer* renderer);
+
+    Stats GetStats() const;
+    // Frame on screen; empty before the first is shown. Still valid after Stop().
+    std::wstring GetShownPath() const;
+
+private:
+    static constexpr uint32_t kMaxSlots = 8;
+    static constexpr unsigned kMaxWorkers = 4;
+    static constexpr uint32_t kUploadsPerUpdate = 2;   // Bounds the staging copies one frame makes
+    static constexpr double kDefaultFps = 24.0;
+    static constexpr uint64_t kEmptySlot = UINT64_MAX;
+
+    void workerMain(unsigned index);
+    bool beginRing(VulkanRenderer* renderer, const ImageData& frame);
+    void uploadDecoded(VulkanRenderer* renderer);
+    void showDue(VulkanRenderer* renderer);
+    void updateWindow();
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Protected by mutex_
+    std::map<uint64_t, ImageData> decoded_;     // Finished positions waiting for a slot
+    uint64_t nextDecode_ = 0;                   // Next position a worker takes
+    uint64_t duePosition_ = 0;                  // Positions before it are skipped
+    uint64_t decodeLimit_ = 0;                  // Positions from it on wait for the ring to move
+    uint64_t failed_ = 0;                       // Undecodable frames, and mismatched ones once seen
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> stalePosition_{0};    // Decodes before it are abandoned
+
+    // Read by the workers, written only while none run
+    std::vector<std::wstring> frames_;
+    DecodeOptions options_;
+
+    // Main thread
+    bool playing_ = false;
+    uint64_t firstPosition_ = 0;
+    uint32_t slots_ = 0;
+    std::vector<uint64_t> slotPositions_;       // Position each slot holds, or kEmptySlot
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    bool isHdr_ = false;
+    double fps_ = kDefaultFps;
+    bool haveShown_ = false;
+    uint64_t shownPosition_ = 0;
+    uint64_t clockStartNs_ = 0;                 // When shownPosition_ was clockStartPosition_
+    uint64_t clockStartPosition_ = 0;
+    uint64_t shownCount_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t mismatched_ = 0;                   // Frames of another size or format
+};
@@ -0,0 +1,286 @@
+#include "software_scaler.h"
+#include "pixel_convert.h"
+#include "worker_pool.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SOFTWARE_SCALER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // RGBA8 <-> BGRA8 in place; plain enough for the compiler to vectorize
+    void SwapRedBlue(uint32_t* texels, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t v = texels[i];
+            texels[i] = (v & 0xFF00FF00u) | ((v & 0x000000FFu) << 16) | ((v >> 16) & 0x000000FFu);
+        }
+    }
+
+    // Rounded mean of four texels, two channels at a time in 16-bit lanes
+    inline uint32_t Average4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+        constexpr uint32_t kMask = 0x00FF00FFu;
+        const uint32_t rb = ((a & kMask) + (b & kMask) + (c & kMask) + (d & kMask) + 0x00020002u) >> 2;
+        const uint32_t ga = (((a >> 8) & kMask) + ((b >> 8) & kMask) + ((c >> 8) & kMask) + ((d >> 8) & kMask) +
+                             0x00020002u) >> 2;
+        return (rb & kMask) | ((ga & kMask) << 8);
+    }
+
+    // One row of the next level: each texel is the 2x2 box under it. An odd last
+    // column or row of the finer level is dropped, as the GPU's mip chain does.
+    void DownsampleRow(const uint32_t* rowA, const uint32_t* rowB, uint32_t srcWidth, uint32_t* out, uint32_t outWidth) {
+        uint32_t x = 0;
+#if defined(SOFTWARE_SCALER_SSE2)
+        // Two output texels from four input texels of each row per step
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi16(2);
+        for (; x + 2 <= outWidth && 2 * x + 4 <= srcWidth; x += 2) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowA + 2 * x));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowB + 2 * x));
+            const __m128i sumLo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            const __m128i sumHi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(sumLo, sumHi), _mm_unpackhi_epi64(sumLo, sumHi));
+            const __m128i mean = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(mean, mean));
+        }
+#endif
+        for (; x < outWidth; ++x) {
+            const uint32_t x0 = std::min(2 * x, srcWidth - 1);
+            const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1);
+            out[x] = Average4(rowA[x0], rowA[x1], rowB[x0], rowB[x1]);
+        }
+    }
+
+    // Bilinear samples along a line through 'level': the first at (u, v) in texels,
+    // each next one (du, dv) further. Coordinates run in 16.16 fixed point and the
+    // weights in 7 bits, so the lerps stay within 16-bit lanes.
+    void SampleSpan(const uint32_t* texels, uint32_t levelWidth, uint32_t levelHeight,
+                    double u, double v, double du, double dv, uint32_t* out, uint32_t count) {
+        // Half a texel back: the integer part is then the left (top) texel of the four
+        int64_t fu = std::llround((u - 0.5) * 65536.0);
+        int64_t fv = std::llround((v - 0.5) * 65536.0);
+        const int64_t fdu = std::llround(du * 65536.0);
+        const int64_t fdv = std::llround(dv * 65536.0);
+        const int64_t maxX = static_cast<int64_t>(levelWidth) - 1;
+        const int64_t maxY = static_cast<int64_t>(levelHeight) - 1;
+
+#if defined(SOFTWARE_SCALER_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+#endif
+        for (uint32_t i = 0; i < count; ++i, fu += fdu, fv += fdv) {
+            const int64_t xi = fu >> 16;
+            const int64_t yi = fv >> 16;
+            const int fx = static_cast<int>((fu >> 9) & 127);
+            const int fy = static_cast<int>((fv >> 9) & 127);
+            const size_t x0 = static_cast<size_t>(std::clamp<int64_t>(xi, 0, maxX));
+            const size_t x1 = static_cast<size_t>(std::clamp<int64_t>(xi + 1, 0, maxX));
+            const uint32_t* top = texels + static_cast<size_t>(std::clamp<int64_t>(yi, 0, maxY)) * levelWidth;
+            const uint32_t* bottom = texels + static_cast<size_t>(std::clamp<int64_t>(yi + 1, 0, maxY)) * levelWidth;
+#if defined(SOFTWARE_SCALER_SSE2)
+            // Left texel in lanes 0-3, right texel in lanes 4-7
+            const __m128i t = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(top[x0])),
+                                                                   _mm_cvtsi32_si128(static_cast<int>(top[x1]))), zero);
+            const __m128i b = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(bottom[x0])),
+                                                                   _mm_cvtsi32_si128(static_cast<int>(bottom[x1]))), zero);
+            const __m128i column = _mm_add_epi16(t, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(b, t),
+                                                                                   _mm_set1_epi16(static_cast<short>(fy))), 7));
+            const __m128i right = _mm_unpackhi_epi64(column, column);
+            const __m128i mixed = _mm_add_epi16(column, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(right, column),
+                                                                                       _mm_set1_epi16(static_cast<short>(fx))), 7));
+            out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(mixed, mixed)));
+#else
+            uint32_t texel = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                const int p00 = static_cast<int>((top[x0] >> shift) & 0xFF);
+                const int p01 = static_cast<int>((top[x1] >> shift) & 0xFF);
+                const int p10 = static_cast<int>((bottom[x0] >> shift) & 0xFF);
+                const int p11 = static_cast<int>((bottom[x1] >> shift) & 0xFF);
+                const int left = p00 + (((p10 - p00) * fy) >> 7);
+                const int rightColumn = p01 + (((p11 - p01) * fy) >> 7);
+                texel |= static_cast<uint32_t>(left + (((rightColumn - left) * fx) >> 7)) << shift;
+            }
+            out[i] = texel;
+#endif
+        }
+    }
+
+    // Pixels x in [first, last) of a row whose samples a + b * x fall in [0, limit)
+    void CoveredSpan(double a, double b, double limit, int64_t& first, int64_t& last) {
+        if (b == 0.0) {
+            if (a < 0.0 || a >= limit) {
+                last = first;
+            }
+            return;
+        }
+        double lo = (0.0 - a) / b;
+        double hi = (limit - a) / b;
+        if (lo > hi) {
+            std::swap(lo, hi);
+        }
+        // Clamped first: a view far off the image must not overflow the conversion
+        lo = std::clamp(lo, static_cast<double>(first), static_cast<double>(last));
+        hi = std::clamp(hi, static_cast<double>(first), static_cast<double>(last));
+        first = static_cast<int64_t>(std::ceil(lo));
+        last = std::max(first, static_cast<int64_t>(std::ceil(hi)));
+    }
+}
+
+bool SoftwareScaler::SetImage(const void* pixels, uint32_t width, uint32_t height, bool isHdr) {
+    Clear();
+    // NASA Standard: Validate input parameters
+    if (pixels == nullptr || width == 0 || height == 0) {
+        return false;
+    }
+
+    try {
+        uint32_t levelWidth = width;
+        uint32_t levelHeight = height;
+        for (;;) {
+            Level level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.texels.resize(static_cast<size_t>(levelWidth) * levelHeight);
+            levels_.push_back(std::move(level));
+            if (levelWidth == 1 && levelHeight == 1) {
+                break;
+            }
+            levelWidth = std::max(1u, levelWidth / 2);
+            levelHeight = std::max(1u, levelHeight / 2);
+        }
+    } catch (const std::bad_alloc&) {
+        // NASA Standard: Handle memory allocation failure
+        Logger::Warn("SoftwareScaler: no memory for a %ux%u image", width, height);
+        Clear();
+        return false;
+    }
+
+    WorkerPool& pool = WorkerPool::Shared();
+    Level& base = levels_[0];
+    bool converted = pool.ParallelFor(height, std::max<size_t>(1, 65536 / width), [&](size_t r0, size_t r1) {
+        for (size_t y = r0; y < r1; ++y) {
+            uint32_t* out = base.texels.data() + y * width;
+            if (isHdr) {
+                const uint16_t* src = static_cast<const uint16_t*>(pixels) + y * width * 4;
+                PixelConvert::HalfToUnorm8Tonemapped(src, reinterpret_cast<uint8_t*>(out), width);
+            } else {
+                std::memcpy(out, static_cast<const uint8_t*>(pixels) + y * width * 4, static_cast<size_t>(width) * 4);
+            }
+            SwapRedBlue(out, width);
+        }
+    });
+
+    for (size_t i = 1; i < levels_.size() && converted; ++i) {
+        const Level& src = levels_[i - 1];
+        Level& dst = levels_[i];
+        converted = pool.ParallelFor(dst.height, std::max<size_t>(1, 65536 / dst.width), [&](size_t r0, size_t r1) {
+            for (size_t y = r0; y < r1; ++y) {
+                const size_t y0 = std::min<size_t>(2 * y, src.height - 1);
+                const size_t y1 = std::min<size_t>(2 * y + 1, src.height - 1);
+                DownsampleRow(src.texels.data() + y0 * src.width, src.texels.data() + y1 * src.width, src.width,
+                              dst.texels.data() + y * dst.width, dst.width);
+            }
+        });
+    }
+
+    if (!converted) {
+        Logger::Warn("SoftwareScaler: building the %ux%u pyramid failed", width, height);
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void SoftwareScaler::Clear() {
+    levels_.clear();
+    levels_.shrink_to_fit();
+}
+
+void SoftwareScaler::Draw(uint8_t* dst, uint32_t width, uint32_t height, size_t pitch, float zoom, float offsetX,
+                          float offsetY, int rotationAngle, bool mirrored, uint32_t background) const {
+    // NASA Standard: Validate input parameters
+    if (dst == nullptr || width == 0 || height == 0 || pitch < static_cast<size_t>(width) * 4) {
+        return;
+    }
+    auto row = [dst, pitch](int64_t y) { return reinterpret_cast<uint32_t*>(dst + static_cast<size_t>(y) * pitch); };
+
+    // The same view transform as VulkanRenderer::computeImagePush(): fit the rotated
+    // footprint to the window, zoom about the centre, mirror before rotating
+    const double imageWidth = levels_.empty() ? 0.0 : static_cast<double>(levels_[0].width);
+    const double imageHeight = levels_.empty() ? 0.0 : static_cast<double>(levels_[0].height);
+    const int quarterTurns = ((rotationAngle / 90) % 4 + 4) % 4;
+    const bool sideways = (quarterTurns % 2) != 0;
+    const double fitScale = levels_.empty() ? 0.0
+                          : sideways ? std::min(width / imageHeight, height / imageWidth)
+                                     : std::min(width / imageWidth, height / imageHeight);
+    const double scale = fitScale * std::clamp(static_cast<double>(zoom), 0.01, 10.0);
+    const bool drawable = scale > 0.0 && std::isfinite(scale) && std::isfinite(offsetX) && std::isfinite(offsetY);
+    if (!drawable) {
+        WorkerPool::Shared().ParallelFor(height, 64, [&](size_t r0, size_t r1) {
+            for (size_t y = r0; y < r1; ++y) {
+                std::fill_n(row(static_cast<int64_t>(y)), width, background);
+            }
+        });
+        return;
+    }
+
+    // The level whose texels are just under a pixel; bilinear filtering then reads at
+    // most a 2x2 footprint of it, which the box filter already averaged
+    const double texelsPerPixel = 1.0 / scale;
+    size_t levelIndex = texelsPerPixel > 1.0 ? static_cast<size_t>(std::floor(std::log2(texelsPerPixel))) : 0;
+    levelIndex = std::min(levelIndex, levels_.size() - 1);
+    const Level& level = levels_[levelIndex];
+
+    // A pixel centre (x + 0.5, y + 0.5) lands at u = u0 + x * dudx + y * dudy (likewise v)
+    // in the chosen level's texels
+    constexpr double kCos[4] = { 1.0, 0.0, -1.0, 0.0 };
+    constexpr double kSin[4] = { 0.0, 1.0, 0.0, -1.0 };
+    const double c = kCos[quarterTurns];
+    const double s = kSin[quarterTurns];
+    const double mirror = mirrored ? -1.0 : 1.0;
+    const double kx = level.width / imageWidth;
+    const double ky = level.height / imageHeight;
+    const double centerX = width * 0.5 + offsetX;
+    const double centerY = height * 0.5 + offsetY;
+    const double dx0 = 0.5 - centerX;
+    const double dy0 = 0.5 - centerY;
+    const double dudx = kx * mirror * c / scale;
+    const double dudy = kx * mirror * s / scale;
+    const double dvdx = -ky * s / scale;
+    const double dvdy = ky * c / scale;
+    const double u0 = kx * (imageWidth * 0.5 + mirror * (dx0 * c + dy0 * s) / scale);
+    const double v0 = ky * (imageHeight * 0.5 + (-dx0 * s + dy0 * c) / scale);
+
+    // Square tiles keep the texels a tile reads close together at any rotation
+    const uint32_t tilesX = (width + kTileSize - 1) / kTileSize;
+    const uint32_t tilesY = (height + kTileSize - 1) / kTileSize;
+    WorkerPool::Shared().ParallelFor(static_cast<size_t>(tilesX) * tilesY, 1, [&](size_t t0, size_t t1) {
+        for (size_t t = t0; t < t1; ++t) {
+            const int64_t x0 = static_cast<int64_t>(t % tilesX) * kTileSize;
+            const int64_t x1 = std::min<int64_t>(x0 + kTileSize, width);
+            const int64_t y0 = static_cast<int64_t>(t / tilesX) * kTileSize;
+            const int64_t y1 = std::min<int64_t>(y0 + kTileSize, height);
+            for (int64_t y = y0; y < y1; ++y) {
+                uint32_t* out = row(y);
+                const double uRow = u0 + y * dudy;
+                const double vRow = v0 + y * dvdy;
+                int64_t first = x0;
+                int64_t last = x1;
+                CoveredSpan(uRow, dudx, level.width, first, last);
+                CoveredSpan(vRow, dvdx, level.height, first, last);
+                if (first >= last) {
+                    std::fill(out + x0, out + x1, background);
+                    continue;
+                }
+                std::fill(out + x0, out + first, background);
+                SampleSpan(level.texels.data(), level.width, level.height, uRow + first * dudx, vRow + first * dvdx,
+                           dudx, dvdx, out + first, static_cast<uint32_t>(last - first));
+                std::fill(out + last, out + x1, background);
+            }
+        }
+    });
+}
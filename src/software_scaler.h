@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * SoftwareScaler - CPU image drawing for the software (non-Vulkan) fallback
+ * SetImage() converts the image once to display-ready BGRA8 (HDR tonemapped
+ * as exports are) and box-filters it into a mip pyramid. Draw() then maps
+ * every window pixel back into the level whose texels are just under a pixel
+ * and samples it bilinearly, with the same fit, zoom, offset, rotation and
+ * mirroring as the GPU path, so a frame costs the window's pixels rather than
+ * the image's. The window is drawn in tiles on the shared worker pool, and
+ * each tile samples only the span of each row the image covers.
+ *
+ * Not thread-safe: one thread sets the image and draws.
+ */
+class SoftwareScaler {
+public:
+    SoftwareScaler() = default;
+
+    SoftwareScaler(const SoftwareScaler&) = delete;
+    SoftwareScaler& operator=(const SoftwareScaler&) = delete;
+
+    // Build the pyramid from tightly packed RGBA8, or RGBA16F when 'isHdr'.
+    // False (and no image) when memory for it is not available.
+    bool SetImage(const void* pixels, uint32_t width, uint32_t height, bool isHdr);
+    void Clear();
+    bool HasImage() const { return !levels_.empty(); }
+
+    // Draw into 'dst', 'width' x 'height' BGRA8 texels 'pitch' bytes apart. Arguments are
+    // Render()'s; pixels the image does not cover get 'background' (0xAARRGGBB).
+    void Draw(uint8_t* dst, uint32_t width, uint32_t height, size_t pitch, float zoom, float offsetX, float offsetY,
+              int rotationAngle, bool mirrored, uint32_t background) const;
+
+private:
+    static constexpr uint32_t kTileSize = 64;
+
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> texels;   // BGRA8, as a DIB wants them
+    };
+
+    std::vector<Level> levels_;
+};
@@ -27,8 +27,9 @@ bool TextRenderer::Initialize() {
         return true; // Already initialized
     }
 
-    if (TTF_Init() != 0) {
-        Logger::Error("Failed to initialize SDL_ttf: {}", SDL_GetError());
+    // SDL3_ttf reports success as true
+    if (!TTF_Init()) {
+        Logger::Error("Failed to initialize SDL_ttf: %s", SDL_GetError());
         return false;
     }
 
@@ -54,6 +55,7 @@ void TextRenderer::Shutdown() {
     if (font_) {
         TTF_CloseFont(font_);
         font_ = nullptr;
+        atlasBuilt_ = false;
     }
     
     if (ttfInitialized_) {
@@ -72,6 +74,7 @@ bool TextRenderer::LoadFont(const std::string& fontPath, int fontSize) {
     if (font_) {
         TTF_CloseFont(font_);
         font_ = nullptr;
+        atlasBuilt_ = false;
     }
 
     font_ = TTF_OpenFont(fontPath.c_str(), fontSize);
@@ -141,6 +144,7 @@ bool TextRenderer::LoadSystemFont(int fontSize) {
     if (font_) {
         TTF_CloseFont(font_);
         font_ = nullptr;
+        atlasBuilt_ = false;
     }
 
     font_ = LoadSystemFontInternal(fontSize);
@@ -265,6 +269,7 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
         return nullptr;
     }
 
+    const std::vector<std::string> text = GetInstructionalText(openColorIOAvailable);
     std::vector<TextLine> lines;
     
     // Calculate center positions
@@ -273,7 +278,7 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
     
     // Title - use current font size with centered positioning
     SDL_Color titleColor = {200, 200, 255, 255}; // Light blue
-    std::string title = "Minimal Image Viewer";
+    const std::string& title = text[0];
     int titleW = 0, titleH = 0;
     if (GetTextSize(title, font_, &titleW, &titleH)) {
         lines.emplace_back(title, centerX - titleW/2, centerY - 80, titleColor, currentFontSize_, 400.0f, 100.0f);
@@ -285,7 +290,7 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
     
     // Main instruction
     SDL_Color instructColor = {255, 255, 255, 255}; // White
-    std::string instruction = "Drag & drop an image here, or press Ctrl+O to open a file.";
+    const std::string& instruction = text[1];
     int instrW = 0, instrH = 0;
     if (GetTextSize(instruction, font_, &instrW, &instrH)) {
         lines.emplace_back(instruction, centerX - instrW/2, centerY - 30, instructColor, currentFontSize_, 400.0f, 100.0f);
@@ -299,9 +304,7 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
     SDL_Color statusColor = openColorIOAvailable ? 
         SDL_Color{200, 255, 200, 255} : SDL_Color{255, 200, 200, 255}; // Green if available, red if not
     
-    std::string ocioStatus = openColorIOAvailable ? 
-        "OpenColorIO: Available (color management enabled)" :
-        "OpenColorIO: Not available (basic color display)";
+    const std::string& ocioStatus = text[2];
     
     int statusW = 0, statusH = 0;
     if (GetTextSize(ocioStatus, font_, &statusW, &statusH)) {
@@ -314,7 +317,7 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
     
     // Shortcuts
     SDL_Color shortcutColor = {220, 220, 220, 255}; // Light gray
-    std::string shortcuts = "Shortcuts: Ctrl+Wheel/+/- to zoom, Ctrl+0 to fit, Right-click for menu.";
+    const std::string& shortcuts = text[3];
     int shortcutsW = 0, shortcutsH = 0;
     if (GetTextSize(shortcuts, font_, &shortcutsW, &shortcutsH)) {
         lines.emplace_back(shortcuts, centerX - shortcutsW/2, centerY + 30, shortcutColor, currentFontSize_, 400.0f, 100.0f);
@@ -329,7 +332,199 @@ SDL_Surface* TextRenderer::CreateInstructionalSurface(int width, int height, boo
     return CreateTextSurface(lines, width, height, backgroundColor);
 }
 
+std::vector<std::string> TextRenderer::GetInstructionalText(bool openColorIOAvailable) const {
+    return {
+        "Minimal Image Viewer",
+        "Drag & drop an image here, or press Ctrl+O to open a file.",
+        openColorIOAvailable ?
+            "OpenColorIO: Available (color management enabled)" :
+            "OpenColorIO: Not available (basic color display)",
+        "Shortcuts: Ctrl+Wheel/+/- to zoom, Ctrl+0 to fit, Right-click for menu."
+    };
+}
+
+const TextRenderer::GlyphAtlas* TextRenderer::GetGlyphAtlas() {
+    if (!atlasBuilt_) {
+        atlasBuilt_ = true;
+        if (!buildGlyphAtlas()) {
+            atlas_ = GlyphAtlas{};
+        }
+    }
+    return atlas_.pixels.empty() ? nullptr : &atlas_;
+}
+
+bool TextRenderer::buildGlyphAtlas() {
+    atlas_ = GlyphAtlas{};
+    if (!font_) return false;
+
+    constexpr int kAtlasWidth = 512;
+    constexpr int kPadding = 1;         // Keeps bilinear taps inside each cell
+    constexpr int kSolidSize = 4;
+    const SDL_Color white{255, 255, 255, 255};
+
+    struct Cell {
+        SDL_Surface* surface = nullptr;
+        int advance = 0;
+    };
+    Cell cells[kGlyphCount];
+
+    // Shelf-pack the cells in code point order; the opaque block comes first
+    int penX = kSolidSize + kPadding;
+    int penY = 0;
+    int shelfHeight = kSolidSize;
+    const int lineHeight = std::max(1, TTF_GetFontHeight(font_));
+
+    for (int i = 0; i < kGlyphCount; ++i) {
+        const Uint32 ch = static_cast<Uint32>(kFirstGlyph + i);
+        int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+        if (TTF_GetGlyphMetrics(font_, ch, &minX, &maxX, &minY, &maxY, &advance)) {
+            cells[i].advance = advance;
+        }
+
+        SDL_Surface* glyph = (ch == ' ') ? nullptr : TTF_RenderGlyph_Blended(font_, ch, white);
+        if (glyph && glyph->format != SDL_PIXELFORMAT_RGBA32) {
+            SDL_Surface* converted = SDL_ConvertSurface(glyph, SDL_PIXELFORMAT_RGBA32);
+            SDL_DestroySurface(glyph);
+            glyph = converted;
+        }
+        if (!glyph) continue;
+        if (cells[i].advance == 0) cells[i].advance = glyph->w;
+
+        if (penX + glyph->w > kAtlasWidth) {
+            penX = 0;
+            penY += shelfHeight + kPadding;
+            shelfHeight = 0;
+        }
+        auto& g = atlas_.glyphs[i];
+        g.x = penX;
+        g.y = penY;
+        g.w = std::min(glyph->w, kAtlasWidth);
+        g.h = glyph->h;
+        penX += g.w + kPadding;
+        shelfHeight = std::max(shelfHeight, g.h);
+        cells[i].surface = glyph;
+    }
+
+    // Power-of-two height keeps the texture friendly to every driver
+    int atlasHeight = 64;
+    while (atlasHeight < penY + shelfHeight) atlasHeight *= 2;
+
+    atlas_.width = kAtlasWidth;
+    atlas_.height = atlasHeight;
+    atlas_.lineHeight = lineHeight;
+    atlas_.solidX = kSolidSize / 2;
+    atlas_.solidY = kSolidSize / 2;
+    atlas_.pixels.assign(static_cast<size_t>(kAtlasWidth) * atlasHeight * 4, 0);
+
+    for (int y = 0; y < kSolidSize; ++y) {
+        std::memset(atlas_.pixels.data() + static_cast<size_t>(y) * kAtlasWidth * 4, 0xFF, kSolidSize * 4);
+    }
+
+    for (int i = 0; i < kGlyphCount; ++i) {
+        auto& g = atlas_.glyphs[i];
+        g.advance = cells[i].advance;
+        SDL_Surface* glyph = cells[i].surface;
+        if (!glyph) continue;
+
+        if (SDL_MUSTLOCK(glyph)) SDL_LockSurface(glyph);
+        const uint8_t* src = static_cast<const uint8_t*>(glyph->pixels);
+        for (int y = 0; y < g.h; ++y) {
+            const uint8_t* srcRow = src + static_cast<size_t>(y) * glyph->pitch;
+            uint8_t* dstRow = atlas_.pixels.data() + (static_cast<size_t>(g.y + y) * kAtlasWidth + g.x) * 4;
+            for (int x = 0; x < g.w; ++x) {
+                // Coverage only; colour comes from each quad
+                dstRow[x * 4 + 0] = 255;
+                dstRow[x * 4 + 1] = 255;
+                dstRow[x * 4 + 2] = 255;
+                dstRow[x * 4 + 3] = srcRow[x * 4 + 3];
+            }
+        }
+        if (SDL_MUSTLOCK(glyph)) SDL_UnlockSurface(glyph);
+        SDL_DestroySurface(glyph);
+    }
+
+    Logger::Info("TextRenderer: glyph atlas %dx%d, line height %d", atlas_.width, atlas_.height, lineHeight);
+    return true;
+}
+
+void TextRenderer::LayoutText(const std::string& text, float x, float y, SDL_Color color,
+                              std::vector<GlyphQuad>& out) const {
+    if (atlas_.pixels.empty()) return;
+
+    const float invW = 1.0f / static_cast<float>(atlas_.width);
+    const float invH = 1.0f / static_cast<float>(atlas_.height);
+    const float rgba[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+
+    float penX = x;
+    float penY = y;
+    for (const char c : text) {
+        if (c == '\n') {
+            penX = x;
+            penY += static_cast<float>(atlas_.lineHeight);
+            continue;
+        }
+        const int code = static_cast<unsigned char>(c);
+        const int index = (code >= kFirstGlyph && code < kFirstGlyph + kGlyphCount) ? code - kFirstGlyph : '?' - kFirstGlyph;
+        const auto& g = atlas_.glyphs[index];
+        if (g.w > 0 && g.h > 0) {
+            GlyphQuad q;
+            q.rect[0] = penX;
+            q.rect[1] = penY;
+            q.rect[2] = penX + static_cast<float>(g.w);
+            q.rect[3] = penY + static_cast<float>(g.h);
+            q.uv[0] = static_cast<float>(g.x) * invW;
+            q.uv[1] = static_cast<float>(g.y) * invH;
+            q.uv[2] = static_cast<float>(g.x + g.w) * invW;
+            q.uv[3] = static_cast<float>(g.y + g.h) * invH;
+            std::memcpy(q.color, rgba, sizeof(rgba));
+            out.push_back(q);
+        }
+        penX += static_cast<float>(g.advance);
+    }
+}
+
+void TextRenderer::MeasureText(const std::string& text, int* width, int* height) const {
+    int lineWidth = 0;
+    int maxWidth = 0;
+    int lines = text.empty() ? 0 : 1;
+    for (const char c : text) {
+        if (c == '\n') {
+            maxWidth = std::max(maxWidth, lineWidth);
+            lineWidth = 0;
+            ++lines;
+            continue;
+        }
+        const int code = static_cast<unsigned char>(c);
+        const int index = (code >= kFirstGlyph && code < kFirstGlyph + kGlyphCount) ? code - kFirstGlyph : '?' - kFirstGlyph;
+        lineWidth += atlas_.glyphs[index].advance;
+    }
+    if (width) *width = std::max(maxWidth, lineWidth);
+    if (height) *height = lines * atlas_.lineHeight;
+}
+
+void TextRenderer::AddSolidQuad(float x0, float y0, float x1, float y1, SDL_Color color,
+                                std::vector<GlyphQuad>& out) const {
+    if (atlas_.pixels.empty()) return;
+
+    // Every corner samples the middle of the opaque block
+    const float u = (static_cast<float>(atlas_.solidX) + 0.5f) / static_cast<float>(atlas_.width);
+    const float v = (static_cast<float>(atlas_.solidY) + 0.5f) / static_cast<float>(atlas_.height);
+    GlyphQuad q;
+    q.rect[0] = x0;
+    q.rect[1] = y0;
+    q.rect[2] = x1;
+    q.rect[3] = y1;
+    q.uv[0] = q.uv[2] = u;
+    q.uv[1] = q.uv[3] = v;
+    q.color[0] = color.r / 255.0f;
+    q.color[1] = color.g / 255.0f;
+    q.color[2] = color.b / 255.0f;
+    q.color[3] = color.a / 255.0f;
+    out.push_back(q);
+}
+
 SDL_Surface* TextRenderer::CreateSplashScreenSurface(int width, int height, const std::string& statusText) {
+    const std::vector<std::string> text = GetInstructionalText(openColorIOAvailable);
     std::vector<TextLine> lines;
     
     // Calculate center positions  
@@ -418,6 +613,7 @@ bool TextRenderer::LoadApplicationFont(int fontSize) {
     }
     
     // Try to load the font with default variable settings
+    atlasBuilt_ = false;
     font_ = CreateFontWithVariations(fontPath, fontSize, 
                                    fontVariations_["wght"], 
                                    fontVariations_["wdth"]);
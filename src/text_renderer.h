@@ -2,6 +2,7 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +32,34 @@ public:
               fontWeight(weight), fontWidth(width) {}
     };
 
+    // Printable ASCII, rasterized once into the glyph atlas
+    static constexpr int kFirstGlyph = 32;
+    static constexpr int kGlyphCount = 95;
+
+    // One textured rectangle of an overlay, laid out from the glyph atlas.
+    // Plain floats so a renderer can copy these straight into a vertex buffer.
+    struct GlyphQuad {
+        float rect[4];    // x0, y0, x1, y1 in pixels
+        float uv[4];      // u0, v0, u1, v1 in the atlas
+        float color[4];   // RGBA in [0,1]
+    };
+
+    // White glyph cells with coverage in alpha (RGBA32), plus a small opaque
+    // block for solid backdrops. Cells include the bearing, so placing them
+    // side by side at their advance reproduces the font's spacing.
+    struct GlyphAtlas {
+        struct Glyph {
+            int x = 0, y = 0, w = 0, h = 0;
+            int advance = 0;
+        };
+        int width = 0;
+        int height = 0;
+        int lineHeight = 0;
+        int solidX = 0, solidY = 0;     // Centre of the opaque block
+        Glyph glyphs[kGlyphCount];
+        std::vector<uint8_t> pixels;
+    };
+
     TextRenderer();
     ~TextRenderer();
 
@@ -60,6 +89,22 @@ public:
     // Create instructional UI surface for "no image loaded" state
     SDL_Surface* CreateInstructionalSurface(int width, int height, bool openColorIOAvailable = false);
 
+    // Lines shown by CreateInstructionalSurface, for callers caching its result
+    std::vector<std::string> GetInstructionalText(bool openColorIOAvailable) const;
+
+    // Atlas for the current font, built on first use. nullptr without a font.
+    const GlyphAtlas* GetGlyphAtlas();
+
+    // Append one quad per visible glyph of 'text' with its top-left at (x, y);
+    // '\n' starts a new line. Needs GetGlyphAtlas() to have succeeded.
+    void LayoutText(const std::string& text, float x, float y, SDL_Color color, std::vector<GlyphQuad>& out) const;
+
+    // Pixel size of 'text' as LayoutText would place it
+    void MeasureText(const std::string& text, int* width, int* height) const;
+
+    // Append an untextured rectangle drawn from the atlas's opaque block
+    void AddSolidQuad(float x0, float y0, float x1, float y1, SDL_Color color, std::vector<GlyphQuad>& out) const;
+
     // Create splash screen surface
     SDL_Surface* CreateSplashScreenSurface(int width, int height, const std::string& statusText = "Loading...");
 
@@ -83,8 +128,11 @@ private:
     std::string fontFamily_;
     std::string currentFontPath_;
     std::map<std::string, float> fontVariations_;  // Current variable font settings
+    GlyphAtlas atlas_;                              // Empty until GetGlyphAtlas()
+    bool atlasBuilt_ = false;
 
     // Helper methods
+    bool buildGlyphAtlas();
     bool GetTextSize(const std::string& text, TTF_Font* font, int* width, int* height);
     SDL_Surface* RenderTextLine(const std::string& text, SDL_Color color, TTF_Font* font);
     void BlitTextToSurface(SDL_Surface* textSurface, SDL_Surface* targetSurface, int x, int y);
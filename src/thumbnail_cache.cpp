@@ -0,0 +1,296 @@
+#include "thumbnail_cache.h"
+#include "logging.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <shlobj.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+
+namespace {
+    constexpr uint32_t kMagic = 0x5456494D;            // "MIVT"
+    constexpr uint32_t kVersion = 1;
+    constexpr uint32_t kIndexEntries = 65536;           // Power of two; at most half full
+    constexpr uint32_t kMaxSlots = kIndexEntries / 2;   // 2 GB of slots at the most
+    constexpr uint64_t kSlotBytes = static_cast<uint64_t>(ThumbnailCache::kThumbnailSize) *
+                                    ThumbnailCache::kThumbnailSize * 4;
+    constexpr uint32_t kSlotsPerChunk = 256;            // 16 MB grown at a time
+    constexpr uint64_t kChunkBytes = kSlotBytes * kSlotsPerChunk;
+    constexpr uint64_t kHeaderBytes = 4096;
+    constexpr uint64_t kEntryBytes = 32;
+    // Views start on the 64 KB allocation granularity, so the slots do too
+    constexpr uint64_t kMapAlignment = 65536;
+    constexpr uint64_t kSlotsOffset = (kHeaderBytes + kEntryBytes * kIndexEntries + sizeof(uint32_t) * kMaxSlots +
+                                       kMapAlignment - 1) / kMapAlignment * kMapAlignment;
+    static_assert(kSlotBytes % kMapAlignment == 0, "Chunks must stay aligned to the allocation granularity");
+
+    // FNV-1a over the lower-cased path, so differently cased spellings share an entry
+    uint64_t HashPath(const std::wstring& path) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const wchar_t c : path) {
+            const uint32_t unit = static_cast<uint32_t>(std::towlower(c));
+            for (int shift = 0; shift < 32; shift += 8) {
+                hash ^= (unit >> shift) & 0xFFu;
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    void* MapRange(HANDLE file, uint64_t offset, uint64_t size) {
+        // A mapping larger than the file extends it; the new bytes read as zeros
+        const uint64_t end = offset + size;
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+        if (mapping == nullptr) {
+            return nullptr;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE,
+                                   static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), static_cast<SIZE_T>(size));
+        // The view keeps the section alive
+        CloseHandle(mapping);
+        return view;
+    }
+}
+
+struct ThumbnailCache::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t thumbnailSize;
+    uint32_t indexEntries;
+    uint32_t maxSlots;
+    uint32_t usedSlots;         // Slots handed out so far; they fill the chunks in order
+    uint32_t nextVictim;        // Slot reused next once all are in use
+    uint32_t reserved;
+};
+
+struct ThumbnailCache::Entry {
+    uint64_t pathHash;
+    uint64_t fileSize;
+    uint64_t writeTime;
+    uint32_t slot;              // Slot + 1; 0 marks an empty index position
+    uint16_t width;
+    uint16_t height;
+};
+
+ThumbnailCache::~ThumbnailCache() {
+    Close();
+}
+
+std::wstring ThumbnailCache::DefaultPath() {
+    std::wstring dir;
+    PWSTR appData = nullptr;
+    if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &appData)) && appData) {
+        dir = std::wstring(appData) + L"\\MinimalImageViewer";
+        CoTaskMemFree(appData);
+        const int rc = SHCreateDirectoryExW(nullptr, dir.c_str(), nullptr);
+        if (rc != ERROR_SUCCESS && rc != ERROR_ALREADY_EXISTS && rc != ERROR_FILE_EXISTS) {
+            dir.clear();
+        }
+    }
+    if (dir.empty()) {
+        dir = Logger::GetLogDirectory();
+    }
+    return (dir.empty() ? std::wstring(L".") : dir) + L"\\thumbnails.cache";
+}
+
+bool ThumbnailCache::MakeKey(const std::wstring& path, Key& out) {
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data) ||
+        (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+    out.pathHash = HashPath(path);
+    out.fileSize = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    out.writeTime = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                    data.ftLastWriteTime.dwLowDateTime;
+    return true;
+}
+
+bool ThumbnailCache::Open(const std::wstring& cachePath) {
+    static_assert(sizeof(Entry) == kEntryBytes, "Index entries are stored as laid out");
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
+
+    // Exclusive: two viewers updating one index would corrupt it
+    HANDLE file = CreateFileW(cachePath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Logger::Warn("ThumbnailCache: cannot open the cache file (error %lu); thumbnails are not kept",
+                     static_cast<unsigned long>(GetLastError()));
+        return false;
+    }
+    file_ = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        size.QuadPart = 0;
+    }
+    base_ = static_cast<uint8_t*>(MapRange(file, 0, kSlotsOffset));
+    if (base_ == nullptr) {
+        Logger::Warn("ThumbnailCache: cannot map the cache index (error %lu)", static_cast<unsigned long>(GetLastError()));
+        closeLocked();
+        return false;
+    }
+    header_ = reinterpret_cast<Header*>(base_);
+    entries_ = reinterpret_cast<Entry*>(base_ + kHeaderBytes);
+    owners_ = reinterpret_cast<uint32_t*>(base_ + kHeaderBytes + kEntryBytes * kIndexEntries);
+
+    const uint64_t chunksNeeded = (static_cast<uint64_t>(header_->usedSlots) + kSlotsPerChunk - 1) / kSlotsPerChunk;
+    const bool valid = header_->magic == kMagic && header_->version == kVersion &&
+                       header_->thumbnailSize == kThumbnailSize && header_->indexEntries == kIndexEntries &&
+                       header_->maxSlots == kMaxSlots && header_->usedSlots <= kMaxSlots &&
+                       header_->nextVictim < kMaxSlots &&
+                       static_cast<uint64_t>(size.QuadPart) >= kSlotsOffset + chunksNeeded * kChunkBytes;
+    if (!valid) {
+        // New, foreign or torn: start empty. Old slot bytes are overwritten as slots are reused.
+        std::memset(base_, 0, static_cast<size_t>(kSlotsOffset));
+        header_->version = kVersion;
+        header_->thumbnailSize = kThumbnailSize;
+        header_->indexEntries = kIndexEntries;
+        header_->maxSlots = kMaxSlots;
+        header_->magic = kMagic;
+    }
+
+    const uint32_t chunks = static_cast<uint32_t>((header_->usedSlots + kSlotsPerChunk - 1) / kSlotsPerChunk);
+    for (uint32_t chunk = 0; chunk < chunks; ++chunk) {
+        if (!mapChunk(chunk)) {
+            Logger::Warn("ThumbnailCache: cannot map slot chunk %u (error %lu)", chunk,
+                         static_cast<unsigned long>(GetLastError()));
+            closeLocked();
+            return false;
+        }
+    }
+    Logger::Info("ThumbnailCache: %u thumbnails in the cache", header_->usedSlots);
+    return true;
+}
+
+void ThumbnailCache::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
+}
+
+bool ThumbnailCache::IsOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return header_ != nullptr;
+}
+
+void ThumbnailCache::closeLocked() {
+    for (uint8_t* chunk : chunks_) {
+        UnmapViewOfFile(chunk);
+    }
+    chunks_.clear();
+    if (base_ != nullptr) {
+        UnmapViewOfFile(base_);
+    }
+    base_ = nullptr;
+    header_ = nullptr;
+    entries_ = nullptr;
+    owners_ = nullptr;
+    if (file_ != nullptr) {
+        CloseHandle(static_cast<HANDLE>(file_));
+        file_ = nullptr;
+    }
+}
+
+bool ThumbnailCache::mapChunk(uint32_t chunk) {
+    void* view = MapRange(static_cast<HANDLE>(file_), kSlotsOffset + chunk * kChunkBytes, kChunkBytes);
+    if (view == nullptr) {
+        return false;
+    }
+    chunks_.push_back(static_cast<uint8_t*>(view));
+    return true;
+}
+
+uint8_t* ThumbnailCache::slotPixels(uint32_t slot) const {
+    return chunks_[slot / kSlotsPerChunk] + static_cast<size_t>(slot % kSlotsPerChunk) * kSlotBytes;
+}
+
+uint32_t ThumbnailCache::probe(uint64_t pathHash) const {
+    uint32_t position = static_cast<uint32_t>(pathHash) & (kIndexEntries - 1);
+    // Never more than half full, so an empty position always ends the walk
+    while (entries_[position].slot != 0 && entries_[position].pathHash != pathHash) {
+        position = (position + 1) & (kIndexEntries - 1);
+    }
+    return position;
+}
+
+void ThumbnailCache::removeEntry(uint32_t position) {
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    uint32_t hole = position;
+    for (uint32_t next = (hole + 1) & (kIndexEntries - 1); entries_[next].slot != 0;
+         next = (next + 1) & (kIndexEntries - 1)) {
+        const uint32_t home = static_cast<uint32_t>(entries_[next].pathHash) & (kIndexEntries - 1);
+        // The entry may fill the hole unless its home lies cyclically in (hole, next]
+        const bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (stays) continue;
+        entries_[hole] = entries_[next];
+        owners_[entries_[hole].slot - 1] = hole + 1;
+        hole = next;
+    }
+    entries_[hole] = Entry{};
+}
+
+bool ThumbnailCache::Lookup(const Key& key, std::vector<uint8_t>& rgba, uint32_t& width, uint32_t& height) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr) return false;
+
+    const Entry& entry = entries_[probe(key.pathHash)];
+    if (entry.slot == 0 || entry.slot > header_->usedSlots ||
+        entry.fileSize != key.fileSize || entry.writeTime != key.writeTime ||
+        entry.width == 0 || entry.height == 0 || entry.width > kThumbnailSize || entry.height > kThumbnailSize) {
+        return false;
+    }
+    width = entry.width;
+    height = entry.height;
+    const uint8_t* pixels = slotPixels(entry.slot - 1);
+    rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    return true;
+}
+
+bool ThumbnailCache::Store(const Key& key, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    // NASA Standard: Validate all input parameters
+    if (rgba == nullptr || width == 0 || height == 0 || width > kThumbnailSize || height > kThumbnailSize) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr) return false;
+
+    uint32_t position = probe(key.pathHash);
+    uint32_t slot = 0;
+    if (entries_[position].slot != 0) {
+        // A newer version of the same file: overwrite its slot
+        slot = entries_[position].slot - 1;
+    } else if (header_->usedSlots < kMaxSlots) {
+        slot = header_->usedSlots;
+        if (slot / kSlotsPerChunk >= chunks_.size() && !mapChunk(slot / kSlotsPerChunk)) {
+            return false;
+        }
+        header_->usedSlots = slot + 1;
+    } else {
+        // Full: reuse the oldest written slot, dropping the entry that owns it
+        slot = header_->nextVictim;
+        header_->nextVictim = (slot + 1) % kMaxSlots;
+        if (owners_[slot] != 0) {
+            removeEntry(owners_[slot] - 1);
+            owners_[slot] = 0;
+        }
+        position = probe(key.pathHash);
+    }
+
+    // Unmatchable while the pixels are replaced, so a torn write is never served
+    Entry& entry = entries_[position];
+    entry.fileSize = UINT64_MAX;
+    entry.writeTime = 0;
+    std::memcpy(slotPixels(slot), rgba, static_cast<size_t>(width) * height * 4);
+    entry.pathHash = key.pathHash;
+    entry.width = static_cast<uint16_t>(width);
+    entry.height = static_cast<uint16_t>(height);
+    entry.slot = slot + 1;
+    entry.writeTime = key.writeTime;
+    entry.fileSize = key.fileSize;
+    owners_[slot] = position + 1;
+    return true;
+}
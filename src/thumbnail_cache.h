@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * ThumbnailCache - Grid thumbnails kept on disk in one memory-mapped file
+ * Each thumbnail is oriented RGBA8, at most kThumbnailSize on its long side,
+ * in a fixed-size slot. Entries are keyed on the file's path together with
+ * its size and last-write time, so an edited file misses and is generated
+ * again. Reopening a folder then costs one lookup and copy per visible cell
+ * instead of a decode.
+ *
+ * The file holds a header, an open-addressed index and the slots. It grows
+ * a chunk of slots at a time, and each chunk is mapped as its own view, so
+ * views already handed out stay valid as it grows. When every slot is in use, the
+ * oldest written is reused. Pages are left for the OS to write back; a file
+ * whose header does not validate on open (other version, other slot size)
+ * starts over empty. One process owns the file at a time; a second viewer
+ * runs without the cache.
+ *
+ * Thread-safe: lookups copy the pixels out under the lock.
+ */
+class ThumbnailCache {
+public:
+    // Long side of a stored thumbnail
+    static constexpr uint32_t kThumbnailSize = 128;
+
+    struct Key {
+        uint64_t pathHash = 0;
+        uint64_t fileSize = 0;
+        uint64_t writeTime = 0;     // FILETIME of the last write
+    };
+
+    ThumbnailCache() = default;
+    ~ThumbnailCache();
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // %LOCALAPPDATA%\MinimalImageViewer\thumbnails.cache, beside the logs otherwise
+    static std::wstring DefaultPath();
+
+    // Key of the file as it is on disk now. False if it cannot be read.
+    static bool MakeKey(const std::wstring& path, Key& out);
+
+    bool Open(const std::wstring& cachePath);
+    void Close();
+    bool IsOpen() const;
+
+    // Copy a stored thumbnail out. False on a miss, including an entry for an older version of the file.
+    bool Lookup(const Key& key, std::vector<uint8_t>& rgba, uint32_t& width, uint32_t& height);
+
+    // Store tightly packed RGBA8 pixels of at most kThumbnailSize x kThumbnailSize
+    bool Store(const Key& key, const uint8_t* rgba, uint32_t width, uint32_t height);
+
+private:
+    struct Header;
+    struct Entry;
+
+    bool mapChunk(uint32_t chunk);
+    uint8_t* slotPixels(uint32_t slot) const;
+    // Index position of the live entry for 'pathHash', or of the empty position where it would go
+    uint32_t probe(uint64_t pathHash) const;
+    void removeEntry(uint32_t position);
+    void closeLocked();
+
+    mutable std::mutex mutex_;
+    void* file_ = nullptr;                  // HANDLE
+    uint8_t* base_ = nullptr;               // Header, index and slot owners
+    std::vector<uint8_t*> chunks_;          // Mapped slot chunks, in file order
+    Header* header_ = nullptr;
+    Entry* entries_ = nullptr;
+    uint32_t* owners_ = nullptr;            // Index position + 1 of each slot's entry, 0 when free
+};
@@ -0,0 +1,313 @@
+#include "thumbnail_grid.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+// Thumbnails are made at the size the atlas cells hold them
+static_assert(ThumbnailCache::kThumbnailSize == VulkanRenderer::kThumbnailCellSize,
+              "Thumbnail cache and atlas cells must agree on the thumbnail size");
+
+namespace {
+    constexpr float kCellSize = static_cast<float>(VulkanRenderer::kThumbnailCellSize);
+
+    // Grid: full-size thumbnails on a square pitch with a gap for the selection frame
+    constexpr float kGridPitch = kCellSize + 16.0f;
+    constexpr int kGridLookaheadRows = 3;
+
+    // Filmstrip: a band along the bottom with thumbnails at three quarters size
+    constexpr float kStripScale = 0.75f;
+    constexpr float kStripPitch = kCellSize * kStripScale + 8.0f;
+    constexpr float kStripHeight = kStripPitch + 8.0f;
+    constexpr int kStripLookahead = 8;
+
+    constexpr SDL_Color kThumbnailTint{ 255, 255, 255, 255 };
+    constexpr SDL_Color kSelectionColor{ 80, 160, 255, 255 };
+    constexpr SDL_Color kPlaceholderColor{ 48, 48, 48, 255 };
+    constexpr SDL_Color kFailedColor{ 96, 40, 40, 255 };
+    constexpr SDL_Color kStripBackdrop{ 0, 0, 0, 176 };
+
+    VulkanRenderer::GridQuad SolidQuad(float x0, float y0, float x1, float y1, SDL_Color color) {
+        VulkanRenderer::GridQuad quad{};
+        quad.rect[0] = x0;
+        quad.rect[1] = y0;
+        quad.rect[2] = x1;
+        quad.rect[3] = y1;
+        quad.cell = VulkanRenderer::kGridSolidFill;
+        quad.color = color;
+        return quad;
+    }
+}
+
+ThumbnailGrid::ThumbnailGrid() {
+    cells_.resize(VulkanRenderer::kThumbnailCells);
+    releaseAll();
+}
+
+ThumbnailGrid::~ThumbnailGrid() {
+    Shutdown();
+}
+
+bool ThumbnailGrid::Start() {
+    return loader_.Start(ThumbnailCache::DefaultPath());
+}
+
+void ThumbnailGrid::Shutdown() {
+    loader_.Shutdown();
+}
+
+void ThumbnailGrid::SetMode(Mode mode, int selected) {
+    mode_ = mode;
+    selected_ = std::max(selected, 0);
+    revealSelection_ = true;
+    layout_.valid = false;
+}
+
+void ThumbnailGrid::MoveSelection(int dx, int dy, int fileCount) {
+    if (fileCount <= 0) return;
+    const int columns = layout_.valid && layout_.columns > 0 ? static_cast<int>(layout_.columns) : 1;
+    selected_ = std::clamp(selected_ + dx + dy * columns, 0, fileCount - 1);
+    revealSelection_ = true;
+}
+
+void ThumbnailGrid::Scroll(float pixels) {
+    if (std::isfinite(pixels)) {
+        scroll_ += pixels;     // Clamped by the next layout, which knows the content height
+    }
+}
+
+void ThumbnailGrid::HandleReady(VulkanRenderer* renderer) {
+    std::vector<ThumbnailLoader::Result> results;
+    if (!loader_.TakeResults(results)) return;
+
+    for (ThumbnailLoader::Result& result : results) {
+        if (!result.success) {
+            failed_[result.path] = result.tooLarge;
+            continue;
+        }
+        uint32_t cell = 0;
+        if (!renderer || !acquireCell(result.path, cell)) {
+            continue;           // Every cell is on screen; asked for again when scrolled to
+        }
+        if (!renderer->SetThumbnail(cell, result.rgba.data(), result.width, result.height)) {
+            resident_.erase(result.path);
+            cells_[cell] = Cell();
+            freeCells_.push_back(cell);
+            continue;
+        }
+        cells_[cell].width = result.width;
+        cells_[cell].height = result.height;
+    }
+
+    // The next layout asks again for whatever is still missing
+    requested_.clear();
+}
+
+void ThumbnailGrid::BuildQuads(uint32_t viewWidth, uint32_t viewHeight, const std::vector<std::wstring>& files,
+                               int current, std::vector<VulkanRenderer::GridQuad>& quads) {
+    quads.clear();
+    layout_ = Layout();
+    ++frame_;
+
+    std::vector<std::wstring> wanted;
+    const int count = static_cast<int>(files.size());
+    const float viewW = static_cast<float>(viewWidth);
+    const float viewH = static_cast<float>(viewHeight);
+
+    if (mode_ == Mode::Grid && count > 0 && viewWidth > 0 && viewHeight > 0) {
+        const uint32_t columns = std::max(1u, static_cast<uint32_t>(viewW / kGridPitch));
+        const int rows = (count + static_cast<int>(columns) - 1) / static_cast<int>(columns);
+        selected_ = std::clamp(selected_, 0, count - 1);
+
+        if (revealSelection_) {
+            const float top = static_cast<float>(selected_ / static_cast<int>(columns)) * kGridPitch;
+            if (top < scroll_) scroll_ = top;
+            if (top + kGridPitch > scroll_ + viewH) scroll_ = top + kGridPitch - viewH;
+            revealSelection_ = false;
+        }
+        const float maxScroll = std::max(0.0f, rows * kGridPitch - viewH);
+        scroll_ = std::clamp(scroll_, 0.0f, maxScroll);
+
+        layout_.valid = true;
+        layout_.columns = columns;
+        layout_.pitch = kGridPitch;
+        layout_.originX = std::floor((viewW - columns * kGridPitch) * 0.5f);
+        layout_.originY = -scroll_;
+        const int firstRow = static_cast<int>(scroll_ / kGridPitch);
+        const int lastRow = std::min(rows - 1, static_cast<int>((scroll_ + viewH) / kGridPitch));
+        layout_.first = firstRow * static_cast<int>(columns);
+        layout_.last = std::min(count - 1, (lastRow + 1) * static_cast<int>(columns) - 1);
+
+        for (int i = layout_.first; i <= layout_.last; ++i) {
+            const float x = layout_.originX + (i % columns) * kGridPitch;
+            const float y = layout_.originY + (i / columns) * kGridPitch;
+            if (i == selected_) {
+                quads.push_back(SolidQuad(x + 2.0f, y + 2.0f, x + kGridPitch - 2.0f, y + kGridPitch - 2.0f,
+                                          kSelectionColor));
+            }
+            emitThumbnail(files[i], x, y, kGridPitch, 1.0f, quads, wanted);
+        }
+
+        // Then the rows a scroll down reaches next, and the one above
+        const int aheadEnd = std::min(count - 1, (lastRow + 1 + kGridLookaheadRows) * static_cast<int>(columns) - 1);
+        for (int i = layout_.last + 1; i <= aheadEnd; ++i) {
+            if (!resident_.count(files[i]) && !failed_.count(files[i])) wanted.push_back(files[i]);
+        }
+        for (int i = std::max(0, layout_.first - static_cast<int>(columns)); i < layout_.first; ++i) {
+            if (!resident_.count(files[i]) && !failed_.count(files[i])) wanted.push_back(files[i]);
+        }
+    } else if (mode_ == Mode::Filmstrip && count > 0 && viewH >= kStripHeight * 2.0f) {
+        const int centre = std::clamp(current, 0, count - 1);
+        const int reach = static_cast<int>(std::ceil(viewW * 0.5f / kStripPitch));
+
+        layout_.valid = true;
+        layout_.pitch = kStripPitch;
+        layout_.stripTop = viewH - kStripHeight;
+        layout_.originX = std::floor(viewW * 0.5f - kStripPitch * 0.5f) - centre * kStripPitch;
+        layout_.originY = layout_.stripTop + (kStripHeight - kStripPitch) * 0.5f;
+        layout_.first = std::max(0, centre - reach);
+        layout_.last = std::min(count - 1, centre + reach);
+
+        quads.push_back(SolidQuad(0.0f, layout_.stripTop, viewW, viewH, kStripBackdrop));
+        for (int i = layout_.first; i <= layout_.last; ++i) {
+            const float x = layout_.originX + i * kStripPitch;
+            if (i == centre) {
+                quads.push_back(SolidQuad(x + 1.0f, layout_.originY + 1.0f, x + kStripPitch - 1.0f,
+                                          layout_.originY + kStripPitch - 1.0f, kSelectionColor));
+            }
+            emitThumbnail(files[i], x, layout_.originY, kStripPitch, kStripScale, quads, wanted);
+        }
+
+        // Either way the user may step next
+        for (int step = 1; step <= kStripLookahead; ++step) {
+            for (const int i : { layout_.last + step, layout_.first - step }) {
+                if (i >= 0 && i < count && !resident_.count(files[i]) && !failed_.count(files[i])) {
+                    wanted.push_back(files[i]);
+                }
+            }
+        }
+    }
+
+    if (wanted != requested_) {
+        loader_.Request(wanted);
+        requested_ = std::move(wanted);
+    }
+}
+
+void ThumbnailGrid::emitThumbnail(const std::wstring& path, float x, float y, float box, float scale,
+                                  std::vector<VulkanRenderer::GridQuad>& quads, std::vector<std::wstring>& wanted) {
+    auto it = resident_.find(path);
+    if (it != resident_.end()) {
+        Cell& cell = cells_[it->second];
+        cell.lastUsed = frame_;
+        const float w = cell.width * scale;
+        const float h = cell.height * scale;
+        const float x0 = std::floor(x + (box - w) * 0.5f);
+        const float y0 = std::floor(y + (box - h) * 0.5f);
+
+        VulkanRenderer::GridQuad quad{};
+        quad.rect[0] = x0;
+        quad.rect[1] = y0;
+        quad.rect[2] = x0 + w;
+        quad.rect[3] = y0 + h;
+        quad.cell = it->second;
+        quad.width = cell.width;
+        quad.height = cell.height;
+        quad.color = kThumbnailTint;
+        quads.push_back(quad);
+        return;
+    }
+
+    // A square where the thumbnail will land, so the layout doesn't shift when it does
+    const float side = kCellSize * scale;
+    const float x0 = std::floor(x + (box - side) * 0.5f);
+    const float y0 = std::floor(y + (box - side) * 0.5f);
+    // A file too large to thumbnail keeps the plain placeholder; it is not broken
+    const auto failedIt = failed_.find(path);
+    const bool failed = failedIt != failed_.end();
+    const bool broken = failed && !failedIt->second;
+    quads.push_back(SolidQuad(x0, y0, x0 + side, y0 + side, broken ? kFailedColor : kPlaceholderColor));
+    if (!failed) {
+        wanted.push_back(path);
+    }
+}
+
+int ThumbnailGrid::HitTest(float x, float y) const {
+    if (!layout_.valid || layout_.pitch <= 0.0f) return -1;
+
+    int index = -1;
+    if (layout_.columns > 0) {
+        const float col = std::floor((x - layout_.originX) / layout_.pitch);
+        const float row = std::floor((y - layout_.originY) / layout_.pitch);
+        if (col < 0.0f || col >= static_cast<float>(layout_.columns) || row < 0.0f) return -1;
+        index = static_cast<int>(row) * static_cast<int>(layout_.columns) + static_cast<int>(col);
+    } else {
+        if (y < layout_.stripTop) return -1;
+        const float slot = std::floor((x - layout_.originX) / layout_.pitch);
+        if (slot < 0.0f) return -1;
+        index = static_cast<int>(slot);
+    }
+    return (index >= layout_.first && index <= layout_.last) ? index : -1;
+}
+
+void ThumbnailGrid::Invalidate(const std::wstring& path) {
+    failed_.erase(path);
+    auto it = resident_.find(path);
+    if (it != resident_.end()) {
+        // The atlas keeps the stale texels until the cell is refilled; nothing draws them
+        cells_[it->second] = Cell();
+        freeCells_.push_back(it->second);
+        resident_.erase(it);
+    }
+    requested_.clear();
+}
+
+void ThumbnailGrid::ResetAtlas() {
+    releaseAll();
+    requested_.clear();
+    Logger::Info("ThumbnailGrid: atlas reset; thumbnails reload from the cache");
+}
+
+bool ThumbnailGrid::acquireCell(const std::wstring& path, uint32_t& cell) {
+    auto it = resident_.find(path);
+    if (it != resident_.end()) {
+        cell = it->second;
+        return true;
+    }
+
+    if (!freeCells_.empty()) {
+        cell = freeCells_.back();
+        freeCells_.pop_back();
+    } else {
+        // Least recently drawn, never one the latest layout showed
+        uint64_t oldest = frame_;
+        bool found = false;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(cells_.size()); ++i) {
+            if (cells_[i].lastUsed < oldest) {
+                oldest = cells_[i].lastUsed;
+                cell = i;
+                found = true;
+            }
+        }
+        if (!found) return false;
+        resident_.erase(cells_[cell].path);
+    }
+
+    cells_[cell] = Cell();
+    cells_[cell].path = path;
+    // Counts as drawn until the next layout so a batch never evicts its own arrivals
+    cells_[cell].lastUsed = frame_;
+    resident_[path] = cell;
+    return true;
+}
+
+void ThumbnailGrid::releaseAll() {
+    std::fill(cells_.begin(), cells_.end(), Cell());
+    resident_.clear();
+    freeCells_.clear();
+    // Handed out from the back: cell 0 first
+    for (uint32_t i = static_cast<uint32_t>(cells_.size()); i > 0; --i) {
+        freeCells_.push_back(i - 1);
+    }
+}
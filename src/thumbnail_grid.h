@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "thumbnail_loader.h"
+#include "vulkan_renderer.h"
+
+/**
+ * ThumbnailGrid - Folder browser drawn over (or instead of) the image
+ * Grid mode fills the window with the folder's thumbnails and a selection;
+ * filmstrip mode runs a strip of them along the bottom, centred on the image
+ * shown. Both are laid out every frame from the current listing into the
+ * renderer's one-draw-call grid, so scrolling never waits on a decode: a
+ * thumbnail not resident yet is a placeholder until the loader delivers it.
+ *
+ * Thumbnails live in the renderer's atlas cells. Cells drawn in the latest
+ * frame are never evicted; the rest are reused least recently drawn first.
+ * The loader is asked for what is on screen first, then the rows ahead.
+ */
+class ThumbnailGrid {
+public:
+    enum class Mode { Off, Grid, Filmstrip };
+
+    ThumbnailGrid();
+    ~ThumbnailGrid();
+
+    ThumbnailGrid(const ThumbnailGrid&) = delete;
+    ThumbnailGrid& operator=(const ThumbnailGrid&) = delete;
+
+    // Start the loader on the persistent cache. Call after SDL_Init().
+    bool Start();
+    void Shutdown();
+    bool IsRunning() const { return loader_.IsRunning(); }
+
+    // SDL event type pushed when thumbnails are ready for HandleReady()
+    Uint32 GetReadyEventType() const { return loader_.GetReadyEventType(); }
+
+    Mode GetMode() const { return mode_; }
+    // Switch modes; 'selected' is the listing index the grid opens on
+    void SetMode(Mode mode, int selected);
+
+    int GetSelected() const { return selected_; }
+    void Select(int index) { selected_ = std::max(index, 0); revealSelection_ = true; }
+    // Arrow keys in the grid: move by columns and rows, clamped to the listing
+    void MoveSelection(int dx, int dy, int fileCount);
+    // Grid mode: scroll by 'pixels' (positive moves down the listing)
+    void Scroll(float pixels);
+
+    // Main thread: hand finished thumbnails to atlas cells and the renderer
+    void HandleReady(VulkanRenderer* renderer);
+
+    // Lay out the current mode for a view of the given size and queue what it is missing.
+    // 'current' is the image shown, which the filmstrip centres on.
+    void BuildQuads(uint32_t viewWidth, uint32_t viewHeight, const std::vector<std::wstring>& files,
+                    int current, std::vector<VulkanRenderer::GridQuad>& quads);
+
+    // Listing index under a window point in the last layout, or -1
+    int HitTest(float x, float y) const;
+
+    // The file changed or went away: drop its thumbnail so it is made again
+    void Invalidate(const std::wstring& path);
+    // The renderer was rebuilt and its atlas with it
+    void ResetAtlas();
+
+private:
+    struct Cell {
+        std::wstring path;          // Empty while free
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t lastUsed = 0;      // Layout that last drew it
+    };
+
+    // Where the last layout put listing index 'first' onwards
+    struct Layout {
+        bool valid = false;
+        float originX = 0.0f;
+        float originY = 0.0f;
+        float pitch = 0.0f;
+        uint32_t columns = 0;
+        int first = 0;
+        int last = -1;              // Inclusive
+        float stripTop = 0.0f;      // Filmstrip: hits above it miss
+    };
+
+    bool acquireCell(const std::wstring& path, uint32_t& cell);
+    void releaseAll();
+    void emitThumbnail(const std::wstring& path, float x, float y, float box, float scale,
+                       std::vector<VulkanRenderer::GridQuad>& quads, std::vector<std::wstring>& wanted);
+
+    ThumbnailLoader loader_;
+    Mode mode_ = Mode::Off;
+    int selected_ = 0;
+    float scroll_ = 0.0f;
+    bool revealSelection_ = false;  // Scroll the selection into view on the next layout
+
+    std::vector<Cell> cells_;
+    std::vector<uint32_t> freeCells_;
+    std::unordered_map<std::wstring, uint32_t> resident_;
+    std::unordered_map<std::wstring, bool> failed_; // No thumbnail, until invalidated; true when only too large
+    uint64_t frame_ = 0;
+
+    std::vector<std::wstring> requested_;           // Last list handed to the loader
+    Layout layout_;
+};
@@ -0,0 +1,196 @@
+#include "thumbnail_loader.h"
+#include "image_saver.h"
+#include "viewer.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <utility>
+
+ThumbnailLoader::ThumbnailLoader() = default;
+
+ThumbnailLoader::~ThumbnailLoader() {
+    Shutdown();
+}
+
+bool ThumbnailLoader::Start(const std::wstring& cachePath) {
+    if (running_) return true;
+
+    readyEvent_ = SDL_RegisterEvents(1);
+    if (readyEvent_ == 0) {
+        Logger::Error("ThumbnailLoader: SDL_RegisterEvents failed: %s", SDL_GetError());
+        return false;
+    }
+
+    // Without the cache every thumbnail is generated again; the grid still works
+    if (!cache_.Open(cachePath)) {
+        Logger::WarnW(L"ThumbnailLoader: cache %ls unavailable; thumbnails will not persist", cachePath.c_str());
+    }
+
+    try {
+        stopping_ = false;
+        for (unsigned i = 0; i < kWorkerCount; ++i) {
+            workers_.emplace_back(&ThumbnailLoader::workerMain, this, i);
+        }
+    } catch (const std::exception& e) {
+        Logger::Error("ThumbnailLoader: failed to start worker threads: %s", e.what());
+        running_ = true;
+        Shutdown();
+        return false;
+    }
+
+    running_ = true;
+    Logger::Info("ThumbnailLoader: %u workers started", kWorkerCount);
+    return true;
+}
+
+void ThumbnailLoader::Shutdown() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+        // Abort decodes in flight so join() doesn't wait for full reads
+        for (Slot& slot : slots_) {
+            slot.cancelled.store(true, std::memory_order_release);
+        }
+    }
+    cv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    cache_.Close();
+
+    running_ = false;
+    Logger::Info("ThumbnailLoader: workers stopped");
+}
+
+void ThumbnailLoader::Request(const std::vector<std::wstring>& paths) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+
+        bool keep[kWorkerCount] = {};
+        for (const auto& path : paths) {
+            bool inFlight = false;
+            for (unsigned i = 0; i < kWorkerCount; ++i) {
+                if (!slots_[i].path.empty() && _wcsicmp(slots_[i].path.c_str(), path.c_str()) == 0) {
+                    keep[i] = true;
+                    inFlight = true;
+                }
+            }
+            if (!inFlight) {
+                queue_.push_back(path);
+            }
+        }
+
+        // Scrolled away from what is decoding: free the worker for what is on screen now
+        for (unsigned i = 0; i < kWorkerCount; ++i) {
+            if (!slots_[i].path.empty() && !keep[i]) {
+                slots_[i].cancelled.store(true, std::memory_order_release);
+            }
+        }
+    }
+    cv_.notify_all();
+}
+
+bool ThumbnailLoader::TakeResults(std::vector<Result>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    eventPosted_ = false;
+    if (completed_.empty()) return false;
+
+    out = std::move(completed_);
+    completed_.clear();
+    return true;
+}
+
+void ThumbnailLoader::workerMain(unsigned index) {
+    Trace::NameThread(index == 0 ? "thumbnail 0" : "thumbnail 1");
+    Slot& slot = slots_[index];
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) return;
+
+        slot.path = std::move(queue_.front());
+        queue_.pop_front();
+        slot.cancelled.store(false, std::memory_order_release);
+        Result result;
+        result.path = slot.path;
+        lock.unlock();
+
+        result.success = generate(result.path, slot.cancelled, result);
+
+        lock.lock();
+        slot.path.clear();
+        if (stopping_) return;
+        // A cancelled decode says nothing about the file; it is requested again when wanted
+        if (slot.cancelled.load(std::memory_order_acquire)) continue;
+
+        completed_.push_back(std::move(result));
+        // One queued event covers everything until the main thread takes it
+        if (eventPosted_) continue;
+        eventPosted_ = true;
+        lock.unlock();
+
+        SDL_Event event{};
+        event.type = readyEvent_;
+        const bool posted = SDL_PushEvent(&event);
+        lock.lock();
+        if (!posted) {
+            Logger::Warn("ThumbnailLoader: SDL_PushEvent failed: %s", SDL_GetError());
+            eventPosted_ = false;
+        }
+    }
+}
+
+bool ThumbnailLoader::generate(const std::wstring& path, const std::atomic<bool>& cancelled, Result& out) {
+    ThumbnailCache::Key key;
+    const bool keyed = ThumbnailCache::MakeKey(path, key);
+    if (keyed && cache_.Lookup(key, out.rgba, out.width, out.height)) {
+        return true;
+    }
+
+    // Plain display-ready pixels: no paged or mapped sources, color converted on the CPU
+    DecodeOptions options;
+    auto isCancelled = [&cancelled] { return cancelled.load(std::memory_order_acquire); };
+    ImageData image;
+    std::string error;
+    if (!DecodeImagePreview(path, image, isCancelled, options)) {
+        options.maxPixels = kMaxDecodePixels;
+        if (!DecodeImageFile(path, image, error, isCancelled, options)) {
+            out.tooLarge = static_cast<uint64_t>(image.width) * image.height > kMaxDecodePixels;
+            return false;
+        }
+    }
+    if (!image.pixels || isCancelled() ||
+        !ResizeImageToFit(image, ThumbnailCache::kThumbnailSize, error)) {
+        return false;
+    }
+
+    // Oriented upright and HDR tonemapped in one pass, as copies to the clipboard are
+    ImageSaver::Job job;
+    job.pixels = image.pixels->data();
+    job.width = image.width;
+    job.height = image.height;
+    job.isHdr = image.isHdr;
+    job.rotation = image.orientationRotation();
+    job.mirrored = image.orientationMirrored();
+    const bool sideways = (job.rotation % 180) != 0;
+    out.width = sideways ? image.height : image.width;
+    out.height = sideways ? image.width : image.height;
+    out.rgba.resize(static_cast<size_t>(out.width) * out.height * 4);
+    if (!ImageSaver::ConvertRows(job, 0, out.height, out.rgba.data(), static_cast<size_t>(out.width) * 4, false)) {
+        return false;
+    }
+
+    if (keyed) {
+        cache_.Store(key, out.rgba.data(), out.width, out.height);
+    }
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "thumbnail_cache.h"
+
+/**
+ * ThumbnailLoader - Background thumbnail generation for the grid and filmstrip
+ * A couple of workers take paths off a queue the main thread replaces as the
+ * view scrolls, most wanted first. Each thumbnail comes from the persistent
+ * ThumbnailCache when the file is unchanged; otherwise it is made from the
+ * file's stored MIP level or embedded preview, or a full decode when it has
+ * neither, then scaled, oriented, tonemapped to RGBA8 and stored back. Files
+ * past kMaxDecodePixels with neither are not decoded at all: a thumbnail is
+ * not worth a gigapixel decode's time and memory.
+ *
+ * Finished thumbnails are batched and announced through one registered SDL
+ * event until taken. A path dropped from the queue while it is decoding is
+ * cancelled at the decoder's next cancellation point.
+ */
+class ThumbnailLoader {
+public:
+    struct Result {
+        std::wstring path;
+        std::vector<uint8_t> rgba;      // Upright RGBA8, width x height
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool success = false;           // False: the file could not be decoded
+        bool tooLarge = false;          // Not decoded: over kMaxDecodePixels without a preview
+    };
+
+    ThumbnailLoader();
+    ~ThumbnailLoader();
+
+    ThumbnailLoader(const ThumbnailLoader&) = delete;
+    ThumbnailLoader& operator=(const ThumbnailLoader&) = delete;
+
+    // Open the cache at 'cachePath' (runs without one if it cannot be opened), start the
+    // workers and register the ready event. Call after SDL_Init().
+    bool Start(const std::wstring& cachePath);
+    void Shutdown();
+    bool IsRunning() const { return running_; }
+
+    // Replace the queue (most wanted first). Paths already decoding keep going.
+    void Request(const std::vector<std::wstring>& paths);
+
+    // Main thread: take the thumbnails finished since the last call. Returns false if none.
+    bool TakeResults(std::vector<Result>& out);
+
+    // SDL event type pushed when results are waiting (0 if registration failed)
+    Uint32 GetReadyEventType() const { return readyEvent_; }
+
+private:
+    static constexpr unsigned kWorkerCount = 2;
+    static constexpr uint64_t kMaxDecodePixels = UINT64_C(67108864);   // 8K x 8K
+
+    struct Slot {
+        std::wstring path;                  // Empty while the worker is idle
+        std::atomic<bool> cancelled{false};
+    };
+
+    void workerMain(unsigned index);
+    bool generate(const std::wstring& path, const std::atomic<bool>& cancelled, Result& out);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Protected by mutex_
+    bool stopping_ = false;
+    std::deque<std::wstring> queue_;
+    Slot slots_[kWorkerCount];
+    std::vector<Result> completed_;
+    bool eventPosted_ = false;              // A ready event is queued and not yet taken
+
+    ThumbnailCache cache_;
+    Uint32 readyEvent_ = 0;
+    bool running_ = false;
+};
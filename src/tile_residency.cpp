@@ -0,0 +1,257 @@
+#include "tile_residency.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+    // Pool granularity: big enough to keep allocation counts low, small enough to track the budget
+    constexpr VkDeviceSize kPageBytes = 16ull * 1024 * 1024;
+}
+
+TileResidency::~TileResidency() {
+    Shutdown();
+}
+
+bool TileResidency::Initialize(VkDevice device, uint32_t memoryTypeIndex, VkDeviceSize tileBytes,
+                               uint32_t tileWidth, uint32_t tileHeight, uint32_t width, uint32_t height,
+                               uint32_t levelCount, VkDeviceSize budgetBytes) {
+    // NASA Standard: Validate all input parameters
+    if (device == VK_NULL_HANDLE || tileBytes == 0 || tileWidth == 0 || tileHeight == 0 ||
+        width == 0 || height == 0 || levelCount == 0) {
+        return false;
+    }
+
+    Shutdown();
+    device_ = device;
+    memoryTypeIndex_ = memoryTypeIndex;
+    tileBytes_ = tileBytes;
+    tileWidth_ = tileWidth;
+    tileHeight_ = tileHeight;
+    slotsPerPage_ = static_cast<uint32_t>(std::max<VkDeviceSize>(1, kPageBytes / tileBytes));
+    maxSlots_ = 0;
+    SetBudget(budgetBytes);
+
+    uint32_t firstTile = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        Level info;
+        info.width = std::max(1u, width >> level);
+        info.height = std::max(1u, height >> level);
+        info.tilesX = (info.width + tileWidth - 1) / tileWidth;
+        info.tilesY = (info.height + tileHeight - 1) / tileHeight;
+        info.firstTile = firstTile;
+        firstTile += info.tilesX * info.tilesY;
+        levels_.push_back(info);
+    }
+    tiles_.resize(firstTile);
+
+    Logger::Info("TileResidency: %u tiles over %u levels, budget %llu MB",
+                 firstTile, levelCount, static_cast<unsigned long long>(GetBudgetBytes() >> 20));
+    return true;
+}
+
+void TileResidency::Shutdown() {
+    if (device_ == VK_NULL_HANDLE) return;
+    for (VkDeviceMemory page : pages_) {
+        vkFreeMemory(device_, page, nullptr);
+    }
+    pages_.clear();
+    slotOwner_.clear();
+    freeSlots_.clear();
+    levels_.clear();
+    tiles_.clear();
+    queued_.clear();
+    device_ = VK_NULL_HANDLE;
+}
+
+void TileResidency::SetBudget(VkDeviceSize budgetBytes) {
+    if (slotsPerPage_ == 0) return;
+    // Whole pages only, so a slot's page and offset follow from its index
+    const VkDeviceSize pageBytes = static_cast<VkDeviceSize>(slotsPerPage_) * tileBytes_;
+    const uint32_t pages = static_cast<uint32_t>(std::max<VkDeviceSize>(1, (budgetBytes + pageBytes - 1) / pageBytes));
+    maxSlots_ = std::max(maxSlots_, pages * slotsPerPage_);
+}
+
+void TileResidency::BeginFrame() {
+    queued_.clear();
+}
+
+void TileResidency::Request(uint32_t level, int64_t x0, int64_t y0, int64_t x1, int64_t y1, uint64_t frameSerial) {
+    if (level >= levels_.size()) return;
+    const Level& info = levels_[level];
+
+    x0 = std::clamp<int64_t>(x0, 0, info.width);
+    x1 = std::clamp<int64_t>(x1, 0, info.width);
+    y0 = std::clamp<int64_t>(y0, 0, info.height);
+    y1 = std::clamp<int64_t>(y1, 0, info.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const uint32_t tx0 = static_cast<uint32_t>(x0) / tileWidth_;
+    const uint32_t ty0 = static_cast<uint32_t>(y0) / tileHeight_;
+    const uint32_t tx1 = static_cast<uint32_t>(x1 - 1) / tileWidth_;
+    const uint32_t ty1 = static_cast<uint32_t>(y1 - 1) / tileHeight_;
+    for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+        for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+            const uint32_t index = info.firstTile + ty * info.tilesX + tx;
+            Tile& tile = tiles_[index];
+            tile.lastVisible = std::max(tile.lastVisible, frameSerial);
+            if ((tile.slot < 0 || tile.stale) && tile.queuedSerial != frameSerial) {
+                tile.queuedSerial = frameSerial;
+                queued_.push_back(index);
+            }
+        }
+    }
+}
+
+void TileResidency::Schedule(uint32_t maxTiles, uint64_t completedFrameSerial,
+                             std::vector<Bind>& unbinds, std::vector<Bind>& binds) {
+    std::vector<uint32_t> victims;      // Resident tiles no in-flight frame has seen; oldest at the back
+    bool victimsBuilt = false;
+
+    size_t next = 0;
+    for (; next < queued_.size() && maxTiles > 0; ++next) {
+        const uint32_t index = queued_[next];
+        Tile& tile = tiles_[index];
+
+        if (tile.slot >= 0) {
+            // Stale contents: same memory, new upload
+            tile.stale = false;
+            Bind bind = makeBind(index);
+            bind.reupload = true;
+            binds.push_back(bind);
+            --maxTiles;
+            continue;
+        }
+
+        if (freeSlots_.empty() && !growPool()) {
+            if (!victimsBuilt) {
+                victimsBuilt = true;
+                for (uint32_t slot = 0; slot < slotOwner_.size(); ++slot) {
+                    const int32_t owner = slotOwner_[slot];
+                    if (owner >= 0 && tiles_[owner].lastVisible <= completedFrameSerial) {
+                        victims.push_back(static_cast<uint32_t>(owner));
+                    }
+                }
+                std::sort(victims.begin(), victims.end(), [this](uint32_t a, uint32_t b) {
+                    return tiles_[a].lastVisible > tiles_[b].lastVisible;
+                });
+            }
+            if (victims.empty()) {
+                break;          // Everything resident is still in use; retry next frame
+            }
+            const uint32_t victim = victims.back();
+            victims.pop_back();
+            Bind unbind = makeBind(victim);
+            unbind.memory = VK_NULL_HANDLE;
+            unbind.memoryOffset = 0;
+            unbinds.push_back(unbind);
+
+            Tile& evicted = tiles_[victim];
+            slotOwner_[evicted.slot] = -1;
+            freeSlots_.push_back(static_cast<uint32_t>(evicted.slot));
+            evicted.slot = -1;
+            evicted.stale = false;
+        }
+
+        const uint32_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        slotOwner_[slot] = static_cast<int32_t>(index);
+        tile.slot = static_cast<int32_t>(slot);
+        tile.stale = false;
+        binds.push_back(makeBind(index));
+        --maxTiles;
+    }
+    queued_.erase(queued_.begin(), queued_.begin() + static_cast<std::ptrdiff_t>(next));
+}
+
+void TileResidency::Cancel(const Bind& bind) {
+    if (bind.tile >= tiles_.size()) return;
+    Tile& tile = tiles_[bind.tile];
+    if (bind.reupload) {
+        tile.stale = tile.slot >= 0;
+        tile.queuedSerial = 0;
+        return;
+    }
+    if (tile.slot >= 0) {
+        slotOwner_[tile.slot] = -1;
+        freeSlots_.push_back(static_cast<uint32_t>(tile.slot));
+        tile.slot = -1;
+    }
+    tile.stale = false;
+    tile.queuedSerial = 0;
+}
+
+void TileResidency::Invalidate(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) return;
+    for (uint32_t level = 0; level < levels_.size(); ++level) {
+        const Level& info = levels_[level];
+        // Level texels covering the level-0 rectangle
+        const uint32_t lx0 = std::min(x >> level, info.width - 1);
+        const uint32_t ly0 = std::min(y >> level, info.height - 1);
+        const uint32_t lx1 = std::min((x + width - 1) >> level, info.width - 1);
+        const uint32_t ly1 = std::min((y + height - 1) >> level, info.height - 1);
+        for (uint32_t ty = ly0 / tileHeight_; ty <= ly1 / tileHeight_; ++ty) {
+            for (uint32_t tx = lx0 / tileWidth_; tx <= lx1 / tileWidth_; ++tx) {
+                Tile& tile = tiles_[info.firstTile + ty * info.tilesX + tx];
+                if (tile.slot >= 0) {
+                    tile.stale = true;
+                    tile.queuedSerial = 0;
+                }
+            }
+        }
+    }
+}
+
+bool TileResidency::growPool() {
+    if (slotOwner_.size() + slotsPerPage_ > maxSlots_) {
+        return false;
+    }
+
+    VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    ai.allocationSize = static_cast<VkDeviceSize>(slotsPerPage_) * tileBytes_;
+    ai.memoryTypeIndex = memoryTypeIndex_;
+    VkDeviceMemory page = VK_NULL_HANDLE;
+    if (vkAllocateMemory(device_, &ai, nullptr, &page) != VK_SUCCESS) {
+        // Out of device memory: what is allocated now is the budget
+        Logger::Warn("TileResidency: page allocation failed at %llu MB; capping the budget",
+                     static_cast<unsigned long long>(GetAllocatedBytes() >> 20));
+        maxSlots_ = static_cast<uint32_t>(slotOwner_.size());
+        return false;
+    }
+
+    pages_.push_back(page);
+    const uint32_t first = static_cast<uint32_t>(slotOwner_.size());
+    slotOwner_.resize(first + slotsPerPage_, -1);
+    // Hand out low slots first so pages fill in order
+    for (uint32_t slot = first + slotsPerPage_; slot > first; --slot) {
+        freeSlots_.push_back(slot - 1);
+    }
+    return true;
+}
+
+TileResidency::Bind TileResidency::makeBind(uint32_t tileIndex) const {
+    // Levels are few, so a linear scan finds the owner cheaply
+    uint32_t level = 0;
+    while (level + 1 < levels_.size() && levels_[level + 1].firstTile <= tileIndex) {
+        ++level;
+    }
+    const Level& info = levels_[level];
+    const uint32_t local = tileIndex - info.firstTile;
+    const uint32_t tx = local % info.tilesX;
+    const uint32_t ty = local / info.tilesX;
+
+    Bind bind;
+    bind.level = level;
+    bind.x = tx * tileWidth_;
+    bind.y = ty * tileHeight_;
+    bind.width = std::min(tileWidth_, info.width - bind.x);
+    bind.height = std::min(tileHeight_, info.height - bind.y);
+    bind.tile = tileIndex;
+
+    const int32_t slot = tiles_[tileIndex].slot;
+    if (slot >= 0) {
+        bind.memory = pages_[static_cast<uint32_t>(slot) / slotsPerPage_];
+        bind.memoryOffset = static_cast<VkDeviceSize>(static_cast<uint32_t>(slot) % slotsPerPage_) * tileBytes_;
+    }
+    return bind;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * TileSource - Texels of a sparse texture, produced on demand
+ * For images that are never fully in memory (e.g. tiled files decoded as the
+ * view reaches them). ReadTile must not block: when the region is not ready
+ * it queues it and returns false, and the caller asks again on a later frame.
+ */
+class TileSource {
+public:
+    virtual ~TileSource() = default;
+
+    // Write 'width' x 'height' texels of mip 'level' at (x, y), RGBA8 or RGBA16F
+    // as the texture, tightly packed into 'dst'. Returns false if not ready yet.
+    virtual bool ReadTile(uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t* dst) = 0;
+};
+
+/**
+ * TileResidency - Working set of a sparse-resident texture
+ * Tracks which tiles of each mip level are backed by memory, hands out
+ * tile-sized slots from a few pooled VkDeviceMemory pages, and evicts the
+ * least recently visible tiles once the byte budget is reached. Only the
+ * bookkeeping lives here; VulkanRenderer turns the scheduled binds into a
+ * single vkQueueBindSparse per frame and uploads the tile contents.
+ *
+ * A tile seen by a frame that may still be in flight is never evicted, so
+ * rebinding its memory cannot race a draw that samples it.
+ */
+class TileResidency {
+public:
+    struct Bind {
+        uint32_t level = 0;
+        uint32_t x = 0, y = 0;                     // Texel offset within the level
+        uint32_t width = 0, height = 0;
+        VkDeviceMemory memory = VK_NULL_HANDLE;    // VK_NULL_HANDLE unbinds
+        VkDeviceSize memoryOffset = 0;
+        uint32_t tile = 0;                         // For Cancel()
+        bool reupload = false;                     // Already bound; only the contents change
+    };
+
+    TileResidency() = default;
+    ~TileResidency();
+
+    TileResidency(const TileResidency&) = delete;
+    TileResidency& operator=(const TileResidency&) = delete;
+
+    // 'levelCount' counts the levels split into tiles, i.e. those before the mip tail.
+    // 'tileBytes' is the sparse block size, which is also the slot size and alignment.
+    bool Initialize(VkDevice device, uint32_t memoryTypeIndex, VkDeviceSize tileBytes,
+                    uint32_t tileWidth, uint32_t tileHeight, uint32_t width, uint32_t height,
+                    uint32_t levelCount, VkDeviceSize budgetBytes);
+    void Shutdown();
+    bool IsInitialized() const { return device_ != VK_NULL_HANDLE; }
+
+    // Raise the budget (e.g. after the window grew). Never shrinks below what is allocated.
+    void SetBudget(VkDeviceSize budgetBytes);
+
+    // Start a new frame's requests; tiles no longer requested stop being queued
+    void BeginFrame();
+
+    // Mark the tiles of 'level' overlapping [x0,x1) x [y0,y1) (texels of that level) as
+    // visible to 'frameSerial'. Missing or stale ones are queued in request order.
+    void Request(uint32_t level, int64_t x0, int64_t y0, int64_t x1, int64_t y1, uint64_t frameSerial);
+
+    // Take up to 'maxTiles' queued tiles. Slots come from the free list, then new pages
+    // within the budget, then tiles last seen at or before 'completedFrameSerial',
+    // oldest first; evicted tiles are appended to 'unbinds'. Tiles that cannot be
+    // placed stay queued for a later frame.
+    void Schedule(uint32_t maxTiles, uint64_t completedFrameSerial,
+                  std::vector<Bind>& unbinds, std::vector<Bind>& binds);
+
+    // Drop a scheduled tile whose contents could not be uploaded. A re-upload keeps its
+    // slot (it is still bound) and stays stale.
+    void Cancel(const Bind& bind);
+
+    // Level-0 texels whose source changed: resident tiles covering them are re-uploaded
+    void Invalidate(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    bool HasQueued() const { return !queued_.empty(); }
+    VkDeviceSize GetAllocatedBytes() const { return static_cast<VkDeviceSize>(slotOwner_.size()) * tileBytes_; }
+    VkDeviceSize GetBudgetBytes() const { return static_cast<VkDeviceSize>(maxSlots_) * tileBytes_; }
+
+private:
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t tilesX = 0;
+        uint32_t tilesY = 0;
+        uint32_t firstTile = 0;
+    };
+    struct Tile {
+        int32_t slot = -1;              // -1 while not resident
+        uint64_t lastVisible = 0;       // Newest frame that requested it
+        uint64_t queuedSerial = 0;      // Frame it was last queued for
+        bool stale = false;             // Resident, but the source has changed
+    };
+
+    bool growPool();
+    Bind makeBind(uint32_t tileIndex) const;
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    uint32_t memoryTypeIndex_ = 0;
+    VkDeviceSize tileBytes_ = 0;
+    uint32_t tileWidth_ = 0;
+    uint32_t tileHeight_ = 0;
+    uint32_t slotsPerPage_ = 0;
+    uint32_t maxSlots_ = 0;
+
+    std::vector<Level> levels_;
+    std::vector<Tile> tiles_;
+    std::vector<uint32_t> queued_;          // Tile indices, in request order
+    std::vector<VkDeviceMemory> pages_;
+    std::vector<int32_t> slotOwner_;        // Tile per slot, -1 when free
+    std::vector<uint32_t> freeSlots_;
+};
@@ -0,0 +1,314 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Trace {
+
+namespace detail {
+    std::atomic<bool> g_enabled{false};
+}
+
+namespace {
+    // Per-thread history: ~4K events is a few seconds of frames plus the loads around them
+    constexpr uint64_t kRingEvents = 4096;
+    // Most recent events per stage the HUD percentiles are taken over
+    constexpr size_t kStatsWindow = 256;
+    // Events kept from threads that have exited, newest kept
+    constexpr size_t kRetiredEvents = 4 * kRingEvents;
+
+    // Fields are atomics so readers never race the owning thread; relaxed stores cost
+    // the same as plain ones
+    struct Event {
+        std::atomic<uint64_t> beginNs{0};
+        std::atomic<uint64_t> endNs{0};
+        std::atomic<uint32_t> stage{0};
+    };
+
+    struct Ring {
+        std::array<Event, kRingEvents> events;
+        std::atomic<uint64_t> head{0};              // Events ever written; only the owner stores
+        std::atomic<const char*> name{nullptr};
+        uint32_t threadId = 0;                      // Guarded by the registry mutex
+    };
+
+    struct Snapshot {
+        uint64_t beginNs;
+        uint64_t endNs;
+        Stage stage;
+        uint32_t threadId;
+        const char* threadName;
+    };
+
+    // Every ring ever made; a ring whose thread exited has head 0 and waits in 'free' for
+    // the next thread. Its events stay in 'retired' so an export still shows finished workers.
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Ring>> rings;
+        std::vector<Ring*> free;
+        std::deque<Snapshot> retired;
+        uint32_t nextThreadId = 1;
+    };
+    Registry& R() { static Registry r; return r; }
+
+    // Copy out every event of 'ring' that was not overwritten while it was read.
+    // Call with the registry mutex held.
+    void CollectRing(const Ring& ring, std::vector<Snapshot>& out) {
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        const uint64_t first = head > kRingEvents ? head - kRingEvents : 0;
+        const char* name = ring.name.load(std::memory_order_relaxed);
+        const size_t start = out.size();
+        for (uint64_t i = first; i < head; ++i) {
+            const Event& e = ring.events[i % kRingEvents];
+            Snapshot s;
+            s.beginNs = e.beginNs.load(std::memory_order_relaxed);
+            s.endNs = e.endNs.load(std::memory_order_relaxed);
+            s.stage = static_cast<Stage>(e.stage.load(std::memory_order_relaxed));
+            s.threadId = ring.threadId;
+            s.threadName = name;
+            out.push_back(s);
+        }
+        // The owner may be rewriting the slot after 'head' (index head - kRingEvents)
+        // while it is read, and anything it has published since is overwritten
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = ring.head.load(std::memory_order_relaxed);
+        const uint64_t valid = after + 1 > kRingEvents ? after + 1 - kRingEvents : 0;
+        if (valid > first) {
+            const size_t drop = static_cast<size_t>(std::min(valid, head) - first);
+            out.erase(out.begin() + static_cast<ptrdiff_t>(start),
+                      out.begin() + static_cast<ptrdiff_t>(start + drop));
+        }
+    }
+
+    // Hands the ring back when its thread exits; thread_local objects are destroyed
+    // before statics, so the registry is still there
+    struct RingOwner {
+        Ring* ring = nullptr;
+        ~RingOwner() {
+            if (ring == nullptr) return;
+            Registry& r = R();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            try {
+                std::vector<Snapshot> events;
+                CollectRing(*ring, events);
+                r.retired.insert(r.retired.end(), events.begin(), events.end());
+                while (r.retired.size() > kRetiredEvents) r.retired.pop_front();
+            } catch (...) {
+                // The events are lost; the ring is still reused
+            }
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->name.store(nullptr, std::memory_order_relaxed);
+            r.free.push_back(ring);   // Capacity reserved when the ring was made
+            ring = nullptr;
+        }
+    };
+
+    // A thread gets its ring on its first event, so naming threads costs nothing untraced
+    thread_local RingOwner t_ring;
+    thread_local const char* t_name = nullptr;
+
+    Ring* ThreadRing() noexcept {
+        Ring*& ring = t_ring.ring;
+        if (ring == nullptr) {
+            try {
+                Registry& r = R();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                Ring* taken = nullptr;
+                if (!r.free.empty()) {
+                    taken = r.free.back();
+                    r.free.pop_back();
+                } else {
+                    auto created = std::make_unique<Ring>();
+                    r.free.reserve(r.rings.size() + 1);
+                    r.rings.push_back(std::move(created));
+                    taken = r.rings.back().get();
+                }
+                taken->threadId = r.nextThreadId++;
+                taken->name.store(t_name, std::memory_order_relaxed);
+                ring = taken;
+            } catch (...) {
+                return nullptr;
+            }
+        }
+        return ring;
+    }
+
+    // Events of exited threads, then every live ring's
+    void CollectEvents(std::vector<Snapshot>& out) {
+        std::lock_guard<std::mutex> lock(R().mutex);
+        out.insert(out.end(), R().retired.begin(), R().retired.end());
+        for (const auto& ring : R().rings) {
+            CollectRing(*ring, out);
+        }
+    }
+
+    double Percentile(std::vector<uint64_t>& sorted, double fraction) {
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[index]) / 1.0e6;
+    }
+
+    // Thread names and stage names are ASCII literals; escape anyway rather than emit bad JSON
+    void AppendJsonString(std::string& json, const char* text) {
+        json += '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') json += '\\';
+            json += (*c >= 32) ? *c : '?';
+        }
+        json += '"';
+    }
+}
+
+const char* StageName(Stage stage) noexcept {
+    switch (stage) {
+        case Stage::Open: return "open";
+        case Stage::Decode: return "decode";
+        case Stage::Ocio: return "ocio";
+        case Stage::Convert: return "convert";
+        case Stage::StagingCopy: return "staging copy";
+        case Stage::Upload: return "upload";
+        case Stage::Acquire: return "acquire";
+        case Stage::Submit: return "submit";
+        case Stage::Present: return "present";
+        case Stage::Frame: return "frame";
+        case Stage::Pace: return "pace";
+        case Stage::Latency: return "latency";
+        case Stage::Startup: return "startup";
+        default: return "unknown";
+    }
+}
+
+void SetEnabled(bool enabled) noexcept {
+    detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Record(Stage stage, uint64_t beginNs, uint64_t endNs) noexcept {
+    Ring* ring = ThreadRing();
+    if (ring == nullptr) return;
+
+    const uint64_t index = ring->head.load(std::memory_order_relaxed);
+    Event& e = ring->events[index % kRingEvents];
+    e.beginNs.store(beginNs, std::memory_order_relaxed);
+    e.endNs.store(endNs, std::memory_order_relaxed);
+    e.stage.store(static_cast<uint32_t>(stage), std::memory_order_relaxed);
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+void NameThread(const char* name) noexcept {
+    t_name = name;
+    if (t_ring.ring != nullptr) {
+        t_ring.ring->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+void GetStageStats(StageStats (&out)[kStageCount]) {
+    for (StageStats& stats : out) {
+        stats = StageStats{};
+    }
+
+    std::vector<Snapshot> events;
+    CollectEvents(events);
+    // Newest first, so each stage keeps its most recent window
+    std::sort(events.begin(), events.end(), [](const Snapshot& a, const Snapshot& b) { return a.endNs > b.endNs; });
+
+    std::vector<uint64_t> durations[kStageCount];
+    for (const Snapshot& e : events) {
+        const size_t stage = static_cast<size_t>(e.stage);
+        if (stage < kStageCount && durations[stage].size() < kStatsWindow && e.endNs >= e.beginNs) {
+            durations[stage].push_back(e.endNs - e.beginNs);
+        }
+    }
+
+    for (size_t stage = 0; stage < kStageCount; ++stage) {
+        std::vector<uint64_t>& sorted = durations[stage];
+        if (sorted.empty()) continue;
+        std::sort(sorted.begin(), sorted.end());
+        out[stage].count = static_cast<uint32_t>(sorted.size());
+        out[stage].p50Ms = Percentile(sorted, 0.50);
+        out[stage].p95Ms = Percentile(sorted, 0.95);
+        out[stage].maxMs = static_cast<double>(sorted.back()) / 1.0e6;
+    }
+}
+
+void GetStageTotals(uint64_t sinceNs, StageTotals (&out)[kStageCount]) {
+    for (StageTotals& totals : out) {
+        totals = StageTotals{};
+    }
+
+    std::vector<Snapshot> events;
+    CollectEvents(events);
+    for (const Snapshot& e : events) {
+        const size_t stage = static_cast<size_t>(e.stage);
+        if (stage < kStageCount && e.beginNs >= sinceNs && e.endNs >= e.beginNs) {
+            out[stage].count++;
+            out[stage].busyMs += static_cast<double>(e.endNs - e.beginNs) / 1.0e6;
+        }
+    }
+}
+
+bool ExportChromeTrace(const std::wstring& path, std::string& error) {
+    std::vector<Snapshot> events;
+    CollectEvents(events);
+    std::sort(events.begin(), events.end(), [](const Snapshot& a, const Snapshot& b) { return a.beginNs < b.beginNs; });
+    const uint64_t origin = events.empty() ? 0 : events.front().beginNs;
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char line[256];
+    bool first = true;
+    // One name per thread that has events, exited threads included
+    std::vector<std::pair<uint32_t, const char*>> names;
+    for (const Snapshot& e : events) {
+        if (e.threadName != nullptr) names.emplace_back(e.threadId, e.threadName);
+    }
+    std::sort(names.begin(), names.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    names.erase(std::unique(names.begin(), names.end(),
+                            [](const auto& a, const auto& b) { return a.first == b.first; }), names.end());
+    for (const auto& [threadId, name] : names) {
+        std::snprintf(line, sizeof(line), "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                      first ? "" : ",\n", threadId);
+        json += line;
+        AppendJsonString(json, name);
+        json += "}}";
+        first = false;
+    }
+    for (const Snapshot& e : events) {
+        if (e.endNs < e.beginNs || static_cast<size_t>(e.stage) >= kStageCount) continue;
+        // Chrome traces count in microseconds
+        std::snprintf(line, sizeof(line), "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                      first ? "" : ",\n", e.threadId,
+                      static_cast<double>(e.beginNs - origin) / 1000.0, static_cast<double>(e.endNs - e.beginNs) / 1000.0);
+        json += line;
+        AppendJsonString(json, StageName(e.stage));
+        json += '}';
+        first = false;
+    }
+    json += "\n]}\n";
+
+#ifdef _WIN32
+    FILE* file = _wfopen(path.c_str(), L"wb");
+#else
+    FILE* file = std::fopen(std::string(path.begin(), path.end()).c_str(), "wb");
+#endif
+    if (file == nullptr) {
+        error = "Could not create the trace file.";
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed) {
+        error = "Could not write the trace file.";
+        return false;
+    }
+    return true;
+}
+
+} // namespace Trace
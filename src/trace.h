@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Trace - Fixed-cost timing of the load and present pipeline
+ * Every thread records stage events (begin/end timestamps) into its own
+ * fixed-size ring, so recording takes no lock and allocates nothing after a
+ * thread's first event. Old events are overwritten; only the last few
+ * thousand per thread are kept. When a thread exits its events move to a
+ * bounded shared history and its ring is handed to the next new thread, so
+ * short-lived threads do not grow memory. While tracing is off a Scope
+ * costs one relaxed load.
+ *
+ * The main thread reads the rings for the performance HUD (per-stage
+ * percentiles) and to export a Chrome trace (JSON "traceEvents"), which
+ * chrome://tracing, Perfetto and Tracy's import-chrome tool open.
+ */
+namespace Trace {
+
+enum class Stage : uint8_t {
+    Open,           // Opening the file and reading its header
+    Decode,         // Reading pixels from the decoder
+    Ocio,           // CPU color conversion
+    Convert,        // Packing to the texture format (half, unorm8)
+    StagingCopy,    // Writing texels into upload staging
+    Upload,         // Recording and submitting a texture upload
+    Acquire,        // Waiting for a swapchain image
+    Submit,         // Submitting the frame
+    Present,        // Queueing the present
+    Frame,          // A whole DrawImage
+    Pace,           // Low-latency pacing: waiting for the last frame to be shown
+    Latency,        // From the first input a frame answers to that frame on screen
+    Startup,        // From process creation to the first image (or, with none, frame) on screen
+    Count
+};
+constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+const char* StageName(Stage stage) noexcept;
+
+namespace detail {
+    extern std::atomic<bool> g_enabled;
+}
+
+inline bool IsEnabled() noexcept { return detail::g_enabled.load(std::memory_order_relaxed); }
+void SetEnabled(bool enabled) noexcept;
+
+// Monotonic nanoseconds
+inline uint64_t Now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Append one event to the calling thread's ring
+void Record(Stage stage, uint64_t beginNs, uint64_t endNs) noexcept;
+
+// Label the calling thread in exported traces; 'name' must outlive the process (a literal)
+void NameThread(const char* name) noexcept;
+
+// Records 'stage' from construction to destruction when tracing was on at construction
+class Scope {
+public:
+    explicit Scope(Stage stage) noexcept : stage_(stage), begin_(IsEnabled() ? Now() : 0) {}
+    ~Scope() {
+        if (begin_ != 0) Record(stage_, begin_, Now());
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Stage stage_;
+    uint64_t begin_;
+};
+
+struct StageStats {
+    uint32_t count = 0;     // Events the figures are taken over
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Percentiles over the most recent events of each stage on every thread. Allocates,
+// so call it once per HUD update rather than from the pipeline itself.
+void GetStageStats(StageStats (&out)[kStageCount]);
+
+struct StageTotals {
+    uint32_t count = 0;     // Events summed
+    double busyMs = 0.0;    // Summed over threads, so parallel work can exceed wall time
+};
+
+// Totals of the events that began at or after 'sinceNs' (a Now() value), for measuring
+// one run of the pipeline; events older than a thread's ring are not counted
+void GetStageTotals(uint64_t sinceNs, StageTotals (&out)[kStageCount]);
+
+// Write every event still held to 'path' as a Chrome trace
+bool ExportChromeTrace(const std::wstring& path, std::string& error);
+
+} // namespace Trace
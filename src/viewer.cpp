@@ -1,5 +1,10 @@
 #include "viewer.h"
 #include "vulkan_renderer.h"
+#include "image_loader.h"
+#include "image_saver.h"
+#include "directory_indexer.h"
+#include "thumbnail_grid.h"
+#include "sequence_player.h"
 
 // Default constructor/destructor with SDL3 initialization
 AppContext::AppContext() {
@@ -15,7 +20,7 @@ AppContext::~AppContext() {
     }
 }
 
-// Copy: copy everything except the renderer (leave null in the copy)
+// Copy: copy everything except the renderer and workers (leave null in the copy)
 AppContext::AppContext(const AppContext& other)
     : window(other.window),
       imageData(other.imageData),
@@ -29,6 +34,11 @@ AppContext::AppContext(const AppContext& other)
       savedWindowRect(other.savedWindowRect),
       savedMaximized(other.savedMaximized),
       renderer(nullptr),
+      imageLoader(nullptr),
+      imageSaver(nullptr),
+      directoryIndexer(nullptr),
+      thumbnailGrid(nullptr),
+      sequencePlayer(nullptr),
       ocioConfig(other.ocioConfig),
       currentDisplayTransform(other.currentDisplayTransform),
       displayDevice(other.displayDevice),
@@ -40,7 +50,12 @@ AppContext::AppContext(const AppContext& other)
       fpsLastTimeMS(other.fpsLastTimeMS),
       fpsFrameCount(other.fpsFrameCount),
       fps(other.fps),
-      rendererNeedsReset(other.rendererNeedsReset) 
+      showInfoOverlay(other.showInfoOverlay),
+      showPerfOverlay(other.showPerfOverlay),
+      traceAtStartup(other.traceAtStartup),
+      lowLatencyPacing(other.lowLatencyPacing),
+      rendererNeedsReset(other.rendererNeedsReset),
+      needsRedraw(other.needsRedraw)
 {
     // Create new mutex for this instance
     renderLock = SDL_CreateMutex();
@@ -60,8 +75,13 @@ AppContext& AppContext::operator=(const AppContext& other) {
         isFullScreen = other.isFullScreen;
         savedWindowRect = other.savedWindowRect;
         savedMaximized = other.savedMaximized;
-        // renderer is not copied; ensure null
+        // renderer and loader are not copied; ensure null
         renderer.reset();
+        imageLoader.reset();
+        imageSaver.reset();
+        directoryIndexer.reset();
+        thumbnailGrid.reset();
+        sequencePlayer.reset();
         ocioConfig = other.ocioConfig;
         currentDisplayTransform = other.currentDisplayTransform;
         displayDevice = other.displayDevice;
@@ -73,7 +93,12 @@ AppContext& AppContext::operator=(const AppContext& other) {
         fpsLastTimeMS = other.fpsLastTimeMS;
         fpsFrameCount = other.fpsFrameCount;
         fps = other.fps;
+        showInfoOverlay = other.showInfoOverlay;
+        showPerfOverlay = other.showPerfOverlay;
+        traceAtStartup = other.traceAtStartup;
+        lowLatencyPacing = other.lowLatencyPacing;
         rendererNeedsReset = other.rendererNeedsReset;
+        needsRedraw = other.needsRedraw;
     }
     return *this;
 }
@@ -92,6 +117,11 @@ AppContext::AppContext(AppContext&& other) noexcept
       savedWindowRect(other.savedWindowRect),
       savedMaximized(other.savedMaximized),
       renderer(std::move(other.renderer)),
+      imageLoader(std::move(other.imageLoader)),
+      imageSaver(std::move(other.imageSaver)),
+      directoryIndexer(std::move(other.directoryIndexer)),
+      thumbnailGrid(std::move(other.thumbnailGrid)),
+      sequencePlayer(std::move(other.sequencePlayer)),
       ocioConfig(other.ocioConfig),
       currentDisplayTransform(other.currentDisplayTransform),
       displayDevice(std::move(other.displayDevice)),
@@ -103,7 +133,12 @@ AppContext::AppContext(AppContext&& other) noexcept
       fpsLastTimeMS(other.fpsLastTimeMS),
       fpsFrameCount(other.fpsFrameCount),
       fps(other.fps),
-      rendererNeedsReset(other.rendererNeedsReset)
+      showInfoOverlay(other.showInfoOverlay),
+      showPerfOverlay(other.showPerfOverlay),
+      traceAtStartup(other.traceAtStartup),
+      lowLatencyPacing(other.lowLatencyPacing),
+      rendererNeedsReset(other.rendererNeedsReset),
+      needsRedraw(other.needsRedraw)
 {
     renderLock = SDL_CreateMutex();
     renderInProgress.store(false, std::memory_order_relaxed);
@@ -132,6 +167,11 @@ AppContext& AppContext::operator=(AppContext&& other) noexcept {
         savedWindowRect = other.savedWindowRect;
         savedMaximized = other.savedMaximized;
         renderer = std::move(other.renderer);
+        imageLoader = std::move(other.imageLoader);
+        imageSaver = std::move(other.imageSaver);
+        directoryIndexer = std::move(other.directoryIndexer);
+        thumbnailGrid = std::move(other.thumbnailGrid);
+        sequencePlayer = std::move(other.sequencePlayer);
         ocioConfig = other.ocioConfig;
         currentDisplayTransform = other.currentDisplayTransform;
         displayDevice = std::move(other.displayDevice);
@@ -143,7 +183,12 @@ AppContext& AppContext::operator=(AppContext&& other) noexcept {
         fpsLastTimeMS = other.fpsLastTimeMS;
         fpsFrameCount = other.fpsFrameCount;
         fps = other.fps;
+        showInfoOverlay = other.showInfoOverlay;
+        showPerfOverlay = other.showPerfOverlay;
+        traceAtStartup = other.traceAtStartup;
+        lowLatencyPacing = other.lowLatencyPacing;
         rendererNeedsReset = other.rendererNeedsReset;
+        needsRedraw = other.needsRedraw;
 
         // Reinitialize our sync primitives/flags
         renderLock = SDL_CreateMutex();
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -14,6 +15,7 @@
 #endif
 
 #include "resource.h"
+#include "pixel_buffer.h"
 
 // OpenImageIO and OpenColorIO
 #include <OpenImageIO/imageio.h>
@@ -22,40 +24,84 @@
 #include "ocio_shim.h"
 
 class VulkanRenderer;
+class ImageLoader;
+class ImageSaver;
+class DirectoryIndexer;
+class ThumbnailGrid;
+class SequencePlayer;
+class PagedImage;
+class MappedImage;
+namespace ColorLut { struct Lut3D; }
+
+// Display gamma images are encoded for; ImageData::gamma re-targets from it
+constexpr float kDefaultGamma = 2.2f;
 
 struct ImageData {
-    std::vector<uint8_t> pixels;        // Unified pixel data (RGBA8 for LDR, interpreted as RGBA16F for HDR)
+    // Unified pixel data (RGBA8 for LDR, RGBA16F for HDR). Written once by the decoder, then
+    // shared read-only, so copies of an ImageData never copy pixels.
+    std::shared_ptr<const PixelBuffer> pixels;
+    std::wstring filePath;              // Source file (cache key); empty if not loaded from disk
+    std::shared_ptr<PagedImage> paged;  // Set instead of pixels for tiled files decoded on demand
+    std::shared_ptr<MappedImage> mapped; // Set instead of pixels for uncompressed files read in place
     uint32_t width = 0;
     uint32_t height = 0;
+    bool isPreview = false;             // Reduced-size stand-in shown until the full decode lands
+    uint32_t fullWidth = 0;             // Size of the image a preview stands in for
+    uint32_t fullHeight = 0;
     bool isHdr = false;
     uint32_t channels = 4; // Always RGBA
+    std::shared_ptr<const OIIO::ImageSpec> sourceSpec; // File header as loaded; Save writes the same format
+    int orientation = 1;                // EXIF Orientation (1-8); applied when drawn, never to the pixels
 
     // OpenColorIO color space information
     std::string sourceColorSpace = "sRGB";        // Original color space from file
     std::string workingColorSpace = "Linear Rec.709 (sRGB)"; // Working space for processing
     OCIO::ConstProcessorRcPtr colorTransform;
+    std::shared_ptr<const ColorLut::Lut3D> displayLut;  // colorTransform baked for the GPU; pixels left unconverted
 
     // Image metadata
     float exposure = 0.0f;        // Exposure compensation
-    float gamma = 2.2f;          // Gamma correction
+    float gamma = kDefaultGamma; // Gamma correction
     bool isTiled = false;        // Whether image uses tiled loading
     bool isSparse = false;       // Whether image uses sparse memory
     uint32_t tileSize = 512;     // Tile size for large images
 
     bool isValid() const { 
-        return width > 0 && height > 0 && !pixels.empty(); 
+        return width > 0 && height > 0 && (pixels != nullptr || paged != nullptr || mapped != nullptr);
+    }
+
+    // Size used for layout (fit, zoom caps, hit testing); a preview lays out as its full image
+    uint32_t displayWidth() const { return isPreview ? fullWidth : width; }
+    uint32_t displayHeight() const { return isPreview ? fullHeight : height; }
+
+    // EXIF orientation as a left-right mirror followed by a clockwise rotation
+    int orientationRotation() const {
+        constexpr int kRotation[9] = { 0, 0, 0, 180, 180, 270, 90, 90, 270 };
+        return (orientation >= 1 && orientation <= 8) ? kRotation[orientation] : 0;
+    }
+    bool orientationMirrored() const {
+        return orientation == 2 || orientation == 4 || orientation == 5 || orientation == 7;
     }
 
     void clear() { 
-        pixels.clear();
+        pixels.reset();
+        filePath.clear();
+        paged.reset();
+        mapped.reset();
         width = 0; 
         height = 0; 
+        isPreview = false;
+        fullWidth = 0;
+        fullHeight = 0;
         isHdr = false; 
+        sourceSpec.reset();
+        orientation = 1;
         sourceColorSpace = "sRGB";
         workingColorSpace = "Linear Rec.709 (sRGB)";
         colorTransform.reset();
+        displayLut.reset();
         exposure = 0.0f;
-        gamma = 2.2f;
+        gamma = kDefaultGamma;
         isTiled = false;
         isSparse = false;
         tileSize = 512;
@@ -81,11 +127,27 @@ struct AppContext {
     // Vulkan renderer (initialized after window creation)
     std::unique_ptr<VulkanRenderer> renderer;
 
-    // OpenColorIO context for color management
+    // Background decode worker (started after SDL_Init)
+    std::unique_ptr<ImageLoader> imageLoader;
+
+    // Background encode worker for Save and Save As (started after SDL_Init)
+    std::unique_ptr<ImageSaver> imageSaver;
+
+    // Streams and watches the listing behind imageFiles (started after SDL_Init)
+    std::unique_ptr<DirectoryIndexer> directoryIndexer;
+
+    // Thumbnail grid and filmstrip over the listing (T / Shift+T; started after SDL_Init)
+    std::unique_ptr<ThumbnailGrid> thumbnailGrid;
+
+    // Flipbook playback of numbered frames (Space); its workers run only while playing
+    std::unique_ptr<SequencePlayer> sequencePlayer;
+
+    // OpenColorIO context for color management. The SDL viewer leaves the config to
+    // the first decode that converts color; only the legacy Win32 entry point fills it.
     OCIO::ConstConfigRcPtr ocioConfig;
     OCIO::ConstProcessorRcPtr currentDisplayTransform;
     std::string displayDevice = "sRGB";
-    bool ocioEnabled = false;
+    bool ocioEnabled = false;       // $OCIO is set
 
     bool showFilePath = false;
     std::wstring currentFilePathOverride;
@@ -97,9 +159,24 @@ struct AppContext {
     int fpsFrameCount = 0;
     float fps = 0.0f;
 
+    // Info HUD drawn over the image: FPS, file and load status (toggled with I)
+    bool showInfoOverlay = false;
+
+    // Per-stage timings from the trace rings (toggled with P; Shift+P exports a Chrome trace)
+    bool showPerfOverlay = false;
+    // Tracing was requested at startup (MIV_TRACE) and stays on without the HUD
+    bool traceAtStartup = false;
+
+    // Present with MAILBOX/FIFO_RELAXED and at most one frame queued (toggled with L);
+    // kept here so a rebuilt renderer paces the same way
+    bool lowLatencyPacing = false;
+
     // Renderer maintenance
     bool rendererNeedsReset = false;
 
+    // Set by anything that changes what's on screen; the main loop sleeps until it is
+    bool needsRedraw = true;
+
     // Synchronization: simple mutex instead of SRWLOCK for cross-platform compatibility
     SDL_Mutex* renderLock = nullptr;
 
@@ -138,12 +215,53 @@ void ZoomImage(float factor);
 void RotateImage(bool clockwise);
 
 // image_io.cpp
+// What the renderer can take over from the decoder
+struct DecodeOptions {
+    // Large tiled files may be opened for on-demand reads (ImageData::paged) instead
+    // of decoded; only when the renderer can show them through a sparse texture
+    bool allowPaged = false;
+    // Leave pixels in the file's color space and bake the display transform into
+    // ImageData::displayLut for the renderer to apply; CPU conversion otherwise
+    bool gpuColor = false;
+    // Uncompressed files may be mapped (ImageData::mapped) and converted as the
+    // renderer uploads them, instead of decoded into pixels
+    bool mappedRows = false;
+    // Images of more pixels are refused before any are read; 0 = no limit. The refusal
+    // leaves 'error' empty and the image's size in 'out'.
+    uint64_t maxPixels = 0;
+};
+DecodeOptions CurrentDecodeOptions();
+bool DecodeImageFile(const std::wstring& filePath, ImageData& out, std::string& error,
+                     const std::function<bool()>& isCancelled = nullptr, const DecodeOptions& options = DecodeOptions());
+// Quick reduced-size stand-in for a large image: a stored MIP level or the embedded
+// thumbnail, in the same pixel format DecodeImageFile would produce. Fails when the
+// file has neither or is small enough that the full decode is just as quick.
+bool DecodeImagePreview(const std::wstring& filePath, ImageData& out,
+                        const std::function<bool()>& isCancelled = nullptr, const DecodeOptions& options = DecodeOptions());
+// Scale decoded pixels down so the long side is at most 'maxSide', keeping their format
+bool ResizeImageToFit(ImageData& image, uint32_t maxSide, std::string& error);
+// Hand g_ctx.imageData (pixels, paged or mapped source, and its display LUT) to the renderer
+void UploadCurrentImage();
 void LoadImageFromFile(const wchar_t* filePath);
 void LoadImageFromFile(const char* filePath);
+void HandleImageLoadComplete();
+void HandleDirectoryChanges();
+void CancelImageLoad();
+void InvalidateCachedImage(const wchar_t* filePath);
+void PrefetchNeighbours(int direction);
+void NavigateImage(int direction);
+// Jump to listing entry 'index' (picked in the thumbnail grid or filmstrip)
+void OpenImageAt(int index);
+// Play the numbered sequence the current image belongs to; false when it has none
+bool StartSequencePlayback();
+// Stop playback; with 'openShownFrame' the frame on screen becomes the current image
+void StopSequencePlayback(bool openShownFrame);
+bool IsSequencePlaying();
 void GetImagesInDirectory(const wchar_t* filePath);
 void GetImagesInDirectory(const char* filePath);
 void SaveImage();
 void SaveImageAs();
+void HandleSaveEvent();
 void DeleteCurrentImage();
 void HandleDropFiles(const std::vector<std::string>& filePaths);
 void HandlePaste();
@@ -152,7 +270,11 @@ void OpenFileLocationAction();
 
 // image_drawing.cpp
 void DrawImage();
+void RequestRedraw();
 void FitImageToWindow();
 void ZoomImage(float factor);
 void RotateImage(bool clockwise);
 bool IsPointInImage(int x, int y);
+// How the image is drawn: the user's rotation on top of the file's orientation
+int DisplayRotation();
+bool DisplayMirrored();
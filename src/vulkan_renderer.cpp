@@ -1,15 +1,21 @@
 #include "vulkan_renderer.h"
 #include "logging.h"
+#include "pixel_convert.h"
+#include "trace.h"
 #include <stdexcept>
+#include <array>
+#include <cstddef>
 #include <cstring>
 #include <algorithm>
 #include <climits>
 #include <cmath>
+#include <new>
 #include <string>
 
 #ifdef _WIN32
 #include <winreg.h>   // For registry functions (RegOpenKeyExA, RegCloseKey)
 #include <psapi.h>    // For PROCESS_MEMORY_COUNTERS_EX, GetProcessMemoryInfo
+#include <shlobj.h>   // For SHGetKnownFolderPath (pipeline cache location)
 
 // Helper function to convert wstring to string for logging
 static std::string w2u(const std::wstring& w) {
@@ -67,6 +73,23 @@ static bool checkVulkanOperation(VkResult r, bool& outDeviceLost, bool& outSwapc
     return checkVulkanResult(r, "", outDeviceLost, outSwapchainOutOfDate);
 }
 
+// SPIR-V compiled from shaders/ at build time (glslc -mfmt=c)
+static const uint32_t kImageVertSpirv[] =
+#include "image.vert.inc"
+;
+static const uint32_t kImageFragSpirv[] =
+#include "image.frag.inc"
+;
+static const uint32_t kTextVertSpirv[] =
+#include "text.vert.inc"
+;
+static const uint32_t kTextFragSpirv[] =
+#include "text.frag.inc"
+;
+static const uint32_t kThumbnailFragSpirv[] =
+#include "thumbnail.frag.inc"
+;
+
 VulkanRenderer::VulkanRenderer() = default;
 VulkanRenderer::~VulkanRenderer() { Shutdown(); }
 
@@ -103,11 +126,14 @@ bool VulkanRenderer::initInstance() {
     app.engineVersion = VK_MAKE_VERSION(1, 0, 0);
     app.apiVersion = VK_API_VERSION_1_1;
 
-    // Get required extensions from SDL3
+    // Get required extensions from SDL3; offscreen rendering needs no surface extensions
     Uint32 extensionCount = 0;
-    const char* const* extensions = SDL_Vulkan_GetInstanceExtensions(&extensionCount);
-    if (extensions == nullptr || extensionCount == 0) {
-        return false; // Could not get required extensions
+    const char* const* extensions = nullptr;
+    if (!headless_) {
+        extensions = SDL_Vulkan_GetInstanceExtensions(&extensionCount);
+        if (extensions == nullptr || extensionCount == 0) {
+            return false; // Could not get required extensions
+        }
     }
 
     VkInstanceCreateInfo ci{};
@@ -156,13 +182,25 @@ bool VulkanRenderer::pickPhysicalDevice() {
         std::vector<VkQueueFamilyProperties> qprops(qCount);
         vkGetPhysicalDeviceQueueFamilyProperties(d, &qCount, qprops.data());
 
-        uint32_t gfxIdx = UINT32_MAX, presentIdx = UINT32_MAX;
+        uint32_t gfxIdx = UINT32_MAX, presentIdx = UINT32_MAX, transferIdx = UINT32_MAX;
         for (uint32_t i = 0; i < qCount; ++i) {
             if (qprops[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
                 gfxIdx = i;
             }
+            // Dedicated transfer family (the copy engine): transfer-only, with texel-granular copies
+            const VkQueueFlags flags = qprops[i].queueFlags;
+            const VkExtent3D& gran = qprops[i].minImageTransferGranularity;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+                gran.width == 1 && gran.height == 1 && gran.depth == 1 && transferIdx == UINT32_MAX) {
+                transferIdx = i;
+            }
             VkBool32 presentSupport = VK_FALSE;
-            vkGetPhysicalDeviceSurfaceSupportKHR(d, i, surface_, &presentSupport);
+            if (surface_ != VK_NULL_HANDLE) {
+                vkGetPhysicalDeviceSurfaceSupportKHR(d, i, surface_, &presentSupport);
+            } else {
+                // Offscreen: nothing is presented, so the graphics family stands in
+                presentSupport = (flags & VK_QUEUE_GRAPHICS_BIT) ? VK_TRUE : VK_FALSE;
+            }
             if (presentSupport) {
                 if (presentIdx == UINT32_MAX) presentIdx = i;
             }
@@ -171,6 +209,12 @@ bool VulkanRenderer::pickPhysicalDevice() {
             physicalDevice_ = d;
             graphicsQueueFamily_ = gfxIdx;
             presentQueueFamily_ = presentIdx;
+            // Sparse binds go on the graphics queue so tile uploads can follow them in order
+            sparseBindingQueue_ = (qprops[gfxIdx].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0;
+            // Without a dedicated family, uploads share the graphics queue
+            transferQueueFamily_ = (transferIdx != UINT32_MAX) ? transferIdx : gfxIdx;
+            Logger::Info("Queue families: graphics=%u present=%u transfer=%u%s", gfxIdx, presentIdx,
+                         transferQueueFamily_, transferIdx != UINT32_MAX ? " (dedicated)" : " (shared)");
             return true;
         }
     }
@@ -186,10 +230,114 @@ bool VulkanRenderer::initializeTextRenderer() {
     return true;
 }
 
-void VulkanRenderer::SetColorTransform(void* processor) {
-    colorProcessor_ = processor;
-    // Implementation would create color LUT from OpenColorIO processor
-    // For now, just store the pointer
+bool VulkanRenderer::waitForText() {
+    if (fontThread_.joinable()) {
+        fontThread_.join();
+    }
+    return textRenderer_.IsReady();
+}
+
+bool VulkanRenderer::SetColorLut(const uint16_t* rgbaHalf, uint32_t edgeLength, float log2Min, float log2Max,
+                                 uint64_t id, bool withNextImage) {
+    // NASA Standard: Validate all input parameters
+    if (!device_ || deviceLost_) {
+        return false;
+    }
+    if (rgbaHalf != nullptr && (edgeLength < 2 || !(log2Max > log2Min))) {
+        return false;
+    }
+    if (rgbaHalf == nullptr) {
+        id = 0;
+    }
+
+    // Already in place (or queued behind the next image): nothing to upload
+    const ColorLutTexture& current = colorLutPending_ ? pendingColorLut_ : colorLut_;
+    if (current.id == id && (id != 0 || current.view == VK_NULL_HANDLE)) {
+        if (!withNextImage) adoptPendingColorLut();
+        return true;
+    }
+
+    ColorLutTexture lut;
+    if (rgbaHalf != nullptr && !createColorLut(rgbaHalf, edgeLength, lut)) {
+        Logger::Warn("Failed to upload the %u^3 display LUT; showing texels as sampled", edgeLength);
+        lut = ColorLutTexture{};
+        id = 0;
+    }
+    lut.log2Min = log2Min;
+    lut.log2Max = log2Max;
+    lut.id = id;
+
+    retireColorLut(pendingColorLut_);
+    pendingColorLut_ = lut;
+    colorLutPending_ = true;
+    if (!withNextImage) {
+        adoptPendingColorLut();
+    }
+    return lut.view != VK_NULL_HANDLE || rgbaHalf == nullptr;
+}
+
+void VulkanRenderer::SetDisplayAdjustments(float exposureStops, float gamma) {
+    // NASA Standard: Keep non-finite values out of the shader
+    if (!std::isfinite(exposureStops)) exposureStops = 0.0f;
+    if (!std::isfinite(gamma) || gamma <= 0.0f) gamma = 1.0f;
+    exposureScale_ = std::exp2(exposureStops);
+    // Output is encoded for a 2.2 display already; other values re-target it
+    constexpr float kReferenceGamma = 2.2f;
+    gammaExponent_ = kReferenceGamma / gamma;
+}
+
+void VulkanRenderer::SetLowLatency(bool enabled) {
+    if (enabled == lowLatency_) return;
+    lowLatency_ = enabled;
+    // The swapchain's present mode is fixed at creation
+    presentModeDirty_ = !headless_ && swapchain_ != VK_NULL_HANDLE;
+}
+
+const char* VulkanRenderer::GetPresentModeName() const {
+    switch (presentMode_) {
+        case VK_PRESENT_MODE_MAILBOX_KHR: return "mailbox";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "fifo relaxed";
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return "immediate";
+        default: return "fifo";
+    }
+}
+
+void VulkanRenderer::PaceFrame() {
+    if (!vulkanAvailable_ || deviceLost_ || headless_ || !device_ || !swapchain_) {
+        return;
+    }
+
+    if (presentWait_ && presentId_ > presentIdShown_) {
+        VkResult wr = VK_SUCCESS;
+        if (lowLatency_) {
+            Trace::Scope paceTrace(Trace::Stage::Pace);
+            wr = waitForPresent_(device_, swapchain_, presentId_, kPaceTimeoutNs);
+        } else {
+            // Smooth pacing only polls, to measure frames that have already been shown
+            wr = waitForPresent_(device_, swapchain_, presentId_, 0);
+        }
+        if (wr == VK_SUCCESS) {
+            presentIdShown_ = presentId_;
+            if (inputPresentedNs_ != 0 && Trace::IsEnabled()) {
+                Trace::Record(Trace::Stage::Latency, inputPresentedNs_, Trace::Now());
+                inputPresentedNs_ = 0;
+            }
+        } else if (wr == VK_ERROR_DEVICE_LOST) {
+            deviceLost_ = true;
+        } else if (wr == VK_ERROR_OUT_OF_DATE_KHR || wr == VK_ERROR_SURFACE_LOST_KHR) {
+            swapchainOutOfDate_ = true;
+            presentIdShown_ = presentId_;
+        }
+        // VK_TIMEOUT: minimized or occluded windows may never show it; draw anyway
+        return;
+    }
+
+    if (lowLatency_ && !presentWait_) {
+        // Without present wait the best bound is the GPU: let no frame start before the last finished
+        const uint32_t previous = (currentFrame_ + MAX_FRAMES_IN_FLIGHT - 1) % MAX_FRAMES_IN_FLIGHT;
+        Trace::Scope paceTrace(Trace::Stage::Pace);
+        vkWaitForFences(device_, 1, &inFlightFences_[previous], VK_TRUE, kPaceTimeoutNs);
+    }
 }
 
 bool VulkanRenderer::createDeviceAndQueues() {
@@ -200,10 +348,19 @@ bool VulkanRenderer::createDeviceAndQueues() {
         return false;
     }
 
+    if (transferQueueFamily_ == UINT32_MAX) {
+        transferQueueFamily_ = graphicsQueueFamily_;
+    }
+
     float prio = 1.0f;
-    VkDeviceQueueCreateInfo qcis[2]{};
-    uint32_t uniqueFamilies[2] = { graphicsQueueFamily_, presentQueueFamily_ };
-    uint32_t qciCount = (graphicsQueueFamily_ == presentQueueFamily_) ? 1u : 2u;
+    VkDeviceQueueCreateInfo qcis[3]{};
+    uint32_t uniqueFamilies[3] = { graphicsQueueFamily_, UINT32_MAX, UINT32_MAX };
+    uint32_t qciCount = 1;
+    for (uint32_t family : { presentQueueFamily_, transferQueueFamily_ }) {
+        if (std::find(uniqueFamilies, uniqueFamilies + qciCount, family) == uniqueFamilies + qciCount) {
+            uniqueFamilies[qciCount++] = family;
+        }
+    }
 
     for (uint32_t i = 0; i < qciCount; ++i) {
         qcis[i].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -212,19 +369,113 @@ bool VulkanRenderer::createDeviceAndQueues() {
         qcis[i].pQueuePriorities = &prio;
     }
 
-    const char* exts[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+    const char* exts[5] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, nullptr, nullptr, nullptr, nullptr };
+    uint32_t extCount = 1;
+
+    // Host pointer import lets mapped files act as transfer sources without staging.
+    // The import granularity must not exceed a page, since files are mapped by pages.
+    hostMemoryImport_ = false;
+    hostPointerAlignment_ = 0;
+    getMemoryHostPointerProperties_ = nullptr;
+    memoryBudget_ = false;
+    presentWait_ = false;
+    waitForPresent_ = nullptr;
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR };
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR };
+    {
+        uint32_t available = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice_, nullptr, &available, nullptr);
+        std::vector<VkExtensionProperties> props(available);
+        vkEnumerateDeviceExtensionProperties(physicalDevice_, nullptr, &available, props.data());
+        const bool hasHostImport = std::any_of(props.begin(), props.end(), [](const VkExtensionProperties& p) {
+            return std::strcmp(p.extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0;
+        });
+
+        VkPhysicalDeviceProperties deviceProps{};
+        vkGetPhysicalDeviceProperties(physicalDevice_, &deviceProps);
+        if (hasHostImport && deviceProps.apiVersion >= VK_API_VERSION_1_1) {
+            VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProps{
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
+            VkPhysicalDeviceProperties2 props2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+            props2.pNext = &hostProps;
+            vkGetPhysicalDeviceProperties2(physicalDevice_, &props2);
+            const VkDeviceSize alignment = hostProps.minImportedHostPointerAlignment;
+            if (alignment != 0 && alignment <= 4096 && (alignment & (alignment - 1)) == 0) {
+                exts[extCount++] = VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME;
+                hostMemoryImport_ = true;
+                hostPointerAlignment_ = alignment;
+            }
+        }
+
+        // Per-heap budgets let uploads pick a cheaper residency before VRAM runs out
+        const bool hasMemoryBudget = std::any_of(props.begin(), props.end(), [](const VkExtensionProperties& p) {
+            return std::strcmp(p.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+        });
+        if (hasMemoryBudget && deviceProps.apiVersion >= VK_API_VERSION_1_1) {
+            exts[extCount++] = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+            memoryBudget_ = true;
+        }
+
+        // Present ids and present wait let low-latency pacing wait for a frame to reach the screen
+        auto hasExtension = [&props](const char* name) {
+            return std::any_of(props.begin(), props.end(), [name](const VkExtensionProperties& p) {
+                return std::strcmp(p.extensionName, name) == 0;
+            });
+        };
+        if (hasExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME) && hasExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME) &&
+            deviceProps.apiVersion >= VK_API_VERSION_1_1) {
+            presentIdFeatures.pNext = &presentWaitFeatures;
+            VkPhysicalDeviceFeatures2 features2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+            features2.pNext = &presentIdFeatures;
+            vkGetPhysicalDeviceFeatures2(physicalDevice_, &features2);
+            if (presentIdFeatures.presentId && presentWaitFeatures.presentWait) {
+                exts[extCount++] = VK_KHR_PRESENT_ID_EXTENSION_NAME;
+                exts[extCount++] = VK_KHR_PRESENT_WAIT_EXTENSION_NAME;
+                presentWait_ = true;
+            }
+        }
+    }
+
+    // Sparse residency backs the path for images too large to keep fully resident
+    VkPhysicalDeviceFeatures supported{};
+    vkGetPhysicalDeviceFeatures(physicalDevice_, &supported);
+    VkPhysicalDeviceFeatures enabled{};
+    sparseImageSupport_ = sparseBindingQueue_ && supported.sparseBinding && supported.sparseResidencyImage2D;
+    if (sparseImageSupport_) {
+        enabled.sparseBinding = VK_TRUE;
+        enabled.sparseResidencyImage2D = VK_TRUE;
+    }
 
     VkDeviceCreateInfo dci{};
     dci.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     dci.queueCreateInfoCount = qciCount;
     dci.pQueueCreateInfos = qcis;
-    dci.enabledExtensionCount = 1;
+    dci.enabledExtensionCount = extCount;
     dci.ppEnabledExtensionNames = exts;
+    dci.pEnabledFeatures = &enabled;
+    if (presentWait_) {
+        // Queried into these structs above: both features reported supported
+        presentIdFeatures.presentId = VK_TRUE;
+        presentWaitFeatures.presentWait = VK_TRUE;
+        dci.pNext = &presentIdFeatures;
+    }
 
     if (vkCreateDevice(physicalDevice_, &dci, nullptr, &device_) != VK_SUCCESS) return false;
 
+    if (presentWait_) {
+        waitForPresent_ = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device_, "vkWaitForPresentKHR"));
+        presentWait_ = waitForPresent_ != nullptr;
+    }
+
+    if (hostMemoryImport_) {
+        getMemoryHostPointerProperties_ = reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+            vkGetDeviceProcAddr(device_, "vkGetMemoryHostPointerPropertiesEXT"));
+        hostMemoryImport_ = getMemoryHostPointerProperties_ != nullptr;
+    }
+
     vkGetDeviceQueue(device_, graphicsQueueFamily_, 0, &graphicsQueue_);
     vkGetDeviceQueue(device_, presentQueueFamily_, 0, &presentQueue_);
+    vkGetDeviceQueue(device_, transferQueueFamily_, 0, &transferQueue_);
     return true;
 }
 
@@ -305,23 +556,100 @@ uint32_t VulkanRenderer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFla
     return UINT32_MAX; // No suitable memory type found
 }
 
+VkDeviceSize VulkanRenderer::deviceLocalHeadroom() const {
+    if (physicalDevice_ == VK_NULL_HANDLE) {
+        return 0;
+    }
+    // A texture is allocated from one heap, so the roomiest device-local heap is what counts
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+    VkPhysicalDeviceMemoryProperties2 props2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2 };
+    if (memoryBudget_) {
+        props2.pNext = &budget;
+        vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &props2);
+    } else {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &props2.memoryProperties);
+    }
+
+    VkDeviceSize headroom = 0;
+    const VkPhysicalDeviceMemoryProperties& memory = props2.memoryProperties;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+        if (!(memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)) continue;
+        VkDeviceSize available = 0;
+        if (memoryBudget_) {
+            // Budget covers other processes too; usage is this process's share
+            available = budget.heapBudget[i] > budget.heapUsage[i] ? budget.heapBudget[i] - budget.heapUsage[i] : 0;
+        } else {
+            // No usage reporting: assume a quarter of the heap is taken by the desktop
+            // and other applications, and leave allocation failures to catch the rest
+            available = memory.memoryHeaps[i].size / 4 * 3;
+        }
+        headroom = std::max(headroom, available);
+    }
+    return headroom;
+}
+
+VkDeviceSize VulkanRenderer::GetDeviceLocalUsage() const {
+    if (physicalDevice_ == VK_NULL_HANDLE || !memoryBudget_) {
+        return 0;
+    }
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+    VkPhysicalDeviceMemoryProperties2 props2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2 };
+    props2.pNext = &budget;
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &props2);
+
+    VkDeviceSize usage = 0;
+    const VkPhysicalDeviceMemoryProperties& memory = props2.memoryProperties;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+        if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            usage += budget.heapUsage[i];
+        }
+    }
+    return usage;
+}
+
+uint32_t VulkanRenderer::denseScaleShift(uint32_t width, uint32_t height, uint32_t pixelSize, bool withMipmaps,
+                                         VkDeviceSize headroom) const {
+    const VkDeviceSize usable = headroom > kVramReserveBytes ? headroom - kVramReserveBytes : 0;
+    uint32_t shift = 0;
+    for (;; ++shift) {
+        const uint64_t w = std::max(1u, width >> shift);
+        const uint64_t h = std::max(1u, height >> shift);
+        VkDeviceSize bytes = static_cast<VkDeviceSize>(w * h * pixelSize);
+        if (withMipmaps) bytes += bytes / 3;    // The whole chain adds a third
+        const bool fits = bytes <= usable && w * h <= kMaxDensePixels;
+        if (fits || shift >= kMaxVramScaleShift || (width >> (shift + 1)) == 0 || (height >> (shift + 1)) == 0) {
+            return shift;
+        }
+    }
+}
+
 bool VulkanRenderer::createCommandPool() {
     VkCommandPoolCreateInfo pci{};
     pci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     pci.queueFamilyIndex = graphicsQueueFamily_;
     pci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    return vkCreateCommandPool(device_, &pci, nullptr, &commandPool_) == VK_SUCCESS;
+    if (vkCreateCommandPool(device_, &pci, nullptr, &commandPool_) != VK_SUCCESS) return false;
+
+    if (!hasDedicatedTransferQueue()) {
+        transferCommandPool_ = commandPool_;
+        return true;
+    }
+    // Upload command buffers are short-lived and freed individually
+    pci.queueFamilyIndex = transferQueueFamily_;
+    pci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    return vkCreateCommandPool(device_, &pci, nullptr, &transferCommandPool_) == VK_SUCCESS;
 }
 
-VkCommandBuffer VulkanRenderer::beginSingleTimeCommands() {
+VkCommandBuffer VulkanRenderer::beginSingleTimeCommands(bool onTransferQueue) {
+    const VkCommandPool pool = onTransferQueue ? transferCommandPool_ : commandPool_;
     // NASA Standard: Validate device state before operations
-    if (!device_ || !commandPool_) {
+    if (!device_ || !pool) {
         return VK_NULL_HANDLE;
     }
 
     VkCommandBufferAllocateInfo a{};
     a.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    a.commandPool = commandPool_;
+    a.commandPool = pool;
     a.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     a.commandBufferCount = 1;
     VkCommandBuffer cmd = VK_NULL_HANDLE;
@@ -341,16 +669,18 @@ VkCommandBuffer VulkanRenderer::beginSingleTimeCommands() {
     VkResult beginResult = vkBeginCommandBuffer(cmd, &bi);
     if (!checkVulkanOperation(beginResult, deviceLost, swapchainOutOfDate)) {
         if (deviceLost) deviceLost_ = true;
-        vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
+        vkFreeCommandBuffers(device_, pool, 1, &cmd);
         return VK_NULL_HANDLE;
     }
     return cmd;
 }
 
-void VulkanRenderer::endSingleTimeCommands(VkCommandBuffer cmd) {
+uint64_t VulkanRenderer::endSingleTimeCommands(VkCommandBuffer cmd, bool onTransferQueue, VkSemaphore waitSemaphore) {
+    const VkCommandPool pool = onTransferQueue ? transferCommandPool_ : commandPool_;
+    const VkQueue queue = onTransferQueue ? transferQueue_ : graphicsQueue_;
     // NASA Standard: Validate input parameters
-    if (cmd == VK_NULL_HANDLE || !device_ || !graphicsQueue_) {
-        return;
+    if (cmd == VK_NULL_HANDLE || !device_ || !queue) {
+        return 0;
     }
 
     VkResult endResult = vkEndCommandBuffer(cmd);
@@ -358,29 +688,755 @@ void VulkanRenderer::endSingleTimeCommands(VkCommandBuffer cmd) {
     bool swapchainOutOfDate = false;
     if (!checkVulkanOperation(endResult, deviceLost, swapchainOutOfDate)) {
         if (deviceLost) deviceLost_ = true;
-        vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
-        return;
+        vkFreeCommandBuffers(device_, pool, 1, &cmd);
+        return 0;
     }
 
+    VkFence fence = VK_NULL_HANDLE;
+    if (!uploadFencePool_.empty()) {
+        fence = uploadFencePool_.back();
+        uploadFencePool_.pop_back();
+    } else {
+        VkFenceCreateInfo fci{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+        if (vkCreateFence(device_, &fci, nullptr, &fence) != VK_SUCCESS) {
+            fence = VK_NULL_HANDLE;
+        }
+    }
+
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
     VkSubmitInfo si{};
     si.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     si.commandBufferCount = 1;
     si.pCommandBuffers = &cmd;
+    if (waitSemaphore != VK_NULL_HANDLE) {
+        si.waitSemaphoreCount = 1;
+        si.pWaitSemaphores = &waitSemaphore;
+        si.pWaitDstStageMask = &waitStage;
+    }
 
-    VkResult submitResult = vkQueueSubmit(graphicsQueue_, 1, &si, VK_NULL_HANDLE);
+    VkResult submitResult = vkQueueSubmit(queue, 1, &si, fence);
     if (!checkVulkanOperation(submitResult, deviceLost, swapchainOutOfDate)) {
         if (deviceLost) deviceLost_ = true;
-        vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
+        if (fence != VK_NULL_HANDLE) uploadFencePool_.push_back(fence);
+        vkFreeCommandBuffers(device_, pool, 1, &cmd);
+        return 0;
+    }
+
+    const uint64_t serial = nextUploadSerial_++;
+    stagingRing_.Commit(serial);
+
+    if (fence == VK_NULL_HANDLE) {
+        // No fence available: fall back to a blocking wait so staging can be reused safely
+        VkResult waitResult = vkQueueWaitIdle(queue);
+        if (waitResult == VK_ERROR_DEVICE_LOST) {
+            deviceLost_ = true;
+        }
+        vkFreeCommandBuffers(device_, pool, 1, &cmd);
+        retireUploads(false);
+        return serial;
+    }
+
+    // Retired later by polling. Graphics-queue uploads are ordered before later frames by
+    // submission order; transfer-queue uploads are handed over once their fence signals.
+    pendingUploads_.push_back(PendingUpload{ serial, fence, cmd, pool });
+    retireUploads(false);
+    return serial;
+}
+
+void VulkanRenderer::retireUploads(bool waitForOldest) {
+    if (!device_) return;
+
+    if (waitForOldest && !pendingUploads_.empty() && !deviceLost_) {
+        // NASA Standard: Wait for completion with timeout to prevent hangs
+        constexpr uint64_t kUploadTimeoutNs = 5ull * 1000 * 1000 * 1000;
+        VkResult waitResult = vkWaitForFences(device_, 1, &pendingUploads_.front().fence, VK_TRUE, kUploadTimeoutNs);
+        if (waitResult == VK_TIMEOUT) {
+            Logger::Error("Upload did not complete within 5s; treating the device as lost");
+            deviceLost_ = true;
+        } else if (waitResult == VK_ERROR_DEVICE_LOST) {
+            deviceLost_ = true;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < pendingUploads_.size(); ++i) {
+        PendingUpload& upload = pendingUploads_[i];
+        // A lost device never signals; everything it held is considered complete
+        const VkResult status = deviceLost_ ? VK_SUCCESS : vkGetFenceStatus(device_, upload.fence);
+        if (status == VK_ERROR_DEVICE_LOST) {
+            deviceLost_ = true;
+        }
+        if (status == VK_SUCCESS || deviceLost_) {
+            vkFreeCommandBuffers(device_, upload.pool, 1, &upload.cmd);
+            vkResetFences(device_, 1, &upload.fence);
+            uploadFencePool_.push_back(upload.fence);
+        } else {
+            pendingUploads_[kept++] = upload;
+        }
+    }
+    pendingUploads_.resize(kept);
+
+    // Serials are submitted in order: everything before the oldest pending one is done
+    const uint64_t completedSerial = pendingUploads_.empty()
+        ? nextUploadSerial_ - 1
+        : pendingUploads_.front().serial - 1;
+    stagingRing_.Reclaim(completedSerial);
+}
+
+void VulkanRenderer::waitForUploads() {
+    while (!pendingUploads_.empty()) {
+        retireUploads(true);
+    }
+}
+
+bool VulkanRenderer::isUploadComplete(uint64_t serial) const {
+    // Pending uploads stay in serial order, so anything older than the front has retired
+    return pendingUploads_.empty() || pendingUploads_.front().serial > serial;
+}
+
+void VulkanRenderer::destroyUploadResources() {
+    waitForUploads();
+    releaseHostImports(true);
+    for (VkFence fence : uploadFencePool_) {
+        vkDestroyFence(device_, fence, nullptr);
+    }
+    uploadFencePool_.clear();
+    stagingRing_.Shutdown();
+}
+
+bool VulkanRenderer::ensureStagingRing() {
+    if (stagingRing_.IsInitialized()) return true;
+    if (!device_ || !physicalDevice_) return false;
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+    // Copies need offsets aligned to the texel size (≤ 8 bytes here) and 4 bytes
+    stagingAlignment_ = std::max<VkDeviceSize>(16, props.limits.optimalBufferCopyOffsetAlignment);
+
+    if (!stagingRing_.Initialize(device_, physicalDevice_, kStagingBlockSize, kMaxStagingBlocks)) {
+        Logger::Error("Failed to create the staging ring");
+        return false;
+    }
+    return true;
+}
+
+bool VulkanRenderer::uploadImageRegion(VkImage image, VkImageLayout& layout, VkImageLayout finalLayout,
+                                       const uint8_t* src, VkDeviceSize srcRowPitch, uint32_t pixelSize,
+                                       uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    // NASA Standard: Validate all input parameters
+    if (image == VK_NULL_HANDLE || src == nullptr || width == 0 || height == 0 || pixelSize == 0) {
+        return false;
+    }
+    if (deviceLost_ || !ensureStagingRing()) {
+        return false;
+    }
+
+    const VkDeviceSize rowBytes = static_cast<VkDeviceSize>(width) * pixelSize;
+    if (rowBytes > stagingRing_.GetBlockSize() || srcRowPitch < rowBytes) {
+        return false;
+    }
+    // Large images stream through the ring in row bands no bigger than one block
+    const uint32_t bandRows = static_cast<uint32_t>(
+        std::min<VkDeviceSize>(height, stagingRing_.GetBlockSize() / rowBytes));
+
+    Trace::Scope uploadTrace(Trace::Stage::Upload);
+    VkCommandBuffer cmd = beginSingleTimeCommands();
+    if (cmd == VK_NULL_HANDLE) {
+        return false;
+    }
+    transitionImageLayout(cmd, image, layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+    for (uint32_t row = 0; row < height; ) {
+        const uint32_t rows = std::min(bandRows, height - row);
+        const VkDeviceSize bandBytes = rowBytes * rows;
+
+        StagingRing::Allocation staging{};
+        if (!stagingRing_.Allocate(bandBytes, stagingAlignment_, staging)) {
+            // Every block is in flight: submit what is recorded and drain before continuing
+            endSingleTimeCommands(cmd);
+            waitForUploads();
+            cmd = VK_NULL_HANDLE;
+            if (!deviceLost_ && stagingRing_.Allocate(bandBytes, stagingAlignment_, staging)) {
+                cmd = beginSingleTimeCommands();
+            }
+            if (cmd == VK_NULL_HANDLE) {
+                Logger::Error("Staging allocation of %llu bytes failed", static_cast<unsigned long long>(bandBytes));
+                return false;
+            }
+        }
+
+        const uint8_t* srcBand = src + static_cast<size_t>(row) * static_cast<size_t>(srcRowPitch);
+        Trace::Scope copyTrace(Trace::Stage::StagingCopy);
+        if (srcRowPitch == rowBytes) {
+            std::memcpy(staging.mapped, srcBand, static_cast<size_t>(bandBytes));
+        } else {
+            for (uint32_t r = 0; r < rows; ++r) {
+                std::memcpy(staging.mapped + static_cast<size_t>(r) * static_cast<size_t>(rowBytes),
+                            srcBand + static_cast<size_t>(r) * static_cast<size_t>(srcRowPitch),
+                            static_cast<size_t>(rowBytes));
+            }
+        }
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = staging.offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { static_cast<int32_t>(x), static_cast<int32_t>(y + row), 0 };
+        region.imageExtent = { width, rows, 1 };
+        vkCmdCopyBufferToImage(cmd, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        row += rows;
+    }
+
+    transitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout);
+    endSingleTimeCommands(cmd);
+    if (deviceLost_) {
+        return false;
+    }
+    layout = finalLayout;
+    return true;
+}
+
+void VulkanRenderer::pumpIncomingTexture() {
+    IncomingTexture& in = incoming_;
+    if (in.image == VK_NULL_HANDLE || in.nextRow >= in.height || deviceLost_ || !ensureStagingRing()) {
         return;
     }
 
-    // NASA Standard: Wait for completion with timeout to prevent hangs
-    VkResult waitResult = vkQueueWaitIdle(graphicsQueue_);
-    if (waitResult == VK_ERROR_DEVICE_LOST) {
-        deviceLost_ = true;
+    // A reduced texture reads a block of source rows behind each row it stages; the
+    // frame budget counts what is read
+    const VkDeviceSize rowBytes = static_cast<VkDeviceSize>(in.width) * in.pixelSize;
+    const VkDeviceSize readBytes = rowBytes << (2 * in.scaleShift);
+    const uint32_t bandRows = static_cast<uint32_t>(
+        std::min<VkDeviceSize>(in.height, std::max<VkDeviceSize>(1, kIncomingBytesPerFrame / readBytes)));
+
+    Trace::Scope uploadTrace(Trace::Stage::Upload);
+    VkCommandBuffer cmd = beginSingleTimeCommands(true);
+    if (cmd == VK_NULL_HANDLE) {
+        return;
+    }
+    if (in.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+        transitionImageLayout(cmd, in.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        in.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    }
+
+    // Stage at most one frame's budget and never wait for ring space; the rest
+    // continues next frame so presentation is not held up by a large image
+    VkDeviceSize budget = kIncomingBytesPerFrame;
+    while (in.nextRow < in.height && budget >= readBytes) {
+        const uint32_t rows = std::min({ bandRows, in.height - in.nextRow,
+                                         static_cast<uint32_t>(budget / readBytes) });
+        const VkDeviceSize bandBytes = rowBytes * rows;
+
+        StagingRing::Allocation staging{};
+        if (!stagingRing_.Allocate(bandBytes, stagingAlignment_, staging)) {
+            break;
+        }
+        Trace::Scope copyTrace(Trace::Stage::StagingCopy);
+        if (in.scaleShift > 0) {
+            reduceIncomingRows(in.nextRow, rows, staging.mapped);
+        } else if (in.rows != nullptr) {
+            // Converted straight into staging; rows the source cannot produce show as transparent
+            if (!in.rows->ReadRows(in.nextRow, rows, staging.mapped)) {
+                std::memset(staging.mapped, 0, static_cast<size_t>(bandBytes));
+            }
+        } else {
+            std::memcpy(staging.mapped, in.src + static_cast<size_t>(in.nextRow) * static_cast<size_t>(rowBytes),
+                        static_cast<size_t>(bandBytes));
+        }
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = staging.offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { 0, static_cast<int32_t>(in.nextRow), 0 };
+        region.imageExtent = { in.width, rows, 1 };
+        vkCmdCopyBufferToImage(cmd, staging.buffer, in.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        in.nextRow += rows;
+        budget -= readBytes * rows;
     }
 
-    vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
+    const bool finished = in.nextRow >= in.height;
+    if (finished) {
+        finishIncomingTexture(cmd);
+    }
+
+    const uint64_t serial = endSingleTimeCommands(cmd, true);
+    if (finished && serial != 0) {
+        in.lastSerial = serial;
+        in.src = nullptr; // Everything is staged; the caller's pixels are no longer read
+        in.rows = nullptr;
+    }
+}
+
+namespace {
+    float srgbToLinear(uint8_t value) {
+        static const auto table = [] {
+            std::array<float, 256> t{};
+            for (size_t i = 0; i < t.size(); ++i) {
+                const float c = static_cast<float>(i) / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table[value];
+    }
+
+    uint8_t linearToSrgb(float value) {
+        const float c = std::clamp(value, 0.0f, 1.0f);
+        const float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(encoded * 255.0f + 0.5f);
+    }
+
+    // One row of 'width' RGBA texels, each the mean of a factor x factor block of the
+    // 'factor' rows at 'src'. sRGB texels are averaged as linear light, as the mip blits do.
+    void downsampleBlockRow(const uint8_t* src, size_t srcPitch, uint32_t width, uint32_t factor, bool isHdr,
+                            uint8_t* dst, std::vector<float>& scratch) {
+        const size_t channels = static_cast<size_t>(width) * 4;
+        const size_t srcChannels = channels * factor;
+        scratch.assign(channels + (isHdr ? srcChannels : 0), 0.0f);
+        float* sum = scratch.data();
+        float* row = sum + channels;
+        for (uint32_t r = 0; r < factor; ++r) {
+            const uint8_t* line = src + r * srcPitch;
+            if (isHdr) {
+                PixelConvert::HalfToFloat(reinterpret_cast<const uint16_t*>(line), row, srcChannels);
+                for (size_t i = 0; i < srcChannels; ++i) {
+                    sum[(i / (4 * factor)) * 4 + (i & 3)] += row[i];
+                }
+            } else {
+                for (size_t i = 0; i < srcChannels; ++i) {
+                    const size_t c = i & 3;
+                    sum[(i / (4 * factor)) * 4 + c] += c == 3 ? line[i] / 255.0f : srgbToLinear(line[i]);
+                }
+            }
+        }
+
+        const float scale = 1.0f / static_cast<float>(factor * factor);
+        for (size_t i = 0; i < channels; ++i) {
+            sum[i] *= scale;
+        }
+        if (isHdr) {
+            PixelConvert::FloatToHalf(sum, reinterpret_cast<uint16_t*>(dst), channels);
+        } else {
+            for (size_t i = 0; i < channels; ++i) {
+                dst[i] = (i & 3) == 3 ? static_cast<uint8_t>(std::clamp(sum[i], 0.0f, 1.0f) * 255.0f + 0.5f)
+                                      : linearToSrgb(sum[i]);
+            }
+        }
+    }
+}
+
+void VulkanRenderer::reduceIncomingRows(uint32_t row, uint32_t count, uint8_t* dst) {
+    IncomingTexture& in = incoming_;
+    const uint32_t factor = 1u << in.scaleShift;
+    const size_t srcPitch = static_cast<size_t>(in.sourceWidth) * in.pixelSize;
+    const size_t rowBytes = static_cast<size_t>(in.width) * in.pixelSize;
+    for (uint32_t i = 0; i < count; ++i) {
+        // The texture's size rounds down, so every block lies inside the source
+        const uint32_t srcY = (row + i) << in.scaleShift;
+        const uint8_t* block = nullptr;
+        if (in.rows != nullptr) {
+            reduceRows_.resize(srcPitch * factor);
+            if (!in.rows->ReadRows(srcY, factor, reduceRows_.data())) {
+                std::memset(reduceRows_.data(), 0, reduceRows_.size());
+            }
+            block = reduceRows_.data();
+        } else {
+            block = in.src + static_cast<size_t>(srcY) * srcPitch;
+        }
+        downsampleBlockRow(block, srcPitch, in.width, factor, in.isHdr, dst + i * rowBytes, reduceScratch_);
+    }
+}
+
+void VulkanRenderer::finishIncomingTexture(VkCommandBuffer cmd) {
+    IncomingTexture& in = incoming_;
+    if (hasDedicatedTransferQueue()) {
+        // Release half of the queue family ownership transfer; Render records the acquire
+        VkImageMemoryBarrier release{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        release.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        release.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        release.srcQueueFamilyIndex = transferQueueFamily_;
+        release.dstQueueFamilyIndex = graphicsQueueFamily_;
+        release.image = in.image;
+        release.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        release.subresourceRange.levelCount = 1;
+        release.subresourceRange.layerCount = 1;
+        release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        release.dstAccessMask = 0;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &release);
+    } else {
+        transitionImageLayout(cmd, in.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    }
+    in.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
+bool VulkanRenderer::importIncomingRows() {
+    IncomingTexture& in = incoming_;
+    if (!hostMemoryImport_ || in.rows == nullptr || in.image == VK_NULL_HANDLE || in.nextRow != 0 ||
+        in.scaleShift != 0) {
+        return false;
+    }
+    size_t rowPitch = 0;
+    const uint8_t* texels = in.rows->GetDirectRows(rowPitch);
+    const VkDeviceSize rowBytes = static_cast<VkDeviceSize>(in.width) * in.pixelSize;
+    if (texels == nullptr || rowPitch < rowBytes || rowPitch % in.pixelSize != 0) {
+        return false;
+    }
+
+    // Import whole aligned blocks around the texels; the copy starts at their offset,
+    // which must be a multiple of the texel size
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(texels);
+    const uintptr_t base = begin & ~static_cast<uintptr_t>(hostPointerAlignment_ - 1);
+    const VkDeviceSize offset = begin - base;
+    if (offset % in.pixelSize != 0) {
+        return false;
+    }
+    const VkDeviceSize span = offset + static_cast<VkDeviceSize>(rowPitch) * (in.height - 1) + rowBytes;
+    const VkDeviceSize size = (span + hostPointerAlignment_ - 1) & ~(hostPointerAlignment_ - 1);
+    void* hostPointer = reinterpret_cast<void*>(base);
+
+    VkMemoryHostPointerPropertiesEXT pointerProps{ VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+    if (getMemoryHostPointerProperties_(device_, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+                                        hostPointer, &pointerProps) != VK_SUCCESS ||
+        pointerProps.memoryTypeBits == 0) {
+        return false;
+    }
+
+    VkExternalMemoryBufferCreateInfo external{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+    external.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    VkBufferCreateInfo bci{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bci.pNext = &external;
+    bci.size = size;
+    bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    HostImport import;
+    if (vkCreateBuffer(device_, &bci, nullptr, &import.buffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkMemoryRequirements reqs{};
+    vkGetBufferMemoryRequirements(device_, import.buffer, &reqs);
+    const uint32_t typeBits = reqs.memoryTypeBits & pointerProps.memoryTypeBits;
+    uint32_t memoryType = findMemoryType(typeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    if (memoryType == UINT32_MAX) {
+        memoryType = findMemoryType(typeBits, 0);
+    }
+    VkImportMemoryHostPointerInfoEXT importInfo{ VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+    importInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+    importInfo.pHostPointer = hostPointer;
+    VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    ai.pNext = &importInfo;
+    ai.allocationSize = size;
+    ai.memoryTypeIndex = memoryType;
+    if (memoryType == UINT32_MAX || reqs.size > size ||
+        vkAllocateMemory(device_, &ai, nullptr, &import.memory) != VK_SUCCESS ||
+        vkBindBufferMemory(device_, import.buffer, import.memory, 0) != VK_SUCCESS) {
+        if (import.memory != VK_NULL_HANDLE) vkFreeMemory(device_, import.memory, nullptr);
+        vkDestroyBuffer(device_, import.buffer, nullptr);
+        return false;
+    }
+
+    VkCommandBuffer cmd = beginSingleTimeCommands(true);
+    if (cmd == VK_NULL_HANDLE) {
+        vkFreeMemory(device_, import.memory, nullptr);
+        vkDestroyBuffer(device_, import.buffer, nullptr);
+        return false;
+    }
+    transitionImageLayout(cmd, in.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    in.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+    // One copy of the whole image, rows 'rowPitch' apart in the file
+    VkBufferImageCopy region{};
+    region.bufferOffset = offset;
+    region.bufferRowLength = static_cast<uint32_t>(rowPitch / in.pixelSize);
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { in.width, in.height, 1 };
+    vkCmdCopyBufferToImage(cmd, import.buffer, in.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    finishIncomingTexture(cmd);
+
+    import.serial = endSingleTimeCommands(cmd, true);
+    if (import.serial == 0) {
+        // Nothing was submitted; the image is rewritten through staging from the start
+        vkFreeMemory(device_, import.memory, nullptr);
+        vkDestroyBuffer(device_, import.buffer, nullptr);
+        in.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        return false;
+    }
+    hostImports_.push_back(import);
+    in.nextRow = in.height;
+    in.lastSerial = import.serial;
+    in.rows = nullptr;
+    Logger::Info("Imported %llu KB of mapped texels for a %ux%u upload without staging",
+                 static_cast<unsigned long long>(size >> 10), in.width, in.height);
+    return true;
+}
+
+void VulkanRenderer::releaseHostImports(bool force) {
+    if (hostImports_.empty()) return;
+    if (force) {
+        // The memory aliases the caller's mapping, which may be unmapped right after this
+        waitForUploads();
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < hostImports_.size(); ++i) {
+        HostImport& import = hostImports_[i];
+        if (force || isUploadComplete(import.serial)) {
+            vkDestroyBuffer(device_, import.buffer, nullptr);
+            vkFreeMemory(device_, import.memory, nullptr);
+        } else {
+            hostImports_[kept++] = import;
+        }
+    }
+    hostImports_.resize(kept);
+}
+
+void VulkanRenderer::adoptIncomingTexture(VkCommandBuffer cmd) {
+    IncomingTexture& in = incoming_;
+    if (in.image == VK_NULL_HANDLE || in.lastSerial == 0 || !isUploadComplete(in.lastSerial)) {
+        return;
+    }
+
+    if (hasDedicatedTransferQueue()) {
+        // Acquire half of the ownership transfer; the host has already seen the upload fence signal
+        VkImageMemoryBarrier acquire{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        acquire.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        acquire.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        acquire.srcQueueFamilyIndex = transferQueueFamily_;
+        acquire.dstQueueFamilyIndex = graphicsQueueFamily_;
+        acquire.image = in.image;
+        acquire.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        acquire.subresourceRange.levelCount = 1;
+        acquire.subresourceRange.layerCount = 1;
+        acquire.srcAccessMask = 0;
+        acquire.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &acquire);
+    }
+
+    // Blits need a graphics queue, so the chain is built here rather than on the transfer queue
+    if (in.mipLevels > 1) {
+        recordMipChain(cmd, in.image, in.width, in.height, in.mipLevels);
+    }
+
+    // Every level is now in TRANSFER_SRC; make the whole chain sampleable
+    VkImageMemoryBarrier toShader{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    toShader.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toShader.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    toShader.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toShader.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toShader.image = in.image;
+    toShader.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    toShader.subresourceRange.levelCount = in.mipLevels;
+    toShader.subresourceRange.layerCount = 1;
+    toShader.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+    toShader.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &toShader);
+
+    // Frames already submitted may still read the outgoing texture
+    if (textureImage_ != VK_NULL_HANDLE) {
+        retireTexture(textureImage_, textureMemory_, textureView_, 0, frameSerial_);
+    }
+    textureImage_ = in.image;
+    textureMemory_ = in.memory;
+    textureView_ = in.view;
+    ++textureGeneration_;
+    adoptPendingColorLut();
+    textureFormat_ = in.format;
+    textureLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    textureWidth_ = in.width;
+    textureHeight_ = in.height;
+    textureMipLevels_ = in.mipLevels;
+    textureScaleShift_ = in.scaleShift;
+    textureIsHdr_ = in.isHdr;
+    textureIsSparse_ = false;
+    incoming_ = IncomingTexture{};
+    // Scratch for reduced uploads is only needed while one streams
+    reduceRows_ = std::vector<uint8_t>();
+    reduceScratch_ = std::vector<float>();
+}
+
+void VulkanRenderer::CancelPendingUpload() {
+    // A sparse texture keeps what is resident but stops reading the caller's pixels
+    sparse_.src = nullptr;
+    sparse_.source = nullptr;
+    // Imported rows belong to the caller too
+    releaseHostImports(true);
+    if (incoming_.image == VK_NULL_HANDLE) return;
+    // Submitted bands may still be writing it
+    retireTexture(incoming_.image, incoming_.memory, incoming_.view, nextUploadSerial_ - 1, 0);
+    incoming_ = IncomingTexture{};
+}
+
+void VulkanRenderer::retireTexture(VkImage image, VkDeviceMemory memory, VkImageView view, uint64_t uploadSerial, uint64_t frameSerial) {
+    retiredTextures_.push_back(RetiredTexture{ image, memory, view, uploadSerial, frameSerial });
+}
+
+void VulkanRenderer::destroyRetiredTextures(bool force) {
+    size_t kept = 0;
+    for (size_t i = 0; i < retiredTextures_.size(); ++i) {
+        const RetiredTexture& retired = retiredTextures_[i];
+        if (force || (isUploadComplete(retired.uploadSerial) && completedFrameSerial_ >= retired.frameSerial)) {
+            if (retired.view != VK_NULL_HANDLE) vkDestroyImageView(device_, retired.view, nullptr);
+            if (retired.image != VK_NULL_HANDLE) vkDestroyImage(device_, retired.image, nullptr);
+            if (retired.memory != VK_NULL_HANDLE) vkFreeMemory(device_, retired.memory, nullptr);
+        } else {
+            retiredTextures_[kept++] = retired;
+        }
+    }
+    retiredTextures_.resize(kept);
+}
+
+bool VulkanRenderer::createColorLut(const uint16_t* rgbaHalf, uint32_t edgeLength, ColorLutTexture& lut) {
+    lut = ColorLutTexture{};
+    // NASA Standard: Validate device state before operations
+    if (!device_ || deviceLost_ || edgeLength == 0 || !ensureStagingRing()) {
+        return false;
+    }
+
+    constexpr VkFormat kLutFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+    VkImageCreateInfo ii{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    ii.imageType = VK_IMAGE_TYPE_3D;
+    ii.extent = { edgeLength, edgeLength, edgeLength };
+    ii.mipLevels = 1;
+    ii.arrayLayers = 1;
+    ii.format = kLutFormat;
+    ii.tiling = VK_IMAGE_TILING_OPTIMAL;
+    ii.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    ii.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    ii.samples = VK_SAMPLE_COUNT_1_BIT;
+    ii.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateImage(device_, &ii, nullptr, &lut.image) != VK_SUCCESS) {
+        lut.image = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements req{};
+    vkGetImageMemoryRequirements(device_, lut.image, &req);
+    VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    ai.allocationSize = req.size;
+    ai.memoryTypeIndex = findMemoryType(req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    auto fail = [this, &lut]() {
+        retireColorLut(lut);
+        return false;
+    };
+    if (ai.memoryTypeIndex == UINT32_MAX || vkAllocateMemory(device_, &ai, nullptr, &lut.memory) != VK_SUCCESS) {
+        lut.memory = VK_NULL_HANDLE;
+        return fail();
+    }
+    if (vkBindImageMemory(device_, lut.image, lut.memory, 0) != VK_SUCCESS) {
+        return fail();
+    }
+
+    VkImageViewCreateInfo vi{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    vi.image = lut.image;
+    vi.viewType = VK_IMAGE_VIEW_TYPE_3D;
+    vi.format = kLutFormat;
+    vi.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    vi.subresourceRange.levelCount = 1;
+    vi.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(device_, &vi, nullptr, &lut.view) != VK_SUCCESS) {
+        lut.view = VK_NULL_HANDLE;
+        return fail();
+    }
+
+    const VkDeviceSize bytes = static_cast<VkDeviceSize>(edgeLength) * edgeLength * edgeLength * 4 * sizeof(uint16_t);
+    StagingRing::Allocation staging;
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(stagingAlignment_, 8);
+    if (!stagingRing_.Allocate(bytes, alignment, staging)) {
+        // Every block is in flight: drain and retry once
+        waitForUploads();
+        if (deviceLost_ || !stagingRing_.Allocate(bytes, alignment, staging)) {
+            return fail();
+        }
+    }
+    if (rgbaHalf != nullptr) {
+        std::memcpy(staging.mapped, rgbaHalf, static_cast<size_t>(bytes));
+    } else {
+        std::memset(staging.mapped, 0, static_cast<size_t>(bytes));
+    }
+
+    VkCommandBuffer cmd = beginSingleTimeCommands();
+    if (cmd == VK_NULL_HANDLE) {
+        return fail();
+    }
+    transitionImageLayout(cmd, lut.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    VkBufferImageCopy copy{};
+    copy.bufferOffset = staging.offset;
+    copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copy.imageSubresource.layerCount = 1;
+    copy.imageExtent = { edgeLength, edgeLength, edgeLength };
+    vkCmdCopyBufferToImage(cmd, staging.buffer, lut.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+    transitionImageLayout(cmd, lut.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    lut.uploadSerial = endSingleTimeCommands(cmd);
+    if (lut.uploadSerial == 0) {
+        return fail();
+    }
+    lut.edgeLength = edgeLength;
+    return true;
+}
+
+bool VulkanRenderer::ensureLutPlaceholder() {
+    if (placeholderLut_.view != VK_NULL_HANDLE) {
+        return true;
+    }
+    // Never sampled (mode 0 skips the lookup) but binding 1 must always hold a view
+    return createColorLut(nullptr, 1, placeholderLut_);
+}
+
+void VulkanRenderer::adoptPendingColorLut() {
+    if (!colorLutPending_) return;
+    colorLutPending_ = false;
+    // Frames already submitted may still sample the outgoing LUT
+    retireColorLut(colorLut_);
+    colorLut_ = pendingColorLut_;
+    pendingColorLut_ = ColorLutTexture{};
+    ++colorLutGeneration_;
+}
+
+void VulkanRenderer::retireColorLut(ColorLutTexture& lut) {
+    if (lut.image != VK_NULL_HANDLE || lut.memory != VK_NULL_HANDLE || lut.view != VK_NULL_HANDLE) {
+        retireTexture(lut.image, lut.memory, lut.view, lut.uploadSerial, frameSerial_);
+    }
+    lut = ColorLutTexture{};
+}
+
+void VulkanRenderer::destroyColorLuts() {
+    retireColorLut(colorLut_);
+    retireColorLut(pendingColorLut_);
+    retireColorLut(placeholderLut_);
+    colorLutPending_ = false;
+    ++colorLutGeneration_;
+    if (device_ != VK_NULL_HANDLE) {
+        destroyRetiredTextures(true);
+    }
+}
+
+VulkanRenderer::ImageColorPush VulkanRenderer::computeColorPush() const {
+    ImageColorPush push{};
+    push.exposureScale = exposureScale_;
+    push.gammaExponent = gammaExponent_;
+    if (colorLut_.view != VK_NULL_HANDLE && colorLut_.edgeLength > 1) {
+        const float n = static_cast<float>(colorLut_.edgeLength);
+        push.mode = 1;
+        push.shaperMin = colorLut_.log2Min;
+        push.shaperMax = colorLut_.log2Max;
+        push.lutScale = (n - 1.0f) / n;
+        push.lutOffset = 0.5f / n;
+        // The LUT encodes for the display; an sRGB target would encode a second time
+        push.linearizeOutput = (swapchainFormat_ == VK_FORMAT_B8G8R8A8_SRGB ||
+                                swapchainFormat_ == VK_FORMAT_R8G8B8A8_SRGB) ? 1u : 0u;
+    }
+    return push;
 }
 
 bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
@@ -389,6 +1445,9 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
     if (width == 0 || height == 0) {
         return false; // Cannot create swapchain with zero dimensions on Win32
     }
+    if (headless_) {
+        return createOffscreenTargets(width, height) && createFrameResources();
+    }
 
     // Query formats
     uint32_t formatCount = 0;
@@ -410,6 +1469,12 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
     swapchainFormat_ = chosen.format;
     swapchainColorSpace_ = chosen.colorSpace;
 
+    // The render pass and pipeline are tied to the swapchain format
+    if (renderPass_ != VK_NULL_HANDLE && renderPassFormat_ != swapchainFormat_) {
+        vkDeviceWaitIdle(device_);
+        destroyImagePipeline();
+    }
+
     VkSurfaceCapabilitiesKHR caps{};
     VkResult capResult = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice_, surface_, &caps);
     if (capResult != VK_SUCCESS) {
@@ -438,7 +1503,29 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
         return false; // Extent violates surface capabilities
     }
 
-    uint32_t imageCount = std::clamp(2u, caps.minImageCount, (caps.maxImageCount ? caps.maxImageCount : 3u));
+    // FIFO is always offered. Low latency takes MAILBOX (never tears, the newest frame
+    // replaces a queued one) over FIFO_RELAXED (tears only when a frame misses vsync).
+    presentMode_ = VK_PRESENT_MODE_FIFO_KHR;
+    if (lowLatency_) {
+        uint32_t modeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice_, surface_, &modeCount, nullptr);
+        std::vector<VkPresentModeKHR> modes(modeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice_, surface_, &modeCount, modes.data());
+        for (VkPresentModeKHR preferred : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR }) {
+            if (std::find(modes.begin(), modes.end(), preferred) != modes.end()) {
+                presentMode_ = preferred;
+                break;
+            }
+        }
+    }
+    presentModeDirty_ = false;
+    // The old swapchain's present ids never complete on this one
+    presentIdShown_ = presentId_;
+    inputPresentedNs_ = 0;
+
+    // MAILBOX needs a third image to have one to replace while another is shown
+    const uint32_t wantedImages = presentMode_ == VK_PRESENT_MODE_MAILBOX_KHR ? 3u : 2u;
+    uint32_t imageCount = std::clamp(wantedImages, caps.minImageCount, (caps.maxImageCount ? caps.maxImageCount : 3u));
 
     VkSwapchainCreateInfoKHR sci{};
     sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -459,10 +1546,12 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
     }
     sci.preTransform = caps.currentTransform;
     sci.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    sci.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    sci.presentMode = presentMode_;
     sci.clipped = VK_TRUE;
 
     if (vkCreateSwapchainKHR(device_, &sci, nullptr, &swapchain_) != VK_SUCCESS) return false;
+    Logger::Info("Swapchain %ux%u, %u images, present mode %s%s", swapchainExtent_.width, swapchainExtent_.height,
+                 imageCount, GetPresentModeName(), presentWait_ ? " with present wait" : "");
 
     uint32_t count = 0;
     vkGetSwapchainImagesKHR(device_, swapchain_, &count, nullptr);
@@ -483,6 +1572,59 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
         if (vkCreateImageView(device_, &vi, nullptr, &swapchainImageViews_[i]) != VK_SUCCESS) return false;
     }
 
+    return createFrameResources();
+}
+
+bool VulkanRenderer::createOffscreenTargets(uint32_t width, uint32_t height) {
+    // Same format a window would most likely get, so the shaders do the same work
+    swapchainFormat_ = VK_FORMAT_B8G8R8A8_SRGB;
+    swapchainColorSpace_ = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    swapchainExtent_ = { width, height };
+
+    // One target per frame slot: a slot's fence guards its target the way acquire would
+    const uint32_t count = MAX_FRAMES_IN_FLIGHT;
+    swapchainImages_.assign(count, VK_NULL_HANDLE);
+    offscreenMemory_.assign(count, VK_NULL_HANDLE);
+    swapchainImageViews_.assign(count, VK_NULL_HANDLE);
+    for (uint32_t i = 0; i < count; ++i) {
+        VkImageCreateInfo ii{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+        ii.imageType = VK_IMAGE_TYPE_2D;
+        ii.extent = { width, height, 1 };
+        ii.mipLevels = 1;
+        ii.arrayLayers = 1;
+        ii.format = swapchainFormat_;
+        ii.tiling = VK_IMAGE_TILING_OPTIMAL;
+        ii.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        ii.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        ii.samples = VK_SAMPLE_COUNT_1_BIT;
+        ii.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateImage(device_, &ii, nullptr, &swapchainImages_[i]) != VK_SUCCESS) {
+            swapchainImages_[i] = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryRequirements req{};
+        vkGetImageMemoryRequirements(device_, swapchainImages_[i], &req);
+        VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        ai.allocationSize = req.size;
+        ai.memoryTypeIndex = findMemoryType(req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        // NASA Standard: Validate memory type index before allocation
+        if (ai.memoryTypeIndex == UINT32_MAX ||
+            vkAllocateMemory(device_, &ai, nullptr, &offscreenMemory_[i]) != VK_SUCCESS) {
+            offscreenMemory_[i] = VK_NULL_HANDLE;
+            return false;
+        }
+        vkBindImageMemory(device_, swapchainImages_[i], offscreenMemory_[i], 0);
+        if (!createImageView(swapchainImages_[i], swapchainFormat_, 1, swapchainImageViews_[i])) return false;
+    }
+    return true;
+}
+
+bool VulkanRenderer::createFrameResources() {
+    const uint32_t count = static_cast<uint32_t>(swapchainImageViews_.size());
+    if (renderPass_ == VK_NULL_HANDLE && !createImagePipeline()) return false;
+    if (!createFramebuffers()) return false;
+
     // Command buffers per image
     if (commandBuffers_.size() != count) {
         if (commandPool_ == VK_NULL_HANDLE) { if (!createCommandPool()) return false; }
@@ -501,6 +1643,10 @@ bool VulkanRenderer::createSwapchain(uint32_t width, uint32_t height) {
 }
 
 void VulkanRenderer::destroySwapchain() {
+    for (auto fb : framebuffers_) {
+        if (fb) vkDestroyFramebuffer(device_, fb, nullptr);
+    }
+    framebuffers_.clear();
     for (auto v : swapchainImageViews_) {
         if (v) vkDestroyImageView(device_, v, nullptr);
     }
@@ -509,6 +1655,458 @@ void VulkanRenderer::destroySwapchain() {
         vkDestroySwapchainKHR(device_, swapchain_, nullptr);
         swapchain_ = VK_NULL_HANDLE;
     }
+    // Offscreen targets are ours to free; swapchain images went with the swapchain
+    if (!offscreenMemory_.empty()) {
+        for (auto image : swapchainImages_) {
+            if (image) vkDestroyImage(device_, image, nullptr);
+        }
+        for (auto memory : offscreenMemory_) {
+            if (memory) vkFreeMemory(device_, memory, nullptr);
+        }
+        offscreenMemory_.clear();
+        swapchainImages_.clear();
+    }
+}
+
+bool VulkanRenderer::createFramebuffers() {
+    // NASA Standard: Validate state before operations
+    if (renderPass_ == VK_NULL_HANDLE || swapchainImageViews_.empty()) {
+        return false;
+    }
+
+    framebuffers_.assign(swapchainImageViews_.size(), VK_NULL_HANDLE);
+    for (size_t i = 0; i < swapchainImageViews_.size(); ++i) {
+        VkFramebufferCreateInfo fci{ VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
+        fci.renderPass = renderPass_;
+        fci.attachmentCount = 1;
+        fci.pAttachments = &swapchainImageViews_[i];
+        fci.width = swapchainExtent_.width;
+        fci.height = swapchainExtent_.height;
+        fci.layers = 1;
+        if (vkCreateFramebuffer(device_, &fci, nullptr, &framebuffers_[i]) != VK_SUCCESS) {
+            framebuffers_[i] = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+    return true;
+}
+
+VkShaderModule VulkanRenderer::createShaderModule(const uint32_t* code, size_t sizeBytes) {
+    VkShaderModuleCreateInfo smci{ VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    smci.codeSize = sizeBytes;
+    smci.pCode = code;
+    VkShaderModule module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(device_, &smci, nullptr, &module) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return module;
+}
+
+// %LOCALAPPDATA%\MinimalImageViewer\pipeline.cache, beside the thumbnail cache
+static std::wstring PipelineCachePath() {
+    std::wstring dir;
+    PWSTR appData = nullptr;
+    if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &appData)) && appData) {
+        dir = std::wstring(appData) + L"\\MinimalImageViewer";
+        CoTaskMemFree(appData);
+        const int rc = SHCreateDirectoryExW(nullptr, dir.c_str(), nullptr);
+        if (rc != ERROR_SUCCESS && rc != ERROR_ALREADY_EXISTS && rc != ERROR_FILE_EXISTS) {
+            dir.clear();
+        }
+    }
+    if (dir.empty()) {
+        dir = Logger::GetLogDirectory();
+    }
+    return (dir.empty() ? std::wstring(L".") : dir) + L"\\pipeline.cache";
+}
+
+void VulkanRenderer::loadPipelineCache() {
+    if (device_ == VK_NULL_HANDLE || pipelineCache_ != VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::vector<uint8_t> data;
+    HANDLE file = CreateFileW(PipelineCachePath().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size{};
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0 &&
+            static_cast<uint64_t>(size.QuadPart) <= kMaxPipelineCacheBytes) {
+            data.resize(static_cast<size_t>(size.QuadPart));
+            DWORD read = 0;
+            if (!ReadFile(file, data.data(), static_cast<DWORD>(data.size()), &read, nullptr) || read != data.size()) {
+                data.clear();
+            }
+        }
+        CloseHandle(file);
+    }
+
+    // Drivers should ignore another device's data, but not all do: only pass on a
+    // header naming this device and driver build
+    if (!data.empty()) {
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+        uint32_t header[4] = {};    // Header size, version, vendor ID, device ID; the UUID follows
+        bool matches = data.size() >= sizeof(header) + VK_UUID_SIZE;
+        if (matches) {
+            std::memcpy(header, data.data(), sizeof(header));
+            matches = header[0] >= sizeof(header) + VK_UUID_SIZE &&
+                      header[1] == static_cast<uint32_t>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+                      header[2] == props.vendorID && header[3] == props.deviceID &&
+                      std::memcmp(data.data() + sizeof(header), props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+        if (!matches) {
+            Logger::Info("Pipeline cache was written for another device or driver; starting a new one");
+            data.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo info{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    info.initialDataSize = data.size();
+    info.pInitialData = data.empty() ? nullptr : data.data();
+    if (vkCreatePipelineCache(device_, &info, nullptr, &pipelineCache_) != VK_SUCCESS) {
+        // Pipelines are still created, only compiled from scratch
+        pipelineCache_ = VK_NULL_HANDLE;
+        Logger::Warn("vkCreatePipelineCache failed; pipelines compile without a cache");
+        return;
+    }
+    pipelineCacheSavedBytes_ = data.size();
+    if (!data.empty()) {
+        Logger::Info("Pipeline cache: %zu bytes loaded", data.size());
+    }
+}
+
+void VulkanRenderer::savePipelineCache() {
+    if (pipelineCache_ == VK_NULL_HANDLE) {
+        return;
+    }
+    // Nothing new compiled: the data is what was loaded or last saved
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &size, nullptr) != VK_SUCCESS || size == 0 ||
+        size == pipelineCacheSavedBytes_ || size > kMaxPipelineCacheBytes) {
+        return;
+    }
+    std::vector<uint8_t> data(size);
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &size, data.data()) != VK_SUCCESS) {
+        return;
+    }
+
+    // Written aside and moved over the old file, so another viewer starting never reads half of it
+    const std::wstring path = PipelineCachePath();
+    const std::wstring temp = path + L".tmp";
+    HANDLE file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Logger::Warn("Pipeline cache not saved: cannot create %s (error %lu)", w2u(temp).c_str(), GetLastError());
+        return;
+    }
+    DWORD written = 0;
+    const bool complete = WriteFile(file, data.data(), static_cast<DWORD>(size), &written, nullptr) && written == size;
+    CloseHandle(file);
+    if (!complete || !MoveFileExW(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        Logger::Warn("Pipeline cache not saved: writing %s failed", w2u(path).c_str());
+        DeleteFileW(temp.c_str());
+        return;
+    }
+    pipelineCacheSavedBytes_ = size;
+    Logger::Info("Pipeline cache: %zu bytes saved", size);
+}
+
+bool VulkanRenderer::createImagePipeline() {
+    // NASA Standard: Validate device state before operations
+    if (!device_ || swapchainFormat_ == VK_FORMAT_UNDEFINED) {
+        return false;
+    }
+    // Startup loads it on the device thread; the other paths with their first pipelines
+    if (pipelineCache_ == VK_NULL_HANDLE) {
+        loadPipelineCache();
+    }
+
+    // Render pass: clear, draw the image, hand the swapchain image to present
+    VkAttachmentDescription color{};
+    color.format = swapchainFormat_;
+    color.samples = VK_SAMPLE_COUNT_1_BIT;
+    color.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    color.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    color.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    color.finalLayout = headless_ ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkAttachmentReference colorRef{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorRef;
+
+    // The layout transition must wait for the acquire semaphore, which is waited at this stage
+    VkSubpassDependency dependency{};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.srcAccessMask = 0;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkRenderPassCreateInfo rpci{ VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO };
+    rpci.attachmentCount = 1;
+    rpci.pAttachments = &color;
+    rpci.subpassCount = 1;
+    rpci.pSubpasses = &subpass;
+    rpci.dependencyCount = 1;
+    rpci.pDependencies = &dependency;
+    if (vkCreateRenderPass(device_, &rpci, nullptr, &renderPass_) != VK_SUCCESS) {
+        renderPass_ = VK_NULL_HANDLE;
+        return false;
+    }
+    renderPassFormat_ = swapchainFormat_;
+
+    // Trilinear: levels come from the texture's mip chain
+    VkSamplerCreateInfo sci{ VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    sci.magFilter = VK_FILTER_LINEAR;
+    sci.minFilter = VK_FILTER_LINEAR;
+    sci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    sci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sci.minLod = 0.0f;
+    sci.maxLod = VK_LOD_CLAMP_NONE;
+    if (vkCreateSampler(device_, &sci, nullptr, &textureSampler_) != VK_SUCCESS) {
+        textureSampler_ = VK_NULL_HANDLE;
+        destroyImagePipeline();
+        return false;
+    }
+
+    // Binding 0: the image (or overlay, or glyph atlas); binding 1: the display LUT
+    VkDescriptorSetLayoutBinding bindings[2]{};
+    for (uint32_t i = 0; i < 2; ++i) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[i].pImmutableSamplers = &textureSampler_;
+    }
+
+    VkDescriptorSetLayoutCreateInfo dslci{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    dslci.bindingCount = 2;
+    dslci.pBindings = bindings;
+    if (vkCreateDescriptorSetLayout(device_, &dslci, nullptr, &descriptorSetLayout_) != VK_SUCCESS) {
+        descriptorSetLayout_ = VK_NULL_HANDLE;
+        destroyImagePipeline();
+        return false;
+    }
+
+    // Per frame slot: the image and the cached instructional overlay; plus the glyph
+    // and thumbnail atlases
+    constexpr uint32_t kSetCount = MAX_FRAMES_IN_FLIGHT * 2 + 2;
+    VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kSetCount * 2 };
+    VkDescriptorPoolCreateInfo dpci{ VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    dpci.maxSets = kSetCount;
+    dpci.poolSizeCount = 1;
+    dpci.pPoolSizes = &poolSize;
+    if (vkCreateDescriptorPool(device_, &dpci, nullptr, &descriptorPool_) != VK_SUCCESS) {
+        descriptorPool_ = VK_NULL_HANDLE;
+        destroyImagePipeline();
+        return false;
+    }
+
+    VkDescriptorSetLayout setLayouts[kSetCount];
+    std::fill(std::begin(setLayouts), std::end(setLayouts), descriptorSetLayout_);
+    VkDescriptorSet sets[kSetCount] = {};
+    VkDescriptorSetAllocateInfo dsai{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    dsai.descriptorPool = descriptorPool_;
+    dsai.descriptorSetCount = kSetCount;
+    dsai.pSetLayouts = setLayouts;
+    if (vkAllocateDescriptorSets(device_, &dsai, sets) != VK_SUCCESS) {
+        destroyImagePipeline();
+        return false;
+    }
+    std::copy(sets, sets + MAX_FRAMES_IN_FLIGHT, frameDescriptorSets_);
+    std::copy(sets + MAX_FRAMES_IN_FLIGHT, sets + 2 * MAX_FRAMES_IN_FLIGHT, frameOverlaySets_);
+    glyphAtlasSet_ = sets[kSetCount - 2];
+    glyphAtlasSetWritten_ = false;
+    thumbnailAtlasSet_ = sets[kSetCount - 1];
+    thumbnailAtlasSetWritten_ = false;
+    std::fill(std::begin(frameDescriptorGenerations_), std::end(frameDescriptorGenerations_), 0);
+    std::fill(std::begin(frameOverlayGenerations_), std::end(frameOverlayGenerations_), 0);
+    std::fill(std::begin(frameLutGenerations_), std::end(frameLutGenerations_), 0);
+
+    // View transform for the vertex stage, then exposure/LUT/gamma for the fragment stage
+    VkPushConstantRange pushRanges[2]{};
+    pushRanges[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushRanges[0].offset = 0;
+    pushRanges[0].size = sizeof(ImagePushConstants);
+    pushRanges[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushRanges[1].offset = sizeof(ImagePushConstants);
+    pushRanges[1].size = sizeof(ImageColorPush);
+
+    VkPipelineLayoutCreateInfo plci{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    plci.setLayoutCount = 1;
+    plci.pSetLayouts = &descriptorSetLayout_;
+    plci.pushConstantRangeCount = 2;
+    plci.pPushConstantRanges = pushRanges;
+    if (vkCreatePipelineLayout(device_, &plci, nullptr, &pipelineLayout_) != VK_SUCCESS) {
+        pipelineLayout_ = VK_NULL_HANDLE;
+        destroyImagePipeline();
+        return false;
+    }
+
+    // Corners are generated in the vertex shader
+    VkPipelineVertexInputStateCreateInfo imageInput{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
+    imagePipeline_ = createQuadPipeline(kImageVertSpirv, sizeof(kImageVertSpirv),
+                                        kImageFragSpirv, sizeof(kImageFragSpirv), imageInput, false);
+    if (imagePipeline_ == VK_NULL_HANDLE) {
+        Logger::Error("Failed to create the image pipeline");
+        destroyImagePipeline();
+        return false;
+    }
+
+    // Text: one instance per glyph quad, read straight from TextRenderer::GlyphQuad
+    VkVertexInputBindingDescription glyphBinding{};
+    glyphBinding.binding = 0;
+    glyphBinding.stride = sizeof(TextRenderer::GlyphQuad);
+    glyphBinding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    VkVertexInputAttributeDescription glyphAttributes[3]{};
+    glyphAttributes[0] = { 0, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(TextRenderer::GlyphQuad, rect) };
+    glyphAttributes[1] = { 1, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(TextRenderer::GlyphQuad, uv) };
+    glyphAttributes[2] = { 2, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(TextRenderer::GlyphQuad, color) };
+    VkPipelineVertexInputStateCreateInfo textInput{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
+    textInput.vertexBindingDescriptionCount = 1;
+    textInput.pVertexBindingDescriptions = &glyphBinding;
+    textInput.vertexAttributeDescriptionCount = 3;
+    textInput.pVertexAttributeDescriptions = glyphAttributes;
+    textPipeline_ = createQuadPipeline(kTextVertSpirv, sizeof(kTextVertSpirv),
+                                       kTextFragSpirv, sizeof(kTextFragSpirv), textInput, true);
+    if (textPipeline_ == VK_NULL_HANDLE) {
+        // Images still display; only the text overlay is lost
+        Logger::Warn("Failed to create the text pipeline; overlays disabled");
+    }
+    // Thumbnails: the same instanced quads, sampling the thumbnail atlas in colour
+    thumbnailPipeline_ = createQuadPipeline(kTextVertSpirv, sizeof(kTextVertSpirv),
+                                            kThumbnailFragSpirv, sizeof(kThumbnailFragSpirv), textInput, true);
+    if (thumbnailPipeline_ == VK_NULL_HANDLE) {
+        Logger::Warn("Failed to create the thumbnail pipeline; thumbnail grid disabled");
+    }
+    savePipelineCache();
+    return true;
+}
+
+VkPipeline VulkanRenderer::createQuadPipeline(const uint32_t* vertCode, size_t vertSize,
+                                              const uint32_t* fragCode, size_t fragSize,
+                                              const VkPipelineVertexInputStateCreateInfo& vertexInput, bool alphaBlend) {
+    VkShaderModule vert = createShaderModule(vertCode, vertSize);
+    VkShaderModule frag = createShaderModule(fragCode, fragSize);
+    if (vert == VK_NULL_HANDLE || frag == VK_NULL_HANDLE) {
+        if (vert) vkDestroyShaderModule(device_, vert, nullptr);
+        if (frag) vkDestroyShaderModule(device_, frag, nullptr);
+        return VK_NULL_HANDLE;
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vert;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = frag;
+    stages[1].pName = "main";
+
+    // Every quad is a four-vertex strip
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{ VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+    VkPipelineViewportStateCreateInfo viewportState{ VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo raster{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
+    raster.polygonMode = VK_POLYGON_MODE_FILL;
+    raster.cullMode = VK_CULL_MODE_NONE;
+    raster.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{ VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                     VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    if (alphaBlend) {
+        // Straight alpha over whatever is already in the attachment
+        blendAttachment.blendEnable = VK_TRUE;
+        blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    }
+    VkPipelineColorBlendStateCreateInfo blend{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
+    blend.attachmentCount = 1;
+    blend.pAttachments = &blendAttachment;
+
+    // Viewport and scissor follow the swapchain, so resizes don't rebuild the pipeline
+    const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamicState{ VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo gpci{ VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
+    gpci.stageCount = 2;
+    gpci.pStages = stages;
+    gpci.pVertexInputState = &vertexInput;
+    gpci.pInputAssemblyState = &inputAssembly;
+    gpci.pViewportState = &viewportState;
+    gpci.pRasterizationState = &raster;
+    gpci.pMultisampleState = &multisample;
+    gpci.pColorBlendState = &blend;
+    gpci.pDynamicState = &dynamicState;
+    gpci.layout = pipelineLayout_;
+    gpci.renderPass = renderPass_;
+    gpci.subpass = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult pipelineResult = vkCreateGraphicsPipelines(device_, pipelineCache_, 1, &gpci, nullptr, &pipeline);
+    vkDestroyShaderModule(device_, vert, nullptr);
+    vkDestroyShaderModule(device_, frag, nullptr);
+    if (pipelineResult != VK_SUCCESS) {
+        Logger::Error("vkCreateGraphicsPipelines failed (VkResult %d)", static_cast<int>(pipelineResult));
+        return VK_NULL_HANDLE;
+    }
+    return pipeline;
+}
+
+void VulkanRenderer::destroyImagePipeline() {
+    if (!device_) return;
+    if (imagePipeline_) vkDestroyPipeline(device_, imagePipeline_, nullptr);
+    if (textPipeline_) vkDestroyPipeline(device_, textPipeline_, nullptr);
+    if (thumbnailPipeline_) vkDestroyPipeline(device_, thumbnailPipeline_, nullptr);
+    if (pipelineLayout_) vkDestroyPipelineLayout(device_, pipelineLayout_, nullptr);
+    // Destroying the pool frees its sets
+    if (descriptorPool_) vkDestroyDescriptorPool(device_, descriptorPool_, nullptr);
+    if (descriptorSetLayout_) vkDestroyDescriptorSetLayout(device_, descriptorSetLayout_, nullptr);
+    if (textureSampler_) vkDestroySampler(device_, textureSampler_, nullptr);
+    if (renderPass_) vkDestroyRenderPass(device_, renderPass_, nullptr);
+    imagePipeline_ = VK_NULL_HANDLE;
+    textPipeline_ = VK_NULL_HANDLE;
+    thumbnailPipeline_ = VK_NULL_HANDLE;
+    pipelineLayout_ = VK_NULL_HANDLE;
+    descriptorPool_ = VK_NULL_HANDLE;
+    descriptorSetLayout_ = VK_NULL_HANDLE;
+    textureSampler_ = VK_NULL_HANDLE;
+    renderPass_ = VK_NULL_HANDLE;
+    renderPassFormat_ = VK_FORMAT_UNDEFINED;
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        frameDescriptorSets_[i] = VK_NULL_HANDLE;
+        frameDescriptorGenerations_[i] = 0;
+        frameOverlaySets_[i] = VK_NULL_HANDLE;
+        frameOverlayGenerations_[i] = 0;
+        frameLutGenerations_[i] = 0;
+    }
+    glyphAtlasSet_ = VK_NULL_HANDLE;
+    glyphAtlasSetWritten_ = false;
+    thumbnailAtlasSet_ = VK_NULL_HANDLE;
+    thumbnailAtlasSetWritten_ = false;
 }
 
 bool VulkanRenderer::createSyncObjects() {
@@ -539,30 +2137,31 @@ void VulkanRenderer::recreateSwapchain(uint32_t width, uint32_t height) {
     createSwapchain(width, height);
 }
 
-bool VulkanRenderer::createTexture(uint32_t width, uint32_t height, bool isHdr) {
-    destroyTexture();
-
-    // Choose format based on HDR flag
-    textureFormat_ = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
-    textureIsHdr_ = isHdr;
+bool VulkanRenderer::createImageResource(uint32_t width, uint32_t height, VkFormat format, uint32_t mipLevels,
+                                         VkImage& image, VkDeviceMemory& memory) {
+    image = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
 
     VkImageCreateInfo ii{};
     ii.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     ii.imageType = VK_IMAGE_TYPE_2D;
     ii.extent = { width, height, 1 };
-    ii.mipLevels = 1;
+    ii.mipLevels = std::max(1u, mipLevels);
     ii.arrayLayers = 1;
-    ii.format = textureFormat_;
+    ii.format = format;
     ii.tiling = VK_IMAGE_TILING_OPTIMAL;
     ii.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    ii.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    ii.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
     ii.samples = VK_SAMPLE_COUNT_1_BIT;
-    ii.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    ii.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // Uploads from the transfer family use an ownership transfer
 
-    if (vkCreateImage(device_, &ii, nullptr, &textureImage_) != VK_SUCCESS) return false;
+    if (vkCreateImage(device_, &ii, nullptr, &image) != VK_SUCCESS) {
+        image = VK_NULL_HANDLE;
+        return false;
+    }
 
     VkMemoryRequirements req{};
-    vkGetImageMemoryRequirements(device_, textureImage_, &req);
+    vkGetImageMemoryRequirements(device_, image, &req);
 
     VkMemoryAllocateInfo ai{};
     ai.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -571,17 +2170,52 @@ bool VulkanRenderer::createTexture(uint32_t width, uint32_t height, bool isHdr)
 
     // NASA Standard: Validate memory type index before allocation
     if (ai.memoryTypeIndex == UINT32_MAX) {
-        vkDestroyImage(device_, textureImage_, nullptr);
-        textureImage_ = VK_NULL_HANDLE;
+        vkDestroyImage(device_, image, nullptr);
+        image = VK_NULL_HANDLE;
+        return false;
+    }
+
+    if (vkAllocateMemory(device_, &ai, nullptr, &memory) != VK_SUCCESS) {
+        vkDestroyImage(device_, image, nullptr);
+        image = VK_NULL_HANDLE;
+        memory = VK_NULL_HANDLE;
+        return false;
+    }
+    vkBindImageMemory(device_, image, memory, 0);
+    return true;
+}
+
+bool VulkanRenderer::createImageView(VkImage image, VkFormat format, uint32_t mipLevels, VkImageView& view) {
+    VkImageViewCreateInfo vi{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    vi.image = image;
+    vi.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    vi.format = format;
+    vi.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    vi.subresourceRange.levelCount = std::max(1u, mipLevels);
+    vi.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(device_, &vi, nullptr, &view) != VK_SUCCESS) {
+        view = VK_NULL_HANDLE;
         return false;
     }
+    return true;
+}
 
-    if (vkAllocateMemory(device_, &ai, nullptr, &textureMemory_) != VK_SUCCESS) {
-        vkDestroyImage(device_, textureImage_, nullptr);
-        textureImage_ = VK_NULL_HANDLE;
+bool VulkanRenderer::createTexture(uint32_t width, uint32_t height, bool isHdr) {
+    destroyTexture();
+
+    // Choose format based on HDR flag
+    textureFormat_ = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
+    textureIsHdr_ = isHdr;
+
+    if (!createImageResource(width, height, textureFormat_, 1, textureImage_, textureMemory_)) return false;
+    if (!createImageView(textureImage_, textureFormat_, 1, textureView_)) {
+        destroyTexture();
         return false;
     }
-    vkBindImageMemory(device_, textureImage_, textureMemory_, 0);
+    ++textureGeneration_;
+    adoptPendingColorLut();
+    textureMipLevels_ = 1;
+    textureScaleShift_ = 0;
 
     textureLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
     textureWidth_ = width;
@@ -591,21 +2225,28 @@ bool VulkanRenderer::createTexture(uint32_t width, uint32_t height, bool isHdr)
 }
 
 void VulkanRenderer::destroyTexture() {
-    // NASA Standard: Clean up sparse image tiles first
-    if (textureIsSparse_ && device_ != VK_NULL_HANDLE) {
-        for (auto& tile : imageTiles_) {
-            if (tile.stagingBuffer != VK_NULL_HANDLE) {
-                vkDestroyBuffer(device_, tile.stagingBuffer, nullptr);
-            }
-            if (tile.stagingMemory != VK_NULL_HANDLE) {
-                vkFreeMemory(device_, tile.stagingMemory, nullptr);
-            }
-            if (tile.memory != VK_NULL_HANDLE) {
-                vkFreeMemory(device_, tile.memory, nullptr);
-            }
+    // NASA Standard: Never destroy an image the GPU may still be writing or reading
+    if (device_ != VK_NULL_HANDLE && (textureImage_ != VK_NULL_HANDLE || sparse_.residency.IsInitialized() ||
+                                      incoming_.image != VK_NULL_HANDLE || !retiredTextures_.empty() ||
+                                      !sequenceSlots_.empty())) {
+        waitForUploads();
+        if (!inFlightFences_.empty() && !deviceLost_) {
+            vkWaitForFences(device_, static_cast<uint32_t>(inFlightFences_.size()), inFlightFences_.data(), VK_TRUE, UINT64_MAX);
         }
+        CancelPendingUpload();
+        // The slot on screen becomes textureImage_ and is destroyed with it below
+        EndSequence();
+        destroyRetiredTextures(true);
     }
 
+    // NASA Standard: Clean up sparse image tiles first
+    destroySparseResources();
+
+    if (textureView_) {
+        vkDestroyImageView(device_, textureView_, nullptr);
+        textureView_ = VK_NULL_HANDLE;
+        ++textureGeneration_;
+    }
     if (textureImage_) {
         vkDestroyImage(device_, textureImage_, nullptr);
         textureImage_ = VK_NULL_HANDLE;
@@ -616,8 +2257,9 @@ void VulkanRenderer::destroyTexture() {
     }
     textureLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
     textureWidth_ = textureHeight_ = 0;
+    textureMipLevels_ = 1;
+    textureScaleShift_ = 0;
     textureIsSparse_ = false; // NASA Standard: Reset sparse flag when destroying texture
-    imageTiles_.clear(); // NASA Standard: Clear any tile data
 }
 
 bool VulkanRenderer::Initialize(HWND hwnd) {
@@ -680,6 +2322,17 @@ void VulkanRenderer::Shutdown() {
     deviceLost_ = false;
     swapchainOutOfDate_ = false;
 
+    // Startup workers still running own what is torn down below
+    if (initThread_.joinable()) {
+        initThread_.join();
+    }
+    initPending_ = false;
+    waitForText();
+
+    fallbackHwnd_ = nullptr;
+    fallbackBuffer_ = std::vector<uint8_t>();
+    fallbackImage_.Clear();
+
     if (device_ == VK_NULL_HANDLE) {
         if (surface_ != VK_NULL_HANDLE && instance_ != VK_NULL_HANDLE) {
             vkDestroySurfaceKHR(instance_, surface_, nullptr);
@@ -710,7 +2363,12 @@ void VulkanRenderer::Shutdown() {
 
     // NASA Standard: Clean up resources in reverse order of creation
     destroyTexture();
+    destroyColorLuts();
+    destroyOverlayResources();
+    destroyThumbnailResources();
+    destroyUploadResources();
     destroySwapchain();
+    destroyImagePipeline();
 
     // NASA Standard: Clean up per-frame synchronization objects
     for (size_t i = 0; i < imageAvailableSemaphores_.size(); ++i) {
@@ -747,11 +2405,20 @@ void VulkanRenderer::Shutdown() {
         vkDestroyFence(device_, inFlightFence_, nullptr);
         inFlightFence_ = VK_NULL_HANDLE;
     }
+    if (transferCommandPool_ != VK_NULL_HANDLE && transferCommandPool_ != commandPool_) {
+        vkDestroyCommandPool(device_, transferCommandPool_, nullptr);
+    }
+    transferCommandPool_ = VK_NULL_HANDLE;
     if (commandPool_ != VK_NULL_HANDLE) {
         vkDestroyCommandPool(device_, commandPool_, nullptr);
         commandPool_ = VK_NULL_HANDLE;
     }
 
+    if (pipelineCache_ != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(device_, pipelineCache_, nullptr);
+        pipelineCache_ = VK_NULL_HANDLE;
+    }
+
     if (device_ != VK_NULL_HANDLE) {
         vkDestroyDevice(device_, nullptr);
         device_ = VK_NULL_HANDLE;
@@ -776,6 +2443,8 @@ void VulkanRenderer::Shutdown() {
     // NASA Standard: Reset all queue handles
     graphicsQueue_ = VK_NULL_HANDLE;
     presentQueue_ = VK_NULL_HANDLE;
+    transferQueue_ = VK_NULL_HANDLE;
+    headless_ = false;
     
     // Shutdown text renderer
     textRenderer_.Shutdown();
@@ -783,6 +2452,7 @@ void VulkanRenderer::Shutdown() {
 
 void VulkanRenderer::Resize(uint32_t width, uint32_t height) {
     if (width == 0 || height == 0) return;
+    if (!vulkanAvailable_) return; // The software fallback sizes its buffer as it draws
     if (swapchainExtent_.width == width && swapchainExtent_.height == height) return;
     recreateSwapchain(width, height);
 }
@@ -819,15 +2489,10 @@ bool VulkanRenderer::createStagingBuffer(VkDeviceSize size, VkBuffer& buffer, Vk
     return true;
 }
 
-void VulkanRenderer::transitionImageLayout(VkImage image, VkFormat /*format*/, VkImageLayout oldLayout, VkImageLayout newLayout) {
-    // NASA Standard: Validate all input parameters and device state
-    if (!device_ || !commandPool_ || image == VK_NULL_HANDLE) {
-        return; // Silently fail if device is not ready
-    }
-
-    VkCommandBuffer cmd = beginSingleTimeCommands();
-    if (cmd == VK_NULL_HANDLE) {
-        return; // Command buffer allocation failed
+void VulkanRenderer::transitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout) {
+    // NASA Standard: Validate all input parameters
+    if (cmd == VK_NULL_HANDLE || image == VK_NULL_HANDLE) {
+        return;
     }
 
     VkImageMemoryBarrier barrier{};
@@ -860,6 +2525,17 @@ void VulkanRenderer::transitionImageLayout(VkImage image, VkFormat /*format*/, V
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
         srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
         dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        // In-place update of a displayed texture: wait for earlier frames' reads
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
     } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
         barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
@@ -874,37 +2550,72 @@ void VulkanRenderer::transitionImageLayout(VkImage image, VkFormat /*format*/, V
     }
 
     vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-    endSingleTimeCommands(cmd);
 }
 
-void VulkanRenderer::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
+bool VulkanRenderer::supportsMipmapBlits(VkFormat format) const {
+    if (!physicalDevice_) return false;
+    VkFormatProperties props{};
+    vkGetPhysicalDeviceFormatProperties(physicalDevice_, format, &props);
+    const VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                        VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (props.optimalTilingFeatures & needed) == needed;
+}
+
+void VulkanRenderer::recordMipChain(VkCommandBuffer cmd, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels) {
     // NASA Standard: Validate all input parameters
-    if (buffer == VK_NULL_HANDLE || image == VK_NULL_HANDLE || width == 0 || height == 0) {
+    if (cmd == VK_NULL_HANDLE || image == VK_NULL_HANDLE || mipLevels < 2) {
         return;
     }
 
-    VkCommandBuffer cmd = beginSingleTimeCommands();
-    if (cmd == VK_NULL_HANDLE) {
-        return; // Command buffer allocation failed
-    }
+    // Level 0 is in TRANSFER_SRC; every other level starts UNDEFINED
+    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
 
-    // NASA Standard: Initialize all structure members explicitly
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {width, height, 1};
+    int32_t srcW = static_cast<int32_t>(width);
+    int32_t srcH = static_cast<int32_t>(height);
+    for (uint32_t level = 1; level < mipLevels; ++level) {
+        const int32_t dstW = std::max(1, srcW / 2);
+        const int32_t dstH = std::max(1, srcH / 2);
 
-    vkCmdCopyBufferToImage(cmd, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    endSingleTimeCommands(cmd);
+        barrier.subresourceRange.baseMipLevel = level;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkImageBlit blit{};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = { srcW, srcH, 1 };
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.layerCount = 1;
+        blit.dstOffsets[1] = { dstW, dstH, 1 };
+        vkCmdBlitImage(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+        // The new level becomes the source of the next blit and of display
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        srcW = dstW;
+        srcH = dstH;
+    }
 }
 
-void VulkanRenderer::UpdateImageFromData(const void* pixelData, uint32_t width, uint32_t height, bool isHdr) {
+void VulkanRenderer::UpdateImageFromData(const void* pixelData, uint32_t width, uint32_t height, bool isHdr, bool generateMipmaps) {
     // NASA Standard: Validate all input parameters before any operations
     if (pixelData == nullptr || width == 0 || height == 0) {
         return;
@@ -915,10 +2626,9 @@ void VulkanRenderer::UpdateImageFromData(const void* pixelData, uint32_t width,
         return; // Dimensions too large for safe GPU operation
     }
 
-    // NASA Standard: Check for potential integer overflow in size calculations
-    const uint64_t pixelCount = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
-    const uint64_t maxSafePixels = UINT64_C(67108864); // 8K x 8K limit
-    if (pixelCount > maxSafePixels) {
+    // Without Vulkan the image is drawn on the CPU from its own copy and pyramid
+    if (IsSoftwareFallback()) {
+        fallbackImage_.SetImage(pixelData, width, height, isHdr);
         return;
     }
 
@@ -927,105 +2637,130 @@ void VulkanRenderer::UpdateImageFromData(const void* pixelData, uint32_t width,
         return; // Cannot update texture when device is lost
     }
 
-    if (!pixelData || width == 0 || height == 0 || !device_) return;
-
-    bool needNewTexture = (textureWidth_ != width || textureHeight_ != height || 
-                           textureIsHdr_ != isHdr || textureImage_ == VK_NULL_HANDLE);
+    if (!device_) return;
 
-    if (needNewTexture) {
-        if (!createTexture(width, height, isHdr)) {
-            // Failed to create texture, mark device as lost to trigger recovery
-            deviceLost_ = true;
-            return;
+    // NASA Standard: Past 8K x 8K, or past what VRAM can still take, a fully resident
+    // texture risks exhausting device memory; stream such images through a sparse
+    // texture sized by the window, or keep a reduced copy when sparse is unavailable
+    destroyRetiredTextures(false);
+    const uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    const uint32_t scaleShift = denseScaleShift(width, height, pixelSize, generateMipmaps, deviceLocalHeadroom());
+    if (scaleShift > 0) {
+        if (sparseImageSupport_) {
+            CancelPendingUpload();
+            if (createSparseTexture(pixelData, nullptr, width, height, isHdr)) {
+                return;
+            }
         }
+        Logger::Warn("Image %ux%u is too large to keep resident; showing it at 1/%u scale",
+                     width, height, 1u << scaleShift);
     }
 
-    // Calculate pixel data size based on format
-    size_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t)); // RGBA16F or RGBA8
-    VkDeviceSize dataSize = static_cast<VkDeviceSize>(width * height * pixelSize);
-
-    // Create staging buffer
-    VkBuffer staging = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMem = VK_NULL_HANDLE;
-
-    if (!createStagingBuffer(dataSize, staging, stagingMem)) {
+    if (!beginIncomingTexture(width, height, isHdr, generateMipmaps, scaleShift)) {
         return;
     }
+    incoming_.src = static_cast<const uint8_t*>(pixelData);
 
-    void* mapped = nullptr;
-    VkResult mapResult = vkMapMemory(device_, stagingMem, 0, dataSize, 0, &mapped);
-    bool deviceLost = false;
-    bool swapchainOutOfDate = false;
-    if (!checkVulkanOperation(mapResult, deviceLost, swapchainOutOfDate)) {
-        if (deviceLost) deviceLost_ = true;
-        vkDestroyBuffer(device_, staging, nullptr);
-        vkFreeMemory(device_, stagingMem, nullptr);
-        return;
-    }
+    // Small images are fully staged here; larger ones continue from Render
+    pumpIncomingTexture();
+}
 
-    std::memcpy(mapped, pixelData, dataSize);
-    vkUnmapMemory(device_, stagingMem);
+bool VulkanRenderer::UpdateImageFromRows(RowSource* source, uint32_t width, uint32_t height, bool isHdr) {
+    // NASA Standard: Validate all input parameters
+    if (source == nullptr || width == 0 || height == 0 || !device_ || deviceLost_) {
+        return false;
+    }
 
-    // NASA Standard: No exceptions - defensive layout transitions
-    transitionImageLayout(textureImage_, textureFormat_, textureLayout_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    if (!deviceLost_) {
-        copyBufferToImage(staging, textureImage_, width, height);
-        if (!deviceLost_) {
-            transitionImageLayout(textureImage_, textureFormat_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-            if (!deviceLost_) {
-                textureLayout_ = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            }
+    // Sources too large to keep resident are shown through UpdateImageFromSource when
+    // sparse residency can hold them; otherwise a reduced copy is streamed
+    destroyRetiredTextures(false);
+    const uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    const uint32_t scaleShift = denseScaleShift(width, height, pixelSize, true, deviceLocalHeadroom());
+    if (scaleShift > 0) {
+        if (sparseImageSupport_) {
+            return false;
         }
+        Logger::Warn("Image %ux%u is too large to keep resident; showing it at 1/%u scale",
+                     width, height, 1u << scaleShift);
     }
 
-    vkDestroyBuffer(device_, staging, nullptr);
-    vkFreeMemory(device_, stagingMem, nullptr);
+    if (!beginIncomingTexture(width, height, isHdr, true, scaleShift)) {
+        return false;
+    }
+    incoming_.rows = source;
+    if (!importIncomingRows()) {
+        pumpIncomingTexture();
+    }
+    return true;
 }
 
-void VulkanRenderer::UpdateImageFromHBITMAP(HBITMAP hBitmap) {
-    if (!hBitmap) return;
-
-    BITMAP bm{};
-    GetObject(hBitmap, sizeof(BITMAP), &bm);
-    uint32_t width = static_cast<uint32_t>(bm.bmWidth);
-    uint32_t height = static_cast<uint32_t>(bm.bmHeight);
-    if (width == 0 || height == 0) return;
-
-    // Read pixels as BGRA and convert to RGBA
-    BITMAPINFO bmi{};
-    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = static_cast<LONG>(width);
-    bmi.bmiHeader.biHeight = -static_cast<LONG>(height); // top-down
-    bmi.bmiHeader.biPlanes = 1;
-    bmi.bmiHeader.biBitCount = 32;
-    bmi.bmiHeader.biCompression = BI_RGB;
-
-    std::vector<uint8_t> bgraPixels(width * height * 4);
-    HDC hdc = GetDC(nullptr);
-    GetDIBits(hdc, hBitmap, 0, height, bgraPixels.data(), &bmi, DIB_RGB_COLORS);
-    ReleaseDC(nullptr, hdc);
-
-    // Convert BGRA to RGBA
-    std::vector<uint8_t> rgbaPixels(width * height * 4);
-    for (size_t i = 0; i < bgraPixels.size(); i += 4) {
-        rgbaPixels[i] = bgraPixels[i + 2];     // R
-        rgbaPixels[i + 1] = bgraPixels[i + 1]; // G
-        rgbaPixels[i + 2] = bgraPixels[i];     // B
-        rgbaPixels[i + 3] = bgraPixels[i + 3]; // A
+bool VulkanRenderer::beginIncomingTexture(uint32_t width, uint32_t height, bool isHdr, bool generateMipmaps,
+                                          uint32_t scaleShift) {
+    // Upload into a fresh image so the current texture keeps presenting; Render
+    // swaps it in when the last band has landed. A newer image supersedes one
+    // still streaming in, and ends a flipbook with its last frame on screen.
+    CancelPendingUpload();
+    EndSequence();
+    if (textureIsSparse_) {
+        destroyTexture();
+    }
+
+    IncomingTexture in;
+    in.format = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
+    const bool withMipmaps = generateMipmaps && supportsMipmapBlits(in.format);
+
+    // Running out of device memory costs resolution, not the device: each failed
+    // allocation halves the texture. The current texture is only let go once its
+    // replacement exists, so a failure leaves it on screen.
+    for (;;) {
+        in.width = std::max(1u, width >> scaleShift);
+        in.height = std::max(1u, height >> scaleShift);
+        in.mipLevels = 1;
+        if (withMipmaps) {
+            // Full chain down to 1x1 so fit-to-window on huge images reads a small level
+            for (uint32_t extent = std::max(in.width, in.height); extent > 1; extent >>= 1) {
+                ++in.mipLevels;
+            }
+        }
+        if (createImageResource(in.width, in.height, in.format, in.mipLevels, in.image, in.memory)) {
+            break;
+        }
+        if (scaleShift < kMaxVramScaleShift && (width >> (scaleShift + 1)) > 0 && (height >> (scaleShift + 1)) > 0) {
+            ++scaleShift;
+            Logger::Warn("Texture allocation for %ux%u failed; retrying at 1/%u scale", width, height, 1u << scaleShift);
+        } else {
+            // The device is fine, just full: a rebuild would fail the same way
+            Logger::Error("Texture allocation for %ux%u failed at 1/%u scale", width, height, 1u << scaleShift);
+            uploadFailed_ = true;
+            return false;
+        }
     }
-
-    UpdateImageFromData(rgbaPixels.data(), width, height, false);
+    if (!createImageView(in.image, in.format, in.mipLevels, in.view)) {
+        Logger::Error("Texture view for %ux%u could not be created", width, height);
+        vkDestroyImage(device_, in.image, nullptr);
+        vkFreeMemory(device_, in.memory, nullptr);
+        uploadFailed_ = true;
+        return false;
+    }
+    in.sourceWidth = width;
+    in.sourceHeight = height;
+    in.scaleShift = scaleShift;
+    in.isHdr = isHdr;
+    in.pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t)); // RGBA16F or RGBA8
+    incoming_ = in;
+    return true;
 }
 
-void VulkanRenderer::UpdateImageFromLDRData(const void* pixelData, uint32_t width, uint32_t height, bool /*generateMipmaps*/) {
-    UpdateImageFromData(pixelData, width, height, false);
+void VulkanRenderer::UpdateImageFromLDRData(const void* pixelData, uint32_t width, uint32_t height, bool generateMipmaps) {
+    UpdateImageFromData(pixelData, width, height, false, generateMipmaps);
 }
 
-void VulkanRenderer::UpdateImageFromHDRData(const uint16_t* pixelData, uint32_t width, uint32_t height, bool /*generateMipmaps*/) {
-    UpdateImageFromData(pixelData, width, height, true);
+void VulkanRenderer::UpdateImageFromHDRData(const uint16_t* pixelData, uint32_t width, uint32_t height, bool generateMipmaps) {
+    UpdateImageFromData(pixelData, width, height, true, generateMipmaps);
 }
 
-void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY, int /*rotationAngle*/) {
+void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY, int rotationAngle,
+                            bool mirrored) {
     // WSI Standard: This method should be called from the main thread that owns the window
     // to avoid deadlocks with Windows SendMessage API calls in Vulkan swapchain operations
     
@@ -1036,7 +2771,7 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
 
     // NASA Standard: Use software fallback if Vulkan is unavailable
     if (!vulkanAvailable_) {
-        renderSoftwareFallback(width, height);
+        renderSoftwareFallback(width, height, zoom, offsetX, offsetY, rotationAngle, mirrored);
         return;
     }
 
@@ -1053,11 +2788,11 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
     // NASA Standard: Clear any previous transient error states
     bool deviceLost = false;
     bool swapchainOutOfDate = false;
-    if (!device_ || !swapchain_) return;
+    if (!device_ || (!swapchain_ && !headless_)) return;
 
-    // Recreate swapchain if size changed
+    // Recreate swapchain if size or pacing mode changed
     if (width == 0 || height == 0) return;
-    if (swapchainExtent_.width != width || swapchainExtent_.height != height) {
+    if (swapchainExtent_.width != width || swapchainExtent_.height != height || (presentModeDirty_ && !headless_)) {
         recreateSwapchain(width, height);
     }
 
@@ -1067,9 +2802,28 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
     VkSemaphore renderFinishedSemaphore = renderFinishedSemaphores_[currentFrame_];
 
     vkWaitForFences(device_, 1, &currentFence, VK_TRUE, UINT64_MAX);
+    completedFrameSerial_ = std::max(completedFrameSerial_, frameFenceSerials_[currentFrame_]);
+
+    // Recycle staging space and command buffers of uploads that have finished,
+    // then stage the next slice of any image streaming in on the transfer queue
+    retireUploads(false);
+    releaseHostImports(false);
+    destroyRetiredTextures(false);
+    pumpIncomingTexture();
+    // Thumbnails generated since the last frame, ahead of the frame that draws them
+    uploadPendingThumbnails();
+    // Bind and fill the sparse tiles this frame's view needs before it samples them
+    pumpSparseTexture(zoom, offsetX, offsetY, rotationAngle, mirrored);
 
     uint32_t imageIndex = 0;
-    VkResult acq = vkAcquireNextImageKHR(device_, swapchain_, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    VkResult acq = VK_SUCCESS;
+    if (headless_) {
+        // The offscreen target of this slot is free once the slot's fence has signalled
+        imageIndex = currentFrame_;
+    } else {
+        Trace::Scope acquireTrace(Trace::Stage::Acquire);
+        acq = vkAcquireNextImageKHR(device_, swapchain_, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    }
     if (acq == VK_ERROR_OUT_OF_DATE_KHR) {
         recreateSwapchain(width, height);
         return;
@@ -1085,153 +2839,101 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
         return;
     }
 
-    // NASA Standard: Proper initial layout transition for swapchain images
-    // Track if each swapchain image has been used before (starts as UNDEFINED, then PRESENT_SRC_KHR)
-    static thread_local std::vector<bool> imageUsed;
-    if (imageUsed.size() != swapchainImages_.size()) {
-        imageUsed.resize(swapchainImages_.size(), false);
-    }
-    
-    VkImageLayout initialLayout = imageUsed[imageIndex] ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_UNDEFINED;
-    imageUsed[imageIndex] = true;
-    
-    // Transition swapchain image to TRANSFER_DST for rendering
-    VkImageMemoryBarrier pre{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-    pre.oldLayout = initialLayout;
-    pre.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    pre.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    pre.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    pre.image = swapchainImages_[imageIndex];
-    pre.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    pre.subresourceRange.levelCount = 1;
-    pre.subresourceRange.layerCount = 1;
-    pre.srcAccessMask = 0;
-    pre.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    vkCmdPipelineBarrier(cmd,
-        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-        0, 0, nullptr, 0, nullptr, 1, &pre);
-
-    // Clear to black (via vkCmdClearColorImage on TRANSFER_DST layout)
-    VkClearColorValue black{};
-    VkImageSubresourceRange range{};
-    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    range.levelCount = 1;
-    range.layerCount = 1;
-    vkCmdClearColorImage(cmd, swapchainImages_[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &black, 1, &range);
-    
-    // If no image is loaded, we'll create a simple text overlay after clearing
-
-    // Blit image if available
-    if (textureImage_ && textureLayout_ == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
-        // Compute destination rectangle with zoom and offsets (no rotation for now)
-        float contentW = static_cast<float>(swapchainExtent_.width);
-        float contentH = static_cast<float>(swapchainExtent_.height);
-        float imgW = static_cast<float>(textureWidth_);
-        float imgH = static_cast<float>(textureHeight_);
-
-        float fitScale = std::min(contentW / imgW, contentH / imgH);
-        float scale = fitScale * std::clamp(zoom, 0.01f, 10.0f);
-
-        float drawW = imgW * scale;
-        float drawH = imgH * scale;
-        float cx = contentW * 0.5f + offsetX;
-        float cy = contentH * 0.5f + offsetY;
-        
-        // NASA Standard: Prevent integer overflow when casting to int32_t
-        // Compute destination coordinates as floats first
-        float dstX0_f = cx - drawW * 0.5f;
-        float dstY0_f = cy - drawH * 0.5f;
-        float dstX1_f = cx + drawW * 0.5f;
-        float dstY1_f = cy + drawH * 0.5f;
-        
-        // NASA Standard: Validate coordinates are within int32_t range to prevent overflow
-        constexpr float kMaxInt32 = 2147483647.0f;  // INT32_MAX as float
-        constexpr float kMinInt32 = -2147483648.0f; // INT32_MIN as float
-        
-        // Check for potential overflow and clamp to safe values
-        if (!std::isfinite(dstX0_f) || !std::isfinite(dstY0_f) || 
-            !std::isfinite(dstX1_f) || !std::isfinite(dstY1_f) ||
-            dstX0_f < kMinInt32 || dstX0_f > kMaxInt32 ||
-            dstY0_f < kMinInt32 || dstY0_f > kMaxInt32 ||
-            dstX1_f < kMinInt32 || dstX1_f > kMaxInt32 ||
-            dstY1_f < kMinInt32 || dstY1_f > kMaxInt32) {
-            // Coordinates would overflow int32_t - use fallback safe coordinates
-            // Just draw a 1x1 pixel in center to avoid crash
-            int32_t centerX = static_cast<int32_t>(contentW * 0.5f);
-            int32_t centerY = static_cast<int32_t>(contentH * 0.5f);
-            dstX0_f = static_cast<float>(centerX);
-            dstY0_f = static_cast<float>(centerY);
-            dstX1_f = static_cast<float>(centerX + 1);
-            dstY1_f = static_cast<float>(centerY + 1);
-        }
-        
-        int32_t dstX0 = static_cast<int32_t>(dstX0_f);
-        int32_t dstY0 = static_cast<int32_t>(dstY0_f);
-        int32_t dstX1 = static_cast<int32_t>(dstX1_f);
-        int32_t dstY1 = static_cast<int32_t>(dstY1_f);
-        
-        // NASA Standard: Clamp blit coordinates to valid Vulkan spec bounds
-        // Per VUID-vkCmdBlitImage-dstOffset-00248: both dstOffsets must be >= 0 and <= image dimensions
-        int32_t swapchainWidth = static_cast<int32_t>(swapchainExtent_.width);
-        int32_t swapchainHeight = static_cast<int32_t>(swapchainExtent_.height);
-        
-        dstX0 = std::max(0, std::min(dstX0, swapchainWidth));
-        dstY0 = std::max(0, std::min(dstY0, swapchainHeight));
-        dstX1 = std::max(0, std::min(dstX1, swapchainWidth));
-        dstY1 = std::max(0, std::min(dstY1, swapchainHeight));
-        
-        // NASA Standard: Ensure we have a valid rectangle (x1 > x0, y1 > y0)
-        if (dstX1 <= dstX0) {
-            dstX1 = dstX0 + 1;
-            if (dstX1 > swapchainWidth) {
-                dstX0 = std::max(0, swapchainWidth - 1);
-                dstX1 = swapchainWidth;
-            }
-        }
-        if (dstY1 <= dstY0) {
-            dstY1 = dstY0 + 1;
-            if (dstY1 > swapchainHeight) {
-                dstY0 = std::max(0, swapchainHeight - 1);
-                dstY1 = swapchainHeight;
-            }
+    // Swap in a finished upload; its barriers and mip blits must precede the render pass
+    adoptIncomingTexture(cmd);
+
+    const bool textureReadable = textureLayout_ == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ||
+                                 (textureIsSparse_ && textureLayout_ == VK_IMAGE_LAYOUT_GENERAL);
+    // The image pipeline always reads binding 1, so nothing is drawn without a LUT view
+    const bool lutBindable = imagePipeline_ != VK_NULL_HANDLE && ensureLutPlaceholder();
+    // A full-window grid hides the image (and the instructional screen) beneath it
+    const bool gridCovers = gridCoversImage_ && !gridQuads_.empty() && thumbnailPipeline_ != VK_NULL_HANDLE;
+    const bool haveTexture = !gridCovers && textureView_ != VK_NULL_HANDLE && textureReadable &&
+                             lutBindable && textureWidth_ > 0 && textureHeight_ > 0;
+    // Without an image, draw the instructional screen; it is re-rasterized only when it changes
+    const bool haveOverlay = !haveTexture && !gridCovers && lutBindable &&
+                             ensureInstructionalOverlay(swapchainExtent_.width, swapchainExtent_.height);
+
+    // This slot's fence has signalled, so its descriptor sets are free to rewrite
+    VkDescriptorSet frameSet = frameDescriptorSets_[currentFrame_];
+    if (haveTexture && frameDescriptorGenerations_[currentFrame_] != textureGeneration_) {
+        writeImageDescriptor(frameSet, textureView_, textureLayout_);
+        frameDescriptorGenerations_[currentFrame_] = textureGeneration_;
+    }
+    if (haveTexture && frameLutGenerations_[currentFrame_] != colorLutGeneration_) {
+        writeLutDescriptor(frameSet, colorLut_.view != VK_NULL_HANDLE ? colorLut_.view : placeholderLut_.view);
+        frameLutGenerations_[currentFrame_] = colorLutGeneration_;
+    }
+    VkDescriptorSet overlaySet = frameOverlaySets_[currentFrame_];
+    if (haveOverlay && frameOverlayGenerations_[currentFrame_] != instructionalOverlay_.generation) {
+        writeImageDescriptor(overlaySet, instructionalOverlay_.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        writeLutDescriptor(overlaySet, placeholderLut_.view);
+        frameOverlayGenerations_[currentFrame_] = instructionalOverlay_.generation;
+    }
+
+    VkClearValue clearValue{};
+    clearValue.color = VkClearColorValue{}; // Black
+    if (!haveTexture && !haveOverlay && !gridCovers) {
+        // No font to rasterize with: keep the "no image" screen recognisable
+        clearValue.color = VkClearColorValue{ { 0.1f, 0.1f, 0.2f, 1.0f } };
+    }
+    VkRenderPassBeginInfo rpbi{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+    rpbi.renderPass = renderPass_;
+    rpbi.framebuffer = framebuffers_[imageIndex];
+    rpbi.renderArea.extent = swapchainExtent_;
+    rpbi.clearValueCount = 1;
+    rpbi.pClearValues = &clearValue;
+    vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+
+    const float contentW = static_cast<float>(swapchainExtent_.width);
+    const float contentH = static_cast<float>(swapchainExtent_.height);
+    const VkViewport viewport{ 0.0f, 0.0f, contentW, contentH, 0.0f, 1.0f };
+    const VkRect2D scissor{ { 0, 0 }, swapchainExtent_ };
+
+    if (haveTexture) {
+        const ImagePushConstants push = computeImagePush(zoom, offsetX, offsetY, rotationAngle, mirrored);
+
+        // NASA Standard: Never hand non-finite geometry to the rasterizer
+        const bool finite = std::isfinite(push.center[0]) && std::isfinite(push.center[1]) &&
+                            std::isfinite(push.halfSize[0]) && std::isfinite(push.halfSize[1]);
+        if (finite) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, imagePipeline_);
+            vkCmdSetViewport(cmd, 0, 1, &viewport);
+            vkCmdSetScissor(cmd, 0, 1, &scissor);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 0, 1, &frameSet, 0, nullptr);
+            vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+            const ImageColorPush colorPush = computeColorPush();
+            vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(push), sizeof(colorPush), &colorPush);
+            vkCmdDraw(cmd, 4, 1, 0, 0);
         }
-
-        VkImageBlit blit{};
-        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        blit.srcSubresource.layerCount = 1;
-        blit.srcOffsets[0] = { 0, 0, 0 };
-        blit.srcOffsets[1] = { static_cast<int32_t>(textureWidth_), static_cast<int32_t>(textureHeight_), 1 };
-        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        blit.dstSubresource.layerCount = 1;
-        blit.dstOffsets[0] = { dstX0, dstY0, 0 };
-        blit.dstOffsets[1] = { dstX1, dstY1, 1 };
-
-        vkCmdBlitImage(cmd,
-            textureImage_, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            swapchainImages_[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            1, &blit, VK_FILTER_LINEAR);
-    }
-
-    // If no image is loaded, render UI text instructions
-    if (!textureImage_ || textureLayout_ != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
-        RenderInstructionalUI(cmd, swapchainImages_[imageIndex], width, height);
-    }
-    
-    // Present transition
-    VkImageMemoryBarrier post{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-    post.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    post.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    post.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    post.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    post.image = swapchainImages_[imageIndex];
-    post.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    post.subresourceRange.levelCount = 1;
-    post.subresourceRange.layerCount = 1;
-    post.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    post.dstAccessMask = 0;
-    vkCmdPipelineBarrier(cmd,
-        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        0, 0, nullptr, 0, nullptr, 1, &post);
+    } else if (haveOverlay) {
+        // Pixel-exact: the overlay was rasterized at the swapchain size
+        ImagePushConstants push{};
+        push.viewportSize[0] = contentW;
+        push.viewportSize[1] = contentH;
+        push.center[0] = contentW * 0.5f;
+        push.center[1] = contentH * 0.5f;
+        push.halfSize[0] = static_cast<float>(instructionalOverlay_.key.width) * 0.5f;
+        push.halfSize[1] = static_cast<float>(instructionalOverlay_.key.height) * 0.5f;
+        push.rotation[0] = 1.0f;
+        push.rotation[1] = 0.0f;
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, imagePipeline_);
+        vkCmdSetViewport(cmd, 0, 1, &viewport);
+        vkCmdSetScissor(cmd, 0, 1, &scissor);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 0, 1, &overlaySet, 0, nullptr);
+        vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+        // The overlay is already display-ready: no exposure, gamma or LUT
+        ImageColorPush colorPush{};
+        colorPush.exposureScale = 1.0f;
+        colorPush.gammaExponent = 1.0f;
+        vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(push), sizeof(colorPush), &colorPush);
+        vkCmdDraw(cmd, 4, 1, 0, 0);
+    }
+
+    recordThumbnailGrid(cmd, viewport, scissor);
+    recordHudText(cmd, viewport, scissor);
+
+    vkCmdEndRenderPass(cmd);
 
     VkResult endResult = vkEndCommandBuffer(cmd);
     if (!checkVulkanOperation(endResult, deviceLost, swapchainOutOfDate)) {
@@ -1239,20 +2941,25 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
         return;
     }
 
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     VkSubmitInfo submit{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    submit.waitSemaphoreCount = 1;
+    // Offscreen frames have no acquire to wait for and no present to signal
+    submit.waitSemaphoreCount = headless_ ? 0 : 1;
     submit.pWaitSemaphores = &imageAvailableSemaphore;
     submit.pWaitDstStageMask = &waitStage;
     submit.commandBufferCount = 1;
     submit.pCommandBuffers = &cmd;
-    submit.signalSemaphoreCount = 1;
+    submit.signalSemaphoreCount = headless_ ? 0 : 1;
     submit.pSignalSemaphores = &renderFinishedSemaphore;
 
     // NASA Standard: Reset fence before submitting to avoid synchronization issues
     vkResetFences(device_, 1, &currentFence);
 
-    VkResult sr = vkQueueSubmit(graphicsQueue_, 1, &submit, currentFence);
+    VkResult sr = VK_SUCCESS;
+    {
+        Trace::Scope submitTrace(Trace::Stage::Submit);
+        sr = vkQueueSubmit(graphicsQueue_, 1, &submit, currentFence);
+    }
     if (sr == VK_ERROR_DEVICE_LOST) {
         deviceLost_ = true;
         return;
@@ -1261,6 +2968,12 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
         deviceLost_ = true;
         return;
     }
+    frameFenceSerials_[currentFrame_] = ++frameSerial_;
+
+    if (headless_) {
+        currentFrame_ = (currentFrame_ + 1) % MAX_FRAMES_IN_FLIGHT;
+        return;
+    }
 
     VkPresentInfoKHR present{ VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
     present.waitSemaphoreCount = 1;
@@ -1268,7 +2981,28 @@ void VulkanRenderer::Render(uint32_t width, uint32_t height, float zoom, float o
     present.swapchainCount = 1;
     present.pSwapchains = &swapchain_;
     present.pImageIndices = &imageIndex;
-    VkResult pr = vkQueuePresentKHR(presentQueue_, &present);
+    const uint64_t presentId = presentId_ + 1;
+    VkPresentIdKHR presentIdInfo{ VK_STRUCTURE_TYPE_PRESENT_ID_KHR };
+    presentIdInfo.swapchainCount = 1;
+    presentIdInfo.pPresentIds = &presentId;
+    if (presentWait_) {
+        present.pNext = &presentIdInfo;
+    }
+    VkResult pr = VK_SUCCESS;
+    {
+        Trace::Scope presentTrace(Trace::Stage::Present);
+        pr = vkQueuePresentKHR(presentQueue_, &present);
+    }
+    if (pr == VK_SUCCESS || pr == VK_SUBOPTIMAL_KHR) {
+        presentId_ = presentId;
+        inputPresentedNs_ = inputPendingNs_;
+        inputPendingNs_ = 0;
+        if (!presentWait_ && inputPresentedNs_ != 0 && Trace::IsEnabled()) {
+            // No way to see the frame reach the screen: measure to the queued present
+            Trace::Record(Trace::Stage::Latency, inputPresentedNs_, Trace::Now());
+            inputPresentedNs_ = 0;
+        }
+    }
     if (pr == VK_ERROR_OUT_OF_DATE_KHR || pr == VK_SUBOPTIMAL_KHR) {
         swapchainOutOfDate_ = true;
         return;
@@ -1307,14 +3041,19 @@ void VulkanRenderer::UpdateImageTiled(const void* pixelData, uint32_t fullWidth,
         return;
     }
 
+    // In-place tile updates replace whatever was streaming in
+    CancelPendingUpload();
+
     // NASA Standard: Initialize texture if not already done
     if (textureImage_ == VK_NULL_HANDLE || 
         textureWidth_ != fullWidth || textureHeight_ != fullHeight || textureIsHdr_ != isHdr) {
 
-        // NASA Standard: Try sparse image first for large images
+        // NASA Standard: Try sparse image first for large images and for images VRAM cannot hold
         bool sparseCreated = false;
-        if (fullWidth >= 4096 && fullHeight >= 4096) {
-            sparseCreated = InitializeSparseImage(fullWidth, fullHeight, isHdr);
+        const uint32_t texelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+        if ((fullWidth >= 4096 && fullHeight >= 4096) ||
+            denseScaleShift(fullWidth, fullHeight, texelSize, false, deviceLocalHeadroom()) > 0) {
+            sparseCreated = createSparseTexture(pixelData, nullptr, fullWidth, fullHeight, isHdr);
         }
 
         // NASA Standard: Fallback to regular texture if sparse failed or not suitable
@@ -1329,136 +3068,138 @@ void VulkanRenderer::UpdateImageTiled(const void* pixelData, uint32_t fullWidth,
 
     // NASA Standard: Handle sparse images and regular textures in separate, reachable paths
     if (textureIsSparse_) {
-        // Calculate which sparse tile this update belongs to
-        uint32_t sparseTileX = tileX / tileSize_;
-        uint32_t sparseTileY = tileY / tileSize_;
-
-        // NASA Standard: Extract tile data from the full pixel data
-        uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
-        std::vector<uint8_t> tileData(tileWidth * tileHeight * pixelSize);
-
-        const uint8_t* srcData = static_cast<const uint8_t*>(pixelData);
-        uint8_t* dstData = tileData.data();
-
-        // NASA Standard: Copy tile data row by row to handle stride differences
-        for (uint32_t y = 0; y < tileHeight; ++y) {
-            const uint8_t* srcRow = srcData + ((tileY + y) * fullWidth + tileX) * pixelSize;
-            uint8_t* dstRow = dstData + y * tileWidth * pixelSize;
-            std::memcpy(dstRow, srcRow, tileWidth * pixelSize);
-        }
-
-        LoadImageTile(sparseTileX, sparseTileY, tileData.data(), isHdr);
+        // Tiles stream from the caller's full image as the view needs them; resident
+        // tiles covering this region are refreshed on their next request
+        sparse_.src = static_cast<const uint8_t*>(pixelData);
+        const uint32_t base = sparse_.baseLevel;
+        sparse_.residency.Invalidate(tileX >> base, tileY >> base,
+                                     std::max(1u, tileWidth >> base), std::max(1u, tileHeight >> base));
     } else {
-        // NASA Standard: For regular textures, update the specific region
-        uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
-        VkDeviceSize tileDataSize = static_cast<VkDeviceSize>(tileWidth * tileHeight * pixelSize);
-
-        // NASA Standard: Create staging buffer for tile update
-        VkBuffer stagingBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-
-        if (!createStagingBuffer(tileDataSize, stagingBuffer, stagingMemory)) {
-            return;
-        }
-
-        // NASA Standard: Map and copy tile data
-        void* mapped = nullptr;
-        bool deviceLost = false;
-        bool swapchainOutOfDate = false;
-        VkResult mapResult = vkMapMemory(device_, stagingMemory, 0, tileDataSize, 0, &mapped);
-        if (!checkVulkanOperation(mapResult, deviceLost, swapchainOutOfDate)) {
-            if (deviceLost) deviceLost_ = true;
-            vkDestroyBuffer(device_, stagingBuffer, nullptr);
-            vkFreeMemory(device_, stagingMemory, nullptr);
-            return;
-        }
+        // NASA Standard: For regular textures, update the specific region straight from
+        // the full image rows; the staging copy handles the stride
+        const uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+        const VkDeviceSize srcRowPitch = static_cast<VkDeviceSize>(fullWidth) * pixelSize;
+        const uint8_t* srcTile = static_cast<const uint8_t*>(pixelData) +
+                                 (static_cast<size_t>(tileY) * fullWidth + tileX) * pixelSize;
 
-        // NASA Standard: Copy tile data with proper stride handling
-        const uint8_t* srcData = static_cast<const uint8_t*>(pixelData);
-        uint8_t* dstData = static_cast<uint8_t*>(mapped);
-
-        for (uint32_t y = 0; y < tileHeight; ++y) {
-            const uint8_t* srcRow = srcData + ((tileY + y) * fullWidth + tileX) * pixelSize;
-            uint8_t* dstRow = dstData + y * tileWidth * pixelSize;
-            std::memcpy(dstRow, srcRow, tileWidth * pixelSize);
-        }
-
-        vkUnmapMemory(device_, stagingMemory);
-
-        // NASA Standard: Transition texture to transfer destination layout
-        VkImageLayout oldLayout = textureLayout_;
-        transitionImageLayout(textureImage_, textureFormat_, oldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-        // NASA Standard: Copy tile region from staging buffer
-        VkCommandBuffer cmd = beginSingleTimeCommands();
-        if (cmd != VK_NULL_HANDLE) {
-            VkBufferImageCopy copyRegion{};
-            copyRegion.bufferOffset = 0;
-            copyRegion.bufferRowLength = 0;
-            copyRegion.bufferImageHeight = 0;
-            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            copyRegion.imageSubresource.mipLevel = 0;
-            copyRegion.imageSubresource.baseArrayLayer = 0;
-            copyRegion.imageSubresource.layerCount = 1;
-            copyRegion.imageOffset = { static_cast<int32_t>(tileX), static_cast<int32_t>(tileY), 0 };
-            copyRegion.imageExtent = { tileWidth, tileHeight, 1 };
+        uploadImageRegion(textureImage_, textureLayout_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                          srcTile, srcRowPitch, pixelSize, tileX, tileY, tileWidth, tileHeight);
+    }
+}
 
-            vkCmdCopyBufferToImage(cmd, stagingBuffer, textureImage_, 
-                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+VulkanRenderer::ImagePushConstants VulkanRenderer::computeImagePush(float zoom, float offsetX, float offsetY, int rotationAngle,
+                                                                   bool mirrored) const {
+    const float contentW = static_cast<float>(swapchainExtent_.width);
+    const float contentH = static_cast<float>(swapchainExtent_.height);
+    const float imgW = static_cast<float>(textureWidth_);
+    const float imgH = static_cast<float>(textureHeight_);
+
+    // Fit the rotated footprint to the window, then apply zoom about the centre
+    const int quarterTurns = ((rotationAngle / 90) % 4 + 4) % 4;
+    const bool sideways = (quarterTurns % 2) != 0;
+    const float fitScale = sideways ? std::min(contentW / imgH, contentH / imgW)
+                                    : std::min(contentW / imgW, contentH / imgH);
+    const float scale = fitScale * std::clamp(zoom, 0.01f, 10.0f);
+
+    constexpr float kCos[4] = { 1.0f, 0.0f, -1.0f, 0.0f };
+    constexpr float kSin[4] = { 0.0f, 1.0f, 0.0f, -1.0f };
+
+    ImagePushConstants push{};
+    push.viewportSize[0] = contentW;
+    push.viewportSize[1] = contentH;
+    push.center[0] = contentW * 0.5f + offsetX;
+    push.center[1] = contentH * 0.5f + offsetY;
+    // Mirroring the quad before it is rotated flips the image on the GPU; the texels stay put
+    push.halfSize[0] = imgW * scale * (mirrored ? -0.5f : 0.5f);
+    push.halfSize[1] = imgH * scale * 0.5f;
+    push.rotation[0] = kCos[quarterTurns];
+    push.rotation[1] = kSin[quarterTurns];
+    return push;
+}
 
-            endSingleTimeCommands(cmd);
-        }
+namespace {
+    // Tiles needed to cover a window at the finest level it samples (at most two texels
+    // per pixel), plus the next coarser level, with the same again kept warm for panning
+    VkDeviceSize sparseBudgetBytes(VkExtent2D extent, uint32_t tileWidth, uint32_t tileHeight, VkDeviceSize tileBytes) {
+        const uint64_t span = std::max<uint64_t>(1, std::max(extent.width, extent.height));
+        const uint64_t across = 2 * span / tileWidth + 2;
+        const uint64_t down = 2 * span / tileHeight + 2;
+        const uint64_t tiles = across * down * 5 / 4 * 2;
+        return static_cast<VkDeviceSize>(tiles) * tileBytes;
+    }
+}
 
-        // NASA Standard: Transition back to shader read optimal
-        transitionImageLayout(textureImage_, textureFormat_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-        textureLayout_ = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+VkDeviceSize VulkanRenderer::sparseBudgetCap(VkDeviceSize wanted) const {
+    // Pages already pooled are part of the heap's usage, so they count as available
+    const VkDeviceSize headroom = deviceLocalHeadroom();
+    const VkDeviceSize spare = headroom > kVramReserveBytes ? headroom - kVramReserveBytes : 0;
+    return std::min(wanted, sparse_.residency.GetAllocatedBytes() + spare);
+}
 
-        // NASA Standard: Clean up staging resources
-        vkDestroyBuffer(device_, stagingBuffer, nullptr);
-        vkFreeMemory(device_, stagingMemory, nullptr);
+bool VulkanRenderer::UpdateImageFromSource(TileSource* source, uint32_t width, uint32_t height, bool isHdr) {
+    // NASA Standard: Validate all input parameters
+    if (source == nullptr || width == 0 || height == 0 || !device_ || deviceLost_) {
+        return false;
+    }
+    CancelPendingUpload();
+    if (!createSparseTexture(nullptr, source, width, height, isHdr)) {
+        Logger::Warn("Paged image %ux%u could not be shown: sparse residency is unavailable", width, height);
+        return false;
     }
+    return true;
 }
 
-bool VulkanRenderer::InitializeSparseImage(uint32_t width, uint32_t height, bool isHdr) {
+bool VulkanRenderer::createSparseTexture(const void* pixelData, TileSource* source,
+                                         uint32_t width, uint32_t height, bool isHdr) {
     // NASA Standard: Validate all input parameters
-    if (width == 0 || height == 0 || !device_ || !physicalDevice_) {
+    if ((pixelData == nullptr && source == nullptr) || width == 0 || height == 0 ||
+        !device_ || !physicalDevice_ || deviceLost_) {
         return false;
     }
-
-    // NASA Standard: Validate dimensions for sparse images (must be large enough to justify sparse allocation)
-    const uint32_t minSparseSize = 4096; // Minimum dimension for sparse images
-    if (width < minSparseSize || height < minSparseSize) {
-        return false; // Use regular images for smaller textures
+    if (!sparseImageSupport_) {
+        return false;
     }
+    EndSequence();
 
-    // NASA Standard: Check if sparse images are supported
-    VkPhysicalDeviceFeatures features{};
-    vkGetPhysicalDeviceFeatures(physicalDevice_, &features);
-    if (!features.sparseBinding || !features.sparseResidencyImage2D) {
-        sparseImageSupport_ = false;
-        textureIsSparse_ = false;
-        return false;
+    // Past the device's 2D limit the texture starts at a coarser source level; the
+    // viewer still shows the whole image, without its finest detail
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+    const uint32_t maxDimension = std::max(1u, props.limits.maxImageDimension2D);
+    uint32_t baseLevel = 0;
+    while ((width >> baseLevel) > maxDimension || (height >> baseLevel) > maxDimension) {
+        ++baseLevel;
+    }
+    if (baseLevel > 0) {
+        Logger::Warn("Sparse texture %ux%u exceeds maxImageDimension2D (%u); showing it at 1/%u scale",
+                     width, height, maxDimension, 1u << baseLevel);
     }
+    const uint32_t sourceWidth = width;
+    const uint32_t sourceHeight = height;
+    width = std::max(1u, sourceWidth >> baseLevel);
+    height = std::max(1u, sourceHeight >> baseLevel);
 
     // Clean up any existing texture first
     destroyTexture();
 
-    // NASA Standard: Choose appropriate format based on HDR flag
-    VkFormat format = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
+    const VkFormat format = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
+    uint32_t mipLevels = 1;
+    for (uint32_t extent = std::max(width, height); extent > 1; extent >>= 1) {
+        ++mipLevels;
+    }
 
     // NASA Standard: Create sparse image with proper validation
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.pNext = nullptr;
     imageInfo.flags = VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
     imageInfo.format = format;
     imageInfo.extent = { width, height, 1 };
-    imageInfo.mipLevels = 1;
+    imageInfo.mipLevels = mipLevels;
     imageInfo.arrayLayers = 1;
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
@@ -1467,246 +3208,424 @@ bool VulkanRenderer::InitializeSparseImage(uint32_t width, uint32_t height, bool
     VkResult createResult = vkCreateImage(device_, &imageInfo, nullptr, &textureImage_);
     if (!checkVulkanOperation(createResult, deviceLost, swapchainOutOfDate)) {
         if (deviceLost) deviceLost_ = true;
+        textureImage_ = VK_NULL_HANDLE;
         return false;
     }
 
-    // NASA Standard: Get sparse memory requirements
+    auto fail = [this](const char* reason) {
+        Logger::Warn("Sparse texture: %s", reason);
+        destroyTexture();
+        return false;
+    };
+
     VkMemoryRequirements memReqs{};
     vkGetImageMemoryRequirements(device_, textureImage_, &memReqs);
-    sparseImageMemoryRequirements_ = memReqs.size;
+    const uint32_t memoryType = findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (memoryType == UINT32_MAX) {
+        return fail("no device-local memory type");
+    }
 
     // NASA Standard: Get sparse image memory requirements for tiling
     uint32_t sparseReqCount = 0;
     vkGetImageSparseMemoryRequirements(device_, textureImage_, &sparseReqCount, nullptr);
-    if (sparseReqCount == 0) {
-        vkDestroyImage(device_, textureImage_, nullptr);
-        textureImage_ = VK_NULL_HANDLE;
-        textureIsSparse_ = false;
-        return false;
-    }
-
     std::vector<VkSparseImageMemoryRequirements> sparseReqs(sparseReqCount);
     vkGetImageSparseMemoryRequirements(device_, textureImage_, &sparseReqCount, sparseReqs.data());
+    const VkSparseImageMemoryRequirements* colorReqs = nullptr;
+    for (const auto& reqs : sparseReqs) {
+        if (reqs.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) {
+            colorReqs = &reqs;
+            break;
+        }
+    }
+    if (colorReqs == nullptr) {
+        return fail("format has no sparse color layout");
+    }
+
+    const VkExtent3D granularity = colorReqs->formatProperties.imageGranularity;
+    sparse_.pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    sparse_.tileWidth = granularity.width;
+    sparse_.tileHeight = granularity.height;
+    sparse_.tileBytes = memReqs.alignment;
+    sparse_.tiledLevels = std::min(colorReqs->imageMipTailFirstLod, mipLevels);
+
+    // Budget follows the window, not the image, and what VRAM can still take; it grows
+    // with the swapchain in pumpSparseTexture
+    if (!sparse_.residency.Initialize(device_, memoryType, sparse_.tileBytes,
+                                      sparse_.tileWidth, sparse_.tileHeight, width, height, sparse_.tiledLevels,
+                                      sparseBudgetCap(sparseBudgetBytes(swapchainExtent_, sparse_.tileWidth,
+                                                                        sparse_.tileHeight, sparse_.tileBytes)))) {
+        return fail("residency tracking could not be initialized");
+    }
+
+    VkSemaphoreCreateInfo sci{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    if (vkCreateSemaphore(device_, &sci, nullptr, &sparse_.bindSemaphore) != VK_SUCCESS) {
+        sparse_.bindSemaphore = VK_NULL_HANDLE;
+        return fail("bind semaphore creation failed");
+    }
+
+    // The mip tail is small and bound once, opaquely, so a coarse image is always resident
+    const bool hasMipTail = sparse_.tiledLevels < mipLevels && colorReqs->imageMipTailSize > 0;
+    if (hasMipTail) {
+        VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        ai.allocationSize = colorReqs->imageMipTailSize;
+        ai.memoryTypeIndex = memoryType;
+        if (vkAllocateMemory(device_, &ai, nullptr, &sparse_.mipTailMemory) != VK_SUCCESS) {
+            sparse_.mipTailMemory = VK_NULL_HANDLE;
+            return fail("mip tail allocation failed");
+        }
 
-    // NASA Standard: Calculate tile size from sparse requirements
-    tileSize_ = std::max(sparseReqs[0].formatProperties.imageGranularity.width,
-                        sparseReqs[0].formatProperties.imageGranularity.height);
-
-    // NASA Standard: Initialize tile tracking structures
-    uint32_t tilesX = (width + tileSize_ - 1) / tileSize_;
-    uint32_t tilesY = (height + tileSize_ - 1) / tileSize_;
-    uint32_t totalTiles = tilesX * tilesY;
+        VkSparseMemoryBind tailBind{};
+        tailBind.resourceOffset = colorReqs->imageMipTailOffset;
+        tailBind.size = colorReqs->imageMipTailSize;
+        tailBind.memory = sparse_.mipTailMemory;
 
-    // NASA Standard: Validate tile count to prevent excessive memory allocation
-    const uint32_t maxTiles = 65536; // Reasonable limit
-    if (totalTiles > maxTiles) {
-        vkDestroyImage(device_, textureImage_, nullptr);
-        textureImage_ = VK_NULL_HANDLE;
-        textureIsSparse_ = false;
-        return false;
-    }
+        VkSparseImageOpaqueMemoryBindInfo opaqueInfo{};
+        opaqueInfo.image = textureImage_;
+        opaqueInfo.bindCount = 1;
+        opaqueInfo.pBinds = &tailBind;
 
-    imageTiles_.clear();
-    imageTiles_.resize(totalTiles);
+        VkBindSparseInfo bindInfo{ VK_STRUCTURE_TYPE_BIND_SPARSE_INFO };
+        bindInfo.imageOpaqueBindCount = 1;
+        bindInfo.pImageOpaqueBinds = &opaqueInfo;
+        bindInfo.signalSemaphoreCount = 1;
+        bindInfo.pSignalSemaphores = &sparse_.bindSemaphore;
 
-    // NASA Standard: Initialize tile information
-    for (uint32_t y = 0; y < tilesY; ++y) {
-        for (uint32_t x = 0; x < tilesX; ++x) {
-            uint32_t tileIndex = y * tilesX + x;
-            TileInfo& tile = imageTiles_[tileIndex];
-            tile.x = x * tileSize_;
-            tile.y = y * tileSize_;
-            tile.width = std::min(tileSize_, width - tile.x);
-            tile.height = std::min(tileSize_, height - tile.y);
-            tile.loaded = false;
-            tile.memory = VK_NULL_HANDLE;
-            tile.stagingBuffer = VK_NULL_HANDLE;
-            tile.stagingMemory = VK_NULL_HANDLE;
+        VkResult bindResult = vkQueueBindSparse(graphicsQueue_, 1, &bindInfo, VK_NULL_HANDLE);
+        if (!checkVulkanOperation(bindResult, deviceLost, swapchainOutOfDate)) {
+            if (deviceLost) deviceLost_ = true;
+            return fail("mip tail bind failed");
         }
     }
 
-    // NASA Standard: Set texture properties
+    if (!createImageView(textureImage_, format, mipLevels, textureView_)) {
+        return fail("view creation failed");
+    }
+
+    VkCommandBuffer cmd = beginSingleTimeCommands();
+    if (cmd == VK_NULL_HANDLE) {
+        return fail("no command buffer");
+    }
+
+    // GENERAL for the texture's lifetime: tiles are copied in while the rest is sampled
+    VkImageMemoryBarrier toGeneral{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    toGeneral.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toGeneral.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    toGeneral.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toGeneral.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toGeneral.image = textureImage_;
+    toGeneral.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    toGeneral.subresourceRange.levelCount = mipLevels;
+    toGeneral.subresourceRange.layerCount = 1;
+    toGeneral.srcAccessMask = 0;
+    toGeneral.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &toGeneral);
+
+    sparse_.src = static_cast<const uint8_t*>(pixelData);
+    sparse_.source = source;
+    sparse_.sourceWidth = sourceWidth;
+    sparse_.sourceHeight = sourceHeight;
+    sparse_.baseLevel = baseLevel;
     textureWidth_ = width;
     textureHeight_ = height;
+    textureMipLevels_ = mipLevels;
+    // A paged source may not have the tail decoded yet; pumpSparseTexture retries it
+    sparse_.tailPending = hasMipTail && !recordMipTail(cmd);
+
+    VkMemoryBarrier toShader{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    toShader.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toShader.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 1, &toShader, 0, nullptr, 0, nullptr);
+    endSingleTimeCommands(cmd, false, hasMipTail ? sparse_.bindSemaphore : VK_NULL_HANDLE);
+    if (deviceLost_) {
+        return fail("device lost during setup");
+    }
+
+    // NASA Standard: Set texture properties
+    ++textureGeneration_;
+    adoptPendingColorLut();
     textureFormat_ = format;
     textureIsHdr_ = isHdr;
     textureIsSparse_ = true;
-    textureLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
-    sparseImageSupport_ = true;
+    textureLayout_ = VK_IMAGE_LAYOUT_GENERAL;
 
+    Logger::Info("Sparse texture %ux%u: %ux%u tiles, %u tiled levels, budget %llu MB",
+                 width, height, sparse_.tileWidth, sparse_.tileHeight, sparse_.tiledLevels,
+                 static_cast<unsigned long long>(sparse_.residency.GetBudgetBytes() >> 20));
     return true;
 }
 
-void VulkanRenderer::LoadImageTile(uint32_t tileX, uint32_t tileY, const void* tileData, bool isHdr) {
-    // NASA Standard: Validate all input parameters
-    if (tileData == nullptr || !textureIsSparse_ || textureImage_ == VK_NULL_HANDLE) {
+void VulkanRenderer::pumpSparseTexture(float zoom, float offsetX, float offsetY, int rotationAngle, bool mirrored) {
+    if (!textureIsSparse_ || (sparse_.src == nullptr && sparse_.source == nullptr) ||
+        !sparse_.residency.IsInitialized() || deviceLost_ || !ensureStagingRing()) {
         return;
     }
 
-    // NASA Standard: Validate tile coordinates
-    uint32_t tilesX = (textureWidth_ + tileSize_ - 1) / tileSize_;
-    uint32_t tilesY = (textureHeight_ + tileSize_ - 1) / tileSize_;
-    if (tileX >= tilesX || tileY >= tilesY) {
+    const ImagePushConstants push = computeImagePush(zoom, offsetX, offsetY, rotationAngle, mirrored);
+    if (!(std::abs(push.halfSize[0]) > 0.0f) || !(push.halfSize[1] > 0.0f) ||
+        !std::isfinite(push.center[0]) || !std::isfinite(push.center[1])) {
         return;
     }
 
-    uint32_t tileIndex = tileY * tilesX + tileX;
-    if (tileIndex >= imageTiles_.size()) {
+    // Map the window corners back into level-0 texels through the inverse of the quad transform
+    const float texW = static_cast<float>(textureWidth_);
+    const float texH = static_cast<float>(textureHeight_);
+    const float cornersX[4] = { 0.0f, push.viewportSize[0], 0.0f, push.viewportSize[0] };
+    const float cornersY[4] = { 0.0f, 0.0f, push.viewportSize[1], push.viewportSize[1] };
+    float minX = texW, minY = texH, maxX = 0.0f, maxY = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        const float dx = cornersX[i] - push.center[0];
+        const float dy = cornersY[i] - push.center[1];
+        const float localX = dx * push.rotation[0] + dy * push.rotation[1];
+        const float localY = -dx * push.rotation[1] + dy * push.rotation[0];
+        const float u = (localX / push.halfSize[0] * 0.5f + 0.5f) * texW;
+        const float v = (localY / push.halfSize[1] * 0.5f + 0.5f) * texH;
+        minX = std::min(minX, u);
+        minY = std::min(minY, v);
+        maxX = std::max(maxX, u);
+        maxY = std::max(maxY, v);
+    }
+
+    // Trilinear filtering reads the level whose texels are just under a pixel and the next one up
+    const float texelsPerPixel = texW / (2.0f * std::abs(push.halfSize[0]));
+    const uint32_t finest = texelsPerPixel > 1.0f ? static_cast<uint32_t>(std::floor(std::log2(texelsPerPixel))) : 0u;
+
+    TileResidency& residency = sparse_.residency;
+    residency.BeginFrame();
+    const uint64_t serial = frameSerial_ + 1;   // The frame about to be recorded
+    for (uint32_t level : { finest + 1, finest }) {
+        if (level >= sparse_.tiledLevels) continue;
+        const float step = static_cast<float>(1u << level);
+        residency.Request(level,
+                          static_cast<int64_t>(std::floor(minX / step)) - 2, static_cast<int64_t>(std::floor(minY / step)) - 2,
+                          static_cast<int64_t>(std::ceil(maxX / step)) + 2, static_cast<int64_t>(std::ceil(maxY / step)) + 2,
+                          serial);
+    }
+    const bool tailDue = sparse_.tailPending;
+    if (!residency.HasQueued() && !tailDue) {
         return;
     }
 
-    TileInfo& tile = imageTiles_[tileIndex];
-
-    // NASA Standard: Skip if tile is already loaded
-    if (tile.loaded) {
+    // A larger window needs more tiles while VRAM allows; the budget never shrinks below what is pooled
+    residency.SetBudget(sparseBudgetCap(sparseBudgetBytes(swapchainExtent_, sparse_.tileWidth, sparse_.tileHeight,
+                                                          sparse_.tileBytes)));
+    sparse_.unbinds.clear();
+    sparse_.binds.clear();
+    residency.Schedule(kSparseTilesPerFrame, completedFrameSerial_, sparse_.unbinds, sparse_.binds);
+    if (sparse_.unbinds.empty() && sparse_.binds.empty() && !tailDue) {
         return;
     }
 
-    // NASA Standard: Calculate tile data size
-    uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
-    VkDeviceSize tileDataSize = static_cast<VkDeviceSize>(tile.width * tile.height * pixelSize);
+    // Stage every tile before binding so a full ring or a tile still decoding only
+    // defers that tile, never leaves it bound and empty
+    VkCommandBuffer cmd = (sparse_.binds.empty() && !tailDue) ? VK_NULL_HANDLE : beginSingleTimeCommands();
+    size_t staged = 0;
+    bool copied = false;
+    if (cmd != VK_NULL_HANDLE) {
+        // The copies overwrite texels earlier frames may still be sampling elsewhere in the image
+        VkMemoryBarrier toTransfer{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        toTransfer.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &toTransfer, 0, nullptr, 0, nullptr);
+
+        if (tailDue && recordMipTail(cmd)) {
+            sparse_.tailPending = false;
+            copied = true;
+        }
 
-    // NASA Standard: Validate tile data size
-    if (tileDataSize == 0 || tileDataSize > 0x10000000) { // 256MB limit per tile
-        return;
+        const VkDeviceSize alignment = std::max<VkDeviceSize>(stagingAlignment_, sparse_.pixelSize);
+        StagingRing::Allocation spare{};     // Staged for a tile that was not ready; reused for the next
+        for (size_t i = 0; i < sparse_.binds.size(); ++i) {
+            const TileResidency::Bind bind = sparse_.binds[i];
+            const VkDeviceSize bytes = static_cast<VkDeviceSize>(bind.width) * bind.height * sparse_.pixelSize;
+            StagingRing::Allocation staging{};
+            if (spare.size >= bytes) {
+                staging = spare;
+                spare = StagingRing::Allocation{};
+            } else if (!stagingRing_.Allocate(bytes, alignment, staging)) {
+                // Ring exhausted: what is left waits for a later frame
+                for (size_t j = i; j < sparse_.binds.size(); ++j) {
+                    residency.Cancel(sparse_.binds[j]);
+                }
+                break;
+            }
+            Trace::Scope copyTrace(Trace::Stage::StagingCopy);
+            if (!fillSparseRegion(staging.mapped, bind.level, bind.x, bind.y, bind.width, bind.height)) {
+                residency.Cancel(bind);
+                spare = staging;
+                continue;
+            }
+
+            VkBufferImageCopy region{};
+            region.bufferOffset = staging.offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = bind.level;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = { static_cast<int32_t>(bind.x), static_cast<int32_t>(bind.y), 0 };
+            region.imageExtent = { bind.width, bind.height, 1 };
+            vkCmdCopyBufferToImage(cmd, staging.buffer, textureImage_, VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+            sparse_.binds[staged++] = bind;
+            copied = true;
+        }
+    } else {
+        for (const TileResidency::Bind& bind : sparse_.binds) {
+            residency.Cancel(bind);
+        }
+    }
+    sparse_.binds.resize(staged);
+
+    // One bind submission per frame: evictions and new tiles together
+    std::vector<VkSparseImageMemoryBind> binds;
+    binds.reserve(sparse_.unbinds.size() + sparse_.binds.size());
+    for (const auto* list : { &sparse_.unbinds, &sparse_.binds }) {
+        for (const TileResidency::Bind& tile : *list) {
+            VkSparseImageMemoryBind bind{};
+            bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            bind.subresource.mipLevel = tile.level;
+            bind.offset = { static_cast<int32_t>(tile.x), static_cast<int32_t>(tile.y), 0 };
+            bind.extent = { tile.width, tile.height, 1 };
+            bind.memory = tile.memory;
+            bind.memoryOffset = tile.memoryOffset;
+            binds.push_back(bind);
+        }
     }
 
-    // NASA Standard: Allocate memory for this tile
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = tileDataSize;
-    allocInfo.memoryTypeIndex = findMemoryType(UINT32_MAX, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    // The copies wait on the binds only when they fill newly bound tiles
+    const bool waitForBinds = staged > 0;
+    if (!binds.empty()) {
+        VkSparseImageMemoryBindInfo imageBindInfo{};
+        imageBindInfo.image = textureImage_;
+        imageBindInfo.bindCount = static_cast<uint32_t>(binds.size());
+        imageBindInfo.pBinds = binds.data();
+
+        VkBindSparseInfo bindInfo{ VK_STRUCTURE_TYPE_BIND_SPARSE_INFO };
+        bindInfo.imageBindCount = 1;
+        bindInfo.pImageBinds = &imageBindInfo;
+        if (waitForBinds) {
+            // The copies wait on this semaphore instead of the host waiting for the queue
+            bindInfo.signalSemaphoreCount = 1;
+            bindInfo.pSignalSemaphores = &sparse_.bindSemaphore;
+        }
 
-    if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-        return; // No suitable memory type
+        bool deviceLost = false;
+        bool swapchainOutOfDate = false;
+        VkResult bindResult = vkQueueBindSparse(graphicsQueue_, 1, &bindInfo, VK_NULL_HANDLE);
+        if (!checkVulkanOperation(bindResult, deviceLost, swapchainOutOfDate)) {
+            if (deviceLost) deviceLost_ = true;
+            if (cmd != VK_NULL_HANDLE) {
+                vkEndCommandBuffer(cmd);
+                vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
+            }
+            return;
+        }
     }
 
-    bool deviceLost = false;
-    bool swapchainOutOfDate = false;
-    VkResult allocResult = vkAllocateMemory(device_, &allocInfo, nullptr, &tile.memory);
-    if (!checkVulkanOperation(allocResult, deviceLost, swapchainOutOfDate)) {
-        if (deviceLost) deviceLost_ = true;
+    if (cmd == VK_NULL_HANDLE) {
         return;
     }
-
-    // NASA Standard: Create staging buffer for tile data
-    if (!createStagingBuffer(tileDataSize, tile.stagingBuffer, tile.stagingMemory)) {
-        vkFreeMemory(device_, tile.memory, nullptr);
-        tile.memory = VK_NULL_HANDLE;
+    if (!copied) {
+        // Nothing fitted in the ring or was decoded yet; the tiles were released above
+        vkEndCommandBuffer(cmd);
+        vkFreeCommandBuffers(device_, commandPool_, 1, &cmd);
         return;
     }
 
-    // NASA Standard: Map and copy tile data
-    void* mapped = nullptr;
-    VkResult mapResult = vkMapMemory(device_, tile.stagingMemory, 0, tileDataSize, 0, &mapped);
-    if (!checkVulkanOperation(mapResult, deviceLost, swapchainOutOfDate)) {
-        if (deviceLost) deviceLost_ = true;
-        vkDestroyBuffer(device_, tile.stagingBuffer, nullptr);
-        vkFreeMemory(device_, tile.stagingMemory, nullptr);
-        vkFreeMemory(device_, tile.memory, nullptr);
-        tile.stagingBuffer = VK_NULL_HANDLE;
-        tile.stagingMemory = VK_NULL_HANDLE;
-        tile.memory = VK_NULL_HANDLE;
-        return;
-    }
+    VkMemoryBarrier toShader{ VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+    toShader.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toShader.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 1, &toShader, 0, nullptr, 0, nullptr);
+    endSingleTimeCommands(cmd, false, waitForBinds ? sparse_.bindSemaphore : VK_NULL_HANDLE);
+}
 
-    std::memcpy(mapped, tileData, static_cast<size_t>(tileDataSize));
-    vkUnmapMemory(device_, tile.stagingMemory);
-
-    // NASA Standard: Bind sparse memory for this tile
-    VkSparseImageMemoryBind bind{};
-    bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    bind.subresource.mipLevel = 0;
-    bind.subresource.arrayLayer = 0;
-    bind.offset = { static_cast<int32_t>(tile.x), static_cast<int32_t>(tile.y), 0 };
-    bind.extent = { tile.width, tile.height, 1 };
-    bind.memory = tile.memory;
-    bind.memoryOffset = 0;
-    bind.flags = 0;
-
-    VkSparseImageMemoryBindInfo imageBindInfo{};
-    imageBindInfo.image = textureImage_;
-    imageBindInfo.bindCount = 1;
-    imageBindInfo.pBinds = &bind;
-
-    VkBindSparseInfo bindInfo{};
-    bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
-    bindInfo.imageBindCount = 1;
-    bindInfo.pImageBinds = &imageBindInfo;
-
-    // NASA Standard: Submit sparse bind operation
-    VkResult bindResult = vkQueueBindSparse(graphicsQueue_, 1, &bindInfo, VK_NULL_HANDLE);
-    if (!checkVulkanOperation(bindResult, deviceLost, swapchainOutOfDate)) {
-        if (deviceLost) deviceLost_ = true;
-        vkDestroyBuffer(device_, tile.stagingBuffer, nullptr);
-        vkFreeMemory(device_, tile.stagingMemory, nullptr);
-        vkFreeMemory(device_, tile.memory, nullptr);
-        tile.stagingBuffer = VK_NULL_HANDLE;
-        tile.stagingMemory = VK_NULL_HANDLE;
-        tile.memory = VK_NULL_HANDLE;
-        return;
+bool VulkanRenderer::recordMipTail(VkCommandBuffer cmd) {
+    if (!ensureStagingRing()) {
+        return false;
     }
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(stagingAlignment_, sparse_.pixelSize);
+    for (uint32_t level = sparse_.tiledLevels; level < textureMipLevels_; ++level) {
+        const uint32_t levelW = std::max(1u, textureWidth_ >> level);
+        const uint32_t levelH = std::max(1u, textureHeight_ >> level);
+        StagingRing::Allocation staging{};
+        if (!stagingRing_.Allocate(static_cast<VkDeviceSize>(levelW) * levelH * sparse_.pixelSize, alignment, staging) ||
+            !fillSparseRegion(staging.mapped, level, 0, 0, levelW, levelH)) {
+            return false;   // Levels already recorded are simply copied again next time
+        }
 
-    // NASA Standard: Wait for sparse bind completion
-    vkQueueWaitIdle(graphicsQueue_);
-
-    // NASA Standard: Copy data from staging buffer to tile
-    VkCommandBuffer cmd = beginSingleTimeCommands();
-    if (cmd != VK_NULL_HANDLE) {
-        // Transition tile region to transfer destination
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = textureImage_;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        VkBufferImageCopy region{};
+        region.bufferOffset = staging.offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { levelW, levelH, 1 };
+        vkCmdCopyBufferToImage(cmd, staging.buffer, textureImage_, VK_IMAGE_LAYOUT_GENERAL, 1, &region);
+    }
+    return true;
+}
 
-        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                           0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-        // Copy from staging buffer to tile region
-        VkBufferImageCopy copyRegion{};
-        copyRegion.bufferOffset = 0;
-        copyRegion.bufferRowLength = 0;
-        copyRegion.bufferImageHeight = 0;
-        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        copyRegion.imageSubresource.mipLevel = 0;
-        copyRegion.imageSubresource.baseArrayLayer = 0;
-        copyRegion.imageSubresource.layerCount = 1;
-        copyRegion.imageOffset = { static_cast<int32_t>(tile.x), static_cast<int32_t>(tile.y), 0 };
-        copyRegion.imageExtent = { tile.width, tile.height, 1 };
-
-        vkCmdCopyBufferToImage(cmd, tile.stagingBuffer, textureImage_, 
-                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-
-        // Transition to shader read optimal
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+bool VulkanRenderer::fillSparseRegion(uint8_t* dst, uint32_t level, uint32_t x, uint32_t y,
+                                      uint32_t width, uint32_t height) {
+    // Texture level 'level' is source level 'level + baseLevel'
+    const uint32_t sourceLevel = level + sparse_.baseLevel;
+    if (sparse_.source != nullptr) {
+        return sparse_.source->ReadTile(sourceLevel, x, y, width, height, dst);
+    }
+    if (sparse_.src == nullptr) {
+        return false;
+    }
 
-        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                           0, 0, nullptr, 0, nullptr, 1, &barrier);
+    const uint32_t pixelSize = sparse_.pixelSize;
+    const size_t srcPitch = static_cast<size_t>(sparse_.sourceWidth) * pixelSize;
+    const size_t rowBytes = static_cast<size_t>(width) * pixelSize;
 
-        endSingleTimeCommands(cmd);
+    if (sourceLevel == 0) {
+        for (uint32_t row = 0; row < height; ++row) {
+            std::memcpy(dst + row * rowBytes,
+                        sparse_.src + static_cast<size_t>(y + row) * srcPitch + static_cast<size_t>(x) * pixelSize,
+                        rowBytes);
+        }
+        return true;
     }
 
-    // NASA Standard: Clean up staging resources
-    vkDestroyBuffer(device_, tile.stagingBuffer, nullptr);
-    vkFreeMemory(device_, tile.stagingMemory, nullptr);
-    tile.stagingBuffer = VK_NULL_HANDLE;
-    tile.stagingMemory = VK_NULL_HANDLE;
+    // Coarser levels point-sample level 0 so a tile costs the same whatever its level
+    for (uint32_t row = 0; row < height; ++row) {
+        const uint32_t srcY = std::min((y + row) << sourceLevel, sparse_.sourceHeight - 1);
+        const uint8_t* srcRow = sparse_.src + static_cast<size_t>(srcY) * srcPitch;
+        uint8_t* dstRow = dst + row * rowBytes;
+        for (uint32_t col = 0; col < width; ++col) {
+            const uint32_t srcX = std::min((x + col) << sourceLevel, sparse_.sourceWidth - 1);
+            std::memcpy(dstRow + static_cast<size_t>(col) * pixelSize,
+                        srcRow + static_cast<size_t>(srcX) * pixelSize, pixelSize);
+        }
+    }
+    return true;
+}
 
-    // NASA Standard: Mark tile as loaded
-    tile.loaded = true;
+void VulkanRenderer::destroySparseResources() {
+    sparse_.residency.Shutdown();
+    if (device_ != VK_NULL_HANDLE) {
+        if (sparse_.mipTailMemory != VK_NULL_HANDLE) {
+            vkFreeMemory(device_, sparse_.mipTailMemory, nullptr);
+        }
+        if (sparse_.bindSemaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(device_, sparse_.bindSemaphore, nullptr);
+        }
+    }
+    sparse_.mipTailMemory = VK_NULL_HANDLE;
+    sparse_.bindSemaphore = VK_NULL_HANDLE;
+    sparse_.src = nullptr;
+    sparse_.source = nullptr;
+    sparse_.sourceWidth = sparse_.sourceHeight = 0;
+    sparse_.baseLevel = 0;
+    sparse_.tailPending = false;
+    sparse_.pixelSize = 0;
+    sparse_.tileWidth = sparse_.tileHeight = 0;
+    sparse_.tileBytes = 0;
+    sparse_.tiledLevels = 0;
+    sparse_.unbinds.clear();
+    sparse_.binds.clear();
 }
 
 bool VulkanRenderer::initializeSoftwareFallback(HWND hwnd) {
@@ -1735,28 +3654,44 @@ bool VulkanRenderer::initializeSoftwareFallback(HWND hwnd) {
     return true;
 }
 
-void VulkanRenderer::renderSoftwareFallback(uint32_t width, uint32_t height) {
+bool VulkanRenderer::initializeSoftwareFallback(SDL_Window* window) {
+    // NASA Standard: Validate input parameters
+    if (window == nullptr) {
+        return false;
+    }
+    HWND hwnd = static_cast<HWND>(SDL_GetPointerProperty(SDL_GetWindowProperties(window),
+                                                         SDL_PROP_WINDOW_WIN32_HWND_POINTER, nullptr));
+    if (hwnd == nullptr || !initializeSoftwareFallback(hwnd)) {
+        return false;
+    }
+    Logger::Warn("Vulkan unavailable; drawing with the software fallback");
+    return true;
+}
+
+void VulkanRenderer::renderSoftwareFallback(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY,
+                                            int rotationAngle, bool mirrored) {
     // NASA Standard: Software fallback rendering
     if (fallbackBuffer_.empty() || fallbackHwnd_ == nullptr) {
         return;
     }
 
-    // NASA Standard: Update buffer size if window changed
-    if (width != fallbackWidth_ || height != fallbackHeight_) {
-        fallbackWidth_ = width;
-        fallbackHeight_ = height;
-        size_t bufferSize = static_cast<size_t>(width) * height * 4;
-        fallbackBuffer_.resize(bufferSize, 0);
+    // NASA Standard: Update buffer size if window changed. Rows are packed to the window
+    // width, so only a larger window needs more memory; shrinking keeps the allocation.
+    fallbackWidth_ = width;
+    fallbackHeight_ = height;
+    const size_t bufferSize = static_cast<size_t>(width) * height * 4;
+    if (bufferSize > fallbackBuffer_.size()) {
+        try {
+            fallbackBuffer_.resize(bufferSize);
+        } catch (const std::bad_alloc&) {
+            return; // NASA Standard: Handle memory allocation failure; skip the frame
+        }
     }
 
-    // NASA Standard: Clear to dark gray to indicate software mode
-    uint32_t clearColor = 0xFF404040; // Dark gray ARGB
-    uint32_t* pixels = reinterpret_cast<uint32_t*>(fallbackBuffer_.data());
-    size_t pixelCount = static_cast<size_t>(width) * height;
-
-    for (size_t i = 0; i < pixelCount; ++i) {
-        pixels[i] = clearColor;
-    }
+    // Black around the image as on the GPU; dark gray with no image marks software mode
+    const uint32_t background = fallbackImage_.HasImage() ? 0xFF000000u : 0xFF404040u;
+    fallbackImage_.Draw(fallbackBuffer_.data(), width, height, static_cast<size_t>(width) * 4, zoom, offsetX, offsetY,
+                        rotationAngle, mirrored, background);
 
     // NASA Standard: Display software-rendered content
     HDC hdc = GetDC(fallbackHwnd_);
@@ -1867,6 +3802,7 @@ void VulkanRenderer::LogVulkanObjectState() const {
     
     Logger::Error("Graphics Queue: 0x{:016X} (family: {})", (uintptr_t)graphicsQueue_, graphicsQueueFamily_);
     Logger::Error("Present Queue: 0x{:016X} (family: {})", (uintptr_t)presentQueue_, presentQueueFamily_);
+    Logger::Error("Transfer Queue: 0x{:016X} (family: {})", (uintptr_t)transferQueue_, transferQueueFamily_);
     
     Logger::Error("CommandPool: 0x{:016X} {}", (uintptr_t)commandPool_, 
                 commandPool_ != VK_NULL_HANDLE ? "(valid)" : "(NULL)");
@@ -1955,9 +3891,9 @@ bool VulkanRenderer::InitializeWithProgress(HWND hwnd, ProgressCallback cb) {
     return true;
 }
 
-bool VulkanRenderer::Initialize(SDL_Window* window) {
+bool VulkanRenderer::InitializeHeadless(uint32_t width, uint32_t height) {
     // NASA Standard: Validate input parameters
-    if (window == nullptr) {
+    if (width == 0 || height == 0 || width > 65536 || height > 65536) {
         return false;
     }
 
@@ -1965,20 +3901,15 @@ bool VulkanRenderer::Initialize(SDL_Window* window) {
     deviceLost_ = false;
     swapchainOutOfDate_ = false;
     vulkanAvailable_ = false;
+    headless_ = true;
 
-    // NASA Standard: Attempt Vulkan initialization with full error protection
     if (!initInstance()) {
-        // NASA Standard: Vulkan unavailable - for SDL3 we don't have software fallback yet
-        return false;
-    }
-
-    if (!createSurface(window)) {
-        Shutdown(); // Clean up instance on failure
+        headless_ = false;
         return false;
     }
 
     if (!pickPhysicalDevice()) {
-        Shutdown(); // Clean up instance and surface on failure
+        Shutdown(); // Clean up instance on failure
         return false;
     }
 
@@ -1992,13 +3923,8 @@ bool VulkanRenderer::Initialize(SDL_Window* window) {
         return false;
     }
 
-    // Get initial window size for swapchain
-    int width, height;
-    SDL_GetWindowSize(window, &width, &height);
-    if (width <= 0) width = 800;
-    if (height <= 0) height = 600;
-
-    if (!createSwapchain(static_cast<uint32_t>(width), static_cast<uint32_t>(height))) {
+    // Offscreen targets stand in for the swapchain
+    if (!createSwapchain(width, height)) {
         Shutdown(); // Clean up all previous resources on failure
         return false;
     }
@@ -2013,6 +3939,97 @@ bool VulkanRenderer::Initialize(SDL_Window* window) {
     return true;
 }
 
+bool VulkanRenderer::Initialize(SDL_Window* window) {
+    return BeginInitialize(window) && FinishInitialize();
+}
+
+bool VulkanRenderer::BeginInitialize(SDL_Window* window) {
+    // NASA Standard: Validate input parameters
+    if (window == nullptr || initPending_) {
+        return false;
+    }
+
+    // NASA Standard: Initialize all member variables to safe states
+    deviceLost_ = false;
+    swapchainOutOfDate_ = false;
+    vulkanAvailable_ = false;
+    initDeviceOk_ = false;
+    initPending_ = true;
+    initWindow_ = window;
+
+    // Only text needs the fonts, so the first text drawn waits for them rather than startup
+    if (!fontThread_.joinable() && !textRenderer_.IsReady()) {
+        try {
+            fontThread_ = std::thread([this]() {
+                Trace::NameThread("fonts");
+                initializeTextRenderer();
+            });
+        } catch (const std::exception& e) {
+            Logger::Warn("Font loader thread unavailable (%s); loading fonts inline", e.what());
+            initializeTextRenderer();
+        }
+    }
+
+    // Instance, surface and device creation never message the window, so they can run
+    // off its thread while the caller starts decoding; the swapchain waits for FinishInitialize()
+    try {
+        initThread_ = std::thread([this, window]() {
+            Trace::NameThread("vulkan init");
+            initDeviceOk_ = initDevice(window);
+        });
+    } catch (const std::exception& e) {
+        Logger::Warn("Vulkan init thread unavailable (%s); creating the device inline", e.what());
+        initDeviceOk_ = initDevice(window);
+    }
+    return true;
+}
+
+bool VulkanRenderer::initDevice(SDL_Window* window) {
+    // NASA Standard: Attempt Vulkan initialization with full error protection
+    if (!initInstance()) {
+        // NASA Standard: Vulkan unavailable - FinishInitialize() sets up the software fallback
+        return false;
+    }
+
+    // Failures are cleaned up by FinishInitialize() on the window's thread
+    if (!createSurface(window) || !pickPhysicalDevice() || !createDeviceAndQueues() || !createCommandPool()) {
+        return false;
+    }
+
+    // Read while the caller is still busy; the pipelines are built with the swapchain
+    loadPipelineCache();
+    return true;
+}
+
+bool VulkanRenderer::FinishInitialize() {
+    if (!initPending_) {
+        return false;
+    }
+    if (initThread_.joinable()) {
+        initThread_.join();
+    }
+    initPending_ = false;
+    if (!initDeviceOk_) {
+        Shutdown(); // Clean up whatever the device thread created
+        return initializeSoftwareFallback(initWindow_);
+    }
+
+    // Get initial window size for swapchain
+    int width, height;
+    SDL_GetWindowSize(initWindow_, &width, &height);
+    if (width <= 0) width = 800;
+    if (height <= 0) height = 600;
+
+    if (!createSwapchain(static_cast<uint32_t>(width), static_cast<uint32_t>(height)) || !createSyncObjects()) {
+        Shutdown(); // Clean up all previous resources on failure
+        return initializeSoftwareFallback(initWindow_);
+    }
+
+    // NASA Standard: Mark Vulkan as available after successful initialization
+    vulkanAvailable_ = true;
+    return true;
+}
+
 bool VulkanRenderer::InitializeWithProgress(SDL_Window* window, ProgressCallback cb) {
     // NASA Standard: Validate input parameters
     if (window == nullptr) {
@@ -2082,155 +4099,565 @@ bool VulkanRenderer::InitializeWithProgress(SDL_Window* window, ProgressCallback
 }
 
 // Instructional UI rendering using SDL3_ttf text renderer
-void VulkanRenderer::RenderInstructionalUI(VkCommandBuffer cmd, VkImage swapchainImage, uint32_t width, uint32_t height) {
+void VulkanRenderer::SetOverlayText(const std::string& text) {
+    if (text != hudText_) {
+        hudText_ = text;
+    }
+}
+
+void VulkanRenderer::writeImageDescriptor(VkDescriptorSet set, VkImageView view, VkImageLayout layout) {
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = layout;
+    VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = set;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+}
+
+void VulkanRenderer::writeLutDescriptor(VkDescriptorSet set, VkImageView view) {
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    VkWriteDescriptorSet write{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = set;
+    write.dstBinding = 1;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+}
+
+bool VulkanRenderer::ensureInstructionalOverlay(uint32_t width, uint32_t height) {
     // NASA Standard: Validate all input parameters
-    if (cmd == VK_NULL_HANDLE || swapchainImage == VK_NULL_HANDLE || width == 0 || height == 0) {
-        return;
+    if (width == 0 || height == 0 || !waitForText()) {
+        return false;
     }
-    
-    // Check if text renderer is available
-    if (!textRenderer_.IsReady()) {
-        // Fallback to simple color clear if text renderer isn't available
-        VkClearColorValue instructionalBackground = {{0.1f, 0.1f, 0.2f, 1.0f}}; // Dark blue background
-        VkImageSubresourceRange fullRange{};
-        fullRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        fullRange.baseMipLevel = 0;
-        fullRange.levelCount = 1;
-        fullRange.baseArrayLayer = 0;
-        fullRange.layerCount = 1;
-        
-        vkCmdClearColorImage(cmd, swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                           &instructionalBackground, 1, &fullRange);
-        return;
+
+    OverlayKey key;
+    key.width = width;
+    key.height = height;
+    key.openColorIOAvailable = (colorLut_.view != VK_NULL_HANDLE || pendingColorLut_.view != VK_NULL_HANDLE);
+    for (const std::string& line : textRenderer_.GetInstructionalText(key.openColorIOAvailable)) {
+        key.text += line;
+        key.text += '\n';
     }
-    
-    // Create instructional UI surface with proper text
-    bool openColorIOAvailable = (colorProcessor_ != nullptr);
-    SDL_Surface* textSurface = textRenderer_.CreateInstructionalSurface(width, height, openColorIOAvailable);
+    if (instructionalOverlay_.view != VK_NULL_HANDLE && instructionalOverlay_.key == key) {
+        return true;
+    }
+
+    // Key changed (resize, OCIO toggled, new text): rasterize once and keep it resident
+    SDL_Surface* textSurface = textRenderer_.CreateInstructionalSurface(static_cast<int>(width), static_cast<int>(height),
+                                                                        key.openColorIOAvailable);
     if (!textSurface) {
         Logger::Error("Failed to create instructional text surface");
-        return;
+        return instructionalOverlay_.view != VK_NULL_HANDLE;
     }
-    
-    // Convert surface to RGBA pixel data
     std::vector<uint8_t> pixelData = textRenderer_.SurfaceToRGBA(textSurface);
     SDL_DestroySurface(textSurface);
-    
-    if (pixelData.empty()) {
+    if (pixelData.size() != static_cast<size_t>(width) * height * 4) {
         Logger::Error("Failed to convert text surface to pixel data");
+        return instructionalOverlay_.view != VK_NULL_HANDLE;
+    }
+
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (!createImageResource(width, height, VK_FORMAT_R8G8B8A8_SRGB, 1, image, memory) ||
+        !uploadImageRegion(image, layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           pixelData.data(), static_cast<VkDeviceSize>(width) * 4, 4, 0, 0, width, height) ||
+        !createImageView(image, VK_FORMAT_R8G8B8A8_SRGB, 1, view)) {
+        // The upload may have been submitted, so let the retire path free it
+        retireTexture(image, memory, view, nextUploadSerial_ - 1, frameSerial_);
+        Logger::Error("Failed to upload the instructional overlay (%ux%u)", width, height);
+        return instructionalOverlay_.view != VK_NULL_HANDLE;
+    }
+
+    // Frames already submitted may still sample the previous overlay
+    if (instructionalOverlay_.view != VK_NULL_HANDLE) {
+        retireTexture(instructionalOverlay_.image, instructionalOverlay_.memory, instructionalOverlay_.view,
+                      nextUploadSerial_ - 1, frameSerial_);
+    }
+    instructionalOverlay_.image = image;
+    instructionalOverlay_.memory = memory;
+    instructionalOverlay_.view = view;
+    instructionalOverlay_.key = std::move(key);
+    ++instructionalOverlay_.generation;
+    return true;
+}
+
+bool VulkanRenderer::ensureGlyphAtlas() {
+    if (glyphAtlasView_ == VK_NULL_HANDLE) {
+        waitForText();
+        const TextRenderer::GlyphAtlas* atlas = textRenderer_.GetGlyphAtlas();
+        if (!atlas) {
+            return false;
+        }
+        const uint32_t w = static_cast<uint32_t>(atlas->width);
+        const uint32_t h = static_cast<uint32_t>(atlas->height);
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // UNORM: coverage is linear and the overlay colours are blended as given
+        if (!createImageResource(w, h, VK_FORMAT_R8G8B8A8_UNORM, 1, glyphAtlasImage_, glyphAtlasMemory_) ||
+            !uploadImageRegion(glyphAtlasImage_, layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                               atlas->pixels.data(), static_cast<VkDeviceSize>(w) * 4, 4, 0, 0, w, h) ||
+            !createImageView(glyphAtlasImage_, VK_FORMAT_R8G8B8A8_UNORM, 1, glyphAtlasView_)) {
+            Logger::Error("Failed to upload the %ux%u glyph atlas", w, h);
+            retireTexture(glyphAtlasImage_, glyphAtlasMemory_, glyphAtlasView_, nextUploadSerial_ - 1, frameSerial_);
+            glyphAtlasImage_ = VK_NULL_HANDLE;
+            glyphAtlasMemory_ = VK_NULL_HANDLE;
+            glyphAtlasView_ = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+
+    // The set lives in descriptorPool_, which is rebuilt with the pipeline
+    if (!glyphAtlasSetWritten_ && glyphAtlasSet_ != VK_NULL_HANDLE) {
+        writeImageDescriptor(glyphAtlasSet_, glyphAtlasView_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        glyphAtlasSetWritten_ = true;
+    }
+    return glyphAtlasSetWritten_;
+}
+
+bool VulkanRenderer::ensureHudBuffers() {
+    if (hudBuffers_[0] != VK_NULL_HANDLE) {
+        return true;
+    }
+    if (!createFrameVertexBuffers(sizeof(TextRenderer::GlyphQuad) * kMaxHudGlyphs, hudBuffers_, hudMemory_, hudMapped_)) {
+        return false;
+    }
+    hudQuads_.reserve(kMaxHudGlyphs);
+    return true;
+}
+
+void VulkanRenderer::destroyHudBuffers() {
+    destroyFrameVertexBuffers(hudBuffers_, hudMemory_, hudMapped_);
+}
+
+bool VulkanRenderer::createFrameVertexBuffers(VkDeviceSize size, VkBuffer (&buffers)[MAX_FRAMES_IN_FLIGHT],
+                                              VkDeviceMemory (&memory)[MAX_FRAMES_IN_FLIGHT],
+                                              void* (&mapped)[MAX_FRAMES_IN_FLIGHT]) {
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        VkBufferCreateInfo bci{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bci.size = size;
+        bci.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(device_, &bci, nullptr, &buffers[i]) != VK_SUCCESS) {
+            buffers[i] = VK_NULL_HANDLE;
+            destroyFrameVertexBuffers(buffers, memory, mapped);
+            return false;
+        }
+
+        VkMemoryRequirements req{};
+        vkGetBufferMemoryRequirements(device_, buffers[i], &req);
+        VkMemoryAllocateInfo ai{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        ai.allocationSize = req.size;
+        ai.memoryTypeIndex = findMemoryType(req.memoryTypeBits,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        if (ai.memoryTypeIndex == UINT32_MAX ||
+            vkAllocateMemory(device_, &ai, nullptr, &memory[i]) != VK_SUCCESS ||
+            vkBindBufferMemory(device_, buffers[i], memory[i], 0) != VK_SUCCESS ||
+            vkMapMemory(device_, memory[i], 0, VK_WHOLE_SIZE, 0, &mapped[i]) != VK_SUCCESS) {
+            destroyFrameVertexBuffers(buffers, memory, mapped);
+            return false;
+        }
+    }
+    return true;
+}
+
+void VulkanRenderer::destroyFrameVertexBuffers(VkBuffer (&buffers)[MAX_FRAMES_IN_FLIGHT],
+                                               VkDeviceMemory (&memory)[MAX_FRAMES_IN_FLIGHT],
+                                               void* (&mapped)[MAX_FRAMES_IN_FLIGHT]) {
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        if (mapped[i]) vkUnmapMemory(device_, memory[i]);
+        if (buffers[i]) vkDestroyBuffer(device_, buffers[i], nullptr);
+        if (memory[i]) vkFreeMemory(device_, memory[i], nullptr);
+        mapped[i] = nullptr;
+        buffers[i] = VK_NULL_HANDLE;
+        memory[i] = VK_NULL_HANDLE;
+    }
+}
+
+void VulkanRenderer::recordHudText(VkCommandBuffer cmd, const VkViewport& viewport, const VkRect2D& scissor) {
+    if (hudText_.empty() || textPipeline_ == VK_NULL_HANDLE) {
         return;
     }
-    
-    // Create a temporary texture to upload the text data
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-    VkDeviceSize dataSize = pixelData.size();
-    
-    if (!createStagingBuffer(dataSize, stagingBuffer, stagingMemory)) {
-        Logger::Error("Failed to create staging buffer for text overlay");
+    if (!ensureGlyphAtlas() || !ensureHudBuffers()) {
         return;
     }
-    
-    // Upload pixel data to staging buffer
-    void* mapped = nullptr;
-    bool deviceLost = false;
-    bool swapchainOutOfDate = false;
-    VkResult mapResult = vkMapMemory(device_, stagingMemory, 0, dataSize, 0, &mapped);
-    if (!checkVulkanOperation(mapResult, deviceLost, swapchainOutOfDate)) {
-        if (deviceLost) deviceLost_ = true;
-        vkDestroyBuffer(device_, stagingBuffer, nullptr);
-        vkFreeMemory(device_, stagingMemory, nullptr);
+
+    // Top-left block on a translucent backdrop so it stays legible over any image
+    constexpr float kMargin = 10.0f;
+    constexpr float kPadding = 6.0f;
+    int textW = 0, textH = 0;
+    textRenderer_.MeasureText(hudText_, &textW, &textH);
+
+    hudQuads_.clear();
+    textRenderer_.AddSolidQuad(kMargin - kPadding, kMargin - kPadding,
+                               kMargin + static_cast<float>(textW) + kPadding,
+                               kMargin + static_cast<float>(textH) + kPadding,
+                               SDL_Color{ 0, 0, 0, 160 }, hudQuads_);
+    textRenderer_.LayoutText(hudText_, kMargin, kMargin, SDL_Color{ 235, 235, 235, 255 }, hudQuads_);
+
+    // This slot's fence has signalled, so its vertex buffer is free to overwrite
+    const uint32_t quadCount = static_cast<uint32_t>(std::min<size_t>(hudQuads_.size(), kMaxHudGlyphs));
+    std::memcpy(hudMapped_[currentFrame_], hudQuads_.data(), sizeof(TextRenderer::GlyphQuad) * quadCount);
+
+    ImagePushConstants push{};
+    push.viewportSize[0] = viewport.width;
+    push.viewportSize[1] = viewport.height;
+    const VkDeviceSize offset = 0;
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, textPipeline_);
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 0, 1, &glyphAtlasSet_, 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+    vkCmdBindVertexBuffers(cmd, 0, 1, &hudBuffers_[currentFrame_], &offset);
+    vkCmdDraw(cmd, 4, quadCount, 0, 0);
+}
+
+void VulkanRenderer::destroyOverlayResources() {
+    if (!device_) return;
+    if (instructionalOverlay_.view) vkDestroyImageView(device_, instructionalOverlay_.view, nullptr);
+    if (instructionalOverlay_.image) vkDestroyImage(device_, instructionalOverlay_.image, nullptr);
+    if (instructionalOverlay_.memory) vkFreeMemory(device_, instructionalOverlay_.memory, nullptr);
+    // Keep the generation monotonic so no frame slot mistakes a new overlay for the old one
+    const uint64_t generation = instructionalOverlay_.generation;
+    instructionalOverlay_ = OverlayTexture{};
+    instructionalOverlay_.generation = generation;
+
+    if (glyphAtlasView_) vkDestroyImageView(device_, glyphAtlasView_, nullptr);
+    if (glyphAtlasImage_) vkDestroyImage(device_, glyphAtlasImage_, nullptr);
+    if (glyphAtlasMemory_) vkFreeMemory(device_, glyphAtlasMemory_, nullptr);
+    glyphAtlasView_ = VK_NULL_HANDLE;
+    glyphAtlasImage_ = VK_NULL_HANDLE;
+    glyphAtlasMemory_ = VK_NULL_HANDLE;
+    glyphAtlasSetWritten_ = false;
+
+    destroyHudBuffers();
+}
+
+bool VulkanRenderer::SetThumbnail(uint32_t cell, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    // NASA Standard: Validate all input parameters
+    if (rgba == nullptr || cell >= kThumbnailCells || width == 0 || height == 0 ||
+        width > kThumbnailCellSize || height > kThumbnailCellSize || !vulkanAvailable_) {
+        return false;
+    }
+
+    // A cell refilled before its last contents went up only needs the newest pixels
+    auto it = std::find_if(pendingThumbnails_.begin(), pendingThumbnails_.end(),
+                           [cell](const PendingThumbnail& pending) { return pending.cell == cell; });
+    if (it == pendingThumbnails_.end()) {
+        pendingThumbnails_.emplace_back();
+        it = pendingThumbnails_.end() - 1;
+    }
+    it->cell = cell;
+    it->width = width;
+    it->height = height;
+    it->rgba.assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    return true;
+}
+
+void VulkanRenderer::SetThumbnailGrid(const std::vector<GridQuad>& quads, bool coverImage) {
+    gridQuads_.assign(quads.begin(), quads.begin() + std::min<size_t>(quads.size(), kMaxGridQuads));
+    gridCoversImage_ = coverImage;
+}
+
+bool VulkanRenderer::ensureThumbnailAtlas() {
+    if (thumbnailAtlasView_ == VK_NULL_HANDLE) {
+        constexpr uint32_t kRows = (kThumbnailCells + 1 + kThumbnailAtlasColumns - 1) / kThumbnailAtlasColumns;
+        constexpr uint32_t kWidth = kThumbnailAtlasColumns * kThumbnailCellSize;
+        constexpr uint32_t kHeight = kRows * kThumbnailCellSize;
+        // Within the 4096 every device supports
+        static_assert(kWidth <= 4096 && kHeight <= 4096, "Thumbnail atlas exceeds the guaranteed image size");
+
+        // sRGB like the instructional overlay: the thumbnails are display-encoded
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        bool created = createImageResource(kWidth, kHeight, VK_FORMAT_R8G8B8A8_SRGB, 1, image, memory) &&
+                       createImageView(image, VK_FORMAT_R8G8B8A8_SRGB, 1, view);
+        if (created) {
+            cmd = beginSingleTimeCommands();
+            created = cmd != VK_NULL_HANDLE;
+        }
+        if (created) {
+            // Every cell starts white; the last one is never handed out and stays that way for solid fills
+            transitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+            const VkClearColorValue white{ { 1.0f, 1.0f, 1.0f, 1.0f } };
+            VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            vkCmdClearColorImage(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &white, 1, &range);
+            transitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            created = endSingleTimeCommands(cmd) != 0;
+        }
+        if (!created) {
+            Logger::Error("Failed to create the %ux%u thumbnail atlas", kWidth, kHeight);
+            retireTexture(image, memory, view, nextUploadSerial_ - 1, frameSerial_);
+            return false;
+        }
+        thumbnailAtlasImage_ = image;
+        thumbnailAtlasMemory_ = memory;
+        thumbnailAtlasView_ = view;
+        thumbnailAtlasLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    // The set lives in descriptorPool_, which is rebuilt with the pipeline
+    if (!thumbnailAtlasSetWritten_ && thumbnailAtlasSet_ != VK_NULL_HANDLE) {
+        writeImageDescriptor(thumbnailAtlasSet_, thumbnailAtlasView_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        thumbnailAtlasSetWritten_ = true;
+    }
+    return thumbnailAtlasSetWritten_;
+}
+
+void VulkanRenderer::uploadPendingThumbnails() {
+    if (pendingThumbnails_.empty() || deviceLost_ || thumbnailPipeline_ == VK_NULL_HANDLE) {
         return;
     }
-    
-    std::memcpy(mapped, pixelData.data(), dataSize);
-    vkUnmapMemory(device_, stagingMemory);
-    
-    // Create temporary image for text overlay
-    VkImage tempImage = VK_NULL_HANDLE;
-    VkDeviceMemory tempMemory = VK_NULL_HANDLE;
-    
-    VkImageCreateInfo ii{};
-    ii.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    ii.imageType = VK_IMAGE_TYPE_2D;
-    ii.extent = { width, height, 1 };
-    ii.mipLevels = 1;
-    ii.arrayLayers = 1;
-    ii.format = VK_FORMAT_R8G8B8A8_SRGB;
-    ii.tiling = VK_IMAGE_TILING_OPTIMAL;
-    ii.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    ii.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-    ii.samples = VK_SAMPLE_COUNT_1_BIT;
-    ii.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-    if (vkCreateImage(device_, &ii, nullptr, &tempImage) == VK_SUCCESS) {
-        VkMemoryRequirements req{};
-        vkGetImageMemoryRequirements(device_, tempImage, &req);
-        
-        VkMemoryAllocateInfo ai{};
-        ai.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        ai.allocationSize = req.size;
-        ai.memoryTypeIndex = findMemoryType(req.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        
-        if (ai.memoryTypeIndex != UINT32_MAX && vkAllocateMemory(device_, &ai, nullptr, &tempMemory) == VK_SUCCESS) {
-            vkBindImageMemory(device_, tempImage, tempMemory, 0);
-            
-            // Transition temp image to transfer dst
-            VkImageMemoryBarrier barrier{};
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barrier.image = tempImage;
-            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            barrier.subresourceRange.levelCount = 1;
-            barrier.subresourceRange.layerCount = 1;
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            
-            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                               0, 0, nullptr, 0, nullptr, 1, &barrier);
-            
-            // Copy from staging buffer to temp image
-            VkBufferImageCopy copyRegion{};
-            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            copyRegion.imageSubresource.layerCount = 1;
-            copyRegion.imageExtent = { width, height, 1 };
-            vkCmdCopyBufferToImage(cmd, stagingBuffer, tempImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-            
-            // Transition temp image to transfer src
-            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-            
-            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                               0, 0, nullptr, 0, nullptr, 1, &barrier);
-            
-            // Blit temp image to swapchain image
-            VkImageBlit blit{};
-            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.srcSubresource.layerCount = 1;
-            blit.srcOffsets[1] = { static_cast<int32_t>(width), static_cast<int32_t>(height), 1 };
-            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            blit.dstSubresource.layerCount = 1;
-            blit.dstOffsets[1] = { static_cast<int32_t>(width), static_cast<int32_t>(height), 1 };
-            
-            vkCmdBlitImage(cmd, tempImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                         swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_NEAREST);
+    if (!ensureThumbnailAtlas() || !ensureStagingRing()) {
+        return;
+    }
+
+    Trace::Scope uploadTrace(Trace::Stage::Upload);
+    VkCommandBuffer cmd = beginSingleTimeCommands();
+    if (cmd == VK_NULL_HANDLE) {
+        return;
+    }
+    // Earlier frames sampling the atlas are ordered before this on the graphics queue
+    transitionImageLayout(cmd, thumbnailAtlasImage_, thumbnailAtlasLayout_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    // One submission for the batch; the rest wait for later frames so a folder's worth
+    // of thumbnails arriving at once never stalls a frame
+    const size_t limit = std::min<size_t>(pendingThumbnails_.size(), kThumbnailUploadsPerFrame);
+    size_t uploaded = 0;
+    for (; uploaded < limit; ++uploaded) {
+        const PendingThumbnail& thumbnail = pendingThumbnails_[uploaded];
+        const VkDeviceSize bytes = static_cast<VkDeviceSize>(thumbnail.rgba.size());
+        StagingRing::Allocation staging{};
+        if (!stagingRing_.Allocate(bytes, stagingAlignment_, staging)) {
+            break;      // Ring busy with a large upload: try again next frame
         }
+        {
+            Trace::Scope copyTrace(Trace::Stage::StagingCopy);
+            std::memcpy(staging.mapped, thumbnail.rgba.data(), thumbnail.rgba.size());
+        }
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = staging.offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = { static_cast<int32_t>((thumbnail.cell % kThumbnailAtlasColumns) * kThumbnailCellSize),
+                               static_cast<int32_t>((thumbnail.cell / kThumbnailAtlasColumns) * kThumbnailCellSize), 0 };
+        region.imageExtent = { thumbnail.width, thumbnail.height, 1 };
+        vkCmdCopyBufferToImage(cmd, staging.buffer, thumbnailAtlasImage_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
     }
-    
-    // Clean up temporary resources
-    if (tempImage != VK_NULL_HANDLE) {
-        vkDestroyImage(device_, tempImage, nullptr);
+
+    transitionImageLayout(cmd, thumbnailAtlasImage_, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    thumbnailAtlasLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    endSingleTimeCommands(cmd);
+    pendingThumbnails_.erase(pendingThumbnails_.begin(), pendingThumbnails_.begin() + uploaded);
+}
+
+void VulkanRenderer::recordThumbnailGrid(VkCommandBuffer cmd, const VkViewport& viewport, const VkRect2D& scissor) {
+    if (gridQuads_.empty() || thumbnailPipeline_ == VK_NULL_HANDLE) {
+        return;
+    }
+    if (!ensureThumbnailAtlas()) {
+        return;
+    }
+    if (gridBuffers_[0] == VK_NULL_HANDLE &&
+        !createFrameVertexBuffers(sizeof(TextRenderer::GlyphQuad) * kMaxGridQuads, gridBuffers_, gridMemory_, gridMapped_)) {
+        return;
+    }
+
+    constexpr float kAtlasWidth = static_cast<float>(kThumbnailAtlasColumns * kThumbnailCellSize);
+    constexpr float kAtlasHeight = static_cast<float>(
+        (kThumbnailCells + 1 + kThumbnailAtlasColumns - 1) / kThumbnailAtlasColumns * kThumbnailCellSize);
+    auto cellOrigin = [](uint32_t cell, float& u, float& v) {
+        u = static_cast<float>((cell % kThumbnailAtlasColumns) * kThumbnailCellSize) / kAtlasWidth;
+        v = static_cast<float>((cell / kThumbnailAtlasColumns) * kThumbnailCellSize) / kAtlasHeight;
+    };
+    float solidU = 0.0f, solidV = 0.0f;
+    cellOrigin(kThumbnailCells, solidU, solidV);
+    solidU += 0.5f * kThumbnailCellSize / kAtlasWidth;
+    solidV += 0.5f * kThumbnailCellSize / kAtlasHeight;
+
+    // This slot's fence has signalled, so its vertex buffer is free to overwrite
+    auto* out = static_cast<TextRenderer::GlyphQuad*>(gridMapped_[currentFrame_]);
+    uint32_t quadCount = 0;
+    for (const GridQuad& quad : gridQuads_) {
+        TextRenderer::GlyphQuad& glyph = out[quadCount];
+        std::copy(std::begin(quad.rect), std::end(quad.rect), glyph.rect);
+        if (quad.cell < kThumbnailCells && quad.width > 0 && quad.height > 0) {
+            // Inset half a texel so filtering never reaches a neighbouring cell's texels
+            float u = 0.0f, v = 0.0f;
+            cellOrigin(quad.cell, u, v);
+            glyph.uv[0] = u + 0.5f / kAtlasWidth;
+            glyph.uv[1] = v + 0.5f / kAtlasHeight;
+            glyph.uv[2] = u + (static_cast<float>(std::min(quad.width, kThumbnailCellSize)) - 0.5f) / kAtlasWidth;
+            glyph.uv[3] = v + (static_cast<float>(std::min(quad.height, kThumbnailCellSize)) - 0.5f) / kAtlasHeight;
+        } else {
+            glyph.uv[0] = glyph.uv[2] = solidU;
+            glyph.uv[1] = glyph.uv[3] = solidV;
+        }
+        glyph.color[0] = quad.color.r / 255.0f;
+        glyph.color[1] = quad.color.g / 255.0f;
+        glyph.color[2] = quad.color.b / 255.0f;
+        glyph.color[3] = quad.color.a / 255.0f;
+        ++quadCount;
+    }
+
+    ImagePushConstants push{};
+    push.viewportSize[0] = viewport.width;
+    push.viewportSize[1] = viewport.height;
+    const VkDeviceSize offset = 0;
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, thumbnailPipeline_);
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 0, 1, &thumbnailAtlasSet_, 0, nullptr);
+    vkCmdPushConstants(cmd, pipelineLayout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+    vkCmdBindVertexBuffers(cmd, 0, 1, &gridBuffers_[currentFrame_], &offset);
+    vkCmdDraw(cmd, 4, quadCount, 0, 0);
+}
+
+void VulkanRenderer::destroyThumbnailResources() {
+    if (!device_) return;
+    if (thumbnailAtlasView_) vkDestroyImageView(device_, thumbnailAtlasView_, nullptr);
+    if (thumbnailAtlasImage_) vkDestroyImage(device_, thumbnailAtlasImage_, nullptr);
+    if (thumbnailAtlasMemory_) vkFreeMemory(device_, thumbnailAtlasMemory_, nullptr);
+    thumbnailAtlasView_ = VK_NULL_HANDLE;
+    thumbnailAtlasImage_ = VK_NULL_HANDLE;
+    thumbnailAtlasMemory_ = VK_NULL_HANDLE;
+    thumbnailAtlasLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+    thumbnailAtlasSetWritten_ = false;
+    pendingThumbnails_.clear();
+    destroyFrameVertexBuffers(gridBuffers_, gridMemory_, gridMapped_);
+}
+
+uint32_t VulkanRenderer::BeginSequence(uint32_t slots, uint32_t width, uint32_t height, bool isHdr) {
+    // NASA Standard: Validate all input parameters
+    if (slots < 2 || width == 0 || height == 0 || width > 65536 || height > 65536 ||
+        !vulkanAvailable_ || !device_ || deviceLost_) {
+        return 0;
+    }
+    EndSequence();
+    // Every slot is a plain dense texture; frames too large for one are not played
+    if (static_cast<uint64_t>(width) * height > kMaxDensePixels) {
+        Logger::Warn("Sequence frames of %ux%u are too large to play", width, height);
+        return 0;
+    }
+
+    // Sparse residency has no place in the ring; the outgoing image goes before the slots are made
+    CancelPendingUpload();
+    if (textureIsSparse_) {
+        destroyTexture();
+    }
+    destroyRetiredTextures(false);
+
+    const uint32_t pixelSize = isHdr ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    const VkDeviceSize frameBytes = static_cast<VkDeviceSize>(width) * height * pixelSize;
+    const VkDeviceSize headroom = deviceLocalHeadroom();
+    const VkDeviceSize usable = headroom > kVramReserveBytes ? headroom - kVramReserveBytes : 0;
+    const uint32_t fit = static_cast<uint32_t>(std::min<VkDeviceSize>(slots, usable / frameBytes));
+
+    sequenceFormat_ = isHdr ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R8G8B8A8_SRGB;
+    sequenceWidth_ = width;
+    sequenceHeight_ = height;
+    for (uint32_t i = 0; i < fit; ++i) {
+        // Running out of device memory shortens the ring rather than failing it
+        SequenceSlot slot;
+        if (!createImageResource(width, height, sequenceFormat_, 1, slot.image, slot.memory)) {
+            break;
+        }
+        if (!createImageView(slot.image, sequenceFormat_, 1, slot.view)) {
+            retireTexture(slot.image, slot.memory, VK_NULL_HANDLE, 0, 0);
+            break;
+        }
+        sequenceSlots_.push_back(slot);
+    }
+
+    if (sequenceSlots_.size() < 2) {
+        Logger::Warn("Sequence: VRAM holds fewer than two %ux%u frames; not playing", width, height);
+        EndSequence();
+        return 0;
+    }
+    Logger::Info("Sequence: %zu texture slots of %ux%u %s (%llu MB)", sequenceSlots_.size(), width, height,
+                 isHdr ? "RGBA16F" : "RGBA8",
+                 static_cast<unsigned long long>(frameBytes * sequenceSlots_.size() / (1024 * 1024)));
+    return static_cast<uint32_t>(sequenceSlots_.size());
+}
+
+void VulkanRenderer::EndSequence() {
+    if (sequenceSlots_.empty()) return;
+
+    for (size_t i = 0; i < sequenceSlots_.size(); ++i) {
+        const SequenceSlot& slot = sequenceSlots_[i];
+        if (static_cast<int32_t>(i) == sequenceShown_) {
+            // Stays on screen as the image texture; textureView_ already names it
+            textureImage_ = slot.image;
+            textureMemory_ = slot.memory;
+            continue;
+        }
+        // Its last upload may still be writing it and submitted frames may still read it
+        retireTexture(slot.image, slot.memory, slot.view, slot.uploadSerial, frameSerial_);
+    }
+    sequenceSlots_.clear();
+    sequenceShown_ = -1;
+}
+
+bool VulkanRenderer::UploadSequenceFrame(uint32_t slot, const void* pixels) {
+    // NASA Standard: Validate all input parameters
+    if (pixels == nullptr || slot >= sequenceSlots_.size() || static_cast<int32_t>(slot) == sequenceShown_ ||
+        deviceLost_) {
+        return false;
+    }
+
+    // On the graphics queue, so the move out of SHADER_READ_ONLY waits for the reads
+    // of frames that showed the slot's previous contents
+    SequenceSlot& target = sequenceSlots_[slot];
+    const uint32_t pixelSize = sequenceFormat_ == VK_FORMAT_R16G16B16A16_SFLOAT ? (4 * sizeof(uint16_t)) : (4 * sizeof(uint8_t));
+    if (!uploadImageRegion(target.image, target.layout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           static_cast<const uint8_t*>(pixels), static_cast<VkDeviceSize>(sequenceWidth_) * pixelSize,
+                           pixelSize, 0, 0, sequenceWidth_, sequenceHeight_)) {
+        return false;
+    }
+    target.uploadSerial = nextUploadSerial_ - 1;
+    return true;
+}
+
+void VulkanRenderer::ShowSequenceFrame(uint32_t slot) {
+    if (slot >= sequenceSlots_.size() || static_cast<int32_t>(slot) == sequenceShown_) {
+        return;
     }
-    if (tempMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device_, tempMemory, nullptr);
+    const SequenceSlot& shown = sequenceSlots_[slot];
+    if (shown.layout != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        return; // Never filled
     }
-    vkDestroyBuffer(device_, stagingBuffer, nullptr);
-    vkFreeMemory(device_, stagingMemory, nullptr);
+
+    if (sequenceShown_ < 0) {
+        // The first frame replaces the image texture and takes the LUT queued for the sequence
+        if (textureImage_ != VK_NULL_HANDLE) {
+            retireTexture(textureImage_, textureMemory_, textureView_, 0, frameSerial_);
+            textureImage_ = VK_NULL_HANDLE;
+            textureMemory_ = VK_NULL_HANDLE;
+        }
+        adoptPendingColorLut();
+    }
+    textureView_ = shown.view;
+    ++textureGeneration_;
+    textureFormat_ = sequenceFormat_;
+    textureLayout_ = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    textureWidth_ = sequenceWidth_;
+    textureHeight_ = sequenceHeight_;
+    textureMipLevels_ = 1;
+    textureScaleShift_ = 0;
+    textureIsHdr_ = sequenceFormat_ == VK_FORMAT_R16G16B16A16_SFLOAT;
+    textureIsSparse_ = false;
+    sequenceShown_ = static_cast<int32_t>(slot);
 }
 
 #endif // _WIN32
@@ -6,6 +6,9 @@
 // Include core Vulkan headers first
 #include <vulkan/vulkan.h>
 #include "text_renderer.h"
+#include "vulkan_staging.h"
+#include "tile_residency.h"
+#include "software_scaler.h"
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -15,18 +18,8 @@
 
 #include <vector>
 #include <cstdint>
-
-// Structure for sparse image tile information
-struct TileInfo {
-    uint32_t x = 0;
-    uint32_t y = 0;
-    uint32_t width = 0;
-    uint32_t height = 0;
-    bool loaded = false;
-    VkDeviceMemory memory = VK_NULL_HANDLE;
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-};
+#include <string>
+#include <thread>
 
 class VulkanRenderer {
 public:
@@ -38,28 +31,139 @@ public:
 
     // SDL3 interface
     bool Initialize(SDL_Window* window);
+    // Initialize() in two halves for startup. BeginInitialize() creates the instance,
+    // surface and device, and loads the fonts, on worker threads and returns at once.
+    // FinishInitialize() waits for the device and creates the swapchain on the calling
+    // thread, which must be the one that owns the window. Without a usable device it
+    // sets up the software fallback instead and still succeeds (IsSoftwareFallback()).
+    bool BeginInitialize(SDL_Window* window);
+    bool FinishInitialize();
+    // Frames are drawn on the CPU and blitted with GDI: no Vulkan device was available
+    bool IsSoftwareFallback() const { return !vulkanAvailable_ && fallbackHwnd_ != nullptr; }
     bool InitializeWithProgress(SDL_Window* window, ProgressCallback cb);
     
+    // Offscreen: frames are drawn into plain images in place of a swapchain, with no
+    // window and no present, so they are paced by the GPU alone (benchmarks)
+    bool InitializeHeadless(uint32_t width, uint32_t height);
+    bool IsHeadless() const { return headless_; }
+
     // Legacy Win32 interface (for compatibility)
     bool Initialize(HWND hwnd);
     bool InitializeWithProgress(HWND hwnd, ProgressCallback cb);
 
     void Shutdown();
     void Resize(uint32_t width, uint32_t height);
-    void Render(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY, int rotationAngle);
+    // 'rotationAngle' is clockwise degrees; 'mirrored' flips left-right before rotating
+    void Render(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY, int rotationAngle,
+                bool mirrored = false);
 
-    void UpdateImageFromData(const void* pixelData, uint32_t width, uint32_t height, bool isHdr);
-    void UpdateImageFromHBITMAP(HBITMAP hBitmap);
+    void UpdateImageFromData(const void* pixelData, uint32_t width, uint32_t height, bool isHdr, bool generateMipmaps = true);
     void UpdateImageFromLDRData(const void* pixelData, uint32_t width, uint32_t height, bool generateMipmaps = false);
     void UpdateImageFromHDRData(const uint16_t* pixelData, uint32_t width, uint32_t height, bool generateMipmaps = false);
     void UpdateImageTiled(const void* pixelData, uint32_t fullWidth, uint32_t fullHeight, 
                          uint32_t tileX, uint32_t tileY, uint32_t tileWidth, uint32_t tileHeight, bool isHdr);
+    // Show an image whose texels come from 'source' as the view needs them (sparse only).
+    // 'source' must stay valid until replaced or CancelPendingUpload() is called.
+    bool UpdateImageFromSource(TileSource* source, uint32_t width, uint32_t height, bool isHdr);
+    bool SupportsSparseTextures() const { return sparseImageSupport_; }
+    // Show an image whose rows come from 'source', converted straight into staging as
+    // the upload streams. Rows the source exposes in the texture's layout are imported
+    // without a copy when the device allows it. False for images past the dense limit
+    // or the VRAM budget when sparse residency can show them (UpdateImageFromSource);
+    // without it they are kept at a reduced scale.
+    // 'source' must stay valid until replaced or CancelPendingUpload() is called.
+    bool UpdateImageFromRows(RowSource* source, uint32_t width, uint32_t height, bool isHdr);
+    bool SupportsRowSources() const { return vulkanAvailable_ && device_ != VK_NULL_HANDLE; }
+    // How many image pixels one texel of the shown texture covers along each axis: 1 at
+    // full resolution, more when VRAM or the device's limits forced a reduced copy
+    uint32_t GetResidentDownscale() const {
+        return 1u << (textureIsSparse_ ? sparse_.baseLevel : textureScaleShift_);
+    }
+
+    // Display transform applied in the fragment shader: an RGBA16F 3D LUT of
+    // 'edgeLength'^3 texels (red varying fastest) indexed through a log2 shaper over
+    // [log2Min, log2Max]. Null shows texels as sampled. 'id' names the transform so an
+    // unchanged one is not uploaded again. With 'withNextImage' the LUT takes effect
+    // when the next uploaded image is shown, so the outgoing image keeps its own.
+    bool SetColorLut(const uint16_t* rgbaHalf, uint32_t edgeLength, float log2Min, float log2Max,
+                     uint64_t id, bool withNextImage = true);
+    bool SupportsColorLut() const { return imagePipeline_ != VK_NULL_HANDLE; }
+    // Exposure in stops, applied before the LUT, and the display gamma after it (2.2 = as encoded)
+    void SetDisplayAdjustments(float exposureStops, float gamma);
+
+    // Frame pacing. Smooth queues frames behind vsync (FIFO). Low latency presents with
+    // MAILBOX, or FIFO_RELAXED, where the surface offers them and keeps at most one frame
+    // ahead of the display, so input handled after PaceFrame() is in the next frame shown.
+    // A change of mode recreates the swapchain on the next frame.
+    void SetLowLatency(bool enabled);
+    bool IsLowLatency() const { return lowLatency_; }
+    const char* GetPresentModeName() const;
+    // Call before handling a frame's input. Low latency: block until the last frame is
+    // on screen (VK_KHR_present_wait) or, without it, off the GPU. Either mode: record
+    // the last frame's input-to-display time as Trace::Stage::Latency once it is shown.
+    void PaceFrame();
+    // Input the next Render() answers arrived at 'inputNs' (Trace::Now()). The earliest
+    // input since the last frame is the one measured.
+    void NoteInput(uint64_t inputNs) { if (inputPendingNs_ == 0) inputPendingNs_ = inputNs; }
+
+    // Text drawn top-left over every frame, '\n' between lines; empty hides it.
+    // Laid out from a glyph atlas, so changing it every frame is cheap.
+    void SetOverlayText(const std::string& text);
+
+    // Thumbnail grid: display-ready RGBA8 thumbnails held in fixed cells of one atlas
+    // texture and drawn, with their frames and fills, as a single instanced batch
+    static constexpr uint32_t kThumbnailCellSize = 128;
+    static constexpr uint32_t kThumbnailCells = 1023;         // Cells callers fill; one more is solid white
+    static constexpr uint32_t kGridSolidFill = UINT32_MAX;    // GridQuad::cell of an untextured rectangle
+    struct GridQuad {
+        float rect[4];          // x0, y0, x1, y1 in pixels
+        uint32_t cell;          // Atlas cell, or kGridSolidFill
+        uint32_t width;         // Thumbnail size within its cell
+        uint32_t height;
+        SDL_Color color;        // Multiplies the thumbnail; the colour of a solid fill
+    };
+    // Copy tightly packed pixels of at most kThumbnailCellSize square into 'cell'.
+    // Uploaded with the next frames, a bounded number per frame.
+    bool SetThumbnail(uint32_t cell, const uint8_t* rgba, uint32_t width, uint32_t height);
+    // Rectangles drawn over the image, back to front; empty draws none. With
+    // 'coverImage' the image is not drawn under them.
+    void SetThumbnailGrid(const std::vector<GridQuad>& quads, bool coverImage);
+    bool SupportsThumbnailGrid() const { return thumbnailPipeline_ != VK_NULL_HANDLE; }
+    // Thumbnails still waiting for a frame to upload them
+    bool HasPendingThumbnails() const { return !pendingThumbnails_.empty() && thumbnailPipeline_ != VK_NULL_HANDLE; }
+
+    // Flipbook playback: a ring of same-size textures filled ahead of the frames that
+    // show them, so moving to the next frame rebinds a texture instead of uploading one.
+    // The image texture keeps presenting until the first frame is shown. EndSequence()
+    // keeps the frame on screen as the image texture; any other image upload ends it.
+    // Returns how many slots VRAM can hold, up to 'slots'; 0 when not even two fit.
+    uint32_t BeginSequence(uint32_t slots, uint32_t width, uint32_t height, bool isHdr);
+    void EndSequence();
+    bool IsSequenceActive() const { return !sequenceSlots_.empty(); }
+    // Copy tightly packed pixels of the sequence's size and format into 'slot' on the
+    // graphics queue, ordered after frames that showed it before. Not the slot on screen.
+    bool UploadSequenceFrame(uint32_t slot, const void* pixels);
+    // Show 'slot' from the next frame on
+    void ShowSequenceFrame(uint32_t slot);
 
-    void SetColorTransform(void* processor);
+    // Drop an image upload that is still streaming in. Call before the pixel data
+    // passed to UpdateImageFromData is freed without another image replacing it.
+    void CancelPendingUpload();
+    bool HasPendingUpload() const {
+        return incoming_.image != VK_NULL_HANDLE ||
+               (textureIsSparse_ && (sparse_.src != nullptr || sparse_.source != nullptr) &&
+                (sparse_.residency.HasQueued() || sparse_.tailPending));
+    }
+
+    // Device-local memory this process has allocated (VK_EXT_memory_budget); 0 when unreported
+    VkDeviceSize GetDeviceLocalUsage() const;
 
     // Error state accessors
     bool IsDeviceLost() const { return deviceLost_; }
     bool IsSwapchainOutOfDate() const { return swapchainOutOfDate_; }
+    // An image upload found no device memory even at its smallest scale; the image
+    // shown before stays on screen. Reading it clears it.
+    bool TakeUploadFailure() { const bool failed = uploadFailed_; uploadFailed_ = false; return failed; }
     // Clear transient error flags after successful recovery (e.g., swapchain recreation)
     void ClearErrorFlags() { deviceLost_ = false; swapchainOutOfDate_ = false; }
 
@@ -71,9 +175,11 @@ private:
     VkSurfaceKHR surface_ = VK_NULL_HANDLE;
     VkQueue graphicsQueue_ = VK_NULL_HANDLE;
     VkQueue presentQueue_ = VK_NULL_HANDLE;
+    VkQueue transferQueue_ = VK_NULL_HANDLE;      // Same as graphicsQueue_ without a dedicated family
 
     uint32_t graphicsQueueFamily_ = UINT32_MAX;
     uint32_t presentQueueFamily_ = UINT32_MAX;
+    uint32_t transferQueueFamily_ = UINT32_MAX;
 
     VkSwapchainKHR swapchain_ = VK_NULL_HANDLE;
     VkFormat swapchainFormat_ = VK_FORMAT_UNDEFINED;
@@ -82,8 +188,41 @@ private:
     std::vector<VkImage> swapchainImages_;
     std::vector<VkImageView> swapchainImageViews_;
     std::vector<VkCommandBuffer> commandBuffers_;
+    std::vector<VkFramebuffer> framebuffers_;   // One per swapchain image view
+    bool headless_ = false;                     // swapchainImages_ are offscreen targets
+    std::vector<VkDeviceMemory> offscreenMemory_; // Backing of the offscreen targets
+
+    // Image pipeline: a textured quad drawn in a single render pass, with the view
+    // transform in push constants so per-frame cost does not depend on image size
+    struct ImagePushConstants {
+        float viewportSize[2];
+        float center[2];
+        float halfSize[2];   // Negative x mirrors the image
+        float rotation[2];   // cos, sin
+    };
+    // Fragment-stage push constants, placed after ImagePushConstants
+    struct ImageColorPush {
+        float exposureScale;
+        float gammaExponent;
+        float shaperMin;        // log2 range mapped onto the LUT's [0,1]
+        float shaperMax;
+        float lutScale;         // Texel-centre mapping: (n-1)/n and 0.5/n
+        float lutOffset;
+        uint32_t mode;          // 0 = as sampled, 1 = through the LUT
+        uint32_t linearizeOutput; // LUT output is display-encoded but the target re-encodes
+    };
+    VkRenderPass renderPass_ = VK_NULL_HANDLE;
+    VkFormat renderPassFormat_ = VK_FORMAT_UNDEFINED;
+    VkDescriptorSetLayout descriptorSetLayout_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool_ = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout_ = VK_NULL_HANDLE;
+    VkPipeline imagePipeline_ = VK_NULL_HANDLE;
+    VkPipeline textPipeline_ = VK_NULL_HANDLE;     // Instanced glyph quads, alpha blended
+    VkPipeline thumbnailPipeline_ = VK_NULL_HANDLE; // Same quads over the thumbnail atlas
+    VkSampler textureSampler_ = VK_NULL_HANDLE;
 
     VkCommandPool commandPool_ = VK_NULL_HANDLE;
+    VkCommandPool transferCommandPool_ = VK_NULL_HANDLE;  // Same as commandPool_ without a dedicated family
     
     // Per-frame synchronization objects
     static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
@@ -91,7 +230,28 @@ private:
     std::vector<VkSemaphore> renderFinishedSemaphores_;
     std::vector<VkFence> inFlightFences_;
     uint32_t currentFrame_ = 0;
+    uint64_t frameSerial_ = 0;                                  // Frames submitted so far
+    uint64_t completedFrameSerial_ = 0;                         // Newest frame known finished
+    uint64_t frameFenceSerials_[MAX_FRAMES_IN_FLIGHT] = {};     // Frame last submitted with each fence
+    // A descriptor set per frame slot, rewritten only after that slot's fence has signalled
+    VkDescriptorSet frameDescriptorSets_[MAX_FRAMES_IN_FLIGHT] = {};
+    uint64_t frameDescriptorGenerations_[MAX_FRAMES_IN_FLIGHT] = {};
+    VkDescriptorSet frameOverlaySets_[MAX_FRAMES_IN_FLIGHT] = {};
+    uint64_t frameOverlayGenerations_[MAX_FRAMES_IN_FLIGHT] = {};
     
+    // Frame pacing: present ids count every present across swapchains (each new swapchain
+    // starts past the last id); the latency of a frame is measured once its id is shown
+    static constexpr uint64_t kPaceTimeoutNs = 100ull * 1000 * 1000;   // A hidden window never presents
+    bool lowLatency_ = false;
+    bool presentModeDirty_ = false;                 // Swapchain still uses the other mode
+    VkPresentModeKHR presentMode_ = VK_PRESENT_MODE_FIFO_KHR;
+    bool presentWait_ = false;                      // VK_KHR_present_id and present_wait enabled
+    PFN_vkWaitForPresentKHR waitForPresent_ = nullptr;
+    uint64_t presentId_ = 0;                        // Last id presented
+    uint64_t presentIdShown_ = 0;                   // Last id known on screen
+    uint64_t inputPendingNs_ = 0;                   // Earliest input the next frame answers
+    uint64_t inputPresentedNs_ = 0;                 // Input answered by presentId_
+
     // Legacy synchronization objects (for cleanup compatibility)
     VkSemaphore imageAvailable_ = VK_NULL_HANDLE;
     VkSemaphore renderFinished_ = VK_NULL_HANDLE;
@@ -100,22 +260,212 @@ private:
     // Texture data
     VkImage textureImage_ = VK_NULL_HANDLE;
     VkDeviceMemory textureMemory_ = VK_NULL_HANDLE;
+    VkImageView textureView_ = VK_NULL_HANDLE;
+    uint64_t textureGeneration_ = 0;        // Bumped whenever textureView_ changes
     VkFormat textureFormat_ = VK_FORMAT_UNDEFINED;
     VkImageLayout textureLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
     uint32_t textureWidth_ = 0;
     uint32_t textureHeight_ = 0;
+    uint32_t textureMipLevels_ = 1;
+    uint32_t textureScaleShift_ = 0;        // Dense texture holds the image at 1/2^shift
     bool textureIsHdr_ = false;
     bool textureIsSparse_ = false;
 
-    // Sparse image support
-    bool sparseImageSupport_ = false;
-    uint32_t tileSize_ = 256;
-    VkDeviceSize sparseImageMemoryRequirements_ = 0;
-    std::vector<TileInfo> imageTiles_;
+    // VRAM budget: VK_EXT_memory_budget reports what each heap can still take. Images
+    // that would not fit go sparse or are kept reduced instead of failing to allocate.
+    static constexpr uint64_t kMaxDensePixels = UINT64_C(67108864);      // 8K x 8K
+    static constexpr VkDeviceSize kVramReserveBytes = 64ull * 1024 * 1024; // Left for swapchain and overlays
+    static constexpr uint32_t kMaxVramScaleShift = 3;                     // 1/8 scale at the most
+    bool memoryBudget_ = false;                     // Extension enabled
+
+    // Sparse image support: images past the dense limit keep only the tiles the
+    // view needs resident, streamed from the caller's pixels or a TileSource under
+    // a budget that follows the window size rather than the image size
+    static constexpr uint32_t kSparseTilesPerFrame = 128;
+    bool sparseImageSupport_ = false;               // Features enabled and graphics queue can bind
+    bool sparseBindingQueue_ = false;               // Graphics family has VK_QUEUE_SPARSE_BINDING_BIT
+    struct SparseTexture {
+        const uint8_t* src = nullptr;   // Caller's level-0 pixels; valid until replaced or cancelled
+        TileSource* source = nullptr;   // Or texels produced on demand
+        uint32_t sourceWidth = 0;       // Full-resolution size; the texture may start lower
+        uint32_t sourceHeight = 0;
+        uint32_t baseLevel = 0;         // Texture level 0 is this source level
+        bool tailPending = false;       // Mip tail not uploaded yet (source not ready)
+        uint32_t pixelSize = 0;
+        uint32_t tileWidth = 0;
+        uint32_t tileHeight = 0;
+        VkDeviceSize tileBytes = 0;     // Sparse block size
+        uint32_t tiledLevels = 0;       // Levels before the mip tail
+        VkDeviceMemory mipTailMemory = VK_NULL_HANDLE;
+        VkSemaphore bindSemaphore = VK_NULL_HANDLE;   // Binds -> the upload that fills them
+        TileResidency residency;
+        std::vector<TileResidency::Bind> unbinds;     // Scratch, reused every frame
+        std::vector<TileResidency::Bind> binds;
+    };
+    SparseTexture sparse_;
+
+    // Uploads: staging comes from a persistent ring; submissions are fenced and
+    // retired by polling instead of waiting for the queue to go idle
+    static constexpr VkDeviceSize kStagingBlockSize = 64ull * 1024 * 1024;
+    static constexpr uint32_t kMaxStagingBlocks = 4;
+    struct PendingUpload {
+        uint64_t serial = 0;
+        VkFence fence = VK_NULL_HANDLE;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkCommandPool pool = VK_NULL_HANDLE;
+    };
+    StagingRing stagingRing_;
+    VkDeviceSize stagingAlignment_ = 16;
+    std::vector<PendingUpload> pendingUploads_;   // Oldest first
+    std::vector<VkFence> uploadFencePool_;
+    uint64_t nextUploadSerial_ = 1;
+
+    // Image upload streaming in on the transfer queue while textureImage_ keeps
+    // presenting. A bounded number of bytes is staged per frame, and the texture
+    // is swapped in by Render once the submission holding the last band completes.
+    static constexpr VkDeviceSize kIncomingBytesPerFrame = 32ull * 1024 * 1024;
+    struct IncomingTexture {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t sourceWidth = 0;       // Caller's size; larger when the texture is reduced
+        uint32_t sourceHeight = 0;
+        uint32_t scaleShift = 0;        // Each texel averages a 2^shift square of source pixels
+        uint32_t mipLevels = 1;         // Levels past 0 are generated on the graphics queue at swap
+        bool isHdr = false;
+        const uint8_t* src = nullptr;   // Caller's pixels; valid until replaced or cancelled
+        RowSource* rows = nullptr;      // Or rows converted into staging as they are streamed
+        uint32_t pixelSize = 0;
+        uint32_t nextRow = 0;           // First row not yet staged
+        uint64_t lastSerial = 0;        // Upload serial of the final band, 0 while streaming
+    };
+    IncomingTexture incoming_;
+    std::vector<uint8_t> reduceRows_;       // Source rows behind one reduced row
+    std::vector<float> reduceScratch_;
+
+    // Zero-copy uploads (VK_EXT_external_memory_host): rows a RowSource already holds
+    // in the texture's layout are imported as a transfer source instead of staged. The
+    // imported memory is freed once its copy completes, before the source may go away.
+    struct HostImport {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint64_t serial = 0;            // Upload reading it
+    };
+    bool hostMemoryImport_ = false;                 // Extension enabled
+    VkDeviceSize hostPointerAlignment_ = 0;         // minImportedHostPointerAlignment
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties_ = nullptr;
+    std::vector<HostImport> hostImports_;
+
+    // Textures replaced or cancelled while the GPU may still use them
+    struct RetiredTexture {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        uint64_t uploadSerial = 0;      // Last upload that may write it
+        uint64_t frameSerial = 0;       // Last frame that may read it
+    };
+    std::vector<RetiredTexture> retiredTextures_;
+
+    // "No image" screen, kept resident and re-rasterized only when its key changes
+    struct OverlayKey {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool openColorIOAvailable = false;
+        std::string text;
+        bool operator==(const OverlayKey&) const = default;
+    };
+    struct OverlayTexture {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        OverlayKey key;
+        uint64_t generation = 0;        // Bumped whenever view changes
+    };
+    OverlayTexture instructionalOverlay_;
+
+    // Display LUTs. The active one belongs to the texture on screen; a pending one
+    // waits for the next texture. The 1x1x1 placeholder keeps binding 1 valid.
+    struct ColorLutTexture {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        uint32_t edgeLength = 0;
+        float log2Min = 0.0f;
+        float log2Max = 0.0f;
+        uint64_t id = 0;
+        uint64_t uploadSerial = 0;
+    };
+    ColorLutTexture colorLut_;
+    ColorLutTexture pendingColorLut_;
+    bool colorLutPending_ = false;
+    ColorLutTexture placeholderLut_;
+    uint64_t colorLutGeneration_ = 1;       // Bumped whenever colorLut_ changes
+    uint64_t frameLutGenerations_[MAX_FRAMES_IN_FLIGHT] = {};
+    float exposureScale_ = 1.0f;
+    float gammaExponent_ = 1.0f;
+
+    // HUD text: quads laid out from TextRenderer's glyph atlas into a per-frame,
+    // persistently mapped vertex buffer
+    static constexpr uint32_t kMaxHudGlyphs = 4096;
+    VkImage glyphAtlasImage_ = VK_NULL_HANDLE;
+    VkDeviceMemory glyphAtlasMemory_ = VK_NULL_HANDLE;
+    VkImageView glyphAtlasView_ = VK_NULL_HANDLE;
+    VkDescriptorSet glyphAtlasSet_ = VK_NULL_HANDLE;
+    bool glyphAtlasSetWritten_ = false;
+    VkBuffer hudBuffers_[MAX_FRAMES_IN_FLIGHT] = {};
+    VkDeviceMemory hudMemory_[MAX_FRAMES_IN_FLIGHT] = {};
+    void* hudMapped_[MAX_FRAMES_IN_FLIGHT] = {};
+    std::string hudText_;
+    std::vector<TextRenderer::GlyphQuad> hudQuads_;   // Reused so layout doesn't allocate per frame
+
+    // Thumbnail grid: a kThumbnailAtlasColumns-wide grid of cells in one texture, the
+    // last cell kept white for solid fills. Pending thumbnails are staged together in one
+    // submission per frame; the quads go through per-frame buffers like the HUD's.
+    static constexpr uint32_t kThumbnailAtlasColumns = 32;
+    static constexpr uint32_t kThumbnailUploadsPerFrame = 64;
+    static constexpr uint32_t kMaxGridQuads = 8192;
+    struct PendingThumbnail {
+        uint32_t cell = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> rgba;
+    };
+    VkImage thumbnailAtlasImage_ = VK_NULL_HANDLE;
+    VkDeviceMemory thumbnailAtlasMemory_ = VK_NULL_HANDLE;
+    VkImageView thumbnailAtlasView_ = VK_NULL_HANDLE;
+    VkImageLayout thumbnailAtlasLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkDescriptorSet thumbnailAtlasSet_ = VK_NULL_HANDLE;
+    bool thumbnailAtlasSetWritten_ = false;
+    std::vector<PendingThumbnail> pendingThumbnails_;   // Oldest first; a cell appears once
+    VkBuffer gridBuffers_[MAX_FRAMES_IN_FLIGHT] = {};
+    VkDeviceMemory gridMemory_[MAX_FRAMES_IN_FLIGHT] = {};
+    void* gridMapped_[MAX_FRAMES_IN_FLIGHT] = {};
+    std::vector<GridQuad> gridQuads_;
+    bool gridCoversImage_ = false;
+
+    // Flipbook ring. While a slot is shown, textureView_ is its view and textureImage_
+    // is null; the slots own their images until EndSequence() hands the shown one over.
+    struct SequenceSlot {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        uint64_t uploadSerial = 0;      // Last upload that wrote it
+    };
+    std::vector<SequenceSlot> sequenceSlots_;
+    VkFormat sequenceFormat_ = VK_FORMAT_UNDEFINED;
+    uint32_t sequenceWidth_ = 0;
+    uint32_t sequenceHeight_ = 0;
+    int32_t sequenceShown_ = -1;            // Slot on screen, or -1 while the image texture is
 
     // Error tracking
     bool deviceLost_ = false;
     bool swapchainOutOfDate_ = false;
+    bool uploadFailed_ = false;
     bool vulkanAvailable_ = false;
     
     // Enhanced device lost diagnostics
@@ -129,13 +479,29 @@ private:
     HWND fallbackHwnd_ = nullptr;
     uint32_t fallbackWidth_ = 800;
     uint32_t fallbackHeight_ = 600;
-    std::vector<uint8_t> fallbackBuffer_;
+    std::vector<uint8_t> fallbackBuffer_;   // Grows with the window, never shrinks
+    SoftwareScaler fallbackImage_;          // The image and its pyramid, drawn on the CPU
 
-    void* colorProcessor_ = nullptr;
-    
     // Text rendering
     TextRenderer textRenderer_;
 
+    // Startup workers (BeginInitialize). The font thread is joined by the first text drawn.
+    std::thread initThread_;
+    std::thread fontThread_;
+    SDL_Window* initWindow_ = nullptr;
+    bool initPending_ = false;              // BeginInitialize() ran and FinishInitialize() has not
+    bool initDeviceOk_ = false;             // Written by initThread_ before it ends
+    bool initDevice(SDL_Window* window);
+    bool waitForText();
+
+    // Pipelines compile from a cache kept between runs, so only the first launch on a
+    // device and driver pays for it
+    static constexpr size_t kMaxPipelineCacheBytes = 64u * 1024 * 1024;   // Larger files are not ours
+    VkPipelineCache pipelineCache_ = VK_NULL_HANDLE;
+    size_t pipelineCacheSavedBytes_ = 0;    // Size of the data on disk; the cache only grows
+    void loadPipelineCache();
+    void savePipelineCache();
+
     // Helper functions
     bool initInstance();
     bool pickPhysicalDevice();
@@ -145,29 +511,108 @@ private:
     bool createSurface(SDL_Window* window);
     bool createCommandPool();
     bool createSwapchain(uint32_t width, uint32_t height);
+    bool createOffscreenTargets(uint32_t width, uint32_t height);
+    // Render pass, framebuffers and command buffers for the current targets
+    bool createFrameResources();
     void destroySwapchain();
+    bool createFramebuffers();
+    bool createImagePipeline();
+    void destroyImagePipeline();
+    VkPipeline createQuadPipeline(const uint32_t* vertCode, size_t vertSize, const uint32_t* fragCode, size_t fragSize,
+                                  const VkPipelineVertexInputStateCreateInfo& vertexInput, bool alphaBlend);
+    void writeImageDescriptor(VkDescriptorSet set, VkImageView view, VkImageLayout layout);
+    void writeLutDescriptor(VkDescriptorSet set, VkImageView view);
+    // Fit, zoom, pan and rotation of the current texture for the image pipeline
+    ImagePushConstants computeImagePush(float zoom, float offsetX, float offsetY, int rotationAngle, bool mirrored) const;
+    VkShaderModule createShaderModule(const uint32_t* code, size_t sizeBytes);
     bool createSyncObjects();
     void recreateSwapchain(uint32_t width, uint32_t height);
 
+    bool createImageResource(uint32_t width, uint32_t height, VkFormat format, uint32_t mipLevels,
+                             VkImage& image, VkDeviceMemory& memory);
+    bool createImageView(VkImage image, VkFormat format, uint32_t mipLevels, VkImageView& view);
     bool createTexture(uint32_t width, uint32_t height, bool isHdr);
     void destroyTexture();
     bool createStagingBuffer(VkDeviceSize size, VkBuffer& buffer, VkDeviceMemory& memory);
-    void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
-    void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+    void transitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout);
+
+    // Mip chain: levels are downsampled with linear blits, each from the one above
+    bool supportsMipmapBlits(VkFormat format) const;
+    void recordMipChain(VkCommandBuffer cmd, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+    // Staged uploads
+    bool ensureStagingRing();
+    bool uploadImageRegion(VkImage image, VkImageLayout& layout, VkImageLayout finalLayout,
+                           const uint8_t* src, VkDeviceSize srcRowPitch, uint32_t pixelSize,
+                           uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void retireUploads(bool waitForOldest);
+    void waitForUploads();
+    void destroyUploadResources();
+    bool isUploadComplete(uint64_t serial) const;
+
+    // Transfer-queue streaming and texture hand-over
+    bool hasDedicatedTransferQueue() const { return transferQueueFamily_ != graphicsQueueFamily_; }
+    bool beginIncomingTexture(uint32_t width, uint32_t height, bool isHdr, bool generateMipmaps, uint32_t scaleShift);
+    void pumpIncomingTexture();
+    void reduceIncomingRows(uint32_t row, uint32_t count, uint8_t* dst);
+    void finishIncomingTexture(VkCommandBuffer cmd);
+    bool importIncomingRows();
+    void releaseHostImports(bool force);
+    void adoptIncomingTexture(VkCommandBuffer cmd);
+    void retireTexture(VkImage image, VkDeviceMemory memory, VkImageView view, uint64_t uploadSerial, uint64_t frameSerial);
+    void destroyRetiredTextures(bool force);
+
+    // Display LUTs
+    bool createColorLut(const uint16_t* rgbaHalf, uint32_t edgeLength, ColorLutTexture& lut);
+    bool ensureLutPlaceholder();
+    void adoptPendingColorLut();
+    void retireColorLut(ColorLutTexture& lut);
+    void destroyColorLuts();
+    ImageColorPush computeColorPush() const;
 
     // Sparse image functions
-    bool InitializeSparseImage(uint32_t width, uint32_t height, bool isHdr);
-    void LoadImageTile(uint32_t tileX, uint32_t tileY, const void* tileData, bool isHdr);
+    bool createSparseTexture(const void* pixelData, TileSource* source, uint32_t width, uint32_t height, bool isHdr);
+    void pumpSparseTexture(float zoom, float offsetX, float offsetY, int rotationAngle, bool mirrored);
+    bool recordMipTail(VkCommandBuffer cmd);
+    bool fillSparseRegion(uint8_t* dst, uint32_t level, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void destroySparseResources();
 
     // Software fallback functions
     bool initializeSoftwareFallback(HWND hwnd);
-    void renderSoftwareFallback(uint32_t width, uint32_t height);
+    bool initializeSoftwareFallback(SDL_Window* window);
+    void renderSoftwareFallback(uint32_t width, uint32_t height, float zoom, float offsetX, float offsetY,
+                                int rotationAngle, bool mirrored);
 
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+    // Bytes the roomiest device-local heap can still take
+    VkDeviceSize deviceLocalHeadroom() const;
+    // Smallest power-of-two reduction that fits a dense texture in 'headroom' and the dense limit
+    uint32_t denseScaleShift(uint32_t width, uint32_t height, uint32_t pixelSize, bool withMipmaps,
+                             VkDeviceSize headroom) const;
+    VkDeviceSize sparseBudgetCap(VkDeviceSize wanted) const;
 
-    VkCommandBuffer beginSingleTimeCommands();
-    void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+    VkCommandBuffer beginSingleTimeCommands(bool onTransferQueue = false);
+    // Returns the upload serial of the submission, or 0 if it was not submitted.
+    // 'waitSemaphore' (e.g. signalled by sparse binds) is waited at the transfer stage.
+    uint64_t endSingleTimeCommands(VkCommandBuffer commandBuffer, bool onTransferQueue = false,
+                                   VkSemaphore waitSemaphore = VK_NULL_HANDLE);
     
     // UI rendering functions
-    void RenderInstructionalUI(VkCommandBuffer cmd, VkImage swapchainImage, uint32_t width, uint32_t height);
+    bool ensureInstructionalOverlay(uint32_t width, uint32_t height);
+    bool ensureGlyphAtlas();
+    bool ensureHudBuffers();
+    void destroyHudBuffers();
+    void recordHudText(VkCommandBuffer cmd, const VkViewport& viewport, const VkRect2D& scissor);
+    // Host-visible, persistently mapped vertex buffer of 'size' bytes per frame slot
+    bool createFrameVertexBuffers(VkDeviceSize size, VkBuffer (&buffers)[MAX_FRAMES_IN_FLIGHT],
+                                  VkDeviceMemory (&memory)[MAX_FRAMES_IN_FLIGHT], void* (&mapped)[MAX_FRAMES_IN_FLIGHT]);
+    void destroyFrameVertexBuffers(VkBuffer (&buffers)[MAX_FRAMES_IN_FLIGHT],
+                                   VkDeviceMemory (&memory)[MAX_FRAMES_IN_FLIGHT], void* (&mapped)[MAX_FRAMES_IN_FLIGHT]);
+
+    // Thumbnail grid
+    bool ensureThumbnailAtlas();
+    void uploadPendingThumbnails();
+    void recordThumbnailGrid(VkCommandBuffer cmd, const VkViewport& viewport, const VkRect2D& scissor);
+    void destroyThumbnailResources();
+    void destroyOverlayResources();
 };
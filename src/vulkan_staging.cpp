@@ -0,0 +1,160 @@
+#include "vulkan_staging.h"
+#include "logging.h"
+
+#include <algorithm>
+
+StagingRing::~StagingRing() {
+    Shutdown();
+}
+
+bool StagingRing::Initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize, uint32_t maxBlocks) {
+    // NASA Standard: Validate all input parameters
+    if (device == VK_NULL_HANDLE || physicalDevice == VK_NULL_HANDLE || blockSize == 0 || maxBlocks == 0) {
+        return false;
+    }
+
+    Shutdown();
+    device_ = device;
+    physicalDevice_ = physicalDevice;
+    blockSize_ = blockSize;
+    maxBlocks_ = maxBlocks;
+
+    // Create the first block up front so the common single-upload case never allocates
+    blocks_.emplace_back();
+    if (!createBlock(blocks_.back())) {
+        blocks_.clear();
+        device_ = VK_NULL_HANDLE;
+        return false;
+    }
+    currentBlock_ = 0;
+    Logger::Info("StagingRing: %llu MB blocks, up to %u",
+                 static_cast<unsigned long long>(blockSize_ >> 20), maxBlocks_);
+    return true;
+}
+
+void StagingRing::Shutdown() {
+    if (device_ == VK_NULL_HANDLE) return;
+    for (auto& block : blocks_) {
+        destroyBlock(block);
+    }
+    blocks_.clear();
+    currentBlock_ = 0;
+    device_ = VK_NULL_HANDLE;
+}
+
+bool StagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& out) {
+    if (device_ == VK_NULL_HANDLE || size == 0 || size > blockSize_) {
+        return false;
+    }
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+
+    auto tryBlock = [&](uint32_t index) {
+        Block& block = blocks_[index];
+        const VkDeviceSize offset = (block.used + alignment - 1) / alignment * alignment;
+        if (offset + size > blockSize_) return false;
+
+        block.used = offset + size;
+        block.uncommitted = true;
+        out.buffer = block.buffer;
+        out.offset = offset;
+        out.size = size;
+        out.mapped = block.mapped + offset;
+        currentBlock_ = index;
+        return true;
+    };
+
+    if (tryBlock(currentBlock_)) return true;
+
+    // Move on to a block that has been fully reclaimed
+    for (uint32_t i = 0; i < blocks_.size(); ++i) {
+        if (i != currentBlock_ && blocks_[i].used == 0 && tryBlock(i)) return true;
+    }
+
+    // NASA Standard: Bound staging memory; the caller waits for in-flight uploads instead
+    if (blocks_.size() >= maxBlocks_) return false;
+
+    blocks_.emplace_back();
+    if (!createBlock(blocks_.back())) {
+        blocks_.pop_back();
+        return false;
+    }
+    return tryBlock(static_cast<uint32_t>(blocks_.size() - 1));
+}
+
+void StagingRing::Commit(uint64_t serial) {
+    for (auto& block : blocks_) {
+        if (block.uncommitted) {
+            block.lastSerial = std::max(block.lastSerial, serial);
+            block.uncommitted = false;
+        }
+    }
+}
+
+void StagingRing::Reclaim(uint64_t completedSerial) {
+    for (auto& block : blocks_) {
+        if (!block.uncommitted && block.lastSerial <= completedSerial) {
+            block.used = 0;
+        }
+    }
+}
+
+bool StagingRing::createBlock(Block& block) {
+    VkBufferCreateInfo bi{};
+    bi.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bi.size = blockSize_;
+    bi.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bi.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device_, &bi, nullptr, &block.buffer) != VK_SUCCESS) {
+        block.buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryRequirements req{};
+    vkGetBufferMemoryRequirements(device_, block.buffer, &req);
+
+    VkPhysicalDeviceMemoryProperties memProps{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice_, &memProps);
+    const VkMemoryPropertyFlags wanted = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    uint32_t typeIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i) {
+        if ((req.memoryTypeBits & (1u << i)) && (memProps.memoryTypes[i].propertyFlags & wanted) == wanted) {
+            typeIndex = i;
+            break;
+        }
+    }
+
+    VkMemoryAllocateInfo ai{};
+    ai.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    ai.allocationSize = req.size;
+    ai.memoryTypeIndex = typeIndex;
+
+    void* mapped = nullptr;
+    if (typeIndex == UINT32_MAX ||
+        vkAllocateMemory(device_, &ai, nullptr, &block.memory) != VK_SUCCESS ||
+        vkBindBufferMemory(device_, block.buffer, block.memory, 0) != VK_SUCCESS ||
+        vkMapMemory(device_, block.memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+        Logger::Warn("StagingRing: failed to allocate a %llu MB staging block",
+                     static_cast<unsigned long long>(blockSize_ >> 20));
+        destroyBlock(block);
+        return false;
+    }
+
+    block.mapped = static_cast<uint8_t*>(mapped);
+    block.used = 0;
+    block.lastSerial = 0;
+    block.uncommitted = false;
+    return true;
+}
+
+void StagingRing::destroyBlock(Block& block) {
+    if (block.mapped && block.memory != VK_NULL_HANDLE) {
+        vkUnmapMemory(device_, block.memory);
+    }
+    if (block.buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device_, block.buffer, nullptr);
+    }
+    if (block.memory != VK_NULL_HANDLE) {
+        vkFreeMemory(device_, block.memory, nullptr);
+    }
+    block = Block{};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * RowSource - Rows of a dense texture, produced as the upload streams them
+ * Lets VulkanRenderer convert texels straight into staging instead of reading
+ * a caller-owned copy of the whole image. Rows are RGBA8 or RGBA16F as the
+ * texture, tightly packed.
+ */
+class RowSource {
+public:
+    virtual ~RowSource() = default;
+
+    // Write rows [y, y + count) into 'dst'. Returns false for rows outside the image.
+    virtual bool ReadRows(uint32_t y, uint32_t count, uint8_t* dst) = 0;
+
+    // Texels already in the texture's layout, 'rowPitch' bytes apart, that stay valid
+    // as long as the source does; null when rows have to go through ReadRows
+    virtual const uint8_t* GetDirectRows(size_t& rowPitch) const {
+        rowPitch = 0;
+        return nullptr;
+    }
+};
+
+/**
+ * StagingRing - Persistently mapped upload arena for VulkanRenderer
+ * Suballocates host-visible staging space from a few large VkDeviceMemory
+ * blocks instead of creating a buffer per upload. Each block is a bump
+ * allocator tagged with the serial of the last submission reading from it;
+ * once the renderer observes that serial complete (via its fences), the
+ * block is rewound and reused. Nothing is unmapped or freed until Shutdown().
+ */
+class StagingRing {
+public:
+    struct Allocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        uint8_t* mapped = nullptr;   // Host pointer to offset
+    };
+
+    StagingRing() = default;
+    ~StagingRing();
+
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+
+    bool Initialize(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize, uint32_t maxBlocks);
+    void Shutdown();
+    bool IsInitialized() const { return device_ != VK_NULL_HANDLE; }
+
+    // Suballocate 'size' bytes. Returns false when the request exceeds the block
+    // size or every block is still in flight; retire submissions and retry.
+    bool Allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& out);
+
+    // Tag everything allocated since the previous Commit with the submission serial
+    void Commit(uint64_t serial);
+
+    // Rewind blocks whose last submission is <= completedSerial
+    void Reclaim(uint64_t completedSerial);
+
+    VkDeviceSize GetBlockSize() const { return blockSize_; }
+
+private:
+    struct Block {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint8_t* mapped = nullptr;
+        VkDeviceSize used = 0;
+        uint64_t lastSerial = 0;     // Newest submission reading from this block
+        bool uncommitted = false;    // Holds allocations not yet submitted
+    };
+
+    bool createBlock(Block& block);
+    void destroyBlock(Block& block);
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkPhysicalDevice physicalDevice_ = VK_NULL_HANDLE;
+    VkDeviceSize blockSize_ = 0;
+    uint32_t maxBlocks_ = 0;
+    uint32_t currentBlock_ = 0;
+    std::vector<Block> blocks_;
+};
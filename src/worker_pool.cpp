@@ -0,0 +1,124 @@
+#include "worker_pool.h"
+#include "logging.h"
+#include "trace.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned workerCount) {
+    if (workerCount == 0) {
+        const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        workerCount = hardwareThreads - 1;
+    }
+    // NASA Standard: Bound thread creation
+    workerCount = std::min(workerCount, 63u);
+
+    workers_.reserve(workerCount);
+    try {
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers_.emplace_back(&WorkerPool::workerMain, this);
+        }
+    } catch (const std::exception& e) {
+        // Run with whatever started; the caller always contributes a thread
+        Logger::Warn("WorkerPool: started %zu of %u threads: %s", workers_.size(), workerCount, e.what());
+    }
+    workerCount_.store(static_cast<unsigned>(workers_.size()), std::memory_order_release);
+    Logger::Info("WorkerPool: %zu worker threads", workers_.size());
+}
+
+WorkerPool::~WorkerPool() {
+    Shutdown();
+}
+
+WorkerPool& WorkerPool::Shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    workerCount_.store(0, std::memory_order_release);
+    workCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+}
+
+bool WorkerPool::ParallelFor(size_t count, size_t grain, const RangeFn& body) {
+    if (count == 0) return true;
+    grain = std::max<size_t>(grain, 1);
+
+    // Enough chunks to balance uneven rows, but never smaller than the grain
+    const size_t concurrency = GetConcurrency();
+    const size_t chunkSize = std::max(grain, (count + concurrency * 4 - 1) / (concurrency * 4));
+
+    auto job = std::make_shared<Job>();
+    job->body = &body;
+    job->count = count;
+    job->chunkSize = chunkSize;
+    job->chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    bool queued = false;
+    if (job->chunkCount > 1 && workerCount_.load(std::memory_order_acquire) != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            jobs_.push_back(job);
+            queued = true;
+        }
+    }
+    if (queued) workCv_.notify_all();
+
+    runChunks(*job);
+
+    if (queued) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [&] { return job->doneChunks.load(std::memory_order_acquire) == job->chunkCount; });
+        jobs_.erase(std::remove(jobs_.begin(), jobs_.end(), job), jobs_.end());
+    }
+    return !job->failed.load(std::memory_order_acquire);
+}
+
+void WorkerPool::runChunks(Job& job) {
+    for (;;) {
+        const size_t chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job.chunkCount) return;
+
+        const size_t begin = chunk * job.chunkSize;
+        const size_t end = std::min(job.count, begin + job.chunkSize);
+        try {
+            (*job.body)(begin, end);
+        } catch (...) {
+            job.failed.store(true, std::memory_order_release);
+        }
+
+        if (job.doneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == job.chunkCount) {
+            // Take the lock so the submitter can't miss the wakeup between its check and wait
+            std::lock_guard<std::mutex> lock(mutex_);
+            doneCv_.notify_all();
+        }
+    }
+}
+
+void WorkerPool::workerMain() {
+    Trace::NameThread("pool");
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        workCv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (stopping_) return;
+
+        std::shared_ptr<Job> job = jobs_.front();
+        if (job->nextChunk.load(std::memory_order_relaxed) >= job->chunkCount) {
+            // Fully claimed; the remaining chunks are finishing elsewhere
+            jobs_.pop_front();
+            continue;
+        }
+
+        lock.unlock();
+        runChunks(*job);
+        lock.lock();
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WorkerPool - Fixed set of threads for data-parallel pixel work
+ * One process-wide pool (Shared()) sized to the machine is used by every
+ * subsystem that splits work into bands: the decode worker, conversion
+ * passes and tools. The submitting thread always participates in its own
+ * job, so ParallelFor may be called from a pool thread without deadlocking
+ * and degrades to a plain loop when there are no workers.
+ */
+class WorkerPool {
+public:
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // 0 = one thread per hardware thread, minus the caller
+    explicit WorkerPool(unsigned workerCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Process-wide pool, created on first use
+    static WorkerPool& Shared();
+
+    // Join all workers; later ParallelFor calls run on the calling thread
+    void Shutdown();
+
+    // Threads that can run chunks concurrently, including the caller
+    unsigned GetConcurrency() const { return workerCount_.load(std::memory_order_acquire) + 1; }
+
+    // Run body over [0, count) in chunks of at least 'grain' items and wait.
+    // Returns false if any chunk threw; the remaining chunks still run.
+    bool ParallelFor(size_t count, size_t grain, const RangeFn& body);
+
+private:
+    struct Job {
+        const RangeFn* body = nullptr;
+        size_t count = 0;
+        size_t chunkSize = 0;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> doneChunks{0};
+        std::atomic<bool> failed{false};
+    };
+
+    void workerMain();
+    void runChunks(Job& job);
+
+    std::vector<std::thread> workers_;   // Touched only by the constructor and Shutdown()
+    std::atomic<unsigned> workerCount_{0};   // What submitters read instead of workers_
+    std::mutex mutex_;
+    std::condition_variable workCv_;   // Workers wait for jobs
+    std::condition_variable doneCv_;   // Submitters wait for their job to drain
+    std::deque<std::shared_ptr<Job>> jobs_;
+    bool stopping_ = false;
+};